@@ -113,12 +113,11 @@ bool baseflight_mavlink_send_1Hzheartbeat(void)                          // That
     return true;
 }
 
-void baseflight_mavlink_send_message(mavlink_message_t* msg)
+bool baseflight_mavlink_send_message(mavlink_message_t* msg)             // false = no room in the uart, nothing sent
 {
     uint8_t  buf[MAVLINK_MAX_PACKET_LEN];
 	  uint16_t len = mavlink_msg_to_send_buffer(buf, msg);
-	  uint16_t i;
-	  for (i = 0; i < len; i++) uartWrite(buf[i]);
+	  return uartWriteBlock(buf, len);
 }
 
 bool baseflight_mavlink_receive(char new)
@@ -172,11 +171,13 @@ void baseflight_mavlink_handleMessage(mavlink_message_t *msg)
 void baseflight_mavlink_send_updates(void)                                      // That's a bad mother here :)
 {
     static uint32_t   Timer100Hz;
-    static uint8_t    HudPackCnt, AttiPackCnt, GPSPackCnt, RCPackCnt, ParaLstCnt, StatuspackCnt, PressPackCnt;
+    static uint8_t    HudPackCnt, AttiPackCnt, GPSPackCnt, RCPackCnt, ParaLstCnt, StatuspackCnt, PressPackCnt, LoopPackCnt, LoopPackNr;
     uint16_t          voltage = 0;
     mavlink_message_t msg2;
     bool              PacketSent;                                               // Avoid too much stuff in one Action
     int16_t           tmp1;
+    int32_t           tmp32;
+    static const char LoopNames[3][10] = { "LOOPOVR", "LOOPMAX", "LOOPSTL" }; // named_value wants the full 10 chars
 
 //  NOTE: THE HZ NUMBERS ARE WISHFUL THINKING, BECAUSE IT IS ENSURED THAT ONLY ONE PACKET IS SENT PER RUN
 //  SO THE ACTUAL HZ WILL DEGRADE, CHECK WITH GCS FOR REAL DATARATES
@@ -186,7 +187,7 @@ void baseflight_mavlink_send_updates(void)
 	  {
         Timer100Hz = currentTime;
         HudPackCnt++; AttiPackCnt++; GPSPackCnt++; RCPackCnt++; ParaLstCnt++;   // INCREASE TIMERS
-        StatuspackCnt++; PressPackCnt++;
+        StatuspackCnt++; PressPackCnt++; LoopPackCnt++;
 
         if (PressPackCnt >= 200 && !PacketSent)                                 // 0.5Hz for Pressure Pack
         {
@@ -197,6 +198,27 @@ void baseflight_mavlink_send_updates(void)
             baseflight_mavlink_send_message(&msg2);
         }
 
+        if (LoopPackCnt >= 33 && !PacketSent)                                  // 1Hz for the loop stats, one named value after the other
+        {
+            LoopPackCnt = 0;
+            PacketSent  = true;
+            switch (LoopPackNr)
+            {
+            case 0:
+                tmp32 = loopStats.overruns;
+                break;
+            case 1:
+                tmp32 = loopStats.maxCycle;
+                break;
+            default:
+                tmp32 = loopStats.stallTask;
+                break;
+            }
+            mavlink_msg_named_value_int_pack(1, 200, &msg2, currentTimeMS, LoopNames[LoopPackNr], tmp32);
+            if (++LoopPackNr >= 3) LoopPackNr = 0;
+            baseflight_mavlink_send_message(&msg2);
+        }
+
         if (RCPackCnt >= 47 && !PacketSent)                                     // 2Hz for RC
         {
             RCPackCnt  = 0;
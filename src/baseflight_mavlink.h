@@ -45,11 +45,11 @@ enum {
 
 void     reset_mavlink(void);
 bool     baseflight_mavlink_receive(char new);
-void     baseflight_mavlink_send_message (mavlink_message_t* msg);
+bool     baseflight_mavlink_send_message (mavlink_message_t* msg);
 void     baseflight_mavlink_handleMessage (mavlink_message_t *msg);
 void     baseflight_mavlink_send_updates(void);
 bool     baseflight_mavlink_send_paramlist(bool Reset);
-void     baseflight_mavlink_send_singleparam(int16_t Nr);
+bool     baseflight_mavlink_send_singleparam(int16_t Nr);
 bool     baseflight_mavlink_set_param (mavlink_param_set_t *packet);
 bool     baseflight_mavlink_send_1Hzheartbeat(void);
 
@@ -0,0 +1,434 @@
+#include "board.h"
+#include "mw.h"
+
+// Blackbox: loop rate flight data in the internal flash behind the firmware image (FLASH_IMAGE_END, first full page,
+// up to the config store). Armed with bb_div > 0, taskControl calls blackboxLog after the motors and every bb_div-th
+// run becomes a frame: time, gyroData, rcCommand, axisPID, EstAlt, vario, flags, motor[0 .. NumberOfMotors - 1].
+// Frames are 'I' (the values) or 'P' (the difference to a per field prediction), every value a zig-zag varint, so the
+// typical P frame is a byte per field. Predictions: previous frame, or straight line through the last two for time and
+// gyro, from the frames that went out: a dropped frame costs no I frame. Every BB_IFRAME_EVERY frames comes an I frame.
+// Arming writes an 'H' frame: "BBX1", frame period us, field count, then per field the prediction and the name (zero
+// ended), so the decoder (tools/bbdecode.c) needs no table. Disarming writes 'E' and zeros up to the next word.
+// The frames go through a RAM ring of a flash page, TASK_BLACKBOX programs BB_STEP_WORDS words per run. A full ring
+// drops the frame, a full flash ends the log. Erasing is never done armed (ca. 20ms stall per page): "bb erase" / MSP
+// and flash that doesn't start with a log (old firmware left there) are erased page by page while disarmed.
+// Flights are appended until the flash is full. Download with cli "bb dump" (hex) or MSP_BLACKBOX (binary).
+//
+// Stream: with st_div > 0 the same kind of frames go out on uart1 live, every st_div-th control loop, armed or not,
+// with the field groups of st_fields. Framing: '$' 'S' length, frame, CRC-8 (DVB-S2) over length and frame. An 'H'
+// frame every second lets a receiver join at any time, frames wait until it fits. A frame only goes out when the TX ring
+// has room for it and ST_RESERVE bytes for MSP / MAVLink, else it's dropped, so the loop never waits for the uart.
+// Receiver: tools/bbdecode -s /dev/ttyUSB0 (or host:port for SITL) writes CSV as it comes.
+
+#define BB_RING_SIZE    FLASH_PAGE_SIZE                                     // Power of 2
+#define BB_STEP_WORDS   8                                                   // Per TASK_BLACKBOX run, a word takes ca. 50-100us on the F103
+#define BB_IFRAME_EVERY 32
+#define BB_FIELDS       (14 + MAX_MOTORS)
+#define BB_FRAME_MAX    (1 + BB_FIELDS * 5)                                 // Tag and a 5 byte varint per field
+#define BB_ERASED       0xFFFFFFFF
+#define BB_HEADER_MAX   (16 + BB_FIELDS * 9)                                // Names up to 7 characters
+#define ST_RESERVE      160                                                 // TX ring bytes the stream leaves to the rest, a MSP_BLACKBOX reply fits
+#define ST_HEADER_US    1000000
+
+#define FLASH_WORD(a)   (*(const uint32_t *)(a))
+
+enum
+{
+    BB_PRED_NONE = 0,
+    BB_PRED_PREV,                                                           // Previous frame
+    BB_PRED_STRAIGHT                                                        // 2 * previous - the one before
+};
+
+enum
+{
+    BB_ALWAYS = 0,
+    BB_GYRO   = 1 << 0,                                                     // st_fields bits
+    BB_RC     = 1 << 1,
+    BB_PID    = 1 << 2,
+    BB_ALT    = 1 << 3,
+    BB_FLAGS  = 1 << 4,
+    BB_MOTOR  = 1 << 5
+};
+
+typedef struct
+{
+    const char *name;
+    uint8_t    pred;
+    uint8_t    group;
+} bbField_t;
+
+typedef struct                                                              // One frame stream: blackbox or uart
+{
+    uint8_t field[BB_FIELDS];                                               // Into bbFields, in frame order
+    uint8_t count;
+    uint8_t div;
+    uint8_t loops;                                                          // Control loops since the last frame
+    uint8_t groups;                                                         // st_fields it was made for
+    uint8_t sinceI;                                                         // Frames since the last I frame, BB_IFRAME_EVERY = next is one
+    int32_t prev[2][BB_FIELDS];                                             // Values of the last two frames
+} bbEncoder_t;
+
+static const bbField_t bbFields[BB_FIELDS] =                                // Motors last, only NumberOfMotors of them are logged
+{
+    { "time",    BB_PRED_STRAIGHT, BB_ALWAYS },
+    { "gyro0",   BB_PRED_STRAIGHT, BB_GYRO },  { "gyro1",   BB_PRED_STRAIGHT, BB_GYRO },  { "gyro2",   BB_PRED_STRAIGHT, BB_GYRO },
+    { "rc0",     BB_PRED_PREV,     BB_RC },    { "rc1",     BB_PRED_PREV,     BB_RC },    { "rc2",     BB_PRED_PREV,     BB_RC },
+    { "rc3",     BB_PRED_PREV,     BB_RC },
+    { "pid0",    BB_PRED_PREV,     BB_PID },   { "pid1",    BB_PRED_PREV,     BB_PID },   { "pid2",    BB_PRED_PREV,     BB_PID },
+    { "alt",     BB_PRED_PREV,     BB_ALT },   { "vario",   BB_PRED_PREV,     BB_ALT },   { "flags",   BB_PRED_PREV,     BB_FLAGS },
+    { "motor0",  BB_PRED_PREV,     BB_MOTOR }, { "motor1",  BB_PRED_PREV,     BB_MOTOR }, { "motor2",  BB_PRED_PREV,     BB_MOTOR },
+    { "motor3",  BB_PRED_PREV,     BB_MOTOR }, { "motor4",  BB_PRED_PREV,     BB_MOTOR }, { "motor5",  BB_PRED_PREV,     BB_MOTOR },
+    { "motor6",  BB_PRED_PREV,     BB_MOTOR }, { "motor7",  BB_PRED_PREV,     BB_MOTOR }, { "motor8",  BB_PRED_PREV,     BB_MOTOR },
+    { "motor9",  BB_PRED_PREV,     BB_MOTOR }, { "motor10", BB_PRED_PREV,     BB_MOTOR }, { "motor11", BB_PRED_PREV,     BB_MOTOR },
+};
+
+extern uint8_t cliMode;
+
+blackboxStats_t blackboxStats;
+
+static uintptr_t bbStart, bbEnd;                                            // Flash of the blackbox, whole pages
+static uintptr_t bbPos;                                                     // Next word to program
+static union                                                                // loop() and pass() exclude each other from the boot on,
+{                                                                           // the vibration results of pass() live here (vibInit)
+    uint8_t   ring[BB_RING_SIZE];
+    vibSlot_t vib[VIB_SLOTS];
+} bbRam;
+vibSlot_t * const vibSlots = bbRam.vib;                                     // See fft.c
+static uint16_t  bbHead, bbTail;                                            // Next to encode, next to program
+static uint16_t  bbErasePage;                                               // Next page to erase, all pages = none
+static bbEncoder_t bbLog, stEnc;
+static bool      bbLogging;
+static bool      bbArmed;
+static bool      stRunning;
+static uint32_t  stHeaderTime;                                              // Next 'H' frame of the stream
+
+static uint16_t bbRingUsed(void)
+{
+    return (bbHead - bbTail) & (BB_RING_SIZE - 1);
+}
+
+static void bbQueue(const uint8_t *buf, uint8_t len)                        // Into the ring for TASK_BLACKBOX
+{
+    while (len--)
+    {
+        bbRam.ring[bbHead] = *buf++;
+        bbHead = (bbHead + 1) & (BB_RING_SIZE - 1);
+    }
+}
+
+static uint8_t *bbPutVar(uint8_t *p, uint32_t v)                            // Unsigned varint, 7 bit per byte, low first
+{
+    while (v >= 0x80)
+    {
+        *p++ = v | 0x80;
+        v >>= 7;
+    }
+    *p++ = v;
+    return p;
+}
+
+static uint8_t *bbPutSigned(uint8_t *p, uint32_t v)                         // Zig-zag of v as int32_t, small negative numbers stay short
+{
+    return bbPutVar(p, v << 1 ^ (0 - (v >> 31)));
+}
+
+static uint8_t crc8Dvb(uint8_t crc, uint8_t c)                              // CRC-8 DVB-S2, poly 0xD5
+{
+    uint8_t i;
+
+    crc ^= c;
+    for (i = 0; i < 8; i++) crc = crc & 0x80 ? (crc << 1) ^ 0xD5 : crc << 1;
+    return crc;
+}
+
+static void bbEncoderInit(bbEncoder_t *e, uint8_t div, uint8_t groups)      // groups: BB_GYRO | ..., time is always in
+{
+    uint8_t i;
+
+    e->count = 0;
+    for (i = 0; i < 14 + min(NumberOfMotors, MAX_MOTORS); i++)
+    {
+        if (bbFields[i].group == BB_ALWAYS || (bbFields[i].group & groups)) e->field[e->count++] = i;
+    }
+    e->div    = div;
+    e->groups = groups;
+    e->loops  = 0;
+    e->sinceI = BB_IFRAME_EVERY;
+}
+
+static uint8_t bbHeader(bbEncoder_t *e, uint8_t *buf)                       // 'H' frame into buf (BB_HEADER_MAX), returns the length
+{
+    const char *name;
+    uint8_t    *p = buf, i;
+
+    for (name = "HBBX1"; *name; name++) *p++ = *name;
+    p = bbPutVar(p, tasks[TASK_CONTROL].period * e->div);
+    p = bbPutVar(p, e->count);
+    for (i = 0; i < e->count; i++)
+    {
+        *p++ = bbFields[e->field[i]].pred;
+        for (name = bbFields[e->field[i]].name; *name; name++) *p++ = *name;
+        *p++ = 0;
+    }
+    e->sinceI = BB_IFRAME_EVERY;                                            // A decoder that joins here needs an I frame
+    return p - buf;
+}
+
+// The prediction and the difference are modulo 2^32 (uint32_t): no signed overflow near the int32_t limits, e.g. the
+// time when micros() wraps, the decoder adds it back the same way.
+static uint8_t bbFrame(const bbEncoder_t *e, const int32_t *v, uint8_t *buf) // 'I' or 'P' frame of v[BB_FIELDS] into buf (BB_FRAME_MAX)
+{
+    uint32_t pred;
+    uint8_t  *p = buf, i, iframe = e->sinceI >= BB_IFRAME_EVERY;
+
+    *p++ = iframe ? 'I' : 'P';
+    for (i = 0; i < e->count; i++)
+    {
+        if (iframe) pred = 0;
+        else if (bbFields[e->field[i]].pred == BB_PRED_STRAIGHT) pred = 2 * (uint32_t)e->prev[0][i] - (uint32_t)e->prev[1][i];
+        else pred = e->prev[0][i];
+        p = bbPutSigned(p, (uint32_t)v[e->field[i]] - pred);
+    }
+    return p - buf;
+}
+
+static void bbCommit(bbEncoder_t *e, const int32_t *v)                      // The frame of bbFrame went out, it's the prediction now
+{
+    uint8_t i, iframe = e->sinceI >= BB_IFRAME_EVERY;
+
+    for (i = 0; i < e->count; i++)
+    {
+        e->prev[1][i] = iframe ? v[e->field[i]] : e->prev[0][i];            // After an I frame straight = previous
+        e->prev[0][i] = v[e->field[i]];
+    }
+    e->sinceI = iframe ? 1 : e->sinceI + 1;
+}
+
+static bool bbErasing(void)
+{
+    return bbErasePage < (bbEnd - bbStart) / FLASH_PAGE_SIZE;
+}
+
+static bool bbPageErased(uintptr_t page)
+{
+    uint16_t i;
+    for (i = 0; i < FLASH_PAGE_SIZE; i += 4)
+    {
+        if (FLASH_WORD(page + i) != BB_ERASED) return false;
+    }
+    return true;
+}
+
+static void bbStats(void)
+{
+    blackboxStats.size    = bbEnd - bbStart;
+    blackboxStats.used    = bbPos - bbStart;
+    blackboxStats.queued  = bbRingUsed();
+    blackboxStats.erasing = bbErasing();
+    blackboxStats.logging = bbLogging;
+}
+
+void blackboxInit(void)                                                     // Finds the end of the log
+{
+    bbStart = FLASH_BASE + ((FLASH_IMAGE_END - FLASH_BASE + FLASH_PAGE_SIZE - 1) & ~(uintptr_t)(FLASH_PAGE_SIZE - 1));
+    bbEnd   = max(bbStart, FLASH_WRITE_ADDR);
+    for (bbPos = bbEnd; bbPos > bbStart && FLASH_WORD(bbPos - 4) == BB_ERASED; bbPos -= 4);
+    bbErasePage = (bbEnd - bbStart) / FLASH_PAGE_SIZE;
+    if (bbPos > bbStart && (FLASH_WORD(bbStart) & 0xFFFFFF) != ('H' | 'B' << 8 | 'B' << 16)) blackboxErase(); // Not a log
+    bbStats();
+}
+
+void blackboxErase(void)                                                    // In the background while disarmed
+{
+    bbLogging   = false;
+    bbHead      = bbTail = 0;
+    bbPos       = bbStart;
+    bbErasePage = 0;
+    bbStats();
+}
+
+static void bbStartLog(void)
+{
+    uint8_t buf[BB_HEADER_MAX], len;
+
+    if (bbErasing() || bbEnd - bbPos < BB_RING_SIZE) return;                // Not ready or no room for a useful log
+    bbEncoderInit(&bbLog, cfg.bb_div, 0xFF);
+    len = bbHeader(&bbLog, buf);
+    if (BB_RING_SIZE - 1 - bbRingUsed() < len + 4) return;                  // Last log not out yet
+    bbQueue(buf, len);
+    bbLogging = true;
+    blackboxStats.frames  = 0;
+    blackboxStats.dropped = 0;
+}
+
+static void bbStopLog(void)
+{
+    static const uint8_t end[4] = { 'E' };
+
+    bbLogging = false;
+    bbQueue(end, 4 - (bbHead & 3));                                         // blackboxLog left room. Whole words, the next log starts on its own
+}
+
+static uint16_t bbFlags(void)
+{
+    return f.ARMED | f.ANGLE_MODE << 1 | f.HORIZON_MODE << 2 | f.MAG_MODE << 3 | f.BARO_MODE << 4 | f.GPS_HOME_MODE << 5 |
+           f.GPS_HOLD_MODE << 6 | f.HEADFREE_MODE << 7 | f.PASSTHRU_MODE << 8 | f.GPS_FIX << 9 | f.FAILSAFE << 10;
+}
+
+static void bbCollect(int32_t *v)                                           // All BB_FIELDS, in bbFields order
+{
+    uint8_t i;
+
+    v[0] = currentTime;
+    for (i = 0; i < 3; i++)
+    {
+        v[1 + i] = lrintf(gyroData[i]);
+        v[8 + i] = axisPID[i];
+    }
+    for (i = 0; i < 4; i++) v[4 + i] = rcCommand[i];
+    v[11] = lrintf(EstAlt);
+    v[12] = lrintf(vario);
+    v[13] = bbFlags();
+    for (i = 0; i < MAX_MOTORS; i++) v[14 + i] = motor[i];
+}
+
+static void bbLogFrame(const int32_t *v)
+{
+    uint8_t buf[BB_FRAME_MAX];
+
+    if (BB_RING_SIZE - 1 - bbRingUsed() < BB_FRAME_MAX + 4)                 // TASK_BLACKBOX can't keep up. Keeps room for the end
+    {
+        blackboxStats.dropped++;                                            // Next frame predicts from the last one in the ring
+        return;
+    }
+    bbQueue(buf, bbFrame(&bbLog, v, buf));
+    bbCommit(&bbLog, v);
+    blackboxStats.frames++;
+}
+
+static bool stSend(const uint8_t *buf, uint8_t len, uint8_t reserve)        // '$' 'S' len buf crc8, all or nothing
+{
+    uint8_t out[BB_HEADER_MAX + 4], crc, i;
+
+    if (uartTxFree() < len + 4 + reserve) return false;
+    out[0] = '$';
+    out[1] = 'S';
+    out[2] = len;
+    crc    = crc8Dvb(0, len);
+    for (i = 0; i < len; i++)
+    {
+        crc        = crc8Dvb(crc, buf[i]);
+        out[3 + i] = buf[i];
+    }
+    out[3 + len] = crc;
+    return uartWriteBlock(out, len + 4);
+}
+
+static bool stDue(void)                                                     // Starts / stops the stream, true when a frame is due
+{
+    if (!cfg.st_div || cliMode)
+    {
+        stRunning = false;
+        return false;
+    }
+    if (!stRunning || stEnc.div != cfg.st_div || stEnc.groups != cfg.st_fields)
+    {
+        bbEncoderInit(&stEnc, cfg.st_div, cfg.st_fields);
+        stRunning    = true;
+        stHeaderTime = currentTime;
+    }
+    return ++stEnc.loops >= stEnc.div;
+}
+
+static void stFrame(const int32_t *v)
+{
+    uint8_t buf[BB_HEADER_MAX], len;
+
+    stEnc.loops = 0;
+    if ((int32_t)(currentTime - stHeaderTime) >= 0)                         // Header first, frames wait for it. It doesn't need the reserve
+    {
+        len = bbHeader(&stEnc, buf);
+        if (!stSend(buf, len, 0))
+        {
+            blackboxStats.stDropped++;
+            return;
+        }
+        stHeaderTime = currentTime + ST_HEADER_US;
+    }
+    len = bbFrame(&stEnc, v, buf);
+    if (!stSend(buf, len, ST_RESERVE))
+    {
+        blackboxStats.stDropped++;                                          // Next frame predicts from the last one sent
+        return;
+    }
+    bbCommit(&stEnc, v);
+    blackboxStats.stFrames++;
+}
+
+void blackboxLog(void)                                                      // From taskControl after the motors
+{
+    int32_t v[BB_FIELDS];
+    bool    logNow, streamNow;
+
+    if (f.ARMED != bbArmed)
+    {
+        bbArmed = f.ARMED;
+        if (bbArmed && cfg.bb_div) bbStartLog();
+        else if (bbLogging) bbStopLog();
+    }
+    logNow    = bbLogging && ++bbLog.loops >= bbLog.div;
+    streamNow = stDue();
+    if (!logNow && !streamNow) return;
+    bbCollect(v);
+    if (logNow)
+    {
+        bbLog.loops = 0;
+        bbLogFrame(v);
+    }
+    if (streamNow) stFrame(v);
+}
+
+void blackboxUpdate(bool disarmed)                                          // TASK_BLACKBOX, one step
+{
+    uint32_t w;
+    uint8_t  i, k;
+
+    if (bbErasing())
+    {
+        if (!disarmed) return;                                              // No 20ms stalls in flight
+        if (bbPageErased(bbStart + bbErasePage * FLASH_PAGE_SIZE)) bbErasePage++;
+        else
+        {
+            FLASH_Unlock();
+            FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);
+            if (FLASH_ErasePage(bbStart + bbErasePage * FLASH_PAGE_SIZE) == FLASH_COMPLETE) bbErasePage++; // Else again
+            FLASH_Lock();
+        }
+        bbStats();
+        return;
+    }
+    if (bbRingUsed() < 4) return;
+    FLASH_Unlock();
+    for (i = 0; i < BB_STEP_WORDS && bbRingUsed() >= 4; i++)
+    {
+        for (w = 0, k = 0; k < 4; k++) w |= (uint32_t)bbRam.ring[(bbTail + k) & (BB_RING_SIZE - 1)] << (k * 8);
+        if (bbPos >= bbEnd || FLASH_ProgramWord(bbPos, w) != FLASH_COMPLETE)
+        {
+            bbLogging = false;                                              // Full or broken, the log ends here
+            bbHead    = bbTail;
+            bbPos     = bbEnd;
+            break;
+        }
+        bbPos += 4;
+        bbTail = (bbTail + 4) & (BB_RING_SIZE - 1);
+    }
+    FLASH_Lock();
+    bbStats();
+}
+
+uint16_t blackboxRead(uint32_t offset, uint8_t *buf, uint16_t len)          // Programmed bytes from offset, returns how many
+{
+    len = min(len, bbPos - bbStart > offset ? bbPos - bbStart - offset : 0);
+    memcpy(buf, (const uint8_t *)(bbStart + offset), len);
+    return len;
+}
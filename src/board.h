@@ -10,8 +10,12 @@
 #include <ctype.h>
 #include <string.h>
 #include <stdio.h>
+#ifdef SITL
+#include "sitl_board.h"         // host stand-ins for the stm32 bits, see src/sitl
+#else
 #include "stm32f10x_conf.h"
 #include "core_cm3.h"
+#endif
 #include "printf.h"
 #include "drv_system.h"         // timers, delays, etc
 #include "drv_gpio.h"
@@ -51,9 +55,13 @@
 #define FLASH_PAGE_COUNT    128
 #endif
 #define FLASH_PAGE_SIZE     ((uint16_t)0x400) // 1KB
-#define FLASH_PAGES_FORCONFIG 3               // 3KB was 1Page/KB before
-#define FLASH_WRITE_ADDR    (0x08000000 + (uint32_t)FLASH_PAGE_SIZE * (FLASH_PAGE_COUNT - FLASH_PAGES_FORCONFIG)) //#define FLASH_WRITE_ADDR (0x08000000 + (uint32_t)FLASH_PAGE_SIZE * (FLASH_PAGE_COUNT - 1))
-#define FDByteSize 2340                       // Defines the Bytesize of the Floppydisk
+#define FLASH_PAGES_FORCONFIG 6               // 2 banks of 2KB for the journaled config store (cfgstore.c) + 2 pages schema, was 3 pages
+#define FLASH_WRITE_ADDR    (FLASH_BASE + (uint32_t)FLASH_PAGE_SIZE * (FLASH_PAGE_COUNT - FLASH_PAGES_FORCONFIG)) //#define FLASH_WRITE_ADDR (0x08000000 + (uint32_t)FLASH_PAGE_SIZE * (FLASH_PAGE_COUNT - 1))
+#define FDByteSize 640                        // Defines the Bytesize of the Floppydisk, config_t has to fit a 2KB bank (cfgstore.c). Was 2300, the blackbox logs more
+#ifndef FLASH_IMAGE_END
+extern uint32_t _sidata, _sdata, _edata;      // stm32_flash.ld
+#define FLASH_IMAGE_END     ((uintptr_t)&_sidata + ((uintptr_t)&_edata - (uintptr_t)&_sdata)) // Code + .data init values, the blackbox (blackbox.c) starts on the next page
+#endif
 
 typedef enum
 {
@@ -118,6 +126,34 @@ typedef struct baro_t
     baroCalculateFuncPtr calculate;
 } baro_t;
 
+typedef enum
+{
+    I2C_JOB_IDLE = 0,                                       // Never submitted, or collected by the owner
+    I2C_JOB_QUEUED,
+    I2C_JOB_BUSY,                                           // On the bus
+    I2C_JOB_DONE,
+    I2C_JOB_ERROR                                           // NACK, bus error or flushed after a timeout
+} i2cJobState_e;
+
+typedef struct i2cJob_t                                     // One queued i2c transaction, see drv_i2c.c
+{
+    uint8_t  addr;                                          // 7 bit device address
+    uint8_t  reg;                                           // Subaddress, 0xFF = none
+    uint8_t  len;
+    bool     read;
+    uint8_t  *buf;                                          // Must stay valid until the job is done
+    void     (* done)(struct i2cJob_t *job);                // Called from the i2c interrupt when the job ends, may be NULL
+    volatile uint8_t state;                                 // i2cJobState_e
+} i2cJob_t;
+
+typedef struct uartTxStats_t                                // USART1 transmit ring, see drv_uart.c
+{
+    uint16_t size;                                          // Usable bytes
+    uint16_t highWater;                                     // Most bytes ever waiting
+    uint32_t overflows;                                     // Bytes uartWrite lost to a full ring
+    uint32_t dropped;                                       // Frames uartWriteBlock had no room for
+} uartTxStats_t;
+
 #define digitalHi(p, i)     { p->BSRR = i; }
 #define digitalLo(p, i)     { p->BRR = i; }
 #define digitalToggle(p, i) { p->ODR ^= i; }
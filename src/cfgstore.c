@@ -0,0 +1,797 @@
+#include "board.h"
+#include "mw.h"
+
+// Journaled config store. The FLASH_PAGES_FORCONFIG pages are two banks that take turns plus the schema, a bank is
+// [seq] [CFG_MAGIC | size] [layout] [snapshot of config_t] [records ...]
+// writeParams doesn't touch the flash: cfgStoreSave compares cfg with the stored image and queues the changed words
+// as records, TASK_CONFIG programs them CFG_STEP_WORDS per run. A record is [first word | CFG_REC_LAST, words] [data]
+// [crc16 | ~crc16 << 16], the records of one save are a group and the last one is flagged.
+// Loading replays the snapshot and every complete group. A torn record or an unfinished group ends the replay and the
+// space behind it is never used again. A full log is compacted: the other bank is erased a page per run (disarmed
+// only, the F103 stalls ca. 20ms per page erase), gets the stored image copied and then its header, the header is
+// the commit. Until then the old bank stays as it is, so a power loss at any point loads either the old or the new config.
+// A save that doesn't fit the queue (defaults, the floppy logger) or has no current bank to compare with becomes a full
+// rewrite: the queue is dropped and TASK_CONFIG writes cfg as a new bank, the same steps as a compaction with cfg as
+// the source, erasing only while disarmed. cfg changed while it was copied (a save or cli set): the copy starts over.
+// A compaction or rewrite that fails CFG_TRIES times is parked: the save stays pending, cli status shows it, and the
+// next save tries again. Nothing here waits for the flash without a bound.
+// SITL: the flash emulation checks the NOR rules and "-f n" cuts the power in the n-th flash operation.
+//
+// Migration: the schema pages describe the layout of config_t field by field, [CFG_SCHEMA_MAGIC | fields] [layout]
+// [tag, offset | type << 16 | count << 20] ... The fields are valueTable of cli.c plus schemaExtra for what cli
+// can't set, tag is the FNV-1a hash of the name and layout the hash over all of it. Every bank has the layout it was
+// written with. A bank in another layout, or with another EEPROM_CONF_VERSION, is not thrown away: checkFirstTime sets
+// the defaults and cfgStoreMigrate takes every field over that the stored schema has under the same name, converted
+// when the type changed and constrained to the cli limits. New fields keep the default, removed ones are gone.
+// The schema pages are rewritten after the first bank in a new layout is committed, until then they describe the old one.
+// No bank at all but a config_t of v34 - v39 the way the firmware before the store wrote it: migrated the same way,
+// from the frozen layouts of legacyLayouts.
+// The banks were 4 pages while FloppyDisk had 2300 bytes. Such a bank doesn't fit a 2 page bank and isn't loaded,
+// checkFirstTime sets the defaults. The 4 pages in front of the store are the blackbox now, it erases them.
+
+#define CFG_BANK_PAGES  2
+#define CFG_BANK_SIZE   ((uint32_t)CFG_BANK_PAGES * FLASH_PAGE_SIZE)
+#define CFG_SCHEMA_ADDR (FLASH_WRITE_ADDR + 2 * CFG_BANK_SIZE)
+#define CFG_SCHEMA_SIZE ((uint32_t)(FLASH_PAGES_FORCONFIG - 2 * CFG_BANK_PAGES) * FLASH_PAGE_SIZE)
+#define CFG_SCHEMA_MAX  ((CFG_SCHEMA_SIZE - 8) / 8)
+#define CFG_SCHEMA_MAGIC 0x5C4E0000
+#define CFG_WORDS       ((sizeof(config_t) + 3) / 4)
+#define CFG_SNAPSHOT    12                                                  // Bank offset of the snapshot
+#define CFG_LOG_START   (CFG_SNAPSHOT + CFG_WORDS * 4)                      // Bank offset of the first record
+#define CFG_MAGIC       0xC5F60000
+#define CFG_REC_LAST    0x8000                                              // Last record of a group
+#define CFG_ERASED      0xFFFFFFFF
+#define CFG_QUEUE_WORDS 128                                                 // Saves of up to ca. 480 bytes go the background way
+#define CFG_STEP_WORDS  4                                                   // Per TASK_CONFIG run, a word takes ca. 50-100us on the F103
+#define CFG_CHUNK_WORDS 32                                                  // Compare cfg with the stored image in pieces of that
+#define CFG_TRIES       3                                                   // Flash errors in a row before a compaction / rewrite is parked
+
+#define FLASH_WORD(a)   (*(const uint32_t *)(a))
+
+typedef char configFitsTheBank[CFG_LOG_START + CFG_QUEUE_WORDS * 4 <= CFG_BANK_SIZE ? 1 : -1]; // Snapshot plus the records of a queued save
+
+enum
+{
+    STORE_IDLE = 0,
+    STORE_APPEND,
+    STORE_ERASE,
+    STORE_COPY,
+    STORE_COMMIT
+};
+
+typedef struct
+{
+    const char *name;
+    uint8_t    type;                                                        // vartype_e
+    void       *ptr;
+    uint16_t   count;
+} schemaField_t;
+
+static const schemaField_t schemaExtra[] =                                  // config_t fields without a cli variable
+{
+    { "mixerConfiguration",  VAR_UINT8,  &cfg.mixerConfiguration,  1 },
+    { "enabledFeatures",     VAR_UINT32, &cfg.enabledFeatures,     1 },
+    { "dynThrPID",           VAR_UINT8,  &cfg.dynThrPID,           1 },
+    { "accZero",             VAR_FLOAT,  &cfg.accZero,             3 },
+    { "sens_1G",             VAR_FLOAT,  &cfg.sens_1G,             1 },
+    { "magZero",             VAR_FLOAT,  &cfg.magZero,             3 },
+    { "magSoft",             VAR_FLOAT,  &cfg.magSoft,             9 },
+    { "accstddev",           VAR_FLOAT,  &cfg.accstddev,           3 },
+    { "mag_calibrated",      VAR_UINT8,  &cfg.mag_calibrated,      1 },
+    { "mag_motorcompusable", VAR_UINT8,  &cfg.mag_motorcompusable, 1 },
+    { "activate",            VAR_UINT32, &cfg.activate,            CHECKBOXITEMS },
+    { "rcmap",               VAR_UINT8,  &cfg.rcmap,               MAX_RC_CHANNELS },
+    { "servotrim",           VAR_INT16,  &cfg.servotrim,           8 },
+    { "servoreverse",        VAR_INT8,   &cfg.servoreverse,        8 },
+    { "customMixer",         VAR_FLOAT,  &cfg.customMixer,         MAX_MOTORS * 4 },
+    { "GPS_MaxDistToHome",   VAR_UINT16, &cfg.GPS_MaxDistToHome,   1 },
+    { "MAXGPSspeed",         VAR_UINT16, &cfg.MAXGPSspeed,         1 },
+    { "MaxAltMeter",         VAR_INT16,  &cfg.MaxAltMeter,         1 },
+    { "MinAltMeter",         VAR_INT16,  &cfg.MinAltMeter,         1 },
+    { "WP_BASE",             VAR_UINT32, &cfg.WP_BASE,             2 },
+    { "WP_BASE_HIGHT",       VAR_INT16,  &cfg.WP_BASE_HIGHT,       1 },
+    { "FDUsedDatasets",      VAR_UINT16, &cfg.FDUsedDatasets,      1 },
+    { "FloppyDisk",          VAR_INT8,   &cfg.FloppyDisk,          FDByteSize },
+};
+
+static const uint8_t schemaTypeSize[] = { 1, 1, 2, 2, 4, 4 };               // By vartype_e
+
+// Before the store, config_t went as it is to the last 3 pages (CFG_LEGACY_ADDR): version, size, magic_be ... magic_ef,
+// chk. Those layouts are frozen here as a chain: v34 as the baseline valueTable and schemaExtra had it, every later
+// layout as the one before with the fields from some offset on moved, plus the fields it brought. The v39 builds before
+// the store are told apart by their size. Fields that went into padding (mag_aux, gy_drdy, gy_tcomp) are in the layout
+// of that size, the builds before them left a 0 there. The 3 pages are the end of bank 1 and the schema, the rewrite
+// after a migration goes to bank 0 and the old copy is only erased once that is committed.
+
+#define CFG_LEGACY_ADDR (FLASH_BASE + (uint32_t)FLASH_PAGE_SIZE * (FLASH_PAGE_COUNT - 3))
+#define CFG_LEGACY_SIZE (3 * FLASH_PAGE_SIZE)
+#define LEGACY(name, type, offset, count) { name, (offset) | (uint32_t)(type) << 16 | (uint32_t)(count) << 20 }
+
+typedef struct
+{
+    const char *name;
+    uint32_t   field;                                                       // offset | type << 16 | count << 20
+} legacyField_t;
+
+typedef struct
+{
+    uint8_t  version;
+    uint16_t size;
+    uint8_t  added;                                                         // legacyAdded[0 .. added - 1] are in it
+    uint16_t shift[3][2];                                                   // Fields of the layout before from offset [0] on are [1] bytes further, 0xFFFF ends
+} legacyLayout_t;
+
+static const legacyField_t legacyV34[] =
+{
+    LEGACY("rc_db", VAR_UINT8, 231, 1),                  LEGACY("rc_dbyw", VAR_UINT8, 232, 1),                LEGACY("rc_dbah", VAR_UINT8, 233, 1),
+    LEGACY("rc_dbgps", VAR_UINT8, 234, 1),               LEGACY("devorssi", VAR_UINT8, 238, 1),               LEGACY("rssicut", VAR_UINT8, 239, 1),
+    LEGACY("rc_mid", VAR_UINT16, 242, 1),                LEGACY("rc_auxch", VAR_UINT8, 230, 1),               LEGACY("rc_rate", VAR_UINT8, 49, 1),
+    LEGACY("rc_expo", VAR_UINT8, 50, 1),                 LEGACY("thr_mid", VAR_UINT8, 51, 1),                 LEGACY("thr_expo", VAR_UINT8, 52, 1),
+    LEGACY("roll_pitch_rate", VAR_UINT8, 53, 1),         LEGACY("yawrate", VAR_UINT8, 54, 1),                 LEGACY("esc_min", VAR_UINT16, 260, 1),
+    LEGACY("esc_max", VAR_UINT16, 262, 1),               LEGACY("esc_nfly", VAR_UINT16, 266, 1),              LEGACY("esc_moff", VAR_UINT16, 264, 1),
+    LEGACY("esc_pwm", VAR_UINT16, 268, 1),               LEGACY("srv_pwm", VAR_UINT16, 270, 1),               LEGACY("pass_mot", VAR_UINT8, 272, 1),
+    LEGACY("rc_min", VAR_UINT16, 244, 1),                LEGACY("rc_max", VAR_UINT16, 246, 1),                LEGACY("rc_rllrm", VAR_UINT8, 248, 1),
+    LEGACY("rc_killt", VAR_UINT16, 250, 1),              LEGACY("fs_delay", VAR_UINT8, 252, 1),               LEGACY("fs_ofdel", VAR_UINT8, 253, 1),
+    LEGACY("fs_rcthr", VAR_UINT16, 254, 1),              LEGACY("fs_ddplt", VAR_UINT8, 256, 1),               LEGACY("fs_jstph", VAR_UINT8, 257, 1),
+    LEGACY("fs_nosnr", VAR_UINT8, 258, 1),               LEGACY("serial_baudrate", VAR_UINT32, 400, 1),       LEGACY("tele_prot", VAR_UINT8, 404, 1),
+    LEGACY("spektrum_hires", VAR_UINT8, 240, 1),         LEGACY("vbatscale", VAR_UINT8, 208, 1),              LEGACY("vbatmaxcellvoltage", VAR_UINT8, 209, 1),
+    LEGACY("vbatmincellvoltage", VAR_UINT8, 210, 1),     LEGACY("power_adc_channel", VAR_UINT8, 211, 1),      LEGACY("tri_ydir", VAR_INT8, 298, 1),
+    LEGACY("tri_ymid", VAR_UINT16, 300, 1),              LEGACY("tri_ymin", VAR_UINT16, 302, 1),              LEGACY("tri_ymax", VAR_UINT16, 304, 1),
+    LEGACY("tri_ydel", VAR_UINT16, 236, 1),              LEGACY("wing_left_min", VAR_UINT16, 306, 1),         LEGACY("wing_left_mid", VAR_UINT16, 308, 1),
+    LEGACY("wing_left_max", VAR_UINT16, 310, 1),         LEGACY("wing_right_min", VAR_UINT16, 312, 1),        LEGACY("wing_right_mid", VAR_UINT16, 314, 1),
+    LEGACY("wing_right_max", VAR_UINT16, 316, 1),        LEGACY("pitch_direction_l", VAR_INT8, 318, 1),       LEGACY("pitch_direction_r", VAR_INT8, 319, 1),
+    LEGACY("roll_direction_l", VAR_INT8, 320, 1),        LEGACY("roll_direction_r", VAR_INT8, 321, 1),        LEGACY("gbl_flg", VAR_UINT8, 324, 1),
+    LEGACY("gbl_pgn", VAR_INT8, 322, 1),                 LEGACY("gbl_rgn", VAR_INT8, 323, 1),                 LEGACY("gbl_pmn", VAR_UINT16, 326, 1),
+    LEGACY("gbl_pmx", VAR_UINT16, 328, 1),               LEGACY("gbl_pmd", VAR_UINT16, 330, 1),               LEGACY("gbl_rmn", VAR_UINT16, 332, 1),
+    LEGACY("gbl_rmx", VAR_UINT16, 334, 1),               LEGACY("gbl_rmd", VAR_UINT16, 336, 1),               LEGACY("al_barolr", VAR_UINT8, 338, 1),
+    LEGACY("al_snrlr", VAR_UINT8, 339, 1),               LEGACY("al_debounce", VAR_UINT8, 340, 1),            LEGACY("al_tobaro", VAR_UINT16, 342, 1),
+    LEGACY("al_tosnr", VAR_UINT16, 344, 1),              LEGACY("as_lnchr", VAR_UINT8, 346, 1),               LEGACY("as_clmbr", VAR_UINT8, 347, 1),
+    LEGACY("as_trgt", VAR_UINT8, 348, 1),                LEGACY("as_stdev", VAR_UINT8, 349, 1),               LEGACY("align_gyro_x", VAR_INT8, 106, 1),
+    LEGACY("align_gyro_y", VAR_INT8, 107, 1),            LEGACY("align_gyro_z", VAR_INT8, 108, 1),            LEGACY("align_acc_x", VAR_INT8, 109, 1),
+    LEGACY("align_acc_y", VAR_INT8, 110, 1),             LEGACY("align_acc_z", VAR_INT8, 111, 1),             LEGACY("align_mag_x", VAR_INT8, 112, 1),
+    LEGACY("align_mag_y", VAR_INT8, 113, 1),             LEGACY("align_mag_z", VAR_INT8, 114, 1),             LEGACY("acc_hdw", VAR_UINT8, 115, 1),
+    LEGACY("acc_lpf", VAR_UINT8, 116, 1),                LEGACY("acc_ilpf", VAR_UINT8, 361, 1),               LEGACY("acc_trim_pitch", VAR_INT16, 104, 1),
+    LEGACY("acc_trim_roll", VAR_INT16, 102, 1),          LEGACY("gy_lpf", VAR_UINT16, 118, 1),                LEGACY("gy_cmpf", VAR_UINT16, 120, 1),
+    LEGACY("gy_cmpfm", VAR_UINT16, 122, 1),              LEGACY("gy_smrll", VAR_UINT8, 124, 1),               LEGACY("gy_smptc", VAR_UINT8, 125, 1),
+    LEGACY("gy_smyw", VAR_UINT8, 126, 1),                LEGACY("gy_stdev", VAR_UINT8, 145, 1),               LEGACY("accz_vcf", VAR_FLOAT, 128, 1),
+    LEGACY("accz_acf", VAR_FLOAT, 132, 1),               LEGACY("bar_lag", VAR_FLOAT, 136, 1),                LEGACY("bar_dscl", VAR_FLOAT, 140, 1),
+    LEGACY("bar_dbg", VAR_UINT8, 144, 1),                LEGACY("mag_dec", VAR_INT16, 98, 1),                 LEGACY("mag_time", VAR_UINT8, 100, 1),
+    LEGACY("mag_gain", VAR_UINT8, 101, 1),               LEGACY("gps_baudrate", VAR_UINT32, 372, 1),          LEGACY("gps_type", VAR_UINT8, 350, 1),
+    LEGACY("gps_ins_vel", VAR_FLOAT, 352, 1),            LEGACY("gps_ins_mdl", VAR_UINT8, 356, 1),            LEGACY("gps_lag", VAR_UINT16, 358, 1),
+    LEGACY("gps_phase", VAR_INT8, 360, 1),               LEGACY("gps_ph_minsat", VAR_UINT8, 362, 1),          LEGACY("gps_ph_settlespeed", VAR_UINT8, 363, 1),
+    LEGACY("gps_maxangle", VAR_UINT8, 364, 1),           LEGACY("gps_ph_brakemaxangle", VAR_UINT8, 365, 1),   LEGACY("gps_ph_minbrakepercent", VAR_UINT8, 366, 1),
+    LEGACY("gps_ph_brkacc", VAR_UINT16, 368, 1),         LEGACY("gps_ph_abstub", VAR_UINT16, 370, 1),         LEGACY("gps_wp_radius", VAR_UINT16, 376, 1),
+    LEGACY("rtl_mnh", VAR_UINT8, 396, 1),                LEGACY("rtl_cr", VAR_UINT8, 397, 1),                 LEGACY("rtl_mnd", VAR_UINT8, 378, 1),
+    LEGACY("gps_rtl_flyaway", VAR_UINT8, 379, 1),        LEGACY("gps_yaw", VAR_UINT8, 380, 1),                LEGACY("nav_rtl_lastturn", VAR_UINT8, 384, 1),
+    LEGACY("nav_speed_min", VAR_UINT8, 385, 1),          LEGACY("nav_speed_max", VAR_UINT16, 386, 1),         LEGACY("nav_approachdiv", VAR_UINT8, 388, 1),
+    LEGACY("nav_tiltcomp", VAR_UINT8, 389, 1),           LEGACY("nav_ctrkgain", VAR_FLOAT, 392, 1),           LEGACY("nav_slew_rate", VAR_UINT8, 381, 1),
+    LEGACY("nav_controls_heading", VAR_UINT8, 383, 1),   LEGACY("nav_tail_first", VAR_UINT8, 382, 1),         LEGACY("floppy_mode", VAR_UINT8, 442, 1),
+    LEGACY("stat_clear", VAR_UINT8, 636, 1),             LEGACY("gps_pos_p", VAR_UINT8, 23, 1),               LEGACY("gps_pos_i", VAR_UINT8, 33, 1),
+    LEGACY("gps_pos_d", VAR_UINT8, 43, 1),               LEGACY("gps_posr_p", VAR_UINT8, 24, 1),              LEGACY("gps_posr_i", VAR_UINT8, 34, 1),
+    LEGACY("gps_posr_d", VAR_UINT8, 44, 1),              LEGACY("gps_nav_p", VAR_UINT8, 25, 1),               LEGACY("gps_nav_i", VAR_UINT8, 35, 1),
+    LEGACY("gps_nav_d", VAR_UINT8, 45, 1),               LEGACY("looptime", VAR_UINT16, 12, 1),               LEGACY("mainpidctrl", VAR_UINT8, 14, 1),
+    LEGACY("mainpt1cut", VAR_UINT8, 15, 1),              LEGACY("newpidimax", VAR_UINT16, 16, 1),             LEGACY("gpspt1cut", VAR_UINT8, 18, 1),
+    LEGACY("p_pitch", VAR_UINT8, 20, 1),                 LEGACY("i_pitch", VAR_UINT8, 30, 1),                 LEGACY("d_pitch", VAR_UINT8, 40, 1),
+    LEGACY("p_roll", VAR_UINT8, 19, 1),                  LEGACY("i_roll", VAR_UINT8, 29, 1),                  LEGACY("d_roll", VAR_UINT8, 39, 1),
+    LEGACY("p_yaw", VAR_UINT8, 21, 1),                   LEGACY("i_yaw", VAR_UINT8, 31, 1),                   LEGACY("d_yaw", VAR_UINT8, 41, 1),
+    LEGACY("p_alt", VAR_UINT8, 22, 1),                   LEGACY("i_alt", VAR_UINT8, 32, 1),                   LEGACY("d_alt", VAR_UINT8, 42, 1),
+    LEGACY("p_level", VAR_UINT8, 26, 1),                 LEGACY("i_level", VAR_UINT8, 36, 1),                 LEGACY("d_level", VAR_UINT8, 46, 1),
+    LEGACY("snr_type", VAR_UINT8, 428, 1),               LEGACY("snr_min", VAR_UINT8, 429, 1),                LEGACY("snr_max", VAR_UINT16, 430, 1),
+    LEGACY("snr_dbg", VAR_UINT8, 432, 1),                LEGACY("snr_tilt", VAR_UINT8, 433, 1),               LEGACY("snr_cf", VAR_FLOAT, 436, 1),
+    LEGACY("snr_diff", VAR_UINT8, 440, 1),               LEGACY("snr_land", VAR_UINT8, 441, 1),               LEGACY("LED_invert", VAR_UINT8, 405, 1),
+    LEGACY("LED_Type", VAR_UINT8, 406, 1),               LEGACY("LED_pinout", VAR_UINT8, 407, 1),             LEGACY("LED_ControlChannel", VAR_UINT8, 408, 1),
+    LEGACY("LED_ARMED", VAR_UINT8, 409, 1),              LEGACY("LED_Toggle_Delay1", VAR_UINT8, 410, 1),      LEGACY("LED_Toggle_Delay2", VAR_UINT8, 411, 1),
+    LEGACY("LED_Toggle_Delay3", VAR_UINT8, 412, 1),      LEGACY("LED_Pattern1", VAR_UINT32, 416, 1),          LEGACY("LED_Pattern2", VAR_UINT32, 420, 1),
+    LEGACY("LED_Pattern3", VAR_UINT32, 424, 1),          LEGACY("mixerConfiguration", VAR_UINT8, 5, 1),       LEGACY("enabledFeatures", VAR_UINT32, 8, 1),
+    LEGACY("dynThrPID", VAR_UINT8, 55, 1),               LEGACY("accZero", VAR_FLOAT, 56, 3),                 LEGACY("sens_1G", VAR_FLOAT, 68, 1),
+    LEGACY("magZero", VAR_FLOAT, 72, 3),                 LEGACY("accstddev", VAR_FLOAT, 84, 3),               LEGACY("mag_calibrated", VAR_UINT8, 96, 1),
+    LEGACY("mag_motorcompusable", VAR_UINT8, 97, 1),     LEGACY("activate", VAR_UINT32, 148, 15),             LEGACY("rcmap", VAR_UINT8, 212, 18),
+    LEGACY("servotrim", VAR_INT16, 274, 8),              LEGACY("servoreverse", VAR_INT8, 290, 8),            LEGACY("customMixer", VAR_FLOAT, 444, 48),
+    LEGACY("GPS_MaxDistToHome", VAR_UINT16, 638, 1),     LEGACY("MAXGPSspeed", VAR_UINT16, 640, 1),           LEGACY("MaxAltMeter", VAR_INT16, 642, 1),
+    LEGACY("MinAltMeter", VAR_INT16, 644, 1),            LEGACY("WP_BASE", VAR_UINT32, 648, 2),               LEGACY("WP_BASE_HIGHT", VAR_INT16, 656, 1),
+    LEGACY("FDUsedDatasets", VAR_UINT16, 658, 1),        LEGACY("FloppyDisk", VAR_INT8, 660, 2340),
+};
+
+static const legacyField_t legacyAdded[] =                                  // At their offset in the layout that brought them
+{
+    LEGACY("mag_ellip", VAR_UINT8, 138, 1),     LEGACY("magSoft", VAR_FLOAT, 84, 9),                                        // v35
+    LEGACY("imu_mode", VAR_UINT8, 162, 1),      LEGACY("imu_kp", VAR_FLOAT, 164, 1),        LEGACY("imu_ki", VAR_FLOAT, 168, 1), // v36
+    LEGACY("alt_mode", VAR_UINT8, 184, 1),      LEGACY("alt_acc_n", VAR_FLOAT, 188, 1),     LEGACY("alt_bias_n", VAR_FLOAT, 192, 1), // v37
+    LEGACY("alt_baro_n", VAR_FLOAT, 196, 1),    LEGACY("alt_snr_n", VAR_FLOAT, 200, 1),
+    LEGACY("gps_ins_kf", VAR_UINT8, 425, 1),    LEGACY("gps_kf_acc", VAR_FLOAT, 428, 1),    LEGACY("gps_kf_bias", VAR_FLOAT, 432, 1), // v38
+    LEGACY("gps_kf_pos", VAR_FLOAT, 436, 1),    LEGACY("gps_kf_vel", VAR_FLOAT, 440, 1),
+    LEGACY("gps_ins_dly", VAR_UINT16, 444, 1),  LEGACY("mag_aux", VAR_UINT8, 139, 1),                                       // v39 3052
+    LEGACY("gy_fifo", VAR_UINT8, 158, 1),       LEGACY("gy_drdy", VAR_UINT8, 159, 1),                                       // v39 3056
+    LEGACY("esc_oneshot", VAR_UINT8, 342, 1),                                                                               // v39 3060
+    LEGACY("maindcut", VAR_UINT8, 15, 1),       LEGACY("gy_lpfcut", VAR_UINT16, 176, 1),    LEGACY("gy_ntch1", VAR_UINT16, 178, 1), // v39 3068
+    LEGACY("gy_ntch1q", VAR_UINT8, 180, 1),     LEGACY("gy_ntch2", VAR_UINT16, 182, 1),     LEGACY("gy_ntch2q", VAR_UINT8, 184, 1),
+    LEGACY("gy_tcomp", VAR_UINT8, 226, 1),
+};
+
+static const legacyLayout_t legacyLayouts[] =
+{
+    { 34, 3004,  0, { { 0xFFFF, 0 } } },
+    { 35, 3044,  2, { { 84, 36 }, { 102, 38 }, { 128, 40 } } },
+    { 36, 3052,  5, { { 162, 10 }, { 168, 8 }, { 0xFFFF, 0 } } },
+    { 37, 3072, 10, { { 184, 20 }, { 0xFFFF, 0 } } },
+    { 38, 3052, 15, { { 426, 18 }, { 440, 20 }, { 0xFFFF, 0 } } },
+    { 39, 3052, 17, { { 444, 2 }, { 460, 0 }, { 0xFFFF, 0 } } },
+    { 39, 3056, 19, { { 158, 2 }, { 164, 4 }, { 0xFFFF, 0 } } },
+    { 39, 3060, 20, { { 342, 2 }, { 424, 4 }, { 0xFFFF, 0 } } },
+    { 39, 3068, 27, { { 180, 8 }, { 0xFFFF, 0 } } },
+};
+
+cfgStoreStats_t cfgStoreStats;
+
+static uintptr_t bankAddr;                                                  // Active bank, 0 = none
+static bool      bankCurrent;                                               // It has the layout of this firmware
+static uint16_t  bankWords;                                                 // Snapshot size of the active bank
+static uint32_t  bankSeq;
+static uint32_t  layout;                                                    // Of this firmware, 0 = not computed yet
+static uint32_t  logStart;                                                  // Bank offset of the first record
+static uint32_t  logEnd;                                                    // Bank offset for the next record, CFG_BANK_SIZE = log closed
+static uint32_t  logCommitted;                                              // End of the last complete group
+static uint32_t  queue[CFG_QUEUE_WORDS];                                    // Records waiting for the flash, ready to program
+static uint16_t  qHead, qTail, qGroup;                                      // Next to program, end, start of the group being programmed
+static uint16_t  recLeft;                                                   // Words left of the record being programmed
+static bool      recLast;
+static uint8_t   storeState;
+static uintptr_t target;                                                    // Compaction: bank being written
+static uint16_t  targetPos;                                                 // Compaction: page being erased / word being copied
+static bool      storeRewrite;                                              // cfg as a new bank is due, instead of the queue
+static bool      storeParked;                                               // Failed CFG_TRIES times, pending until the next save
+static uint8_t   storeTries;                                                // Flash errors of the running compaction / rewrite
+static bool      schemaDue;                                                 // Schema pages to write, after a rewrite
+static const legacyLayout_t *legacy;                                        // No bank, a config_t of before the store at CFG_LEGACY_ADDR
+
+static uint16_t storeCrc(uint16_t crc, uint32_t w)                          // CRC-16-CCITT, word as 4 bytes little endian
+{
+    uint8_t i, k;
+    for (i = 0; i < 4; i++, w >>= 8)
+    {
+        crc ^= (uint16_t)(w & 0xFF) << 8;
+        for (k = 0; k < 8; k++) crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+static uint32_t storeRecordCrc(const uint32_t *rec)
+{
+    uint16_t crc = 0xFFFF, i, words = rec[0] >> 16;
+    for (i = 0; i <= words; i++) crc = storeCrc(crc, rec[i]);
+    return crc | (uint32_t)(uint16_t)~crc << 16;
+}
+
+static uint32_t cfgWord(uint16_t i)
+{
+    uint32_t w = CFG_ERASED;
+    memcpy(&w, (uint8_t *)&cfg + i * 4, min(4, sizeof(config_t) - i * 4));
+    return w;
+}
+
+static uint32_t storeScan(uintptr_t bank, uint32_t *committed)              // End of the valid records, committed = end of the last complete group
+{
+    uint32_t pos = logStart, hdr, words;
+
+    *committed = pos;
+    while (pos + 8 <= CFG_BANK_SIZE)
+    {
+        hdr   = FLASH_WORD(bank + pos);
+        words = hdr >> 16;
+        if (!words || (hdr & ~CFG_REC_LAST & 0xFFFF) + words > bankWords || pos + (words + 2) * 4 > CFG_BANK_SIZE) break;
+        if (FLASH_WORD(bank + pos + (words + 1) * 4) != storeRecordCrc((const uint32_t *)(bank + pos))) break;
+        pos += (words + 2) * 4;
+        if (hdr & CFG_REC_LAST) *committed = pos;
+    }
+    return pos;
+}
+
+static const uint32_t *storeOverlay(const uint32_t *rec, uint32_t *buf, uint16_t first, uint16_t n) // Record over buf, returns the next record
+{
+    uint16_t start = rec[0] & ~CFG_REC_LAST & 0xFFFF, words = rec[0] >> 16, i;
+    for (i = max(start, first); i < min(start + words, first + n); i++) buf[i - first] = rec[1 + i - start];
+    return rec + words + 2;
+}
+
+static void storeImage(uint32_t *buf, uint16_t first, uint16_t n, bool queued) // Stored words first .. first + n, with the queue on top if queued
+{
+    const uint32_t *rec, *end;
+
+    memcpy(buf, (const uint32_t *)(bankAddr + CFG_SNAPSHOT) + first, n * 4);
+    for (rec = (const uint32_t *)(bankAddr + logStart), end = (const uint32_t *)(bankAddr + logCommitted); rec < end;)
+        rec = storeOverlay(rec, buf, first, n);
+    if (!queued) return;
+    for (rec = queue, end = queue + qTail; rec < end;) rec = storeOverlay(rec, buf, first, n);
+}
+
+static void storeRead(uint16_t offset, void *dst, uint16_t len)            // Bytes of the stored image, any layout
+{
+    uint32_t buf[CFG_CHUNK_WORDS];
+    uint16_t first, n, skip, cnt;
+    uint8_t  *d = dst;
+
+    for (first = offset / 4; len; first += n)
+    {
+        n    = min(CFG_CHUNK_WORDS, bankWords - first);
+        storeImage(buf, first, n, false);
+        skip = first == offset / 4 ? offset % 4 : 0;
+        cnt  = min(len, n * 4 - skip);
+        memcpy(d, (uint8_t *)buf + skip, cnt);
+        d   += cnt;
+        len -= cnt;
+    }
+}
+
+static void storeStats(void)
+{
+    cfgStoreStats.bank    = bankAddr ? (bankAddr - FLASH_WRITE_ADDR) / CFG_BANK_SIZE : 0xFF;
+    cfgStoreStats.seq     = bankSeq;
+    cfgStoreStats.logUsed = min(logEnd, CFG_BANK_SIZE) - logStart;
+    cfgStoreStats.logSize = CFG_BANK_SIZE - logStart;
+    cfgStoreStats.queued  = (qTail - qHead) * 4;
+    cfgStoreStats.rewrite = storeRewrite;
+    cfgStoreStats.parked  = storeParked;
+}
+
+static uint32_t fnv(uint32_t h, const void *data, uint16_t len)             // FNV-1a
+{
+    const uint8_t *p = data;
+    while (len--) h = (h ^ *p++) * 16777619UL;
+    return h;
+}
+
+static uint16_t schemaCount(void)
+{
+    return min(valueTableCount + sizeof(schemaExtra) / sizeof(schemaExtra[0]), CFG_SCHEMA_MAX);
+}
+
+static const char *schemaEntry(uint16_t i, uint32_t *entry)                 // Field i: tag, offset | type << 16 | count << 20, returns the name
+{
+    const char *name;
+    uint8_t    type;
+    void       *ptr;
+    uint16_t   count = 1;
+
+    if (i < valueTableCount)
+    {
+        name  = valueTable[i].name;
+        type  = valueTable[i].type;
+        ptr   = valueTable[i].ptr;
+    }
+    else
+    {
+        i    -= valueTableCount;
+        name  = schemaExtra[i].name;
+        type  = schemaExtra[i].type;
+        ptr   = schemaExtra[i].ptr;
+        count = schemaExtra[i].count;
+    }
+    entry[0] = fnv(2166136261UL, name, strlen(name));
+    entry[1] = (uint32_t)((uint8_t *)ptr - (uint8_t *)&cfg) | (uint32_t)type << 16 | (uint32_t)count << 20;
+    return name;
+}
+
+static uint32_t schemaLayout(void)                                          // Hash over size and schema, never 0 or erased
+{
+    uint32_t entry[2], h;
+    uint16_t i, size = sizeof(config_t);
+
+    if (layout) return layout;
+    h = fnv(2166136261UL, &size, 2);
+    for (i = 0; i < schemaCount(); i++)
+    {
+        schemaEntry(i, entry);
+        h = fnv(h, entry, 8);
+    }
+    layout = h == 0 || h == CFG_ERASED ? 1 : h;
+    return layout;
+}
+
+static void schemaWrite(void)                                               // The schema of this firmware, blocking
+{
+    uint32_t entry[2];
+    uint16_t i, n = schemaCount();
+    uint8_t  k;
+
+    if (FLASH_WORD(CFG_SCHEMA_ADDR) == (CFG_SCHEMA_MAGIC | n) && FLASH_WORD(CFG_SCHEMA_ADDR + 4) == schemaLayout()) return;
+    FLASH_Unlock();
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);
+    for (i = 0; i < CFG_SCHEMA_SIZE / FLASH_PAGE_SIZE; i++)
+    {
+        for (k = 0; k < CFG_TRIES && FLASH_ErasePage(CFG_SCHEMA_ADDR + i * FLASH_PAGE_SIZE) != FLASH_COMPLETE; k++);
+        if (k == CFG_TRIES) break;
+    }
+    if (i < CFG_SCHEMA_SIZE / FLASH_PAGE_SIZE)                              // No schema, a later layout can't migrate from this one
+    {
+        FLASH_Lock();
+        cfgStoreStats.failures++;
+        return;
+    }
+    for (i = 0; i < n; i++)
+    {
+        schemaEntry(i, entry);
+        if (FLASH_ProgramWord(CFG_SCHEMA_ADDR + 8 + i * 8, entry[0]) != FLASH_COMPLETE ||
+            FLASH_ProgramWord(CFG_SCHEMA_ADDR + 12 + i * 8, entry[1]) != FLASH_COMPLETE) break;
+    }
+    if (i == n && FLASH_ProgramWord(CFG_SCHEMA_ADDR + 4, schemaLayout()) == FLASH_COMPLETE) FLASH_ProgramWord(CFG_SCHEMA_ADDR, CFG_SCHEMA_MAGIC | n); // Magic last
+    FLASH_Lock();
+    cfgStoreStats.schemaFields = n;
+}
+
+static void storeSwitch(void)                                               // target is committed, it's the active bank now
+{
+    bankAddr     = target;
+    bankCurrent  = true;
+    bankWords    = CFG_WORDS;
+    bankSeq++;
+    logStart     = logEnd = logCommitted = CFG_LOG_START;
+    storeState   = STORE_IDLE;
+}
+
+static const legacyLayout_t *legacyFind(void)                               // The config_t at CFG_LEGACY_ADDR, if it's one of legacyLayouts
+{
+    const uint8_t *p = (const uint8_t *)CFG_LEGACY_ADDR;
+    uint16_t      size = p[2] | p[3] << 8, i;
+    uint8_t       chk = 0, k;
+
+    if (size > CFG_LEGACY_SIZE || size < 8 || p[4] != 0xBE || p[size - 4] != 0xEF) return NULL;
+    for (k = 0; k < sizeof(legacyLayouts) / sizeof(legacyLayouts[0]); k++)
+        if (legacyLayouts[k].version == p[0] && legacyLayouts[k].size == size) break;
+    if (k == sizeof(legacyLayouts) / sizeof(legacyLayouts[0])) return NULL;
+    for (i = 0; i < size; i++) chk ^= p[i];
+    return chk ? NULL : &legacyLayouts[k];
+}
+
+static bool legacyField(const char *name, uint32_t *field)                  // Where the legacy layout has that field
+{
+    const legacyField_t *f;
+    uint16_t            offset, shift;
+    uint8_t             from = 0, l, k;
+
+    for (f = legacyV34; f < legacyV34 + sizeof(legacyV34) / sizeof(legacyV34[0]) && strcmp(f->name, name); f++);
+    if (f == legacyV34 + sizeof(legacyV34) / sizeof(legacyV34[0]))
+    {
+        for (f = legacyAdded; f < legacyAdded + legacy->added && strcmp(f->name, name); f++);
+        if (f == legacyAdded + legacy->added) return false;
+        while (legacyLayouts[from].added <= f - legacyAdded) from++;       // The layout that brought it
+    }
+    offset = f->field & 0xFFFF;
+    for (l = from + 1; l <= legacy - legacyLayouts; l++)                    // Moved by every layout since
+    {
+        for (shift = 0, k = 0; k < 3 && offset >= legacyLayouts[l].shift[k][0]; k++) shift = legacyLayouts[l].shift[k][1];
+        offset += shift;
+    }
+    *field = (f->field & 0xFFFF0000) | offset;
+    return true;
+}
+
+bool cfgStoreLoad(void)                                                     // cfg from the newest bank, false when there is none in this layout
+{
+    uint32_t  buf[CFG_CHUNK_WORDS], end;
+    uintptr_t bank;
+    uint16_t  first, n;
+    uint8_t   i;
+
+    bankAddr = 0;
+    for (i = 0; i < 2; i++)
+    {
+        bank = FLASH_WRITE_ADDR + i * CFG_BANK_SIZE;
+        if ((FLASH_WORD(bank + 4) & 0xFFFF0000) != CFG_MAGIC || FLASH_WORD(bank) == CFG_ERASED) continue;
+        if (CFG_SNAPSHOT + (FLASH_WORD(bank + 4) & 0xFFFF) > CFG_BANK_SIZE) continue; // Bank of the 4 page builds, not taken over
+        if (bankAddr && FLASH_WORD(bank) < bankSeq) continue;
+        bankAddr = bank;
+        bankSeq  = FLASH_WORD(bank);
+    }
+    qHead = qTail = 0;
+    storeState   = STORE_IDLE;
+    storeRewrite = storeParked = schemaDue = false;
+    storeTries   = 0;
+    legacy       = NULL;
+    if (FLASH_WORD(CFG_SCHEMA_ADDR) >> 16 == CFG_SCHEMA_MAGIC >> 16) cfgStoreStats.schemaFields = FLASH_WORD(CFG_SCHEMA_ADDR) & 0xFFFF;
+    if (!bankAddr)
+    {
+        legacy   = legacyFind();                                            // cfgStoreMigrate
+        bankSeq  = 0;
+        logStart = logEnd = logCommitted = CFG_LOG_START;
+        storeStats();
+        return false;
+    }
+    bankWords   = ((FLASH_WORD(bankAddr + 4) & 0xFFFF) + 3) / 4;
+    bankCurrent = bankWords == CFG_WORDS && (FLASH_WORD(bankAddr + 4) & 0xFFFF) == sizeof(config_t) && FLASH_WORD(bankAddr + 8) == schemaLayout();
+    logStart    = CFG_SNAPSHOT + bankWords * 4;
+    end         = storeScan(bankAddr, &logCommitted);
+    logEnd      = end == logCommitted && (end + 4 > CFG_BANK_SIZE || FLASH_WORD(bankAddr + end) == CFG_ERASED) ? end : CFG_BANK_SIZE; // Torn: closed
+    storeStats();
+    if (!bankCurrent) return false;                                         // Other layout, cfgStoreMigrate
+    for (first = 0; first < CFG_WORDS; first += n)
+    {
+        n = min(CFG_CHUNK_WORDS, CFG_WORDS - first);
+        storeImage(buf, first, n, false);
+        memcpy((uint8_t *)&cfg + first * 4, buf, min(n * 4, sizeof(config_t) - first * 4));
+    }
+    schemaWrite();                                                          // Power lost after the migration, before the schema
+    return true;
+}
+
+static void migrateRead(uint16_t offset, void *dst, uint16_t len)          // Bytes of the old config, bank or legacy
+{
+    if (legacy) memcpy(dst, (const uint8_t *)CFG_LEGACY_ADDR + offset, len);
+    else storeRead(offset, dst, len);
+}
+
+static void schemaConvert(uint16_t offset, uint8_t type, uint8_t *dst, uint8_t newType, const clivalue_t *var) // One stored value into cfg
+{
+    uint32_t raw = 0;
+    int32_t  value;
+    float    valuef;
+
+    migrateRead(offset, &raw, schemaTypeSize[type]);
+    switch (type)
+    {
+    case VAR_UINT8:  value = (uint8_t)raw;  break;
+    case VAR_INT8:   value = (int8_t)raw;   break;
+    case VAR_UINT16: value = (uint16_t)raw; break;
+    case VAR_INT16:  value = (int16_t)raw;  break;
+    case VAR_UINT32: value = (int32_t)raw;  break;
+    default:
+        memcpy(&valuef, &raw, 4);
+        value = lrintf(valuef);
+        break;
+    }
+    if (type != VAR_FLOAT) valuef = value;
+    if (var)                                                                // A value the new limits don't allow would be a surprise in flight
+    {
+        value  = constrain(value,  var->min, var->max);
+        valuef = constrain(valuef, var->min, var->max);
+    }
+    switch (newType)
+    {
+    case VAR_UINT8:
+    case VAR_INT8:   *(int8_t *)dst  = value;  break;
+    case VAR_UINT16:
+    case VAR_INT16:  *(int16_t *)dst = value;  break;
+    case VAR_UINT32: *(int32_t *)dst = value;  break;
+    default:         *(float *)dst   = valuef; break;
+    }
+}
+
+bool cfgStoreMigrate(void)                                                  // Fields of the stored config onto the defaults in cfg
+{
+    const uint32_t *old = (const uint32_t *)(CFG_SCHEMA_ADDR + 8);
+    const char     *name;
+    uint32_t entry[2], field;
+    uint16_t i, k, n, offset, count, size;
+    uint8_t  type, newType;
+
+    cfgStoreStats.migrated = cfgStoreStats.legacy = 0;
+    n = FLASH_WORD(CFG_SCHEMA_ADDR) & 0xFFFF;
+    if (legacy) size = legacy->size;                                        // config_t of before the store, the frozen layout
+    else if (!bankAddr || FLASH_WORD(CFG_SCHEMA_ADDR) >> 16 != CFG_SCHEMA_MAGIC >> 16 || n > CFG_SCHEMA_MAX ||
+             FLASH_WORD(CFG_SCHEMA_ADDR + 4) != FLASH_WORD(bankAddr + 8)) return false; // No schema of that bank
+    else size = bankWords * 4;
+    for (i = 0; i < schemaCount(); i++)
+    {
+        name = schemaEntry(i, entry);
+        if (legacy)
+        {
+            if (!legacyField(name, &field)) continue;                       // New field, keeps the default
+        }
+        else
+        {
+            for (k = 0; k < n && old[k * 2] != entry[0]; k++);
+            if (k == n) continue;
+            field = old[k * 2 + 1];
+        }
+        offset  = field & 0xFFFF;
+        type    = (field >> 16) & 0x0F;
+        newType = (entry[1] >> 16) & 0x0F;
+        count   = min(field >> 20, entry[1] >> 20);
+        if (type > VAR_FLOAT || offset + count * schemaTypeSize[type] > size) continue;
+        if (type == newType && i >= valueTableCount)                        // Calibration, mixer, logger: as they are
+            migrateRead(offset, (uint8_t *)&cfg + (entry[1] & 0xFFFF), count * schemaTypeSize[type]);
+        else for (k = 0; k < count; k++)
+            schemaConvert(offset + k * schemaTypeSize[type], type, (uint8_t *)&cfg + (entry[1] & 0xFFFF) + k * schemaTypeSize[newType],
+                          newType, i < valueTableCount ? &valueTable[i] : NULL);
+        cfgStoreStats.migrated++;
+    }
+    if (legacy) cfgStoreStats.legacy = legacy->version;
+    cfg.FDUsedDatasets = min(cfg.FDUsedDatasets, FDByteSize / 4);           // GPS logger datasets (floppy.c), FloppyDisk may have been cut
+    return true;
+}
+
+static bool storeCommit(void)                                               // Header of target, the magic word last
+{
+    return FLASH_ProgramWord(target, bankSeq + 1) == FLASH_COMPLETE && FLASH_ProgramWord(target + 8, schemaLayout()) == FLASH_COMPLETE &&
+           FLASH_ProgramWord(target + 4, CFG_MAGIC | sizeof(config_t)) == FLASH_COMPLETE;
+}
+
+static void storeRewriteStart(void)                                         // cfg as a new bank, in the steps of TASK_CONFIG
+{
+    storeRewrite = true;
+    if (storeState == STORE_APPEND) logEnd = CFG_BANK_SIZE;                 // The group half in the log stays torn, close it
+    if (storeState != STORE_ERASE) storeState = STORE_IDLE;                 // A copy on the way (compaction or rewrite) starts over
+    qHead = qTail = 0;                                                      // All in the new snapshot
+    storeStats();
+}
+
+static void storeTarget(void)                                               // Compaction / rewrite into the other bank
+{
+    target     = bankAddr == FLASH_WRITE_ADDR ? FLASH_WRITE_ADDR + CFG_BANK_SIZE : FLASH_WRITE_ADDR;
+    targetPos  = 0;
+    storeState = STORE_ERASE;
+}
+
+static void storeFail(void)                                                 // Flash error in a compaction / rewrite: start over, CFG_TRIES times
+{
+    storeTarget();
+    if (++storeTries < CFG_TRIES) return;
+    storeState  = STORE_IDLE;                                               // Parked: still pending, tried again at the next save
+    storeParked = true;
+    cfgStoreStats.failures++;
+}
+
+static bool storeCopied(void)                                               // The rewritten snapshot is still cfg
+{
+    uint16_t i;
+    for (i = 0; i < CFG_WORDS && FLASH_WORD(target + CFG_SNAPSHOT + i * 4) == cfgWord(i); i++);
+    return i == CFG_WORDS;
+}
+
+void cfgStoreSave(void)                                                     // Queue the difference between cfg and the stored config
+{
+    uint32_t buf[CFG_CHUNK_WORDS];
+    uint16_t first, n, i, run, start = qTail, last = CFG_QUEUE_WORDS, rec;
+
+    cfgStoreStats.saves++;
+    storeParked = false;                                                    // Another try for whatever is pending
+    storeTries  = 0;
+    if (!bankAddr || !bankCurrent || storeRewrite)                          // Nothing to compare with, or cfg goes as a whole anyway
+    {
+        storeRewriteStart();
+        return;
+    }
+    for (first = 0; first < CFG_WORDS; first += n)
+    {
+        n = min(CFG_CHUNK_WORDS, CFG_WORDS - first);
+        storeImage(buf, first, n, true);
+        for (i = 0; i < n; i += run)
+        {
+            run = 1;
+            if (cfgWord(first + i) == buf[i]) continue;
+            while (i + run < n && (cfgWord(first + i + run) != buf[i + run] ||        // A single equal word is cheaper than a new record
+                   (i + run + 1 < n && cfgWord(first + i + run + 1) != buf[i + run + 1]))) run++;
+            if (qTail + run + 2 > CFG_QUEUE_WORDS)                          // Too big for the queue, new bank
+            {
+                storeRewriteStart();
+                return;
+            }
+            last          = qTail;
+            queue[qTail++] = (first + i) | (uint32_t)run << 16;
+            for (rec = 0; rec < run; rec++) queue[qTail++] = cfgWord(first + i + rec);
+            qTail++;                                                        // crc, below
+        }
+    }
+    if (last == CFG_QUEUE_WORDS)                                            // Nothing changed
+    {
+        storeStats();
+        return;
+    }
+    queue[last] |= CFG_REC_LAST;
+    for (rec = start; rec < qTail; rec += (queue[rec] >> 16) + 2) queue[rec + (queue[rec] >> 16) + 1] = storeRecordCrc(&queue[rec]);
+    storeStats();
+}
+
+void cfgStoreUpdate(bool disarmed)                                          // TASK_CONFIG, one step
+{
+    uint32_t buf[CFG_CHUNK_WORDS], words;
+    uint16_t i, n;
+
+    switch (storeState)
+    {
+    case STORE_IDLE:
+        if (storeParked) return;
+        if (schemaDue && disarmed)                                          // After a migration, the old schema is no longer needed
+        {
+            schemaDue = false;
+            schemaWrite();
+            return;
+        }
+        if (storeRewrite)
+        {
+            if (disarmed) storeTarget();
+            return;
+        }
+        if (qHead == qTail) return;
+        for (words = 0, i = qHead; i < qTail; i += n)                       // Size of the next group
+        {
+            n      = (queue[i] >> 16) + 2;
+            words += n;
+            if (queue[i] & CFG_REC_LAST) break;
+        }
+        if (logEnd + words * 4 <= CFG_BANK_SIZE) storeState = STORE_APPEND;
+        else if (disarmed) storeTarget();                                   // Log full, compact into the other bank
+        qGroup  = qHead;
+        recLeft = 0;
+        return;
+
+    case STORE_APPEND:
+        FLASH_Unlock();
+        for (i = 0; i < CFG_STEP_WORDS && storeState == STORE_APPEND; i++)
+        {
+            if (!recLeft)
+            {
+                recLeft = (queue[qHead] >> 16) + 2;
+                recLast = queue[qHead] & CFG_REC_LAST;
+            }
+            if (FLASH_ProgramWord(bankAddr + logEnd, queue[qHead]) != FLASH_COMPLETE)
+            {
+                logEnd     = CFG_BANK_SIZE;                                 // Close the log, the group goes into the next bank
+                qHead      = qGroup;
+                storeState = STORE_IDLE;
+                break;
+            }
+            logEnd += 4;
+            qHead++;
+            if (--recLeft || !recLast) continue;
+            logCommitted = logEnd;                                          // Group complete
+            if (qHead == qTail) qHead = qTail = 0;
+            storeState = STORE_IDLE;
+        }
+        FLASH_Lock();
+        break;
+
+    case STORE_ERASE:
+        if (!disarmed) return;                                              // No 20ms stalls in flight
+        FLASH_Unlock();
+        FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);
+        if (FLASH_ErasePage(target + targetPos * FLASH_PAGE_SIZE) != FLASH_COMPLETE) storeFail();
+        else if (++targetPos == CFG_BANK_PAGES)
+        {
+            targetPos  = 0;
+            storeState = STORE_COPY;
+        }
+        FLASH_Lock();
+        break;
+
+    case STORE_COPY:
+        n = min(disarmed ? CFG_CHUNK_WORDS : CFG_STEP_WORDS, CFG_WORDS - targetPos); // Disarmed nobody minds 2ms
+        if (storeRewrite) for (i = 0; i < n; i++) buf[i] = cfgWord(targetPos + i);
+        else storeImage(buf, targetPos, n, false);                          // Stored image only, the queue follows as records
+        FLASH_Unlock();
+        for (i = 0; i < n; i++)
+        {
+            if (FLASH_ProgramWord(target + CFG_SNAPSHOT + (targetPos + i) * 4, buf[i]) == FLASH_COMPLETE) continue;
+            storeFail();
+            break;
+        }
+        FLASH_Lock();
+        if (storeState == STORE_COPY && (targetPos += n) == CFG_WORDS) storeState = STORE_COMMIT;
+        break;
+
+    case STORE_COMMIT:
+        if (storeRewrite && !storeCopied())                                 // cfg changed in the meantime
+        {
+            storeTarget();
+            break;
+        }
+        FLASH_Unlock();
+        if (!storeCommit()) storeFail();
+        else
+        {
+            if (storeRewrite) cfgStoreStats.fullWrites++;
+            else cfgStoreStats.compactions++;
+            schemaDue   |= storeRewrite;
+            storeRewrite = false;
+            storeTries   = 0;
+            storeSwitch();
+        }
+        FLASH_Lock();
+        break;
+    }
+    storeStats();
+}
+
+void cfgStoreFlush(void)                                                    // Everything in the flash, blocking. Before a reset
+{
+    while ((storeState != STORE_IDLE || qHead != qTail || storeRewrite || schemaDue) && !storeParked) cfgStoreUpdate(true);
+}
@@ -2,26 +2,6 @@
 #include "mw.h"
 #include "baseflight_mavlink.h"
 
-typedef enum
-{
-    VAR_UINT8,
-    VAR_INT8,
-    VAR_UINT16,
-    VAR_INT16,
-    VAR_UINT32,
-    VAR_FLOAT
-} vartype_e;
-
-typedef struct
-{
-    const char *name;
-    const uint8_t type; // vartype_e
-    void *ptr;
-    const int32_t min;
-    const int32_t max;
-    const uint8_t lcd; // 1 = Displayed in LCD // 0 = Not displayed
-} clivalue_t;
-
 // we unset this on 'exit'
 extern uint8_t cliMode;
 static void cliAuxset(char *cmdline);
@@ -38,9 +18,13 @@ static void cliMap(char *cmdline);
 static void cliMixer(char *cmdline);
 static void cliSet(char *cmdline);
 static void cliStatus(char *cmdline);
+static void cliTasks(char *cmdline);
 static void cliVersion(char *cmdline);
+static void cliVib(char *cmdline);
+static void cliBlackbox(char *cmdline);
 static void cliScanbus(char *cmdline);
 static void cliPassgps(char *cmdline);
+static void cliPerf(char *cmdline);
 static void cliFlash(char *cmdline);
 static void cliErrorMessage(void);
 static void cliSetVar(const clivalue_t *var, const int32_t value);
@@ -128,6 +112,7 @@ typedef struct
 const clicmd_t cmdTable[] =
 {
     { "auxset", "alternative to GUI", cliAuxset },
+    { "bb",      "blackbox status, dump or erase", cliBlackbox },
     { "cmix", "design custom mixer", cliCMix },
 #ifdef debugmode
     { "debug", "show debugstuff", cliDebug },
@@ -142,11 +127,14 @@ const clicmd_t cmdTable[] =
     { "map",     "mapping of rc channel order", cliMap },
     { "mixer",   "mixer name or list", cliMixer },
     { "passgps", "pass through gps data", cliPassgps },
+    { "perf",    "probe timing or clear", cliPerf },
     { "save",    "save and reboot", cliSave },
     { "scanbus", "scan i2c bus", cliScanbus },
     { "set",     "name=value or blank or * for list", cliSet },
     { "status",  "sys status & stats", cliStatus },
+    { "tasks",   "scheduler stats or clear", cliTasks },
     { "version", "", cliVersion },
+    { "vib",     "vibration peaks (feature pass) or clear", cliVib },
 };
 #define CMD_COUNT (sizeof(cmdTable) / sizeof(cmdTable[0]))
 
@@ -171,6 +159,7 @@ const clivalue_t valueTable[] =
     { "esc_nfly",                  VAR_UINT16, &cfg.esc_nfly,                    0,       2000, 1 },
     { "esc_moff",                  VAR_UINT16, &cfg.esc_moff,                    0,       2000, 0 },
     { "esc_pwm",                   VAR_UINT16, &cfg.esc_pwm,                    50,        498, 0 },
+    { "esc_oneshot",               VAR_UINT8,  &cfg.esc_oneshot,                 0,          1, 0 },
     { "srv_pwm",                   VAR_UINT16, &cfg.srv_pwm,                    50,        498, 0 },
     { "pass_mot",                  VAR_UINT8,  &cfg.pass_mot,                    0,         10, 0 },
     { "rc_min",                    VAR_UINT16, &cfg.rc_min,                      0,       2000, 0 },
@@ -238,24 +227,46 @@ const clivalue_t valueTable[] =
     { "acc_trim_pitch",            VAR_INT16,  &cfg.angleTrim[PITCH],         -300,        300, 1 },
     { "acc_trim_roll",             VAR_INT16,  &cfg.angleTrim[ROLL],          -300,        300, 1 },
     { "gy_lpf",                    VAR_UINT16, &cfg.gy_lpf,                      0,        256, 0 },
+    { "gy_fifo",                   VAR_UINT8,  &cfg.gy_fifo,                     0,          1, 0 },
+    { "gy_drdy",                   VAR_UINT8,  &cfg.gy_drdy,                     0,          1, 0 },
     { "gy_cmpf",                   VAR_UINT16, &cfg.gy_cmpf,                    10,       2000, 1 },
     { "gy_cmpfm",                  VAR_UINT16, &cfg.gy_cmpfm,                   10,       2000, 1 },
-    { "gy_smrll",                  VAR_UINT8,  &cfg.gy_smrll,                    0,        200, 1 },
-    { "gy_smptc",                  VAR_UINT8,  &cfg.gy_smptc,                    0,        200, 1 },
-    { "gy_smyw",                   VAR_UINT8,  &cfg.gy_smyw,                     0,        200, 1 },
+    { "imu_mode",                  VAR_UINT8,  &cfg.imu_mode,                    0,          1, 0 },
+    { "imu_kp",                    VAR_FLOAT,  &cfg.imu_kp,                      0,         10, 1 },
+    { "imu_ki",                    VAR_FLOAT,  &cfg.imu_ki,                      0,          1, 1 },
+    { "gy_lpfcut",                 VAR_UINT16, &cfg.gy_lpfcut,                   0,       1000, 1 },
+    { "gy_ntch1",                  VAR_UINT16, &cfg.gy_ntch1,                    0,       1000, 0 },
+    { "gy_ntch1q",                 VAR_UINT8,  &cfg.gy_ntch1q,                   5,        200, 0 },
+    { "gy_ntch2",                  VAR_UINT16, &cfg.gy_ntch2,                    0,       1000, 0 },
+    { "gy_ntch2q",                 VAR_UINT8,  &cfg.gy_ntch2q,                   5,        200, 0 },
+    { "gy_lpfyw",                  VAR_UINT8,  &cfg.gy_lpfyw,                    0,        255, 1 },
     { "gy_stdev",                  VAR_UINT8,  &cfg.gy_stdev,                    5,        100, 0 },
+    { "gy_tcomp",                  VAR_UINT8,  &cfg.gy_tcomp,                    0,          1, 0 },
     { "accz_vcf",                  VAR_FLOAT,  &cfg.accz_vcf,                    0,          1, 1 },
     { "accz_acf",                  VAR_FLOAT,  &cfg.accz_acf,                    0,          1, 1 },
+    { "alt_mode",                  VAR_UINT8,  &cfg.alt_mode,                    0,          1, 0 },
+    { "alt_acc_n",                 VAR_FLOAT,  &cfg.alt_acc_n,                   1,       1000, 1 },
+    { "alt_bias_n",                VAR_FLOAT,  &cfg.alt_bias_n,                  0,        100, 1 },
+    { "alt_baro_n",                VAR_FLOAT,  &cfg.alt_baro_n,                  1,       1000, 1 },
+    { "alt_snr_n",                 VAR_FLOAT,  &cfg.alt_snr_n,                   1,        100, 1 },
     { "bar_lag",                   VAR_FLOAT,  &cfg.bar_lag,                     0,         10, 1 },
     { "bar_dscl",                  VAR_FLOAT,  &cfg.bar_dscl,                    0,          1, 1 },
     { "bar_dbg",                   VAR_UINT8,  &cfg.bar_dbg,                     0,          1, 0 },
     { "mag_dec",                   VAR_INT16,  &cfg.mag_dec,                -18000,      18000, 1 },
     { "mag_time",                  VAR_UINT8,  &cfg.mag_time,                    1,          6, 1 },
     { "mag_gain",                  VAR_UINT8,  &cfg.mag_gain,                    0,          1, 1 },
+    { "mag_ellip",                 VAR_UINT8,  &cfg.mag_ellip,                   0,          1, 0 },
+    { "mag_aux",                   VAR_UINT8,  &cfg.mag_aux,                     0,          1, 0 },
     { "gps_baudrate",              VAR_UINT32, &cfg.gps_baudrate,             1200,     115200, 0 },
     { "gps_type",                  VAR_UINT8,  &cfg.gps_type,                    0,          9, 0 },
     { "gps_ins_vel",               VAR_FLOAT,  &cfg.gps_ins_vel,                 0,          1, 1 },
     { "gps_ins_mdl",               VAR_UINT8,  &cfg.gps_ins_mdl,                 1,          2, 1 },
+    { "gps_ins_kf",                VAR_UINT8,  &cfg.gps_ins_kf,                  0,          1, 0 },
+    { "gps_kf_acc",                VAR_FLOAT,  &cfg.gps_kf_acc,                  1,       1000, 1 },
+    { "gps_kf_bias",               VAR_FLOAT,  &cfg.gps_kf_bias,                 0,        100, 1 },
+    { "gps_kf_pos",                VAR_FLOAT,  &cfg.gps_kf_pos,                  1,      10000, 1 },
+    { "gps_kf_vel",                VAR_FLOAT,  &cfg.gps_kf_vel,                  0,       1000, 1 },
+    { "gps_ins_dly",               VAR_UINT16, &cfg.gps_ins_dly,                 0,        600, 1 },
     { "gps_lag",                   VAR_UINT16, &cfg.gps_lag,                     0,      10000, 1 },
     { "gps_phase",                 VAR_INT8,   &cfg.gps_phase,                 -30,         30, 1 },
     { "gps_ph_minsat",             VAR_UINT8,  &cfg.gps_ph_minsat,               5,         10, 1 },
@@ -282,6 +293,9 @@ const clivalue_t valueTable[] =
     { "nav_tail_first",            VAR_UINT8,  &cfg.nav_tail_first,              0,          1, 1 },
     { "floppy_mode",               VAR_UINT8,  &cfg.floppy_mode,                 0,          1, 1 },
     { "stat_clear",                VAR_UINT8,  &cfg.stat_clear,                  0,          1, 1 },    
+    { "bb_div",                    VAR_UINT8,  &cfg.bb_div,                      0,        255, 0 },
+    { "st_div",                    VAR_UINT8,  &cfg.st_div,                      0,        255, 0 },
+    { "st_fields",                 VAR_UINT8,  &cfg.st_fields,                   0,         63, 0 },
     { "gps_pos_p",                 VAR_UINT8,  &cfg.P8[PIDPOS],                  0,        200, 1 },
     { "gps_pos_i",                 VAR_UINT8,  &cfg.I8[PIDPOS],                  0,        200, 0 },
     { "gps_pos_d",                 VAR_UINT8,  &cfg.D8[PIDPOS],                  0,        200, 0 },
@@ -293,7 +307,7 @@ const clivalue_t valueTable[] =
     { "gps_nav_d",                 VAR_UINT8,  &cfg.D8[PIDNAVR],                 0,        200, 1 },
     { "looptime",                  VAR_UINT16, &cfg.looptime,                    0,       9000, 1 },
     { "mainpidctrl",               VAR_UINT8,  &cfg.mainpidctrl,                 0,          1, 1 },
-    { "mainpt1cut",                VAR_UINT8,  &cfg.mainpt1cut,                  0,         50, 1 },
+    { "maindcut",                  VAR_UINT8,  &cfg.maindcut,                    0,        200, 1 },
     { "newpidimax",                VAR_UINT16, &cfg.newpidimax,                 10,      65000, 1 },
     { "gpspt1cut",                 VAR_UINT8,  &cfg.gpspt1cut,                   1,         50, 1 },    
     { "p_pitch",                   VAR_UINT8,  &cfg.P8[PITCH],                   0,        200, 1 },
@@ -333,6 +347,7 @@ const clivalue_t valueTable[] =
 };
 
 #define VALUE_COUNT (sizeof(valueTable) / sizeof(valueTable[0]))
+const uint16_t valueTableCount = VALUE_COUNT;                           // For the config schema in cfgstore.c
 
 #ifndef HAVE_ITOA_FUNCTION
 
@@ -585,6 +600,8 @@ static void cliDebug(char *cmdline)
         printf("\r\n\r\nMAG ");
         if (cfg.mag_calibrated) printf("calibrated"); else printf("not calibrated");
         printxyzcalval(cfg.magZero, 0, true);
+        printf("\r\nSoft iron*1000");
+        for (i = 0; i < 3; i++) printf("\r\n%d %d %d", (int32_t)(cfg.magSoft[i][0] * 1000), (int32_t)(cfg.magSoft[i][1] * 1000), (int32_t)(cfg.magSoft[i][2] * 1000));
         printf("\r\nRuntime\r\n");
         for (i = 0; i < 3; i++)
         {
@@ -829,6 +846,7 @@ static void cliDefault(char *cmdline)
 {
     uartPrint("Resetting to defaults...\r\n");
     checkFirstTime(true);
+    cfgStoreFlush();                                    // Nothing may wait in the queue when resetting
     uartPrint("Rebooting...");
     delay(10);
     systemReset(false);
@@ -1034,6 +1052,7 @@ void cliSave(char *cmdline)
 {
     uartPrint("Saving...");
     writeParams(0);
+    cfgStoreFlush();
     uartPrint("\r\nRebooting...");
     delay(10);
     cliMode = 0;
@@ -1043,7 +1062,7 @@ void cliSave(char *cmdline)
 static void cliPrintVar(const clivalue_t *var, uint32_t full)
 {
     int32_t value = 0;
-    char buf[8];
+    char buf[16];                       // ftoa: sign, up to 10 digits and the point
 
     switch (var->type)
     {
@@ -1170,10 +1189,28 @@ static void cliStatus(char *cmdline)
         if (mask & (1 << i)) printf("%s ", sensorNames[i]);
     }
     if (sensors(SENSOR_ACC)) printf("ACC: %s", accNames[accHardware]);
-    printf("\r\nCycle Time: %d, I2C Errors: %d\r\n\r\n", cycleTime, i2cGetErrorCounter());
+    printf("\r\nCycle Time: %d, I2C Errors: %d\r\n", cycleTime, i2cGetErrorCounter());
+    printf("UART1 TX: %d B ring, max %d B waiting, %d B lost, %d frames dropped\r\n", uartTxStats.size, uartTxStats.highWater,
+           uartTxStats.overflows, uartTxStats.dropped);
+    printf("Loop: %d cycles, %d overruns, max %d us (%s)\r\n", loopStats.cycles, loopStats.overruns, loopStats.maxCycle, tasks[loopStats.stallTask].name);
+    if (drdyActive) printf("Data ready to motors: max %d us\r\n", loopStats.maxLatency);
+    printf("Jitter <10 <25 <50 <100 <250 <500 <1000 >=1000 us:");
+    for (i = 0; i < LOOP_BUCKETS; i++) printf(" %d", loopStats.hist[i]);
+    printf("\r\n\r\n");
     printf("Total : %d B\r\n", cfg.size);
     printf("Config: %d B\r\n", cfg.size - FDByteSize);
-    printf("Logger: %d B, %d Datasets\r\n\r\n", FDByteSize, cfg.FDUsedDatasets);
+    printf("Logger: %d B, %d Datasets\r\n", FDByteSize, cfg.FDUsedDatasets);
+    if (vibRunning) printf("Blackbox: off in feature pass\r\n");
+    else printf("Blackbox: %d B of flash between the firmware and the store%s\r\n", blackboxStats.size,
+                blackboxStats.size < FLASH_PAGE_SIZE ? ", too little to log" : "");
+    printf("Store : bank %d seq %d, log %d/%d B, %d B queued%s, %d saves, %d compactions, %d full writes, %d failed\r\n",
+           cfgStoreStats.bank, cfgStoreStats.seq, cfgStoreStats.logUsed, cfgStoreStats.logSize, cfgStoreStats.queued,
+           cfgStoreStats.rewrite ? " + full write" : "", cfgStoreStats.saves, cfgStoreStats.compactions, cfgStoreStats.fullWrites,
+           cfgStoreStats.failures);
+    if (cfgStoreStats.parked) printf("Store : flash errors, the last save is NOT in the flash. Save again to retry\r\n");
+    printf("Schema: %d fields, %d migrated at boot", cfgStoreStats.schemaFields, cfgStoreStats.migrated);
+    if (cfgStoreStats.legacy) printf(" from v%d", cfgStoreStats.legacy);
+    printf("\r\n\r\n");
 
     printf("Stats:\r\n");
     if (sensors(SENSOR_BARO) || sensors(SENSOR_GPS))
@@ -1193,7 +1230,8 @@ static void cliStatus(char *cmdline)
         }
     }
     printf("\r\nMotor:\r\n");
-    printf("Actual Range: %d - %d at %d Hz PWM.\r\n", cfg.esc_min, cfg.esc_max, cfg.esc_pwm);
+    if (cfg.esc_oneshot) printf("Actual Range: %d - %d OneShot125.\r\n", cfg.esc_min, cfg.esc_max);
+    else printf("Actual Range: %d - %d at %d Hz PWM.\r\n", cfg.esc_min, cfg.esc_max, cfg.esc_pwm);
     tmpu16 = (cfg.esc_max - cfg.esc_min) / 100;
     if(motorpercent[0])
     {
@@ -1202,6 +1240,109 @@ static void cliStatus(char *cmdline)
     } else printf("Nothing!\r\n");
 }
 
+static void cliPerf(char *cmdline)
+{
+    uint8_t i, k;
+    if (strlen(cmdline) && !strncasecmp(cmdline, "clear", 5))
+    {
+        perfClear();
+        printf("Cleared\r\n");
+        return;
+    }
+    printf("\r\nProbe\tMin\tAvg\tMax us\tHistogram <%d us doubling\r\n", PERF_BUCKET_US);
+    for (i = 0; i < PERF_COUNT; i++)
+    {
+        printf("%s\t%d\t%d\t%d\t", perfNames[i], perfProbes[i].min, perfAvg(i), perfProbes[i].max);
+        for (k = 0; k < PERF_BUCKETS; k++) printf("%d ", perfProbes[i].hist[k]);
+        printf("\r\n");
+    }
+}
+
+static void cliTasks(char *cmdline)
+{
+    uint8_t i;
+    if (strlen(cmdline) && !strncasecmp(cmdline, "clear", 5))
+    {
+        schedulerClearStats();
+        printf("Cleared\r\n");
+        return;
+    }
+    printf("\r\nTask\t\tPeriod\tBudget\tMax\tRuns\tLate\tOver\r\n");
+    for (i = 0; i < TASK_COUNT; i++)
+    {
+        if (!tasks[i].enabled) continue;
+        printf("%s\t%s%d\t%d\t%d\t%d\t%d\t%d\r\n", tasks[i].name, strlen(tasks[i].name) < 8 ? "\t" : "", tasks[i].period, tasks[i].budget, tasks[i].maxTime, tasks[i].runCnt, tasks[i].lateCnt, tasks[i].overCnt);
+    }
+}
+
+static void cliVib(char *cmdline)
+{
+    const vibSlot_t *slot;
+    uint8_t i, axis, k;
+    if (!vibRunning)
+    {
+        printf("\r\nOnly sampled in feature pass with running motors%s\r\n", feature(FEATURE_PASS) ? ", save and reboot" : "");
+        return;
+    }
+    if (strlen(cmdline) && !strncasecmp(cmdline, "clear", 5))
+    {
+        vibClear();
+        printf("Cleared\r\n");
+        return;
+    }
+    printf("\r\nPeaks Hz/amplitude, %d Hz sampling, %d samples. Mind gy_lpf\r\n", 1000000 / VIB_SAMPLE_US, VIB_N);
+    for (i = 0; i < VIB_SLOTS; i++)
+    {
+        slot = vibResult(i);
+        if (!slot->captures) continue;
+        if (i) printf("Motor %d", i);
+        else printf("All motors");
+        printf(", throttle %d, %d captures\r\n", slot->throttle, slot->captures);
+        for (axis = 0; axis < VIB_AXES; axis++)
+        {
+            printf("%s", vibAxisName(axis));
+            for (k = 0; k < VIB_PEAKS && slot->peak[axis][k].amp; k++)
+                printf("\t%d.%d/%d", slot->peak[axis][k].freq / 10, slot->peak[axis][k].freq % 10, slot->peak[axis][k].amp);
+            printf("\r\n");
+        }
+    }
+}
+
+static void cliBlackbox(char *cmdline)
+{
+    uint32_t offset;
+    uint8_t  buf[32], i, n;
+    char     line[sizeof(buf) * 2 + 1];
+
+    if (strlen(cmdline) && !strncasecmp(cmdline, "erase", 5))
+    {
+        blackboxErase();
+        printf("Erasing in the background\r\n");
+        return;
+    }
+    if (strlen(cmdline) && !strncasecmp(cmdline, "dump", 4))                // Hex lines "offset:bytes" for tools/bbdecode
+    {
+        for (offset = 0; (n = blackboxRead(offset, buf, sizeof(buf))); offset += n)
+        {
+            for (i = 0; i < n; i++) sprintf(line + i * 2, "%02x", buf[i]);
+            printf("%05x:%s\r\n", offset, line);
+        }
+        return;
+    }
+    if (vibRunning)
+    {
+        printf("Blackbox: off in feature pass, its RAM holds the vibration results\r\n");
+        return;
+    }
+    printf("Blackbox: %d/%d B used, %d B queued, %s\r\n", blackboxStats.used, blackboxStats.size, blackboxStats.queued,
+           blackboxStats.size < FLASH_PAGE_SIZE ? "no room, the firmware fills the flash" : blackboxStats.erasing ? "erasing" :
+           blackboxStats.logging ? "logging" : blackboxStats.used + FLASH_PAGE_SIZE > blackboxStats.size ?
+           "full, bb erase" : cfg.bb_div ? "logs when armed" : "off (bb_div 0)");
+    printf("Last log: %d frames, %d dropped\r\n", blackboxStats.frames, blackboxStats.dropped);
+    printf("Stream: %d frames, %d dropped, %s\r\n", blackboxStats.stFrames, blackboxStats.stDropped,
+           cfg.st_div ? "on outside the cli" : "off (st_div 0)");
+}
+
 static void cliVersion(char *cmdline)
 {
     uartPrint(FIRMWARE);
@@ -1339,6 +1480,7 @@ void serialOSD(void)
         printf(".!.!.Saving.!.!.");
         delay(1000);
         writeParams(0);
+        cfgStoreFlush();
         LCDoff();
         systemReset(false);
         break;
@@ -1873,7 +2015,7 @@ bool baseflight_mavlink_send_paramlist(bool Reset)
         return true;                                    // Return status not relevant but true because the "Reset" was a success
     }
     BlockProtocolChange = true;                         // Block Autodetect during transmission
-    baseflight_mavlink_send_singleparam(i);
+    if (!baseflight_mavlink_send_singleparam(i)) return false; // Uart full, the same one next time
     i++;
     if (i == VALUE_COUNT)
     {
@@ -1884,14 +2026,14 @@ bool baseflight_mavlink_send_paramlist(bool Reset)
     else return false;
 }
 
-void baseflight_mavlink_send_singleparam(int16_t Nr)
+bool baseflight_mavlink_send_singleparam(int16_t Nr)
 {
     uint8_t StrLength, MavlinkParaType = MAV_VAR_FLOAT;
     float   value = 0;
     char    buf[16];                                      // Always send 16 chars
     mavlink_message_t msg;
 
-    if(Nr == -1 || Nr >= VALUE_COUNT) return;
+    if(Nr == -1 || Nr >= VALUE_COUNT) return false;
   
     memset (buf, 0, 16);                                  // Fill with 0 For Stringtermination
     StrLength = min(strlen(valueTable[Nr].name), 16);     // Copy max 16 Bytes
@@ -1924,7 +2066,7 @@ void baseflight_mavlink_send_singleparam(int16_t Nr)
         break;
     }
     mavlink_msg_param_value_pack(1, 200, &msg, buf, value, MavlinkParaType, VALUE_COUNT, Nr);
-		baseflight_mavlink_send_message(&msg);
+		return baseflight_mavlink_send_message(&msg);
 }
 
 bool baseflight_mavlink_set_param(mavlink_param_set_t *packet)
@@ -5,7 +5,7 @@
 config_t cfg;
 const char rcChannelLetters[] = "AERT1234";
 
-static uint8_t  EEPROM_CONF_VERSION = 34;
+static uint8_t  EEPROM_CONF_VERSION = 39;
 static uint32_t enabledSensors      = 0;
 static void resetConf(void);
 
@@ -20,23 +20,21 @@ void parseRcChannels(const char *input)
     }
 }
 
-static uint8_t validEEPROM(void)
+static uint8_t validEEPROM(void)                                                          // cfg as loaded by cfgStoreLoad
 {
-    const config_t *temp = (const config_t *)FLASH_WRITE_ADDR;
     const uint8_t  *p;
     uint8_t        chk = 0;
 
-    if (EEPROM_CONF_VERSION != temp->version) return 0;                                   // check version number
-    if (temp->size != sizeof(config_t) || temp->magic_be != 0xBE || temp->magic_ef != 0xEF) return 0; // check size and magic numbers
-    for (p = (const uint8_t *)temp; p < ((const uint8_t *)temp + sizeof(config_t)); p++) chk ^= *p;   // verify integrity of temporary copy
+    if (EEPROM_CONF_VERSION != cfg.version) return 0;                                     // check version number
+    if (cfg.size != sizeof(config_t) || cfg.magic_be != 0xBE || cfg.magic_ef != 0xEF) return 0; // check size and magic numbers
+    for (p = (const uint8_t *)&cfg; p < ((const uint8_t *)&cfg + sizeof(config_t)); p++) chk ^= *p; // verify integrity
     if (chk != 0) return 0;                                                               // checksum failed
     return 1;                                                                             // looks good, let's roll!
 }
 
-void readEEPROM(void)
+void readEEPROM(void)                                                                     // cfg is loaded by checkFirstTime, this derives the rest
 {
     uint8_t i;
-    memcpy(&cfg, (char *)FLASH_WRITE_ADDR, sizeof(config_t));                             // Read flash
     for (i = 0; i < 6; i++)
         lookupPitchRollRC[i] = (2500 + cfg.rcExpo8 * (i * i - 25)) * i * (int32_t) cfg.rcRate8 / 2500;
 
@@ -54,10 +52,8 @@ void readEEPROM(void)
     GPS_reset_nav();
 }
 
-void writeParams(uint8_t b)
+void writeParams(uint8_t b)                                                               // Queued, TASK_CONFIG writes the flash (cfgstore.c)
 {
-    FLASH_Status status;
-    uint32_t i;
     uint8_t chk = 0;
     const uint8_t *p;
 
@@ -68,27 +64,17 @@ void writeParams(uint8_t b)
     cfg.chk        = 0;
     for (p = (const uint8_t *)&cfg; p < ((const uint8_t *)&cfg + sizeof(config_t)); p++) chk ^= *p; // recalculate checksum before writing
     cfg.chk = chk;
-    FLASH_Unlock();                                                                       // write it
-    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);
-  
-    for (i = 0; i < FLASH_PAGES_FORCONFIG; i++)                                           // Erase the pages here
-    {
-        while (FLASH_ErasePage(FLASH_WRITE_ADDR + (i * FLASH_PAGE_SIZE)) != FLASH_COMPLETE);
-    }
-
-    for (i = 0; i < sizeof(config_t); i += 4)                                             // Write that config now.
-    {
-        status = FLASH_ProgramWord(FLASH_WRITE_ADDR + i, *(uint32_t *) ((char *) &cfg + i));
-        if (status != FLASH_COMPLETE) break;                                              // TODO: fail
-    }
-    FLASH_Lock();
+    cfgStoreSave();
     readEEPROM();
     if (b) blinkLED(15, 20, 1);
 }
 
 void checkFirstTime(bool reset)
 {
-    if (!validEEPROM() || reset) resetConf();                                             // check the EEPROM integrity
+    if (!reset && cfgStoreLoad() && validEEPROM()) return;                                // check the EEPROM integrity
+    resetConf();
+    if (!reset) cfgStoreMigrate();                                                        // Other layout or version: keep what the stored config has
+    writeParams(0);
 }
 
 // Default settings
@@ -166,26 +152,44 @@ static void resetConf(void)
     cfg.mag_dec                   = 110;        // Crashpilot //cfg.acc_hdw = ACC_DEFAULT;// default/autodetect
     cfg.mag_time                  = 1;          // (1-6) Calibration time in minutes
     cfg.mag_gain                  = 0;          // 0(default) = 1.9 GAUSS ; 1 = 2.5 GAUSS (problematic copters, will reduce 20% resolution)
+    cfg.mag_ellip                 = 0;          // 0 = Sphere fit (hard iron), 1 = Ellipsoid fit (hard & soft iron)
+    cfg.mag_aux                   = 0;          // 1 = Mag on the aux i2c of the MPU6050 (GY-86 style boards), read in the gyro burst. Needs a reboot
+    for (i = 0; i < 3; i++) cfg.magSoft[i][i] = 1.0f;         // No soft iron correction
     cfg.acc_hdw                   = 2;          // Crashpilot MPU6050
     cfg.acc_lpf                   = 100;	      // changed 27.11.2012
     cfg.acc_ilpf                  = 10;         // General LPF for all INS stuff
 
     cfg.looptime                  = 3000;	      // changed 27.11.2012 //    cfg.acc_lpf = 4;
-    cfg.mainpidctrl               = 0;          // 0 = OriginalMwiiPid pimped by me, 1 = New mwii controller (experimental, float pimped + pt1)
-    cfg.mainpt1cut                = 15;         // (0-50Hz) 0 Disables pt1element. Cuf Off Frequency for pt1 element D term in Hz of main Pid controller
+    cfg.mainpidctrl               = 0;          // 0 = OriginalMwiiPid pimped by me, 1 = New mwii controller (experimental, float pimped + D low-pass)
+    cfg.maindcut                  = 30;         // (0-200Hz) 0 = off. Biquad low-pass on the D term of the main Pid controller. Tuning change: replaces the
+                                                // 15Hz pt1, 7.5 instead of 10.6ms delay and -21 instead of -17dB at 100Hz. Less D lag, check the D gains
     cfg.newpidimax                = 256;        // (10-65000) 256 Default. Imax of new Pidcontroller
     cfg.gpspt1cut                 = 10;         // (1-50Hz) Cuf Off Frequency for D term in Hz of GPS Pid controller 
     cfg.gy_cmpf                   = 1000;       // (10-1000) 400 default. Now 1000. The higher, the more weight gets the gyro and the lower is the correction with Acc data.
     cfg.gy_cmpfm                  = 1000;       // (10-2000) 200 default for 10Hz. Now 1000 for 70Hz seems ok. Gyro/Magnetometer Complement. Greater Value means more filter on mag/delay
-    cfg.gy_smrll                  = 0;
-    cfg.gy_smptc                  = 0;
-    cfg.gy_smyw                   = 0;          // Ensure at least 3 in Tricoptermode for yaw
+    cfg.imu_mode                  = 0;          // 0 = EstG rotation + complementary filter, 1 = Quaternion (Mahony)
+    cfg.imu_kp                    = 0.3f;       // (0-10) About the acc/mag correction of gy_cmpf 1000 @ 3ms looptime. Higher = faster & noisier
+    cfg.imu_ki                    = 0.002f;     // (0-1) Gyro bias correction. 0 = Proportional only
+    cfg.gy_lpfcut                 = 0;          // (0-1000Hz) Biquad low-pass on the gyro for the Pid. Filters above 0.45 * looprate are off
+    cfg.gy_ntch1                  = 0;          // (0-1000Hz) Notch on the gyro for a frame resonance, 0 = off
+    cfg.gy_ntch1q                 = 30;         // Q * 10, 30 = Q 3: notch 1/3 of the centre frequency wide
+    cfg.gy_ntch2                  = 0;
+    cfg.gy_ntch2q                 = 30;
+    cfg.gy_lpfyw                  = 0;          // (0-255Hz) Low-pass on the yaw gyro only. Tricopters: ca. 20, what gy_smyw 3 was at 3ms looptime
     cfg.gy_lpf                    = 42;         // Values for MPU 6050/3050: 256, 188, 98, 42, 20, 10, (HZ) For L3G4200D: 93, 78, 54, 32
-    cfg.gy_stdev                  = 5;
+    cfg.gy_fifo                   = 0;          // 1 = Drain the MPU6050 FIFO every loop, all 1KHz gyro samples go into the attitude. Needs a reboot
+    cfg.gy_drdy                   = 0;          // 1 = MPU6050 data ready interrupt starts the control loop and timestamps the samples. Needs a reboot
+    cfg.gy_stdev                  = 5;          // Sum of the gyro standard deviations of a still 0.5s window (raw / 4), bias is only learnt when below
+    cfg.gy_tcomp                  = 0;          // 1 = Gyro bias follows the temperature in flight, coefficient learnt while disarmed
 
     // Baro
     cfg.accz_vcf                  = 0.985f;     // Crashpilot: Value for complementary filter accz and barovelocity
     cfg.accz_acf                  = 0.940f;     // Crashpilot: Value for complementary filter accz and altitude
+    cfg.alt_mode                  = 0;          // 0 = complementary filter, 1 = Kalman filter (alt_acc_n, alt_bias_n, alt_baro_n, alt_snr_n)
+    cfg.alt_acc_n                 = 40.0f;      // [cm/s^2] acc_up noise
+    cfg.alt_bias_n                = 2.0f;       // [cm/s^2 per sqrt(s)] How fast the acc bias may wander
+    cfg.alt_baro_n                = 40.0f;      // [cm] Baro noise, propwash included
+    cfg.alt_snr_n                 = 5.0f;       // [cm] Sonar noise
     cfg.bar_lag                   = 0.3f;       // Lag of Baro/Althold stuff in general, makes stop in hightchange snappier
     cfg.bar_dscl                  = 0.7f;       // Scale downmovement down (because copter drops faster than rising)
     cfg.bar_dbg                   = 0;          // Crashpilot: 1 = Debug Barovalues //cfg.baro_noise_lpf = 0.6f;// Crashpilot: Not used anymore//cfg.baro_cf = 0.985f;// Crashpilot: Not used anymore
@@ -233,6 +237,7 @@ static void resetConf(void)
     cfg.esc_nfly                  = 1300;       // This is the absolute throttle that kicks off the "has landed timer" if it is too low cfg.rc_min + 5% is taken. Also baselinethr for Autostart, also plausibility check for initial Failsafethrottle
 //  cfg.esc_nfly                  = 0;          // This is the absolute throttle that kicks off the "has landed timer" if it is too low cfg.rc_min + 5% is taken.
     cfg.esc_pwm                   = 400;
+    cfg.esc_oneshot               = 0;          // 1 = OneShot125, only for ESCs that support it. Needs a reboot
     cfg.srv_pwm                   = 50;
     cfg.pass_mot                  = 0;          // Crashpilot: Only used with feature pass. If 0 = all Motors, otherwise specific Motor
 
@@ -273,6 +278,12 @@ static void resetConf(void)
 //  cfg.gps_ins_vel               = 0.72f;      // Crashpilot GPS INS The LOWER the value the closer to gps speed // Dont go to high here
     cfg.gps_ins_vel               = 0.6f;       // Crashpilot GPS INS The LOWER the value the closer to gps speed // Dont go to high here
     cfg.gps_ins_mdl               = 1;          // NOTE: KEEP THIS TO "1" FOR NOW because other models work like shit currently. GPS ins model. 1 = Based on lat/lon, 2 = based on Groundcourse & speed,(3 = based on ublx velned deleted)
+    cfg.gps_ins_kf                = 0;          // 0 = complementary filter (gps_ins_vel), 1 = Kalman filter (gps_kf_acc, gps_kf_bias, gps_kf_pos, gps_kf_vel)
+    cfg.gps_kf_acc                = 100.0f;     // [cm/s^2] Earthframe acc noise
+    cfg.gps_kf_bias               = 20.0f;      // [cm/s^2 per sqrt(s)] How fast the acc bias may wander (tilt errors)
+    cfg.gps_kf_pos                = 150.0f;     // [cm] GPS position noise at HDOP 1, scaled with HDOP (or satcount when the protocol has no HDOP)
+    cfg.gps_kf_vel                = 30.0f;      // [cm/s] GPS speed noise at HDOP 1. 0 = Don't use speed & course (no doppler speed from the receiver)
+    cfg.gps_ins_dly               = 100;        // [0 - 600ms] Kalman: Age of a fix on arrival, the fix is compared to the INS state of that time. 0 = off
     cfg.gps_lag                   = 2000;       // GPS Lag in ms
     cfg.gps_phase                 = 0;          // +- 30 Degree Make a phaseshift of GPS output for whatever reason you might want that (frametype etc)
     cfg.gps_ph_minsat             = 6;          // Minimal Satcount for PH, PH on RTL is still done with 5Sats or more
@@ -369,12 +380,14 @@ static void resetConf(void)
     // LOGGING
     cfg.floppy_mode               = FD_MODE_GPSLOGGER; // Usagemode of free Space. 1 = GPS Logger
     cfg.FDUsedDatasets            = 0;          // Default no Datasets stored
+    cfg.bb_div                    = 0;          // Blackbox off. 1 = every control loop, the internal flash lasts seconds then
+    cfg.st_div                    = 0;          // Stream off, it shares uart1 with MSP. 1 = every control loop, all fields are ca. 8kB/s then, 115200 baud carries 11kB/s
+    cfg.st_fields                 = 1 | 2 | 32; // Stream gyro, rc and motors
     cfg.stat_clear                = 1;          // This will clear the stats between flights, or you can set to 0 and treasue overallstats, but you have to write manually eeprom or have logging enabled
     cfg.sens_1G                   = 1;          // Just feed a dummy "1" to avoid div by zero
     ClearStats();
     // custom mixer. clear by Dfaults.
     for (i = 0; i < MAX_MOTORS; i++) cfg.customMixer[i].throttle = 0.0f;
-    writeParams(0);
 }
 
 void ClearStats(void)
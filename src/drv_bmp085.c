@@ -8,15 +8,7 @@
 #define BARO_OFF                 digitalLo(BARO_GPIO, BARO_PIN);
 #define BARO_ON                  digitalHi(BARO_GPIO, BARO_PIN);
 
-// EXTI14 for BMP085 End of Conversion Interrupt
-void EXTI15_10_IRQHandler(void)
-{
-    if (EXTI_GetITStatus(EXTI_Line14) == SET)
-    {
-        EXTI_ClearITPendingBit(EXTI_Line14);
-//        convDone = true;
-    }
-}
+// EXTI14 for BMP085 End of Conversion Interrupt, the handler is in drv_system.c (EXTI15_10 is shared with MPU_INT)
 
 typedef struct
 {
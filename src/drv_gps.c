@@ -522,22 +522,24 @@ static uint32_t GPS_coord_to_degrees(char* s)
     return deg * 10000000UL + (min * 1000000UL + frac_min * 100UL) / 6;
 }
 
-static uint32_t grab_fields(char *src, uint8_t mult)                            // convert string to uint32
+static uint32_t grab_fields(char *src, uint8_t mult)                            // convert string to uint32, value * 10^mult
 {
-    uint8_t i;
+    uint8_t i, dec = 0;
+    bool    frac = false;
     uint32_t tmp = 0;
     for (i = 0; src[i] != 0; i++)
     {
         if (src[i] == '.')
         {
-            i++;
-            if (mult == 0) break;
-            else src[i + mult] = 0;
+            frac = true;
+            continue;
         }
+        if (frac && dec++ == mult) break;                                       // Decimals past mult are cut
         tmp *= 10;
         if (src[i] >= '0' && src[i] <= '9')
             tmp += src[i] - '0';
     }
+    for (; dec < mult; dec++) tmp *= 10;                                        // "1" or "1.2" with mult 2 is 100 / 120
     return tmp;
 }
 
@@ -586,6 +588,10 @@ static bool GPS_NMEA_newFrame(char c)
             {
                 GPS_numSat = grab_fields(string,0);
             }
+            else if (param == 8)
+            {
+                GPS_hdop = grab_fields(string,2);                               // HDOP * 100, with or without decimals
+            }
             else if (param == 9)
             {
                 GPS_altitude = grab_fields(string,0);                           // altitude in meters added by Mis
@@ -710,7 +716,8 @@ static bool UBLOX_parse_gps(void)
     case MSG_SOL:
         next_fix = (_buffer.solution.fix_status & NAV_STATUS_FIX_VALID) && (_buffer.solution.fix_type == FIX_3D || _buffer.solution.fix_type == FIX_2D);
         if (!next_fix) f.GPS_FIX = false;
-        GPS_numSat = _buffer.solution.satellites;                               // GPS_hdop = _buffer.solution.position_DOP;
+        GPS_numSat = _buffer.solution.satellites;
+        GPS_hdop   = _buffer.solution.position_DOP;                             // PDOP * 100, NAV-SOL has no HDOP. Close enough for weighting the fix
         break;
     case MSG_VELNED:
         GPS_speed = _buffer.velned.speed_2d;                                    // cm/s speed_3d = _buffer.velned.speed_3d;  // cm/s
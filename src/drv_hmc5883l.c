@@ -118,7 +118,7 @@ void hmc5883lInit(float *calGain)                   // THE RESULT IS ALIGNED
 void hmc5883lRead(int16_t *magData)                 // Read aligned BTW: The 5883 sends in that order: X Z Y
 {
     uint8_t  buf[6];
-    i2cRead(MAG_ADDRESS, MAG_DATA_REGISTER, 6, buf);
+    if (!mpu6050AuxMagRead(buf)) i2cRead(MAG_ADDRESS, MAG_DATA_REGISTER, 6, buf); // With mag_aux the MPU6050 burst has it already
     magData[0] = (int16_t)(((uint16_t)buf[0] << 8) | (uint16_t)buf[1]);
     magData[1] = (int16_t)(((uint16_t)buf[2] << 8) | (uint16_t)buf[3]);
     magData[2] = (int16_t)(((uint16_t)buf[4] << 8) | (uint16_t)buf[5]);
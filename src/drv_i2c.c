@@ -28,11 +28,20 @@ void I2C2_EV_IRQHandler(void)
     i2c_ev_handler();
 }
 
-#define I2C_DEFAULT_TIMEOUT 30000
+// Transactions are queued. i2cSubmit puts a job descriptor into the queue, the event interrupt runs it and
+// starts the next queued job when it is done, so the cpu only has to wait when it really needs the data.
+// i2cRead / i2cWrite / i2cWriteBuffer are the old blocking calls, they queue a job and wait for it.
+// A job that is queued or on the bus is refused, so a prefetch from the loop and one from an interrupt can't queue it twice.
+#define I2C_DEFAULT_TIMEOUT 30000                            // Wait loops without progress on the bus, then reset
+#define I2C_QUEUE_SIZE      8                                // Power of 2
 static volatile uint16_t i2cErrorCount = 0;
 
+static i2cJob_t * volatile queue[I2C_QUEUE_SIZE];
+static volatile uint8_t qHead, qTail;                        // Interrupt takes jobs at head, i2cSubmit adds at tail
+static i2cJob_t * volatile job;                              // Job on the bus, NULL = idle
+
 static volatile bool error = false;
-static volatile bool busy;
+static volatile uint8_t subaddress_sent;                     // flag to indicate if subaddess sent
 
 static volatile uint8_t addr;
 static volatile uint8_t reg;
@@ -42,6 +51,63 @@ static volatile uint8_t reading;
 static volatile uint8_t* write_p;
 static volatile uint8_t* read_p;
 
+static void i2cStartNext(void)                               // Put the next queued job on the bus, if the bus is free
+{
+    bool restart;
+
+    if (job || qHead == qTail) return;
+    restart = !(I2Cx->CR2 & I2C_IT_EVT);                     // if we are restarting the driver
+    if (restart && (I2Cx->CR1 & 0x0200)) return;             // the stop of the last job is still going out, a start now gets lost. No waiting here, it may be the interrupt: i2cPoll starts it
+    job = queue[qHead];
+    qHead = (qHead + 1) & (I2C_QUEUE_SIZE - 1);
+    addr = job->addr << 1;
+    reg = job->reg;
+    writing = !job->read;
+    reading = job->read;
+    write_p = job->buf;
+    read_p = job->buf;
+    bytes = job->len;
+    subaddress_sent = 0;
+    error = false;
+    job->state = I2C_JOB_BUSY;
+
+    if (restart) {
+        if (!(I2Cx->CR1 & 0x0100))                           // ensure sending a start
+            I2C_GenerateSTART(I2Cx, ENABLE);                 // send the start for the new job
+        I2C_ITConfig(I2Cx, I2C_IT_EVT | I2C_IT_ERR, ENABLE); // allow the interrupts to fire off again
+    }
+}
+
+void i2cPoll(void)                                           // Start a job that was left queued behind a stop: scheduler, systick and the wait loop
+{
+    __disable_irq();
+    i2cStartNext();
+    __enable_irq();
+}
+
+static void i2cJobDone(uint8_t state)                        // Interrupt side, chain the next job before telling the owner
+{
+    i2cJob_t *done = job;
+
+    job = NULL;
+    i2cStartNext();
+    if (!done) return;
+    done->state = state;
+    if (done->done) done->done(done);
+}
+
+static void i2cFlush(void)                                   // After a timeout, everything queued fails
+{
+    i2cJob_t *j = job;
+
+    job = NULL;
+    if (j) j->state = I2C_JOB_ERROR;
+    while (qHead != qTail) {
+        queue[qHead]->state = I2C_JOB_ERROR;
+        qHead = (qHead + 1) & (I2C_QUEUE_SIZE - 1);
+    }
+}
+
 static void i2c_er_handler(void)
 {
     volatile uint32_t SR1Register; // SR2Register;
@@ -70,39 +136,73 @@ static void i2c_er_handler(void)
         }
     }
     I2Cx->SR1 &= ~0x0F00;                                    // reset all the error bits to clear the interrupt
-    busy = 0;
+    if (SR1Register & 0x0700)                                // job abandoned, an overrun alone lets it finish with error set
+        i2cJobDone(I2C_JOB_ERROR);
 }
 
-bool i2cWriteBuffer(uint8_t addr_, uint8_t reg_, uint8_t len_, uint8_t *data)
+bool i2cSubmit(i2cJob_t *j)
 {
-    uint32_t timeout = I2C_DEFAULT_TIMEOUT;
+    uint8_t next;
 
-    addr = addr_ << 1;
-    reg = reg_;
-    writing = 1;
-    reading = 0;
-    write_p = data;
-    read_p = data;
-    bytes = len_;
-    busy = 1;
-    error = false;
+    __disable_irq();                                         // The interrupt may finish the running job and look at the queue meanwhile
+    next = (qTail + 1) & (I2C_QUEUE_SIZE - 1);
+    if (next == qHead || j->state == I2C_JOB_QUEUED || j->state == I2C_JOB_BUSY) { // Full, or in already
+        __enable_irq();
+        return false;
+    }
+    j->state = I2C_JOB_QUEUED;
+    queue[qTail] = j;
+    qTail = next;
+    i2cStartNext();
+    __enable_irq();
+    return true;
+}
 
-    if (!(I2Cx->CR2 & I2C_IT_EVT)) {                         // if we are restarting the driver
-        if (!(I2Cx->CR1 & 0x0100)) {                         // ensure sending a start
-            while (I2Cx->CR1 & 0x0200) { ; }                 // wait for any stop to finish sending
-            I2C_GenerateSTART(I2Cx, ENABLE);                 // send the start for the new job
+bool i2cWait(i2cJob_t *j)                                    // Block until the job is through, false on error
+{
+    uint32_t timeout = I2C_DEFAULT_TIMEOUT;
+    i2cJob_t *running = job;
+
+    while ((j->state == I2C_JOB_QUEUED || j->state == I2C_JOB_BUSY) && --timeout > 0) {
+        i2cPoll();
+        if (job != running) {                                // the queue moves, jobs ahead of us don't count as timeout
+            running = job;
+            timeout = I2C_DEFAULT_TIMEOUT;
         }
-        I2C_ITConfig(I2Cx, I2C_IT_EVT | I2C_IT_ERR, ENABLE); // allow the interrupts to fire off again
     }
-
-    while (busy && --timeout > 0);
     if (timeout == 0) {
         i2cErrorCount++;
+        __disable_irq();
+        i2cFlush();
+        __enable_irq();
         i2cInit(I2Cx);                                       // reinit peripheral + clock out garbage
         return false;
     }
 
-    return !error;
+    return j->state == I2C_JOB_DONE;
+}
+
+static bool i2cTransfer(uint8_t addr_, uint8_t reg_, uint8_t len_, uint8_t *buf, bool read)
+{
+    i2cJob_t j;
+
+    j.addr = addr_;
+    j.reg = reg_;
+    j.len = len_;
+    j.read = read;
+    j.buf = buf;
+    j.done = NULL;
+    j.state = I2C_JOB_IDLE;
+    if (!i2cSubmit(&j)) {
+        i2cErrorCount++;
+        return false;
+    }
+    return i2cWait(&j);
+}
+
+bool i2cWriteBuffer(uint8_t addr_, uint8_t reg_, uint8_t len_, uint8_t *data)
+{
+    return i2cTransfer(addr_, reg_, len_, data, false);
 }
 
 bool i2cWrite(uint8_t addr_, uint8_t reg_, uint8_t data)
@@ -112,40 +212,12 @@ bool i2cWrite(uint8_t addr_, uint8_t reg_, uint8_t data)
 
 bool i2cRead(uint8_t addr_, uint8_t reg_, uint8_t len, uint8_t* buf)
 {
-    uint32_t timeout = I2C_DEFAULT_TIMEOUT;
-
-    addr = addr_ << 1;
-    reg = reg_;
-    writing = 0;
-    reading = 1;
-    read_p = buf;
-    write_p = buf;
-    bytes = len;
-    busy = 1;
-    error = false;
-
-    if (!(I2Cx->CR2 & I2C_IT_EVT)) {                         // if we are restarting the driver
-        if (!(I2Cx->CR1 & 0x0100)) {                         // ensure sending a start
-            while (I2Cx->CR1 & 0x0200) { ; }                 // wait for any stop to finish sending
-            I2C_GenerateSTART(I2Cx, ENABLE);                 // send the start for the new job
-        }
-        I2C_ITConfig(I2Cx, I2C_IT_EVT | I2C_IT_ERR, ENABLE); // allow the interrupts to fire off again
-    }
-
-    while (busy && --timeout > 0);
-    if (timeout == 0) {
-        i2cErrorCount++;
-        // reinit peripheral + clock out garbage
-        i2cInit(I2Cx);
-        return false;
-    }
-
-    return !error;
+    return i2cTransfer(addr_, reg_, len, buf, true);
 }
 
 void i2c_ev_handler(void)
 {
-    static uint8_t subaddress_sent, final_stop;              // flag to indicate if subaddess sent, flag to indicate final bus condition
+    static uint8_t final_stop;                               // flag to indicate final bus condition
     static int8_t index;                                     // index is signed -1==send the subaddress
     uint8_t SReg_1 = I2Cx->SR1;                              // read the status register here
 
@@ -243,9 +315,9 @@ void i2c_ev_handler(void)
         // End of completion tasks
         subaddress_sent = 0;                                 // reset this here
         // I2Cx->CR1 &= ~0x0800;   // reset the POS bit so NACK applied to the current byte
-        if (final_stop)  //If there is a final stop and no more jobs, bus is inactive, disable interrupts to prevent BTF
+        if (final_stop)  //If there is a final stop, bus is inactive, disable interrupts to prevent BTF. i2cStartNext restarts them for a queued job
             I2C_ITConfig(I2Cx, I2C_IT_EVT | I2C_IT_ERR, DISABLE); // Disable EVT and ERR interrupts while bus inactive
-        busy = 0;
+        i2cJobDone(error ? I2C_JOB_ERROR : I2C_JOB_DONE);
     }
 }
 
@@ -5,3 +5,8 @@ bool i2cWriteBuffer(uint8_t addr_, uint8_t reg_, uint8_t len_, uint8_t *data);
 bool i2cWrite(uint8_t addr_, uint8_t reg, uint8_t data);
 bool i2cRead(uint8_t addr_, uint8_t reg, uint8_t len, uint8_t* buf);
 uint16_t i2cGetErrorCounter(void);
+
+// Non blocking: queue a job and collect it later through job->state or job->done
+bool i2cSubmit(i2cJob_t *job);
+bool i2cWait(i2cJob_t *job);
+void i2cPoll(void);                                          // Scheduler and systick: starts a job queued while a stop was still going out
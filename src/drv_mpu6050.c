@@ -119,6 +119,28 @@ static void mpu6050GyroRead(int16_t *gyroData);
 static void mpu6050GyroAlign(int16_t *gyroData);
 static void mpu6050TempRead(float *tempData);
 
+#define MPU_PREFETCH_AGE        1000                         // us, older prefetched data is read again
+#define MPU_AUX_MAG_ADDRESS     0x1E                         // HMC5883L
+#define MPU_AUX_MAG_DLY         3                            // Aux slave read every 1 + 3 samples, 250Hz @ 1KHz sample rate
+#define MPU_FIFO_SIZE           1024
+#define MPU_FIFO_FRAME          14                           // acc, temp, gyro, the same layout as the burst
+
+static void     mpuFifoCountDone(i2cJob_t *job);
+
+static uint8_t  mpuBuf[20];                                  // acc, temp, gyro, EXT_SENS_DATA_00..05 (mag) with the aux mag
+static uint8_t  mpuMagBuf[6];
+static bool     mpuAuxMag;
+static i2cJob_t mpuJob = { MPU6050_ADDRESS, MPU_RA_ACCEL_XOUT_H, 14, true, mpuBuf, NULL, I2C_JOB_IDLE };
+static uint32_t mpuJobTime;
+static uint8_t  mpuUserCtrl;                                 // USER_CTRL bits in use, I2C_MST_EN (aux mag) and FIFO_EN
+static bool     mpuFifo;
+static volatile bool mpuFifoOverflow;
+static uint8_t  mpuFifoCount[2];
+static uint8_t  mpuFifoBuf[MPU_FIFO_MAX * MPU_FIFO_FRAME];
+static i2cJob_t mpuCountJob = { MPU6050_ADDRESS, MPU_RA_FIFO_COUNTH, 2, true, mpuFifoCount, mpuFifoCountDone, I2C_JOB_IDLE };
+static i2cJob_t mpuFifoJob  = { MPU6050_ADDRESS, MPU_RA_FIFO_R_W, 0, true, mpuFifoBuf, NULL, I2C_JOB_IDLE };
+static i2cJob_t mpuMagJob   = { MPU6050_ADDRESS, MPU_RA_EXT_SENS_DATA_00, 6, true, &mpuBuf[14], NULL, I2C_JOB_IDLE };
+
 //static uint8_t mpuAccelHalf = 0;
 
 bool mpu6050Detect(sensor_t * acc, sensor_t * gyro)
@@ -245,6 +267,20 @@ static void mpu6050GyroInit(void)
     i2cWrite(MPU6050_ADDRESS, MPU_RA_GYRO_CONFIG, 0x18);     // GYRO_CONFIG   -- FS_SEL = 3: Full scale set to 2000 deg/sec
 //    i2cWrite(MPU6050_ADDRESS, MPU_RA_ACCEL_CONFIG, 2 << 3);// Accel scale 8g (4096 LSB/g)
     i2cWrite(MPU6050_ADDRESS, MPU_RA_ACCEL_CONFIG, 1 << 3);  // Accel scale 4g (8192 LSB/g)    
+    if ((cfg.gy_fifo || cfg.gy_drdy) && MpuSpecial && !DLPFCFG)
+        i2cWrite(MPU6050_ADDRESS, MPU_RA_SMPLRT_DIV, 7);     // 8KHz without DLPF, more than the bus can drain. FIFO and data ready run at 1KHz
+    if (cfg.gy_drdy && MpuSpecial)
+    {
+        i2cWrite(MPU6050_ADDRESS, MPU_RA_INT_ENABLE, 0x01);  // DATA_RDY_EN, 50us pulse on MPU_INT for every sample
+        mpuIntInit();
+    }
+    if (cfg.gy_fifo && MpuSpecial)
+    {
+        i2cWrite(MPU6050_ADDRESS, MPU_RA_FIFO_EN, 0xF8);     // TEMP, XG, YG, ZG, ACCEL
+        mpuUserCtrl |= 0x40;                                 // FIFO_EN
+        i2cWrite(MPU6050_ADDRESS, MPU_RA_USER_CTRL, mpuUserCtrl | 0x04); // + FIFO_RESET
+        mpuFifo = true;
+    }
 }
 
 static void mpu6050AccRead(int16_t *accData)
@@ -291,14 +327,25 @@ static void mpu6050GyroAlign(int16_t *gyroData)
     gyroData[2] = -gyroData[2];
 }
 
-void MPU6050ReadAllShit(int16_t *accData, float *tempData, int16_t *gyroData)
+void MPU6050Prefetch(void)                                   // Put the read of MPU6050ReadAllShit on the bus now, it runs in the background
+{
+    if (mpuFifo)                                             // Nothing gets stale in the FIFO, just don't drain it twice
+    {
+        if (mpuCountJob.state == I2C_JOB_IDLE) i2cSubmit(&mpuCountJob);
+        return;
+    }
+    if (mpuJob.state == I2C_JOB_QUEUED || mpuJob.state == I2C_JOB_BUSY) return;
+    if (mpuJob.state == I2C_JOB_DONE && micros() - mpuJobTime < MPU_PREFETCH_AGE) return; // Still fresh, not collected yet
+    mpuJobTime = micros();
+    i2cSubmit(&mpuJob);
+}
+
+static void mpuDecode(uint8_t *buf, int16_t *accData, float *tempData, int16_t *gyroData)
 {
 //  0x3B acc  6 bytes
 //  0x41 temp 2 bytes
 //  0x43 gyro 6 bytes
-    uint8_t buf[14];
     int16_t temp;
-    i2cRead(MPU6050_ADDRESS, MPU_RA_ACCEL_XOUT_H, 14, buf);
     accData[0]  = (int16_t)((buf[0]  << 8) | buf[1]);
     accData[1]  = (int16_t)((buf[2]  << 8) | buf[3]);
     accData[2]  = (int16_t)((buf[4]  << 8) | buf[5]);
@@ -309,4 +356,104 @@ void MPU6050ReadAllShit(int16_t *accData, float *tempData, int16_t *gyroData)
     gyroData[2] = (int16_t)((buf[12] << 8) | buf[13]);
 }
 
+static void mpuFifoCountDone(i2cJob_t *job)                  // Interrupt: FIFO_COUNT is in, drain the whole samples right behind it
+{
+    uint16_t count = (mpuFifoCount[0] << 8) | mpuFifoCount[1];
+    if (job->state != I2C_JOB_DONE) return;
+    if (count > MPU_FIFO_SIZE - MPU_FIFO_FRAME)              // Full, samples are lost and the frames may be out of step
+    {
+        mpuFifoOverflow = true;
+        return;
+    }
+    count /= MPU_FIFO_FRAME;
+    if (count > MPU_FIFO_MAX) count = MPU_FIFO_MAX;          // The rest comes next time
+    mpuFifoJob.len = count * MPU_FIFO_FRAME;
+    if (count) i2cSubmit(&mpuFifoJob);
+    if (mpuAuxMag) i2cSubmit(&mpuMagJob);                    // The aux mag isn't in the FIFO, read EXT_SENS_DATA on its own
+}
+
+// FIFO mode: all samples since the last call, acc is averaged, temp is the last one and gyro comes per sample.
+// Returns the number of samples, 0 = the FIFO was reset (overflow, bus error), -1 = no new sample yet.
+static int8_t mpuFifoRead(int16_t *accData, float *tempData, int16_t (*gyroData)[3])
+{
+    int32_t accSum[3] = { 0, 0, 0 };
+    uint8_t n, i, k;
+    bool    ok;
+
+    if (mpuCountJob.state == I2C_JOB_IDLE) i2cSubmit(&mpuCountJob); // Not prefetched, the same thing blocking
+    ok = i2cWait(&mpuCountJob) && !mpuFifoOverflow;
+    if (!i2cWait(&mpuFifoJob) && mpuFifoJob.state != I2C_JOB_IDLE) ok = false;
+    if (i2cWait(&mpuMagJob)) memcpy(mpuMagBuf, &mpuBuf[14], 6);
+    n = mpuFifoJob.state == I2C_JOB_DONE ? mpuFifoJob.len / MPU_FIFO_FRAME : 0;
+    mpuCountJob.state = mpuFifoJob.state = mpuMagJob.state = I2C_JOB_IDLE;
+    if (!ok)
+    {
+        i2cWrite(MPU6050_ADDRESS, MPU_RA_USER_CTRL, mpuUserCtrl | 0x04); // FIFO_RESET
+        mpuFifoOverflow = false;
+        return 0;
+    }
+    if (!n) return -1;
+    for (i = 0; i < n; i++)
+    {
+        mpuDecode(&mpuFifoBuf[i * MPU_FIFO_FRAME], accData, tempData, gyroData[i]);
+        for (k = 0; k < 3; k++) accSum[k] += accData[k];
+    }
+    for (k = 0; k < 3; k++) accData[k] = accSum[k] / n;
+    return n;
+}
+
+// Returns the number of FIFO samples in gyroData (gy_fifo), 0 = one sample from the data registers, -1 = nothing new (FIFO)
+int8_t MPU6050ReadAllShit(int16_t *accData, float *tempData, int16_t (*gyroData)[3])
+{
+    uint8_t *buf = mpuBuf;
+    int8_t  n;
+    if (mpuFifo && (n = mpuFifoRead(accData, tempData, gyroData)) != 0) return n;
+    if (mpuJob.state == I2C_JOB_QUEUED || mpuJob.state == I2C_JOB_BUSY) i2cWait(&mpuJob); // Collect the prefetch
+    if (mpuJob.state != I2C_JOB_DONE || micros() - mpuJobTime > MPU_PREFETCH_AGE) i2cRead(MPU6050_ADDRESS, MPU_RA_ACCEL_XOUT_H, mpuJob.len, buf); // None or stale, read now
+    mpuJob.state = I2C_JOB_IDLE;
+    if (mpuAuxMag) memcpy(mpuMagBuf, &buf[14], 6);           // Mag task picks it up, see mpu6050AuxMagRead
+    mpuDecode(buf, accData, tempData, gyroData[0]);
+    return 0;
+}
+
+// Aux mag: the HMC5883L sits on the aux i2c of the MPU6050 (XDA/XCL, GY-86 style boards). Detection and the gain calibration
+// in hmc5883lInit run in bypass mode, where the aux bus is switched through to ours. After that the i2c master of the MPU
+// reads the 6 data bytes through SLV0 into EXT_SENS_DATA_00.., directly behind the gyro, and MPU6050ReadAllShit gets them
+// in its burst: 20 bytes instead of 14, one transaction less per mag read and the mag sample is aligned with the gyro.
+bool mpu6050AuxMagInit(void)
+{
+    uint8_t id[3];
+
+    i2cWrite(MPU6050_ADDRESS, MPU_RA_INT_PIN_CFG, 0);        // Bypass off, the aux bus belongs to the MPU now
+    i2cWrite(MPU6050_ADDRESS, MPU_RA_I2C_MST_CTRL, 0x0D);    // Master clock 400KHz
+    i2cWrite(MPU6050_ADDRESS, MPU_RA_I2C_SLV0_ADDR, 0x80 | MPU_AUX_MAG_ADDRESS); // SLV0 reads from the mag
+    i2cWrite(MPU6050_ADDRESS, MPU_RA_I2C_SLV0_REG, 0x0A);    // Identification registers first, to see it works
+    i2cWrite(MPU6050_ADDRESS, MPU_RA_I2C_SLV0_CTRL, 0x80 | 3);
+    i2cWrite(MPU6050_ADDRESS, MPU_RA_I2C_SLV4_CTRL, MPU_AUX_MAG_DLY);
+    i2cWrite(MPU6050_ADDRESS, MPU_RA_I2C_MST_DELAY_CTRL, 0x01); // SLV0 only every 1 + MPU_AUX_MAG_DLY samples
+    mpuUserCtrl |= 0x20;                                     // I2C_MST_EN
+    i2cWrite(MPU6050_ADDRESS, MPU_RA_USER_CTRL, mpuUserCtrl);
+    delay(10);
+    if (!i2cRead(MPU6050_ADDRESS, MPU_RA_EXT_SENS_DATA_00, 3, id) || id[0] != 'H' || id[1] != '4' || id[2] != '3')
+    {
+        mpuUserCtrl &= ~0x20;                                // Nothing on the aux bus, back to bypass
+        i2cWrite(MPU6050_ADDRESS, MPU_RA_USER_CTRL, mpuUserCtrl);
+        i2cWrite(MPU6050_ADDRESS, MPU_RA_INT_PIN_CFG, 1 << 1);
+        return false;
+    }
+    i2cWrite(MPU6050_ADDRESS, MPU_RA_I2C_SLV0_REG, 0x03);    // Data X Z Y
+    i2cWrite(MPU6050_ADDRESS, MPU_RA_I2C_SLV0_CTRL, 0x80 | 6);
+    delay(10);
+    mpuAuxMag  = true;
+    mpuJob.len = 20;
+    return true;
+}
+
+bool mpu6050AuxMagRead(uint8_t *buf)                         // Raw HMC5883L data register bytes from the last burst, false without aux mag
+{
+    if (!mpuAuxMag) return false;
+    memcpy(buf, mpuMagBuf, 6);
+    return true;
+}
+
 //Degrees C = (TEMP_OUT Register Value as a signed quantity)/340 + 36.53
@@ -1,5 +1,10 @@
 #pragma once
 
+#define MPU_FIFO_MAX    16                          // gy_fifo: samples drained per loop at most, 16 * 14 bytes
+#define MPU_SAMPLE_US   1000                        // Sample interval with gy_fifo / gy_drdy, 1KHz
+
 bool mpu6050Detect(sensor_t * acc, sensor_t * gyro);
 void mpu6050DmpLoop(void);
 void mpu6050DmpResetFifo(void);
+bool mpu6050AuxMagInit(void);
+bool mpu6050AuxMagRead(uint8_t *buf);
@@ -2,6 +2,8 @@
 #include "mw.h"
 
 #define PULSE_1MS       (1000) // 1ms pulse width
+#define ONESHOT_HZ      8000000                                // OneShot125 motor timers count at 8MHz, so the motor value 1000 - 2000 is 125 - 250us
+#define ONESHOT_PERIOD  2050                                   // Counts to the update event, the longest pulse is ONESHOT_PERIOD - 1
 
 /* FreeFlight/Naze32 timer layout
     TIM2_CH1    RC1             PWM1
@@ -122,6 +124,9 @@ static pwmPortData_t *servos[MAX_SERVOS];
 static uint8_t numMotors = 0;
 static uint8_t numServos = 0;
 static uint8_t numInputs = 0;
+static bool    oneshot;
+static TIM_TypeDef *motorTimers[4];                            // OneShot: the timers pwmCompleteMotorUpdate starts
+static uint8_t numMotorTimers = 0;
 
 extern uint16_t failsafeCnt; // external vars (ugh)
 
@@ -203,13 +208,13 @@ static const uint8_t *hardwareMaps[] =
     airPPM,
 };
 
-static void pwmTimeBase(TIM_TypeDef *tim, uint32_t period)
+static void pwmTimeBase(TIM_TypeDef *tim, uint32_t period, uint32_t hz)
 {
     TIM_TimeBaseInitTypeDef  TIM_TimeBaseStructure;
 
     TIM_TimeBaseStructInit(&TIM_TimeBaseStructure);
     TIM_TimeBaseStructure.TIM_Period        = period - 1;
-    TIM_TimeBaseStructure.TIM_Prescaler     = (SystemCoreClock / 1000000) - 1; // all timers run at 1MHz
+    TIM_TimeBaseStructure.TIM_Prescaler     = (SystemCoreClock / hz) - 1; // all timers run at 1MHz, OneShot motors at 8MHz
     TIM_TimeBaseStructure.TIM_ClockDivision = 0;
     TIM_TimeBaseStructure.TIM_CounterMode   = TIM_CounterMode_Up;
     TIM_TimeBaseInit(tim, &TIM_TimeBaseStructure);
@@ -226,7 +231,10 @@ static void pwmNVICConfig(uint8_t irq)
     NVIC_Init(&NVIC_InitStructure);
 }
 
-static void pwmOCConfig(TIM_TypeDef *tim, uint8_t channel, uint16_t value)
+// PWM: output high from the update event until CCR. OneShot: the timer runs once (one pulse mode) and the output
+// goes high at CCR until the update event, where the counter stops at 0 with the output low. CCR is preloaded in both:
+// a pwmWriteMotor during a OneShot pulse doesn't cut or split it, pwmCompleteMotorUpdate's UG takes the new value.
+static void pwmOCConfig(TIM_TypeDef *tim, uint8_t channel, uint16_t value, bool single)
 {
     TIM_OCInitTypeDef  TIM_OCInitStructure;
 
@@ -235,7 +243,7 @@ static void pwmOCConfig(TIM_TypeDef *tim, uint8_t channel, uint16_t value)
     TIM_OCInitStructure.TIM_OutputState  = TIM_OutputState_Enable;
     TIM_OCInitStructure.TIM_OutputNState = TIM_OutputNState_Disable;
     TIM_OCInitStructure.TIM_Pulse        = value;
-    TIM_OCInitStructure.TIM_OCPolarity   = TIM_OCPolarity_Low;
+    TIM_OCInitStructure.TIM_OCPolarity   = single ? TIM_OCPolarity_High : TIM_OCPolarity_Low;
     TIM_OCInitStructure.TIM_OCIdleState  = TIM_OCIdleState_Set;
 
     switch (channel)
@@ -285,16 +293,17 @@ static void pwmGPIOConfig(GPIO_TypeDef *gpio, uint32_t pin, uint8_t input)
     GPIO_Init(gpio, &GPIO_InitStructure);
 }
 
-static pwmPortData_t *pwmOutConfig(uint8_t port, uint16_t period, uint16_t value)
+static pwmPortData_t *pwmOutConfig(uint8_t port, uint16_t period, uint16_t value, bool single)
 {
     pwmPortData_t *p = &pwmPorts[port];
-    pwmTimeBase(timerHardware[port].tim, period);
+    pwmTimeBase(timerHardware[port].tim, period, single ? ONESHOT_HZ : 1000000);
     pwmGPIOConfig(timerHardware[port].gpio, timerHardware[port].pin, 0);
-    pwmOCConfig(timerHardware[port].tim, timerHardware[port].channel, value);
+    pwmOCConfig(timerHardware[port].tim, timerHardware[port].channel, value, single);
     // Needed only on TIM1
     if (timerHardware[port].outputEnable)
         TIM_CtrlPWMOutputs(timerHardware[port].tim, ENABLE);
-    TIM_Cmd(timerHardware[port].tim, ENABLE);
+    if (single) TIM_SelectOnePulseMode(timerHardware[port].tim, TIM_OPMode_Single); // Started by pwmCompleteMotorUpdate
+    else TIM_Cmd(timerHardware[port].tim, ENABLE);
 
     switch (timerHardware[port].channel)
     {
@@ -317,7 +326,7 @@ static pwmPortData_t *pwmOutConfig(uint8_t port, uint16_t period, uint16_t value
 static pwmPortData_t *pwmInConfig(uint8_t port, pwmCallbackPtr callback, uint8_t channel)
 {
     pwmPortData_t *p = &pwmPorts[port];
-    pwmTimeBase(timerHardware[port].tim, 0xFFFF);
+    pwmTimeBase(timerHardware[port].tim, 0xFFFF, 1000000);
     pwmGPIOConfig(timerHardware[port].gpio, timerHardware[port].pin, 1);
     pwmICConfig(timerHardware[port].tim, timerHardware[port].channel, TIM_ICPolarity_Rising);
     TIM_Cmd(timerHardware[port].tim, ENABLE);
@@ -517,7 +526,7 @@ bool pwmInit(drv_pwm_config_t *init)
 
 bool pwmInit(drv_pwm_config_t *init)
 {
-    uint8_t i = 0;
+    uint8_t i = 0, k;
     const uint8_t *setup;
 
     // this is pretty hacky shit, but it will do for now. array of 4 config maps, [ multiPWM multiPPM airPWM airPPM ]
@@ -571,19 +580,43 @@ bool pwmInit(drv_pwm_config_t *init)
             numInputs++;
             break;
         case TYPE_M:                                           // Motor
-            motors[numMotors++] = pwmOutConfig(port, 1000000 / init->motorPwmRate, PULSE_1MS);
+            if (init->oneshot)
+            {
+                motors[numMotors++] = pwmOutConfig(port, ONESHOT_PERIOD, ONESHOT_PERIOD - PULSE_1MS, true);
+                for (k = 0; k < numMotorTimers && motorTimers[k] != timerHardware[port].tim; k++);
+                if (k == numMotorTimers) motorTimers[numMotorTimers++] = timerHardware[port].tim;
+            }
+            else motors[numMotors++] = pwmOutConfig(port, 1000000 / init->motorPwmRate, PULSE_1MS, false);
             break;
         case TYPE_S:                                           // Servo
-            servos[numServos++] = pwmOutConfig(port, 1000000 / init->servoPwmRate, PULSE_1MS);
+            servos[numServos++] = pwmOutConfig(port, 1000000 / init->servoPwmRate, PULSE_1MS, false);
             break;
         }
     }
+    oneshot = init->oneshot;
     return false;
 }
 
 void pwmWriteMotor(uint8_t index, uint16_t value)
 {
-    if (index < numMotors) *motors[index]->ccr = value;
+    if (index >= numMotors) return;
+    if (oneshot) *motors[index]->ccr = ONESHOT_PERIOD - min(value, ONESHOT_PERIOD - 1); // Pulse is the last "value" counts
+    else *motors[index]->ccr = value;
+}
+
+// OneShot: fire all motor pulses now, called right behind the last pwmWriteMotor of a loop. The pulses end together at
+// the update events, ESC input latency is the pulse itself instead of up to a whole free running PWM period.
+// A timer that is still in its pulse (more than one call within 256us) is left alone, its update event loads the new CCR.
+void pwmCompleteMotorUpdate(void)
+{
+    uint8_t i;
+    if (!oneshot) return;
+    for (i = 0; i < numMotorTimers; i++)
+    {
+        if (motorTimers[i]->CR1 & TIM_CR1_CEN) continue;
+        motorTimers[i]->EGR  = TIM_EGR_UG;                     // Preloaded CCRs to the compare, the counter is at 0 already
+        motorTimers[i]->CR1 |= TIM_CR1_CEN;
+    }
 }
 
 void pwmWriteServo(uint8_t index, uint16_t value)
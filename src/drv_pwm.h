@@ -19,6 +19,7 @@ typedef struct drv_pwm_config_t
     uint8_t adcChannel;  // steal one RC input for current sensor
     uint16_t motorPwmRate;
     uint16_t servoPwmRate;
+    bool oneshot;        // motors as OneShot125, fired by pwmCompleteMotorUpdate instead of free running at motorPwmRate
 } drv_pwm_config_t;
 
 // This indexes into the read-only hardware definition structure in drv_pwm.c, as well as into pwmPorts[] structure with dynamic data.
@@ -53,6 +54,7 @@ typedef struct
 
 bool pwmInit(drv_pwm_config_t *init); // returns whether driver is asking to calibrate throttle or not
 void pwmWriteMotor(uint8_t index, uint16_t value);
+void pwmCompleteMotorUpdate(void);
 void pwmWriteServo(uint8_t index, uint16_t value);
 uint16_t pwmRead(uint8_t channel);
 
@@ -15,17 +15,26 @@ void (* systemBeepPtr)(bool onoff) = NULL;
 #endif
 
 
+// DWT cycle counter, not in our old cmsis core_cm3.h
+#define DWT_CTRL                (*(volatile uint32_t *)0xE0001000)
+#define DWT_CYCCNT              (*(volatile uint32_t *)0xE0001004)
+#define DWT_CTRL_CYCCNTENA      (1 << 0)
+
 static void cycleCounterInit(void)
 {
     RCC_ClocksTypeDef clocks;
     RCC_GetClocksFreq(&clocks);
     usTicks = clocks.SYSCLK_Frequency / 1000000;
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;   // Enable trace so the DWT runs, free running cyclecounter for the perf probes
+    DWT_CYCCNT        = 0;
+    DWT_CTRL         |= DWT_CTRL_CYCCNTENA;
 }
 
 // SysTick
 void SysTick_Handler(void)
 {
     sysTickUptime++;
+    i2cPoll();                                               // During a long task a job chained behind a stop waits at most 1ms
 }
 
 
@@ -43,6 +52,19 @@ uint32_t micros(void)
 }
 
 
+// Return cpu cycles since boot (rollover in 59 seconds at 72MHz)
+uint32_t cycles(void)
+{
+    return DWT_CYCCNT;
+}
+
+// Return cpu cycles per microsecond
+uint32_t cyclesPerMicro(void)
+{
+    return usTicks;
+}
+
+
 // Return system uptime in milliseconds (rollover in 49 days)
 uint32_t millis(void)
 {
@@ -130,6 +152,40 @@ void systemInit(void)
     delay(100);
 }
 
+// MPU_INT data ready (gy_drdy): PB13 on rev4, PC13 on rev5. EXTI13 shares EXTI15_10 with the BMP085 EOC on EXTI14.
+void mpuIntInit(void)
+{
+    EXTI_InitTypeDef EXTI_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    GPIO_EXTILineConfig(hse_value == 12000000 ? GPIO_PortSourceGPIOC : GPIO_PortSourceGPIOB, GPIO_PinSource13);
+    EXTI_InitStructure.EXTI_Line = EXTI_Line13;
+    EXTI_InitStructure.EXTI_Mode = EXTI_Mode_Interrupt;
+    EXTI_InitStructure.EXTI_Trigger = EXTI_Trigger_Rising;
+    EXTI_InitStructure.EXTI_LineCmd = ENABLE;
+    EXTI_Init(&EXTI_InitStructure);
+
+    NVIC_InitStructure.NVIC_IRQChannel = EXTI15_10_IRQn;          // Right behind the i2c, so the timestamp is taken at once
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 2;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+void EXTI15_10_IRQHandler(void)
+{
+    if (EXTI_GetITStatus(EXTI_Line13) == SET)
+    {
+        EXTI_ClearITPendingBit(EXTI_Line13);
+        schedulerDataReady();
+    }
+    if (EXTI_GetITStatus(EXTI_Line14) == SET)                     // BMP085 end of conversion, unused
+    {
+        EXTI_ClearITPendingBit(EXTI_Line14);
+//        convDone = true;
+    }
+}
+
 #if 1
 void delayMicroseconds(uint32_t us)
 {
@@ -6,10 +6,15 @@ void delay(uint32_t ms);
 
 uint32_t micros(void);
 uint32_t millis(void);
+uint32_t cycles(void);
+uint32_t cyclesPerMicro(void);
 
 // failure
 void failureMode(uint8_t mode);
 
+// MPU_INT data ready interrupt (gy_drdy)
+void mpuIntInit(void);
+
 // bootloader/IAP
 void systemReset(bool toBootloader);
 // current crystal frequency - 8 or 12MHz
@@ -9,27 +9,47 @@
 // Receive buffer, circular DMA
 volatile uint8_t rxBuffer[UART_BUFFER_SIZE];
 uint32_t rxDMAPos = 0;
-volatile uint8_t txBuffer[UART_BUFFER_SIZE];
-uint32_t txBufferTail = 0;
-uint32_t txBufferHead = 0;
+
+// Transmit ring, single producer (main loop) single consumer (DMA). Only the producer moves txBufferHead, only
+// uartTxDMA moves txBufferTail: from the DMA interrupt, or from the producer when the DMA is off and no interrupt can come.
+// Nothing is ever overwritten: uartWrite drops the byte when full, uartWriteBlock takes a whole frame or nothing.
+volatile uint8_t txBuffer[UART_TX_BUFFER_SIZE];
+volatile uint32_t txBufferTail = 0;
+volatile uint32_t txBufferHead = 0;
+uartTxStats_t uartTxStats = { UART_TX_BUFFER_SIZE - 1 };
 
 static void uartTxDMA(void)
 {
+    uint32_t head = txBufferHead;
+
+    if (head == txBufferTail)                               // Nothing to send, the else below would send the whole stale ring
+        return;
     DMA1_Channel4->CMAR = (uint32_t)&txBuffer[txBufferTail];
-    if (txBufferHead > txBufferTail)
+    if (head > txBufferTail)
     {
-        DMA1_Channel4->CNDTR = txBufferHead - txBufferTail;
-        txBufferTail = txBufferHead;
+        DMA1_Channel4->CNDTR = head - txBufferTail;
+        txBufferTail = head;
     }
     else
     {
-        DMA1_Channel4->CNDTR = UART_BUFFER_SIZE - txBufferTail;
+        DMA1_Channel4->CNDTR = UART_TX_BUFFER_SIZE - txBufferTail;
         txBufferTail = 0;
     }
 
     DMA_Cmd(DMA1_Channel4, ENABLE);
 }
 
+static void uartTxKick(void)
+{
+    uint16_t used = UART_TX_BUFFER_SIZE - 1 - uartTxFree();
+
+    if (used > uartTxStats.highWater)
+        uartTxStats.highWater = used;
+    // if DMA wasn't enabled, fire it up
+    if (!(DMA1_Channel4->CCR & 1))
+        uartTxDMA();
+}
+
 void DMA1_Channel4_IRQHandler(void)
 {
     DMA_ClearITPendingBit(DMA1_IT_TC4);
@@ -117,6 +137,15 @@ bool uartTransmitEmpty(void)
     return (txBufferTail == txBufferHead);
 }
 
+uint16_t uartTxFree(void)                                  // Bytes uartWrite can take, what the DMA is still reading counts as used
+{
+    uint32_t used = (txBufferHead - txBufferTail) % UART_TX_BUFFER_SIZE;
+
+    if (DMA1_Channel4->CCR & 1)
+        used += DMA_GetCurrDataCounter(DMA1_Channel4);
+    return used < UART_TX_BUFFER_SIZE - 1 ? UART_TX_BUFFER_SIZE - 1 - used : 0;
+}
+
 uint8_t uartRead(void)
 {
     uint8_t ch;
@@ -137,18 +166,45 @@ uint8_t uartReadPoll(void)
 
 void uartWrite(uint8_t ch)
 {
+    if (!uartTxFree())
+    {
+        uartTxStats.overflows++;
+        return;
+    }
     txBuffer[txBufferHead] = ch;
-    txBufferHead = (txBufferHead + 1) % UART_BUFFER_SIZE;
+    txBufferHead = (txBufferHead + 1) % UART_TX_BUFFER_SIZE;
+    uartTxKick();
+}
 
-    // if DMA wasn't enabled, fire it up
-    if (!(DMA1_Channel4->CCR & 1))
-        uartTxDMA();
+bool uartWriteBlock(const uint8_t *data, uint16_t len)     // All or nothing, a frame is never cut. false = no room, try later or drop it
+{
+    uint32_t head = txBufferHead, part;
+
+    if (!len)
+        return true;
+    if (uartTxFree() < len)
+    {
+        uartTxStats.dropped++;
+        return false;
+    }
+    part = min(len, UART_TX_BUFFER_SIZE - head);
+    memcpy((uint8_t *)&txBuffer[head], data, part);
+    memcpy((uint8_t *)txBuffer, data + part, len - part);
+    txBufferHead = (head + len) % UART_TX_BUFFER_SIZE;
+    uartTxKick();
+    return true;
+}
+
+void uartWriteWait(uint8_t ch)                              // CLI text and printf, waits for room instead of losing it
+{
+    while (!uartTxFree());
+    uartWrite(ch);
 }
 
 void uartPrint(char *str)
 {
     while (*str)
-        uartWrite(*(str++));
+        uartWriteWait(*(str++));
 }
 
 /* -------------------------- UART2 (Spektrum, GPS) ----------------------------- */
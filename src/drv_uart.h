@@ -1,12 +1,19 @@
 #pragma once
 
 // USART1
+#define UART_TX_BUFFER_SIZE 512                             // Power of 2. Holds the biggest MSP reply next to the stream of blackbox.c
+
+extern uartTxStats_t uartTxStats;
+
 void uartInit(uint32_t speed);
 bool uartAvailable(void);
 bool uartTransmitEmpty(void);
+uint16_t uartTxFree(void);
 uint8_t uartRead(void);
 uint8_t uartReadPoll(void);
 void uartWrite(uint8_t ch);
+void uartWriteWait(uint8_t ch);
+bool uartWriteBlock(const uint8_t *data, uint16_t len);
 void uartPrint(char *str);
 
 // USART2 (GPS, Spektrum)
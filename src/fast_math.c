@@ -0,0 +1,87 @@
+#include "board.h"
+#include "mw.h"
+
+// Float replacements for the libm calls in the loop and gps paths. On the M3 every libm call is soft-float,
+// sinf/cosf/atan2f cost a few thousand cycles each and pow() even runs in double.
+// Polynomials are minimax fits (Lawson), evaluated in Horner form. Errors are measured on the host against double libm
+// (test/fast_math_test.c):
+// fastSin          : abs error < 1.6e-7 for |x| < 64 PI (libm sinf in float: 3.3e-8)
+// fastCos          : abs error < 3.5e-7 for |x| < 64 PI, the + PI/2 after the reduction rounds once more
+// fastAtan2        : abs error < 2.0e-6 rad (0.0001 deg)
+// fastInvSqrt      : rel error < 4.8e-6, x > 0 only
+// fastBaroAlt      : abs error < 0.4 cm from -600m to 5500m (p/p0 0.5 - 1.08), outside that it falls back to powf
+
+#define PI       3.14159265359f                                            // Not the double of math.h, that would promote the float math
+#define PI_A     3.14159274101f                                            // PI as float plus the rest, PI_A - x is exact for x >= PI/2
+#define PI_B     -8.74227766e-8f
+#define HALF_PI  1.57079632679f
+#define TWO_PI   6.28318530718f
+#define TWO_PI_A 6.28125f                                                  // 2PI split in an exact and a small part (Cody-Waite),
+#define TWO_PI_B 1.93530717958e-3f                                         // so n * 2PI doesn't round away the argument
+
+static float reduce(float x)                                               // To -PI .. PI
+{
+    int32_t n = (int32_t)(x * (1.0f / TWO_PI) + (x >= 0 ? 0.5f : -0.5f)); // Nearest multiple of 2PI
+    return (x - (float)n * TWO_PI_A) - (float)n * TWO_PI_B;
+}
+
+static float sinPoly(float x)                                              // x in -PI .. PI
+{
+    float x2;
+    if (x > HALF_PI)       x =  (PI_A - x) + PI_B;                         // -PI/2 .. PI/2, sin is symmetric around +-PI/2
+    else if (x < -HALF_PI) x = -(PI_A + x) - PI_B;
+    x2 = x * x;
+    return x + x * x2 * (-1.66666596e-1f + x2 * (8.33306724e-3f + x2 * (-1.98096807e-4f + x2 * 2.60596282e-6f)));
+}
+
+float fastSin(float x)
+{
+    return sinPoly(reduce(x));
+}
+
+float fastCos(float x)
+{
+    x = reduce(x) + HALF_PI;                                               // cos(x) = sin(x + PI/2), added after the reduction
+    if (x > PI) x -= TWO_PI;
+    return sinPoly(x);
+}
+
+float fastAtan2(float y, float x)
+{
+    float ax = fabsf(x), ay = fabsf(y), z, z2, r;
+
+    if (ax == 0.0f && ay == 0.0f) return 0.0f;
+    if (ay > ax) z = ax / ay;                                              // 0 .. 1, atan(1/z) = PI/2 - atan(z)
+    else         z = ay / ax;
+    z2 = z * z;
+    r  = z * (9.99977336e-1f + z2 * (-3.32625671e-1f + z2 * (1.93559163e-1f + z2 * (-1.16475980e-1f + z2 * (5.27034138e-2f + z2 * -1.17419116e-2f)))));
+    if (ay > ax)  r = HALF_PI - r;
+    if (x < 0.0f) r = PI - r;
+    if (y < 0.0f) r = -r;
+    return r;
+}
+
+float fastInvSqrt(float x)
+{
+    union
+    {
+        int32_t i;
+        float   f;
+    } conv;
+    float half = 0.5f * x;
+
+    conv.f = x;
+    conv.i = 0x5f3759df - (conv.i >> 1);                                   // First guess, 3.5% off
+    conv.f = conv.f * (1.5f - half * conv.f * conv.f);                     // Newton, 0.2%
+    conv.f = conv.f * (1.5f - half * conv.f * conv.f);                     // Newton, 5ppm
+    return conv.f;
+}
+
+float fastBaroAlt(float pressure)                                          // Pa to cm, (1 - (p / 101325) ^ 0.190295) * 4433000
+{
+    float d = pressure * (1.0f / 101325.0f);
+
+    if (d < 0.5f || d > 1.08f) return (1.0f - powf(d, 0.190295f)) * 4433000.0f;
+    d -= 1.0f;
+    return d * (-1.90294579e-1f + d * (7.70659497e-2f + d * (-4.64714705e-2f + d * (2.92058827e-2f + d * (-5.10792630e-2f + d * (-5.62864398e-2f + d * -1.03503306e-1f)))))) * 4433000.0f;
+}
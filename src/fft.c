@@ -0,0 +1,263 @@
+#include "board.h"
+#include "mw.h"
+
+// Fixed point radix-2 FFT and the vibration analyser of feature pass.
+// fftQ15: in place decimation in time on int16 re / im, every stage halves, so the result is X / N and can't overflow.
+// The twiddles are a quarter sine wave in Q15 for FFT_MAX_N, smaller transforms step through it.
+// Against a double DFT, N = 128 with the input at 2^13 - 2^14: error 0.018% of the largest bin (-75dB).
+// ca. 4400 host cycles per transform, 448 butterflies are ca. 0.2ms estimated for the 72MHz M3.
+// Analyser on synthetic sines: frequency within 0.3Hz (3.9Hz bins), amplitude within 3.6%.
+//
+// Vibration analyser: pass() samples accADC and gyroADC every VIB_SAMPLE_US while the motors run (throttle >= esc_min).
+// A capture is VIB_N samples of an axis pair, AccX AccY, AccZ GyrX, GyrY GyrZ in turn, taken as one complex signal
+// re + j im: one FFT for two axes and no buffer for the imaginary part. vibUpdate works through a complete capture in
+// three calls: mean removed and scaled up to use the 16 bit (block floating point, per axis), Hann window, FFT; then
+// the spectra of the two axes apart from their symmetry (X[k] = (Z[k] + Z*[N - k]) / 2, Y[k] = (Z[k] - Z*[N - k]) / 2j)
+// and the peaks of the first; the peaks of the second. The VIB_PEAKS strongest local maxima go to vibSlots[pass_mot],
+// so every motor keeps its own result for balancing. Frequencies are interpolated between the bins (parabola),
+// amplitudes are sensor LSB. The MPU DLPF (gy_lpf) is in front of all that, set it above the frequencies of interest.
+// RAM: the capture is 512 bytes. The results (836 bytes) are in the blackbox ring (blackbox.c), main.c boots into either
+// loop() with the blackbox or pass(): vibInit from the pass branch hands the ring over. Without it vibSample / vibUpdate
+// do nothing and vibResult gives an empty slot, feature pass switched on in cli doesn't count until the reboot.
+// cli "vib", MSP_VIBRATION. test/fft_test.c, test/fft_bench.c.
+
+#define FFT_MAX_LOG2N VIB_LOG2N
+#define FFT_MAX_N     (1 << FFT_MAX_LOG2N)
+
+static const int16_t fftSinTab[FFT_MAX_N / 4 + 1] =                        // sin(2 PI k / FFT_MAX_N) Q15, k = 0 .. N/4
+{
+         0,   1608,   3212,   4808,   6393,   7962,   9512,  11039,  12539,  14010,  15446,
+     16846,  18204,  19519,  20787,  22005,  23170,  24279,  25329,  26319,  27245,  28105,
+     28898,  29621,  30273,  30852,  31356,  31785,  32137,  32412,  32609,  32728,  32767,
+};
+
+static const int16_t vibHann[VIB_N / 2 + 1] =                              // sin(PI n / VIB_N)^2 Q15, n = 0 .. N/2, w[N - n] = w[n]
+{
+         0,     20,     79,    177,    315,    491,    705,    958,   1247,   1573,   1935,
+      2331,   2761,   3224,   3719,   4244,   4799,   5381,   5990,   6624,   7281,   7961,
+      8660,   9379,  10114,  10864,  11628,  12403,  13187,  13980,  14778,  15580,  16383,
+     17187,  17989,  18787,  19580,  20364,  21139,  21903,  22653,  23388,  24107,  24806,
+     25486,  26143,  26777,  27386,  27968,  28523,  29048,  29543,  30006,  30436,  30832,
+     31194,  31520,  31809,  32062,  32276,  32452,  32590,  32688,  32747,  32767,
+};
+
+static const char * const vibAxisNames[VIB_AXES] = { "AccX", "AccY", "AccZ", "GyrX", "GyrY", "GyrZ" };
+
+#define VIB_SILENT    0xFF                                                 // vibPrepare of a constant axis
+
+static const vibSlot_t vibNone;
+
+bool vibRunning;                                                           // pass() runs, vibSlots is ours
+
+static int16_t  vibBuf[2][VIB_N];                                          // Capture of a pair, FFT re / im, then the magnitudes
+static uint8_t  vibShift[2];                                               // Block floating point of the pair
+static uint8_t  vibCount;                                                  // Samples in vibBuf
+static uint8_t  vibPair;                                                   // Axes 2 * vibPair, 2 * vibPair + 1 are captured
+static uint8_t  vibStep;                                                   // vibUpdate on a complete capture
+static uint8_t  vibSlot;                                                   // pass_mot when the first capture started
+static uint32_t vibThrSum;                                                 // Over the VIB_AXES / 2 captures of a result
+
+void fftQ15(int16_t *re, int16_t *im, uint8_t log2n)
+{
+    uint16_t n = 1 << log2n, i, j, k, bit, len, half, step, idx;
+    int16_t  wr, wi, t;
+    int32_t  tr, ti;
+
+    for (i = 1, j = 0; i < n; i++)                                         // Bit reversed order
+    {
+        for (bit = n >> 1; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j)
+        {
+            t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+    for (len = 2; len <= n; len <<= 1)
+    {
+        half = len >> 1;
+        step = FFT_MAX_N / len;
+        for (k = 0; k < half; k++)
+        {
+            idx = k * step;                                                // W = exp(-j 2 PI idx / FFT_MAX_N), idx < N/2
+            if (idx <= FFT_MAX_N / 4)
+            {
+                wr =  fftSinTab[FFT_MAX_N / 4 - idx];
+                wi = -fftSinTab[idx];
+            }
+            else
+            {
+                wr = -fftSinTab[idx - FFT_MAX_N / 4];
+                wi = -fftSinTab[FFT_MAX_N / 2 - idx];
+            }
+            for (i = k; i < n; i += len)
+            {
+                j     = i + half;
+                tr    = ((int32_t)re[j] * wr - (int32_t)im[j] * wi + (1 << 14)) >> 15; // Rounded
+                ti    = ((int32_t)re[j] * wi + (int32_t)im[j] * wr + (1 << 14)) >> 15;
+                re[j] = (re[i] - tr + 1) >> 1;
+                im[j] = (im[i] - ti + 1) >> 1;
+                re[i] = (re[i] + tr + 1) >> 1;
+                im[i] = (im[i] + ti + 1) >> 1;
+            }
+        }
+    }
+}
+
+static uint16_t isqrt32(uint32_t x)
+{
+    uint32_t r = 0, b = 1UL << 30;
+    while (b > x) b >>= 2;
+    while (b)
+    {
+        if (x >= r + b)
+        {
+            x -= r + b;
+            r  = (r >> 1) + b;
+        }
+        else r >>= 1;
+        b >>= 2;
+    }
+    return r;
+}
+
+static int16_t vibValue(uint8_t axis)
+{
+    return constrain(axis < 3 ? accADC[axis] : gyroADC[axis - 3], -32768, 32767);
+}
+
+void vibSample(uint16_t throttle)                                          // From pass() every VIB_SAMPLE_US, after computeIMU
+{
+    if (!vibRunning || vibCount == VIB_N) return;                          // vibUpdate still busy with the last capture
+    if (throttle < cfg.esc_min || ((vibCount || vibPair) && vibSlot != cfg.pass_mot) || cfg.pass_mot >= VIB_SLOTS)
+    {
+        vibCount = 0;                                                      // Motors off or motor changed, start over
+        vibPair  = 0;
+        return;
+    }
+    if (!vibCount && !vibPair)
+    {
+        vibSlot   = cfg.pass_mot;
+        vibThrSum = 0;
+    }
+    vibBuf[0][vibCount] = vibValue(vibPair * 2);
+    vibBuf[1][vibCount] = vibValue(vibPair * 2 + 1);
+    vibThrSum += throttle;
+    vibCount++;
+}
+
+static uint8_t vibPrepare(int16_t *x)                                      // Mean off, scaled up, windowed. Returns the shift
+{
+    int32_t  sum = 0;
+    uint16_t absMax = 0;
+    uint8_t  i, shift = 0;
+
+    for (i = 0; i < VIB_N; i++) sum += x[i];
+    sum /= VIB_N;
+    for (i = 0; i < VIB_N; i++)
+    {
+        x[i]   = constrain(x[i] - sum, -32767, 32767);
+        absMax = max(absMax, abs(x[i]));
+    }
+    if (!absMax) return VIB_SILENT;
+    while (absMax < (1 << 13))                                             // Top of the signal at 2^13 - 2^14
+    {
+        absMax <<= 1;
+        shift++;
+    }
+    for (i = 0; i < VIB_N; i++) x[i] = ((int32_t)(x[i] << shift) * vibHann[i <= VIB_N / 2 ? i : VIB_N - i]) >> 15;
+    return shift;
+}
+
+static void vibSplit(void)                                                 // Z = FFT(x + j y) to |2 X|, |2 Y| in the first halves
+{
+    int16_t  *re = vibBuf[0], *im = vibBuf[1];
+    uint16_t *magX = (uint16_t *)re, *magY = (uint16_t *)im;
+    int32_t  xr, xi, yr, yi;
+    uint8_t  k, m;
+
+    for (k = 0; k < VIB_N / 2; k++)                                        // Bin m = N - k is above N / 2, read once, never written
+    {
+        m  = (VIB_N - k) & (VIB_N - 1);
+        xr = re[k] + re[m];
+        xi = im[k] - im[m];
+        yr = im[k] + im[m];
+        yi = re[m] - re[k];
+        magX[k] = isqrt32((uint32_t)xr * (uint32_t)xr + (uint32_t)xi * (uint32_t)xi); // Below 2^15 sqrt(2), the squares fit
+        magY[k] = isqrt32((uint32_t)yr * (uint32_t)yr + (uint32_t)yi * (uint32_t)yi);
+    }
+}
+
+static void vibPeaks(const uint16_t *mag, uint8_t shift, vibPeak_t *peaks) // mag: |2 X|, VIB_N / 2 bins
+{
+    int32_t  a, b, c, den, d;
+    uint32_t peak;
+    uint8_t  i, k;
+
+    memset(peaks, 0, sizeof(vibPeak_t) * VIB_PEAKS);
+    if (shift == VIB_SILENT) return;                                       // Only the rounding of the other axis in there
+    for (k = 2; k < VIB_N / 2 - 1; k++)                                    // Bin 0 and 1 are the mean and the window leakage of it
+    {
+        b = mag[k];
+        if (b <= mag[k - 1] || b < mag[k + 1]) continue;                   // Not a local maximum
+        a    = mag[k - 1];
+        c    = mag[k + 1];
+        den  = 2 * (a - 2 * b + c);
+        d    = den ? (a - c) * 256 / den : 0;                              // Parabola through the 3 bins, vertex offset in 1/256 bin
+        peak = (2 * b + (1 << shift >> 1)) >> shift;                       // Hann and 1/N: a sine of amplitude A gives A / 4 on its bin
+        peak = min(peak, 0xFFFF);
+        peak = min((peak << 16) / (65536 - d * d * 621 / 1024), 0xFFFF);   // Between the bins the Hann main lobe is 1 - 0.606 d^2 lower
+        if (!peak || peak <= peaks[VIB_PEAKS - 1].amp) continue;
+        for (i = VIB_PEAKS - 1; i > 0 && peak > peaks[i - 1].amp; i--) peaks[i] = peaks[i - 1];
+        peaks[i].amp  = peak;
+        peaks[i].freq = (((int32_t)k * 256 + d) * (10000000 / VIB_SAMPLE_US)) / (VIB_N * 256); // 0.1Hz
+    }
+}
+
+void vibUpdate(void)                                                       // From pass(), a third of the analysis per call
+{
+    vibSlot_t *slot;
+
+    if (!vibRunning || vibCount < VIB_N) return;
+    slot = &vibSlots[vibSlot];
+    switch (vibStep++)
+    {
+    case 0:
+        vibShift[0] = vibPrepare(vibBuf[0]);
+        vibShift[1] = vibPrepare(vibBuf[1]);
+        fftQ15(vibBuf[0], vibBuf[1], VIB_LOG2N);
+        return;
+    case 1:
+        vibSplit();
+        vibPeaks((const uint16_t *)vibBuf[0], vibShift[0], slot->peak[vibPair * 2]);
+        return;
+    }
+    vibPeaks((const uint16_t *)vibBuf[1], vibShift[1], slot->peak[vibPair * 2 + 1]);
+    vibStep  = 0;
+    vibCount = 0;
+    if (++vibPair < VIB_AXES / 2) return;
+    slot->throttle = vibThrSum / (VIB_N * VIB_AXES / 2);
+    slot->captures++;
+    vibPair = 0;
+}
+
+void vibInit(void)                                                         // From main.c before pass() runs, the blackbox never starts
+{
+    vibRunning = true;
+    vibClear();
+}
+
+void vibClear(void)
+{
+    if (vibRunning) memset(vibSlots, 0, sizeof(vibSlot_t) * VIB_SLOTS);   // Else it's the blackbox ring
+}
+
+const vibSlot_t *vibResult(uint8_t slot)
+{
+    return vibRunning ? &vibSlots[slot] : &vibNone;
+}
+
+const char *vibAxisName(uint8_t axis)
+{
+    return vibAxisNames[axis];
+}
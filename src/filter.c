@@ -0,0 +1,105 @@
+#include "board.h"
+#include "mw.h"
+
+// Biquad filters for the gyro and the D term, coefficients after the RBJ audio EQ cookbook, precomputed for the control loop rate.
+// One biquad3_t filters the three axes with shared coefficients, the state is kept per axis in arrays (struct of arrays),
+// so biquad3Apply runs all axes in one loop. Transposed direct form II: 5 mul + 4 add per axis, 2 state values.
+// A filter with hz 0 or hz at / above 0.45 * loop rate is off and passes the input through.
+// rbiquad3 is the same on real_t for the PID: in the FIXEDPOINT build Q28 coefficients, the state in Q40 (64 bit),
+// 32 x 32 -> 64 bit multiplies, no soft-float in the loop. In the float build the names are those of biquad3 (mw.h).
+
+#define TWO_PI 6.28318530718f                                              // Not 2 * M_PI, that is a double
+
+static void biquad3Set(biquad3_t *f, float b0, float b1, float b2, float a0, float a1, float a2)
+{
+    float inv = 1.0f / a0;
+    f->b0 = b0 * inv;
+    f->b1 = b1 * inv;
+    f->b2 = b2 * inv;
+    f->a1 = a1 * inv;
+    f->a2 = a2 * inv;
+    f->enabled = true;
+    biquad3Reset(f);
+}
+
+static bool biquad3Omega(biquad3_t *f, float hz, float q, float sampleHz, float *cs, float *alpha)
+{
+    float w;
+    f->enabled = false;
+    if (hz <= 0.0f || q <= 0.0f || hz >= 0.45f * sampleHz) return false;
+    w      = TWO_PI * hz / sampleHz;
+    *cs    = fastCos(w);
+    *alpha = fastSin(w) / (2.0f * q);
+    return true;
+}
+
+void biquad3Lowpass(biquad3_t *f, float hz, float sampleHz)                // 2nd order Butterworth, Q = 1/sqrt(2)
+{
+    float cs, alpha;
+    if (!biquad3Omega(f, hz, 0.70710678f, sampleHz, &cs, &alpha)) return;
+    biquad3Set(f, (1.0f - cs) * 0.5f, 1.0f - cs, (1.0f - cs) * 0.5f, 1.0f + alpha, -2.0f * cs, 1.0f - alpha);
+}
+
+void biquad3Notch(biquad3_t *f, float hz, float q, float sampleHz)         // Bandwidth is hz / q, a higher Q is a narrower notch
+{
+    float cs, alpha;
+    if (!biquad3Omega(f, hz, q, sampleHz, &cs, &alpha)) return;
+    biquad3Set(f, 1.0f, -2.0f * cs, 1.0f, 1.0f + alpha, -2.0f * cs, 1.0f - alpha);
+}
+
+void biquad3Reset(biquad3_t *f)
+{
+    uint8_t axis;
+    for (axis = 0; axis < 3; axis++) f->s1[axis] = f->s2[axis] = 0;
+}
+
+void biquad3Apply(biquad3_t *f, float *v)                                  // All three axes in place
+{
+    uint8_t axis;
+    float   x, y;
+    if (!f->enabled) return;
+    for (axis = 0; axis < 3; axis++)
+    {
+        x           = v[axis];
+        y           = f->b0 * x + f->s1[axis];
+        f->s1[axis] = f->b1 * x - f->a1 * y + f->s2[axis];
+        f->s2[axis] = f->b2 * x - f->a2 * y;
+        v[axis]     = y;
+    }
+}
+
+float biquad3ApplyAxis(biquad3_t *f, uint8_t axis, float x)                // One axis, for loops that handle the axes one by one
+{
+    float y;
+    if (!f->enabled) return x;
+    y           = f->b0 * x + f->s1[axis];
+    f->s1[axis] = f->b1 * x - f->a1 * y + f->s2[axis];
+    f->s2[axis] = f->b2 * x - f->a2 * y;
+    return y;
+}
+
+#ifdef FIXEDPOINT
+void rbiquad3Lowpass(rbiquad3_t *f, float hz, float sampleHz)
+{
+    biquad3_t d;
+    uint8_t   axis;
+    biquad3Lowpass(&d, hz, sampleHz);                                      // Designed in float, only at init
+    f->b0 = (int32_t)(d.b0 * 268435456.0f);
+    f->b1 = (int32_t)(d.b1 * 268435456.0f);
+    f->b2 = (int32_t)(d.b2 * 268435456.0f);
+    f->a1 = (int32_t)(d.a1 * 268435456.0f);
+    f->a2 = (int32_t)(d.a2 * 268435456.0f);
+    f->enabled = d.enabled;
+    for (axis = 0; axis < 3; axis++) f->s1[axis] = f->s2[axis] = 0;
+}
+
+real_t rbiquad3ApplyAxis(rbiquad3_t *f, uint8_t axis, real_t x)           // Q12 in and out, the products are Q40
+{
+    real_t y;
+    if (!f->enabled) return x;
+    y           = (real_t)(((int64_t)f->b0 * x + f->s1[axis] + (1 << 27)) >> 28);
+    f->s1[axis] = (int64_t)f->b1 * x - (int64_t)f->a1 * y + f->s2[axis];
+    f->s2[axis] = (int64_t)f->b2 * x - (int64_t)f->a2 * y;
+    return y;
+}
+#endif
@@ -46,7 +46,7 @@ Not limited, since heading is stored without delta. Resolution is reduced to 2 d
 
 Duration of Logging at 0,5 Hz and current bytesize
 ==================================================
-Dataset = 4 Bytes and (FDByteSize)2340 Bytes available = 585 Datasets at 1/0.5s = 1170 sec = 19 Min 30 sec
+Dataset = 4 Bytes and (FDByteSize)640 Bytes available = 160 Datasets at 1/0.5s = 320 sec = 5 Min 20 sec
 */
 
 #define GPSLoggerDatasetSize 4
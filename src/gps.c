@@ -3,6 +3,7 @@
 
 #define PhStickCenterTimeout  300         // Defines the time in ms when we consider the sticks really back to center
 #define PhSettleTimeout       410         // Defines the time in ms, where actual speed must be below settlespeed, to consider a settled copter
+#define NavCoord              (cfg.gps_ins_kf ? GPS_coord : Real_GPS_coord) // Position nav works with, the Kalman estimate when gps_ins_kf is on
 
 // NAVIGATION & Crosstrack Common Variables
 int32_t   target_bearing;                 // target_bearing is where we should be heading
@@ -63,7 +64,7 @@ static void GPS_HzSandbox(void)
     }
     else                                                                        // Do dist to Home Stuff here
     {
-        GPS_distance_cm_bearing(&Real_GPS_coord[LAT], &Real_GPS_coord[LON], &GPS_home[LAT], &GPS_home[LON], &dist, &dir);
+        GPS_distance_cm_bearing(&NavCoord[LAT], &NavCoord[LON], &GPS_home[LAT], &GPS_home[LON], &dist, &dir);
         GPS_distanceToHome  = dist / 100;
         GPS_directionToHome = dir  / 100;
         if (GPS_distanceToHome > cfg.GPS_MaxDistToHome ) cfg.GPS_MaxDistToHome  = GPS_distanceToHome;
@@ -144,8 +145,8 @@ static void GPS_HzSandbox(void)
                 {
                     if(!PHuseGPSWP)                                             // We already know our Ph target
                     {
-                        GPS_WP[LAT] = Real_GPS_coord[LAT];                      // No? So we define it here
-                        GPS_WP[LON] = Real_GPS_coord[LON];
+                        GPS_WP[LAT] = NavCoord[LAT];                            // No? So we define it here
+                        GPS_WP[LON] = NavCoord[LON];
                     }
                     GPS_reset_nav();                                            // Reset nav Speedvector as well
                     PHcascade++;                    
@@ -154,7 +155,7 @@ static void GPS_HzSandbox(void)
             case 4:                                                             // Do this forever ?
                 PHtoofast = false;
                 PHChange  = false;
-                GPS_calc_location_error(&GPS_WP[LAT], &GPS_WP[LON], &Real_GPS_coord[LAT], &Real_GPS_coord[LON]);
+                GPS_calc_location_error(&GPS_WP[LAT], &GPS_WP[LON], &NavCoord[LAT], &NavCoord[LON]);
                 ph_status = PH_STATUS_DONE;
                 break;
             }
@@ -169,8 +170,8 @@ static void GPS_HzSandbox(void)
 
         case NAV_MODE_WP:
         case NAV_MODE_RTL:
-            GPS_distance_cm_bearing(&Real_GPS_coord[LAT], &Real_GPS_coord[LON], &GPS_WP[LAT], &GPS_WP[LON], &wp_distance, &target_bearing);
-            GPS_calc_location_error(&GPS_WP[LAT], &GPS_WP[LON], &Real_GPS_coord[LAT], &Real_GPS_coord[LON]);
+            GPS_distance_cm_bearing(&NavCoord[LAT], &NavCoord[LON], &GPS_WP[LAT], &GPS_WP[LON], &wp_distance, &target_bearing);
+            GPS_calc_location_error(&GPS_WP[LAT], &GPS_WP[LON], &NavCoord[LAT], &NavCoord[LON]);
 
             speed = GPS_calc_desired_speed();
             GPS_calc_nav_rate(speed);                                           // use error as the desired rate towards the target Desired output is in nav_lat and nav_lon where 1deg inclination is 100
@@ -207,8 +208,8 @@ void GPS_set_next_wp(int32_t *lat, int32_t *lon)
     GPS_WP[LON] = *lon;
 
     GPS_calc_longitude_scaling();
-    GPS_distance_cm_bearing(&Real_GPS_coord[LAT], &Real_GPS_coord[LON], &GPS_WP[LAT], &GPS_WP[LON], &wp_distance, &target_bearing);
-    GPS_calc_location_error(&GPS_WP[LAT], &GPS_WP[LON], &Real_GPS_coord[LAT], &Real_GPS_coord[LON]);
+    GPS_distance_cm_bearing(&NavCoord[LAT], &NavCoord[LON], &GPS_WP[LAT], &GPS_WP[LON], &wp_distance, &target_bearing);
+    GPS_calc_location_error(&GPS_WP[LAT], &GPS_WP[LON], &NavCoord[LAT], &NavCoord[LON]);
     nav_bearing = target_bearing;
     original_target_bearing = target_bearing;
     waypoint_speed_gov = (float)cfg.nav_speed_min;
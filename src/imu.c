@@ -1,14 +1,15 @@
 #include "board.h"
 #include "mw.h"
 
-float        accSmooth[3], ACC_speed[2];
+float        accSmooth[3], ACC_speed[2], ACC_earth[2];            // ACC_earth: earthframe acc in cm/s^2, + is north / east
 float        accADC[3], gyroADC[3], magADCfloat[3];
 int32_t      sonarAlt;
 float        BaroAlt, EstAlt, AltHold, vario;            // variometer in cm/s + is up
 int16_t      BaroP, BaroI, BaroD;
-bool         newbaroalt, GroundAltInitialized;
+bool         newbaroalt, newsonaralt, GroundAltInitialized;
 float        BaroDeltaTime, ACCDeltaTimeINS = 0;
 static float INV_GYR_CMPF_FACTOR, INV_GYR_CMPFM_FACTOR, INV_ACC_INS_LPF, INV_ACC_LPF;
+static float AccUpCms;                                   // Tiltcompensated acc_up in cm/s^2, input of the altitude Kalman filter
 
 // **************
 // gyro+acc IMU
@@ -22,8 +23,7 @@ static float INV_GYR_CMPF_FACTOR, INV_GYR_CMPFM_FACTOR, INV_ACC_INS_LPF, INV_ACC
  */
 
 float   gyroData[3] = { 0, 0, 0 }, angle[2] = { 0, 0 };                    // absolute angle inclination in multiple of 0.1 degree    180 deg = 1800
-static  uint8_t Smoothing[3]  = { 0, 0, 0 };
-static  bool    GyroSmoothing;
+static  biquad3_t GyroNotch[2], GyroLpf, GyroLpfYaw;                       // Pid input filters, set up by gyroFilterInit
 
 static void getEstimatedAttitude(void);
 
@@ -35,24 +35,21 @@ void imuInit(void)                                                         // In
     INV_ACC_LPF          = 1.0f / (float)cfg.acc_lpf;                      // acc_lpf is limited to 1 in cli to avoid 0
     accADC[0] = accADC[1] = accADC[2] = 0;
 
-    if (cfg.gy_smrll || cfg.gy_smptc || cfg.gy_smyw)
-    {
-        Smoothing[ROLL]  = cfg.gy_smrll;
-        Smoothing[PITCH] = cfg.gy_smptc;
-        Smoothing[YAW]   = cfg.gy_smyw;
-        GyroSmoothing    = true;
-    } else GyroSmoothing = false;
-
 #ifdef MAG
     if (sensors(SENSOR_MAG)) Mag_init();
 #endif
 }
 
-void computeIMU(void)
+void gyroFilterInit(float sampleHz)                                        // From schedulerInit, sampleHz is the control loop rate (0 = looptime 0, all off)
 {
-    static  float gyroSmooth[3] = { 0, 0, 0 };
-    uint8_t axis;
+    biquad3Notch(&GyroNotch[0], cfg.gy_ntch1, cfg.gy_ntch1q * 0.1f, sampleHz);
+    biquad3Notch(&GyroNotch[1], cfg.gy_ntch2, cfg.gy_ntch2q * 0.1f, sampleHz);
+    biquad3Lowpass(&GyroLpf, cfg.gy_lpfcut, sampleHz);
+    biquad3Lowpass(&GyroLpfYaw, cfg.gy_lpfyw, sampleHz);                   // Tricopter yaw, took the place of gy_smyw
+}
 
+void computeIMU(void)
+{
     if (MpuSpecial)
     {
         GETMPU6050();
@@ -69,17 +66,10 @@ void computeIMU(void)
         }
     }
 
-    if (GyroSmoothing)
-    {
-        for (axis = 0; axis < 3; axis++)
-        {
-            if (Smoothing[axis])                                 // Circumvent the 0 here
-            {
-                gyroData[axis]   = ((gyroSmooth[axis] * (float)(Smoothing[axis] - 1)) + gyroData[axis]) / (float)Smoothing[axis];
-                gyroSmooth[axis] = gyroData[axis];
-            }
-        }
-    }
+    biquad3Apply(&GyroNotch[0], gyroData);                       // Only the Pid input, the attitude integrates the unfiltered gyroADC
+    biquad3Apply(&GyroNotch[1], gyroData);
+    biquad3Apply(&GyroLpf, gyroData);
+    gyroData[YAW] = biquad3ApplyAxis(&GyroLpfYaw, YAW, gyroData[YAW]);
 }
 
 typedef struct fp_vector
@@ -102,12 +92,12 @@ void rotateV(struct fp_vector *v, float *delta)
     float     mat[3][3];                                                  // This does a  "proper" matrix rotation using gyro deltas without small-angle approximation
     float     cosx, sinx, cosy, siny, cosz, sinz;
     float     coszcosx, coszcosy, sinzcosx, coszsinx, sinzsinx;
-    cosx      = cosf(-delta[PITCH]);
-    sinx      = sinf(-delta[PITCH]);
-    cosy      = cosf(delta[ROLL]);
-    siny      = sinf(delta[ROLL]);
-    cosz      = cosf(delta[YAW]);
-    sinz      = sinf(delta[YAW]);
+    cosx      = fastCos(-delta[PITCH]);
+    sinx      = fastSin(-delta[PITCH]);
+    cosy      = fastCos(delta[ROLL]);
+    siny      = fastSin(delta[ROLL]);
+    cosz      = fastCos(delta[YAW]);
+    sinz      = fastSin(delta[YAW]);
     coszcosx  = cosz * cosx;
     coszcosy  = cosz * cosy;
     sinzcosx  = sinz * cosx;
@@ -127,6 +117,123 @@ void rotateV(struct fp_vector *v, float *delta)
     v->Z      = v_tmp.X * mat[0][2] + v_tmp.Y * mat[1][2] + v_tmp.Z * mat[2][2];
 }
 
+// Quaternion attitude for cfg.imu_mode 1, instead of the two rotateV calls and the complementary filters.
+// First order integration of the gyro deltas, acc and mag errors go through a Mahony PI controller into the rate.
+// The mag error is limited to the yaw axis, so a bad mag can't tilt the horizon.
+// Results are written back into EstG / EstM in the same units and axes, so angles, heading, TiltValue and INS don't care.
+// rotateV turns a vector by (-PITCH, ROLL, YAW) x v, that is a body rate of (PITCH, -ROLL, -YAW) in this frame.
+static void quaternionUpdate(float *delta, bool accOk, t_fp_vector *EstM)
+{
+    static float q0 = 1.0f, q1, q2, q3, bx, bz, Ibias[3];
+    static bool  qInit;
+    float        gx, gy, gz, vx, vy, vz, ex = 0, ey = 0, ez = 0;
+    float        ax, ay, az, tmp, dt = ACCDeltaTimeINS;
+#ifdef MAG
+    float        mx, my, mz, hx, hy, wx, wy, wz;
+#endif
+
+    if (!qInit)                                                            // Start at the acc attitude, not level
+    {
+        tmp = sqrtf(accADC[0] * accADC[0] + accADC[1] * accADC[1] + accADC[2] * accADC[2]);
+        if (tmp == 0.0f) return;
+        ax  = accADC[0] / tmp;
+        ay  = accADC[1] / tmp;
+        az  = accADC[2] / tmp;
+        if (az > -0.9f)                                                    // Rotation from acc to up, upside down stays at identity
+        {
+            q0  = 1.0f + az;
+            q1  = ay;
+            q2  = -ax;
+            tmp = fastInvSqrt(q0 * q0 + q1 * q1 + q2 * q2);
+            q0 *= tmp;
+            q1 *= tmp;
+            q2 *= tmp;
+        }
+        qInit = true;
+    }
+
+    vx = 2.0f * (q1 * q3 - q0 * q2);                                       // Estimated gravity in bodyframe, unit length
+    vy = 2.0f * (q0 * q1 + q2 * q3);
+    vz = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+
+    if (accOk)
+    {
+        tmp = fastInvSqrt(accSmooth[0] * accSmooth[0] + accSmooth[1] * accSmooth[1] + accSmooth[2] * accSmooth[2]); // AccMag > 72 so no div by 0
+        ax  = accSmooth[0] * tmp;
+        ay  = accSmooth[1] * tmp;
+        az  = accSmooth[2] * tmp;
+        ex  = ay * vz - az * vy;                                           // Error is measured x estimated
+        ey  = az * vx - ax * vz;
+        ez  = ax * vy - ay * vx;
+    }
+
+#ifdef MAG
+    if (sensors(SENSOR_MAG) && cfg.mag_calibrated == 1 && !f.CALIBRATE_MAG)
+    {
+        tmp = magADCfloat[0] * magADCfloat[0] + magADCfloat[1] * magADCfloat[1] + magADCfloat[2] * magADCfloat[2];
+        if (tmp > 0.0f)
+        {
+            tmp = fastInvSqrt(tmp);
+            mx  = magADCfloat[0] * tmp;
+            my  = magADCfloat[1] * tmp;
+            mz  = magADCfloat[2] * tmp;
+            hx  = 2.0f * (mx * (0.5f - q2 * q2 - q3 * q3) + my * (q1 * q2 - q0 * q3) + mz * (q1 * q3 + q0 * q2)); // Mag in earthframe
+            hy  = 2.0f * (mx * (q1 * q2 + q0 * q3) + my * (0.5f - q1 * q1 - q3 * q3) + mz * (q2 * q3 - q0 * q1));
+            bz  = 2.0f * (mx * (q1 * q3 - q0 * q2) + my * (q2 * q3 + q0 * q1) + mz * (0.5f - q1 * q1 - q2 * q2));
+            bx  = sqrtf(hx * hx + hy * hy);                                // Reference field: north and down only
+            wx  = 2.0f * (bx * (0.5f - q2 * q2 - q3 * q3) + bz * (q1 * q3 - q0 * q2)); // Back into bodyframe
+            wy  = 2.0f * (bx * (q1 * q2 - q0 * q3) + bz * (q0 * q1 + q2 * q3));
+            wz  = 2.0f * (bx * (q0 * q2 + q1 * q3) + bz * (0.5f - q1 * q1 - q2 * q2));
+            tmp = (my * wz - mz * wy) * vx + (mz * wx - mx * wz) * vy + (mx * wy - my * wx) * vz; // Yaw part of the mag error only
+            if (bx > 0.1f) tmp /= bx * bx;                                 // Is sin(heading error) * bx^2, don't let the inclination slow it down
+            ex += tmp * vx;
+            ey += tmp * vy;
+            ez += tmp * vz;
+        }
+    }
+#endif
+
+    if (cfg.imu_ki > 0.0f)
+    {
+        tmp       = cfg.imu_ki * dt;
+        Ibias[0] += ex * tmp;
+        Ibias[1] += ey * tmp;
+        Ibias[2] += ez * tmp;
+    }
+    else Ibias[0] = Ibias[1] = Ibias[2] = 0;
+
+    tmp = cfg.imu_kp * dt;
+    if (!f.ARMED) tmp *= 10.0f;                                            // Settle quickly on the ground, the start heading can be 180deg off
+    gx  = delta[PITCH] + ex * tmp + Ibias[0] * dt;                         // Rotation in rad for this cycle
+    gy  = -delta[ROLL] + ey * tmp + Ibias[1] * dt;
+    gz  = -delta[YAW]  + ez * tmp + Ibias[2] * dt;
+
+    gx *= 0.5f;
+    gy *= 0.5f;
+    gz *= 0.5f;
+    ax  = q0;
+    ay  = q1;
+    az  = q2;
+    q0 += -ay * gx - az * gy - q3 * gz;
+    q1 +=  ax * gx + az * gz - q3 * gy;
+    q2 +=  ax * gy - ay * gz + q3 * gx;
+    q3 +=  ax * gz + ay * gy - az * gx;
+    tmp = fastInvSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    q0 *= tmp;
+    q1 *= tmp;
+    q2 *= tmp;
+    q3 *= tmp;
+
+    EstG.V.X = 2.0f * (q1 * q3 - q0 * q2) * acc_1G;
+    EstG.V.Y = 2.0f * (q0 * q1 + q2 * q3) * acc_1G;
+    EstG.V.Z = (q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3) * acc_1G;
+#ifdef MAG
+    EstM->V.X = 2.0f * (bx * (0.5f - q2 * q2 - q3 * q3) + bz * (q1 * q3 - q0 * q2));
+    EstM->V.Y = 2.0f * (bx * (q1 * q2 - q0 * q3) + bz * (q0 * q1 + q2 * q3));
+    EstM->V.Z = 2.0f * (bx * (q0 * q2 + q1 * q3) + bz * (0.5f - q1 * q1 - q2 * q2));
+#endif
+}
+
 static void getEstimatedAttitude(void)
 {
     static t_fp_vector EstM;
@@ -137,7 +244,7 @@ static void getEstimatedAttitude(void)
     float           cy, sy, spcy, spsy, acc_south, acc_west, acc_up;
     float           tmp0, tmp1, tmp2, tmp3, AccMag = 0;
     uint8_t         axis;
-    uint32_t        currentT = micros();
+    uint32_t        currentT = drdyActive ? drdySampleTime : micros(); // gy_drdy: sample time from the interrupt
   
     tmp0            = (float)(currentT - previousT);
     scale           = tmp0 * GyroScale;
@@ -148,50 +255,54 @@ static void getEstimatedAttitude(void)
     tmp3 = 1.0f - INV_ACC_LPF;
     for (axis = 0; axis < 3; axis++)
     {
-        deltaGyroAngle[axis] = gyroADC[axis]   * scale;
+        deltaGyroAngle[axis] = GyroDeltaValid ? GyroDelta[axis] : gyroADC[axis] * scale; // gy_fifo: the FIFO samples cover the loop
         accLPFINS[axis]      = accLPFINS[axis] * tmp1 + accADC[axis] * INV_ACC_INS_LPF;
         accSmooth[axis]      = accSmooth[axis] * tmp3 + accADC[axis] * INV_ACC_LPF;
         AccMag              += accSmooth[axis] * accSmooth[axis];
     }
     AccMag = (AccMag * 100) / SQacc_1G;
-    rotateV(&EstG.V, deltaGyroAngle);
-    if (sensors(SENSOR_MAG)) rotateV(&EstM.V, deltaGyroAngle);
+    if (cfg.imu_mode) quaternionUpdate(deltaGyroAngle, 72 < AccMag && AccMag < 133, &EstM);
+    else
+    {
+        rotateV(&EstG.V, deltaGyroAngle);
+        if (sensors(SENSOR_MAG)) rotateV(&EstM.V, deltaGyroAngle);
 //    if (abs(accSmooth[ROLL])  < acc_25deg &&
 //        abs(accSmooth[PITCH]) < acc_25deg && accSmooth[YAW] > 0) f.SMALL_ANGLES_25 = 1;
 //    else f.SMALL_ANGLES_25 = 0;
 //    debug[0] = f.SMALL_ANGLES_25;    
     
-    // Apply complimentary filter (Gyro drift correction)
-    // If accel magnitude >1.15G or <0.85G and ACC vector outside of the limit range => we neutralize the effect of accelerometers in the angle estimation.
-    // To do that, we just skip filter, as EstV already rotated by Gyro
-    if (72 < AccMag && AccMag < 133)
-    {
-        for (axis = 0; axis < 3; axis++)
-            EstG.A[axis] = (EstG.A[axis] * (float)cfg.gy_cmpf + accSmooth[axis]) * INV_GYR_CMPF_FACTOR;
+        // Apply complimentary filter (Gyro drift correction)
+        // If accel magnitude >1.15G or <0.85G and ACC vector outside of the limit range => we neutralize the effect of accelerometers in the angle estimation.
+        // To do that, we just skip filter, as EstV already rotated by Gyro
+        if (72 < AccMag && AccMag < 133)
+        {
+            for (axis = 0; axis < 3; axis++)
+                EstG.A[axis] = (EstG.A[axis] * (float)cfg.gy_cmpf + accSmooth[axis]) * INV_GYR_CMPF_FACTOR;
+        }
+#ifdef MAG
+        if (sensors(SENSOR_MAG))
+        {
+            for (axis = 0; axis < 3; axis++)
+                EstM.A[axis] = (EstM.A[axis] * (float)cfg.gy_cmpfm + magADCfloat[axis]) * INV_GYR_CMPFM_FACTOR; // EstM.A[axis] = (EstM.A[axis] * GYR_CMPFM_FACTOR + magADCfloat[axis]) * INV_GYR_CMPFM_FACTOR;
+        }
+#endif
     }
 
     if (EstG.A[YAW] > ACCZ_25deg) f.SMALL_ANGLES_25 = 1;
     else f.SMALL_ANGLES_25 = 0;
 
-#ifdef MAG
-    if (sensors(SENSOR_MAG))
-    {
-        for (axis = 0; axis < 3; axis++)
-            EstM.A[axis] = (EstM.A[axis] * (float)cfg.gy_cmpfm + magADCfloat[axis]) * INV_GYR_CMPFM_FACTOR; // EstM.A[axis] = (EstM.A[axis] * GYR_CMPFM_FACTOR + magADCfloat[axis]) * INV_GYR_CMPFM_FACTOR;
-    }
-#endif
 //  rollRAD      = atan2f(EstG.V.X, EstG.V.Z);
 //  pitchRAD     = asinf(EstG.V.Y / -sqrtf(EstG.V.X * EstG.V.X + EstG.V.Y * EstG.V.Y + EstG.V.Z * EstG.V.Z)); // Has to have the "wrong sign" relative to angle[PITCH]
     tmp0         = EstG.V.X * EstG.V.X + EstG.V.Z * EstG.V.Z;
-    rollRAD      = atan2f(EstG.V.X, EstG.V.Z);
-    pitchRAD     = -atan2f(EstG.V.Y, tmp0 / sqrtf(tmp0));              // "Pitchrad" has to have the "wrong sign" relative to angle[PITCH]
+    rollRAD      = fastAtan2(EstG.V.X, EstG.V.Z);
+    pitchRAD     = -fastAtan2(EstG.V.Y, tmp0 * fastInvSqrt(tmp0));              // "Pitchrad" has to have the "wrong sign" relative to angle[PITCH]
     angle[ROLL]  = constrain( rollRAD  * RADtoDEG10, -1800, 1800);
     angle[PITCH] = constrain(-pitchRAD * RADtoDEG10, -1800, 1800);
 
-    cr        = cosf(rollRAD);
-    sr        = sinf(rollRAD);
-    cp        = cosf(pitchRAD);
-    sp        = sinf(pitchRAD);
+    cr        = fastCos(rollRAD);
+    sr        = fastSin(rollRAD);
+    cp        = fastCos(pitchRAD);
+    sp        = fastSin(pitchRAD);
     TiltValue = EstG.V.Z * INVacc_1G;                                  // / acc_1G;
     heading   = 0;                                                     // if no mag or not calibrated do bodyframe below
 #ifdef MAG
@@ -199,14 +310,14 @@ static void getEstimatedAttitude(void)
     {
         Xh   = EstM.A[1] * cp + EstM.A[0] * sr * sp + EstM.A[2] * cr * sp;
         Yh   = EstM.A[0] * cr - EstM.A[2] * sr;
-        heading = constrain(atan2f(-Yh,Xh) * RADtoDEG, -180.0f, 180.0f) + magneticDeclination; // Get rad to Degree and add declination (without *10 shit)
+        heading = constrain(fastAtan2(-Yh,Xh) * RADtoDEG, -180.0f, 180.0f) + magneticDeclination; // Get rad to Degree and add declination (without *10 shit)
         if (heading > 180.0f)       heading = heading - 360.0f;        // Wrap to -180 0 +180 Degree
         else if (heading < -180.0f) heading = heading + 360.0f;
     }
 #endif
     tmp0      = heading * RADX;                                        // Do GPS INS rotate ACC X/Y to earthframe no centrifugal comp. yet
-    cy        = cosf(tmp0);
-    sy        = sinf(tmp0);
+    cy        = fastCos(tmp0);
+    sy        = fastSin(tmp0);
     cos_yaw_x = cy;                                                    // Store for general use
     sin_yaw_y = sy;                                                    // Store for general use
     spcy      = sp * cy;
@@ -218,18 +329,24 @@ static void getEstimatedAttitude(void)
     tmp0      = accLPFINS[0];
     tmp1      = accLPFINS[1];
     tmp2      = accLPFINS[2];
-    tmp3      = sqrtf(EstG.V.X * tmp0 + EstG.V.Y  * tmp1 + EstG.V.Z * tmp2); // Normalize ACCvector so the gps ins works
-    if (tmp3 == 0.0f) tmp3 = 1;                                        // In that case all tmp must be zero so div by 1 is ok
-    tmp0      = tmp0 / tmp3;
-    tmp1      = tmp1 / tmp3;
-    tmp2      = tmp2 / tmp3;
+    tmp3      = EstG.V.X * tmp0 + EstG.V.Y  * tmp1 + EstG.V.Z * tmp2;   // Normalize ACCvector so the gps ins works
+    if (tmp3 > 0.0f) tmp3 = fastInvSqrt(tmp3);
+    else tmp3 = 1;                                                     // All tmp zero (or upside down, sqrtf gave NaN here before) so no scaling is ok
+    tmp0      = tmp0 * tmp3;
+    tmp1      = tmp1 * tmp3;
+    tmp2      = tmp2 * tmp3;
     acc_south = (cp * cy) * tmp1 + (sr * spcy - cr * sy) * tmp0 + ( sr * sy + cr * spcy) * tmp2;
     acc_west  = (cp * sy) * tmp1 + (cr * cy + sr * spsy) * tmp0 + (-sr * cy + cr * spsy) * tmp2;
     tmp3      = 980.665f  * ACCDeltaTimeINS;                           // vel factor for normalized output tmp3      = (9.80665f * (float)ACCDeltaTime) / 10000.0f;
-    tmp2      = constrain(TiltValue, 0.5f, 1.0f) * tmp3;               // Empirical reduction of hightdrop in forward flight
-    if(GroundAltInitialized) vario = vario + acc_up * tmp2;            // Positive when moving Up. Just do Vario when Baro completely initialized.
-    ACC_speed[LAT] = ACC_speed[LAT] - acc_south * tmp3;                // Positive when moving North cm/sec when no MAG this is speed to the front
-    ACC_speed[LON] = ACC_speed[LON] - acc_west  * tmp3;                // Positive when moving East cm/sec when no MAG this is speed to the right
+    AccUpCms  = acc_up * constrain(TiltValue, 0.5f, 1.0f) * 980.665f;  // Empirical reduction of hightdrop in forward flight
+    if(GroundAltInitialized && !cfg.alt_mode) vario = vario + AccUpCms * ACCDeltaTimeINS; // Positive when moving Up. Just do Vario when Baro completely initialized. alt_mode 1: Kalman does it
+    ACC_earth[LAT] = -acc_south * 980.665f;                            // Input of the gps ins Kalman filter
+    ACC_earth[LON] = -acc_west  * 980.665f;
+    if (!cfg.gps_ins_kf)                                               // gps_ins_kf 1: Kalman in navigation.c does the speed
+    {
+        ACC_speed[LAT] = ACC_speed[LAT] - acc_south * tmp3;            // Positive when moving North cm/sec when no MAG this is speed to the front
+        ACC_speed[LON] = ACC_speed[LON] - acc_west  * tmp3;            // Positive when moving East cm/sec when no MAG this is speed to the right
+    }
 }
 
 #ifdef BARO
@@ -238,6 +355,36 @@ static void getEstimatedAttitude(void)
 ///////////////////////////////////////////////
 #define VarioTabsize 8
 #define BaroTabsize 5
+static kalman3_t AltKf;                                           // Altitude (cm over GroundAlt), vario (cm/s) and acc_up bias
+
+// alt_mode 1: Kalman filter driven by AccUpCms at looprate, baro and sonar are altitude measurements with their own noise.
+// No moving averages, so no group delay.
+static void altKalman(void)
+{
+    static float SNRcorrect;
+
+    kalman3Predict(&AltKf, AccUpCms, ACCDeltaTimeINS, cfg.alt_acc_n, cfg.alt_bias_n);
+    if (newbaroalt) kalman3Correct(&AltKf, BaroAlt - GroundAlt - AltKf.x[0], cfg.alt_baro_n);
+    switch(SonarStatus)
+    {
+    case 1:
+        if (newsonaralt) SNRcorrect = AltKf.x[0] - (float)sonarAlt; // Offset sonar to the current estimate, EstAlt keeps going from there
+        break;
+    case 2:
+        if (newsonaralt) kalman3Correct(&AltKf, SNRcorrect + (float)sonarAlt - AltKf.x[0], cfg.alt_snr_n);
+        break;
+    }
+    EstAlt = AltKf.x[0];
+    vario  = AltKf.x[1];
+    if (cfg.bar_dbg)
+    {
+        debug[0] = (BaroAlt - GroundAlt) * 10;
+        debug[1] = EstAlt * 10;
+        debug[2] = AltKf.x[2];
+        debug[3] = vario;
+    }
+}
+
 void getEstimatedAltitude(void)
 {
     static uint8_t  Vidx, Bidx, IniStep = 0, IniCnt;
@@ -255,6 +402,7 @@ void getEstimatedAltitude(void)
                 for (i = 0; i < VarioTabsize; i++) VarioTab[i] = 0;
                 for (i = 0; i < BaroTabsize;  i++) BaroTab[i]  = 0;
                 EstAlt = vario = SNRavg = 0;
+                kalman3Reset(&AltKf, 0, cfg.alt_baro_n, 10.0f, 20.0f);
                 IniCnt = SonarStatus = 0;
                 GroundAlt = BaroAlt;
                 IniStep++;
@@ -267,6 +415,7 @@ void getEstimatedAltitude(void)
             }
         }
     }
+    else if (cfg.alt_mode) altKalman();
     else
     {
         switch(SonarStatus)
@@ -311,6 +460,7 @@ void getEstimatedAltitude(void)
             }
         }
     }
+    newbaroalt = newsonaralt = false;                            // Baro_update is a task of its own now, so reset it here after use
 }
 
 void getAltitudePID(void)                                        // I put this out of getEstimatedAltitude seems logical
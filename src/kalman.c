@@ -0,0 +1,75 @@
+#include "board.h"
+#include "mw.h"
+
+// Small linear Kalman filter for one axis: position, velocity and acc bias, driven by a measured acceleration
+// and corrected with position (and velocity) measurements. Used for the altitude (imu.c) and for north / east of the gps ins (navigation.c).
+// Covariance is kept as the 6 unique entries of the symmetric 3x3 matrix: 00 01 02 11 12 22.
+// Everything is written out for the sparse transition matrix F = [1 dt -dt^2/2, 0 1 -dt, 0 0 1], ca. 40 float ops per predict.
+
+void kalman3Reset(kalman3_t *k, float pos, float posNoise, float velNoise, float biasNoise)
+{
+    k->x[0] = pos;
+    k->x[1] = k->x[2] = 0;
+    k->P[0] = posNoise  * posNoise;
+    k->P[1] = k->P[2] = k->P[4] = 0;
+    k->P[3] = velNoise  * velNoise;
+    k->P[5] = biasNoise * biasNoise;
+}
+
+void kalman3Predict(kalman3_t *k, float acc, float dt, float accNoise, float biasNoise)
+{
+    float *P = k->P, e = 0.5f * dt * dt, q = accNoise * accNoise, p00, p01, p02, p11, p12;
+
+    acc     -= k->x[2];
+    k->x[0] += k->x[1] * dt + acc * e;
+    k->x[1] += acc * dt;
+    p02  = P[2] + dt * P[4] - e * P[5];                                    // FP
+    p12  = P[4] - dt * P[5];
+    p01  = P[1] + dt * P[3] - e * P[4];
+    p11  = P[3] - dt * P[4];
+    p00  = P[0] + dt * P[1] - e * P[2];
+    P[0] = p00 + dt * p01 - e * p02 + e * e * q;                           // FPF' + Q, acc noise enters like the acc
+    P[1] = p01 - dt * p02 + e * dt * q;
+    P[2] = p02;
+    P[3] = p11 - dt * p12 + dt * dt * q;
+    P[4] = p12;
+    P[5] += biasNoise * biasNoise * dt;                                    // Bias random walk
+}
+
+void kalman3Correct(kalman3_t *k, float innovation, float noise)         // Position measurement, innovation = measured - estimated position
+{
+    float *P = k->P, p0 = P[0], p1 = P[1], p2 = P[2], k0, k1, k2, s;
+
+    s  = 1.0f / (p0 + noise * noise);
+    k0 = p0 * s;
+    k1 = p1 * s;
+    k2 = p2 * s;
+    k->x[0] += k0 * innovation;
+    k->x[1] += k1 * innovation;
+    k->x[2] += k2 * innovation;
+    P[0] -= k0 * p0;                                                       // P = (I - KH)P
+    P[1] -= k0 * p1;
+    P[2] -= k0 * p2;
+    P[3] -= k1 * p1;
+    P[4] -= k1 * p2;
+    P[5] -= k2 * p2;
+}
+
+void kalman3CorrectVel(kalman3_t *k, float innovation, float noise)      // Velocity measurement, innovation = measured - estimated velocity
+{
+    float *P = k->P, p1 = P[1], p3 = P[3], p4 = P[4], k0, k1, k2, s;
+
+    s  = 1.0f / (p3 + noise * noise);
+    k0 = p1 * s;
+    k1 = p3 * s;
+    k2 = p4 * s;
+    k->x[0] += k0 * innovation;
+    k->x[1] += k1 * innovation;
+    k->x[2] += k2 * innovation;
+    P[0] -= k0 * p1;                                                       // P = (I - KH)P with H = [0 1 0]
+    P[1] -= k0 * p3;
+    P[2] -= k0 * p4;
+    P[3] -= k1 * p3;
+    P[4] -= k1 * p4;
+    P[5] -= k2 * p4;
+}
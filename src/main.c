@@ -1,5 +1,8 @@
 #include "board.h"
 #include "mw.h"
+#ifdef SITL
+#include "sitl.h"
+#endif
 
 extern uint8_t useServo;
 extern rcReadRawDataPtr rcReadRawFunc;
@@ -7,10 +10,14 @@ extern uint16_t pwmReadRawRC(uint8_t chan);
 
 static void _putc(void *p, char c)
 {
-    uartWrite(c);
+    uartWriteWait(c);
 }
 
+#ifdef SITL
+int main(int argc, char *argv[])
+#else
 int main(void)
+#endif
 {
     uint8_t i;
     drv_pwm_config_t pwm_params;
@@ -38,11 +45,18 @@ int main(void)
     GPIOB->CRL = 0x44433444;               // PIN 4 & 3 Output 50MHz
 #endif
 
+#ifdef SITL
+    sitlInit(argc, argv);
+#endif
     systemInit();
     init_printf(NULL, _putc);
 
     checkFirstTime(false);
+    cfgStoreFlush();                       // Defaults or a migration are a full rewrite, at boot it may block
     readEEPROM();
+#ifdef SITL
+    sitlConfig();
+#endif
 
     // configure power ADC
     if (cfg.power_adc_channel > 0 && (cfg.power_adc_channel == 1 || cfg.power_adc_channel == 9))
@@ -75,6 +89,7 @@ int main(void)
     pwm_params.useServos    = useServo;
     pwm_params.extraServos  = (cfg.gbl_flg & GIMBAL_FORWARDAUX) || (feature(FEATURE_LED) && cfg.LED_Type == 1);
     pwm_params.motorPwmRate = cfg.esc_pwm;
+    pwm_params.oneshot      = cfg.esc_oneshot;
     pwm_params.servoPwmRate = cfg.srv_pwm;
 
     pwm_params.useRC5   = false;
@@ -169,19 +184,38 @@ int main(void)
         calibratingG = true;
         f.SMALL_ANGLES_25 = 1;
         if(cfg.stat_clear) ClearStats();
-        newpidimax = (float)cfg.newpidimax * 8192.0f;
+        newpidimax = itor(cfg.newpidimax);  // errorGyroI of the new controller is kept in ITerm units (/ 8192)
         baseflight_mavlink_init();         // Always precalculate some Mavlink stuff, maybe needed
         SonarLandWanted = cfg.snr_land;    // Variable may be overwritten by failsave
+        blackboxInit();                    // Finds the end of the log in the flash
+        schedulerInit();                   // Task table in mw.c, sensors are known now
+#ifdef SITL
+        while (1)
+        {
+            loop();
+            sitlLoop();
+        }
+#else
         while (1) loop();                  // Do Harakiri        
+#endif
     }
     else                                   // We want feature pass, do the minimal program
     {
         sensorsAutodetect();
         imuInit();
         writeAllMotors(cfg.esc_moff);      // All Motors off
+        vibInit();                         // The vibration analyser gets the RAM of the blackbox
         LD0_ON();
         LD1_OFF();
+#ifdef SITL
+        while (1)
+        {
+            pass();
+            sitlLoop();
+        }
+#else
         while(1) pass();                   // Do feature pass
+#endif
     }
 }
 
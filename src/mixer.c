@@ -6,7 +6,7 @@ uint8_t useServo = 0;
 int16_t motor[MAX_MOTORS];
 int16_t servo[8] = { 1500, 1500, 1500, 1500, 1500, 1500, 1500, 1500 };
 
-static motorMixer_t currentMixer[MAX_MOTORS];
+static motorMixerReal_t currentMixer[MAX_MOTORS];
 
 static const motorMixer_t mixerTri[] =
 {
@@ -144,6 +144,14 @@ const mixer_t mixers[] =
     { 0, 0, NULL },                // MULTITYPE_CUSTOM
 };
 
+static void mixerSet(uint8_t i, const motorMixer_t *mix)
+{
+    currentMixer[i].throttle = ftor(mix->throttle);
+    currentMixer[i].roll     = ftor(mix->roll);
+    currentMixer[i].pitch    = ftor(mix->pitch);
+    currentMixer[i].yaw      = ftor(mix->yaw);
+}
+
 uint8_t mixerInit(void)
 {
     uint8_t i;
@@ -155,7 +163,7 @@ uint8_t mixerInit(void)
         for (i = 0; i < MAX_MOTORS; i++)                   // load custom mixer into currentMixer
         {
             if (cfg.customMixer[i].throttle == 0.0f) break;// check if done
-            currentMixer[i] = cfg.customMixer[i];
+            mixerSet(i, &cfg.customMixer[i]);
             numberMotor++;
         }
     }
@@ -165,7 +173,7 @@ uint8_t mixerInit(void)
         // copy motor-based mixers
         if (mixers[cfg.mixerConfiguration].motor)
         {
-            for (i = 0; i < numberMotor; i++) currentMixer[i] = mixers[cfg.mixerConfiguration].motor[i];
+            for (i = 0; i < numberMotor; i++) mixerSet(i, &mixers[cfg.mixerConfiguration].motor[i]);
         }
     }
     return numberMotor;
@@ -246,6 +254,7 @@ void writeMotors(void)
 {
     uint8_t i;
     for (i = 0; i < numberMotor; i++) pwmWriteMotor(i, motor[i]);
+    pwmCompleteMotorUpdate();                                   // OneShot: all pulses go out now
 }
 
 void writeAllMotors(int16_t mc)
@@ -321,7 +330,7 @@ void mixTable(void)
     // motors for non-servo mixes
     if (numberMotor > 1)
         for (i = 0; i < numberMotor; i++)
-            motor[i] = rcCommand[THROTTLE] * currentMixer[i].throttle + axisPID[PITCH] * currentMixer[i].pitch + axisPID[ROLL] * currentMixer[i].roll + cfg.tri_ydir * axisPID[YAW] * currentMixer[i].yaw;
+            motor[i] = rtoi(rmuli(currentMixer[i].throttle, rcCommand[THROTTLE]) + rmuli(currentMixer[i].pitch, axisPID[PITCH]) + rmuli(currentMixer[i].roll, axisPID[ROLL]) + rmuli(currentMixer[i].yaw, cfg.tri_ydir * axisPID[YAW]));
 
     // airplane / servo mixes
     switch (cfg.mixerConfiguration)
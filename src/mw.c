@@ -23,8 +23,8 @@ int16_t  lookupThrottleRC[11];                                       // lookup t
 rcReadRawDataPtr rcReadRawFunc = NULL;                               // receive data from default (pwm/ppm) or additional (spek/sbus/?? receiver drivers)
 uint8_t  rcOptions[CHECKBOXITEMS];
 int16_t  axisPID[3];
-float    newpidimax;
-static   float dynP8[3], dynD8[3];
+real_t   newpidimax;
+static   real_t dynP8[3], dynD8[3];
 
 // **********************
 // IMU
@@ -59,6 +59,7 @@ int32_t  Real_GPS_coord[2];                                          // RAW GPS
 int32_t  GPS_home[2];
 int32_t  GPS_WP[2];                                                  // Currently used WP
 uint8_t  GPS_numSat;
+uint16_t GPS_hdop;                                                   // HDOP * 100, 0 = not reported by the protocol
 uint16_t GPS_distanceToHome;                                         // distance to home point in meters
 int16_t  GPS_directionToHome;                                        // direction to home or hol point in degrees
 uint16_t GPS_altitude, GPS_speed;                                    // altitude in m and speed in 0.1m/s
@@ -126,14 +127,31 @@ void blinkLED(uint8_t num, uint8_t wait, uint8_t repeat);
 static void ChkFailSafe(void);
 static void DoKillswitch(void);
 static void GetClimbrateTorcDataTHROTTLE(int16_t cr);
+static void taskControl(void);
+static void taskRC(void);
+static void taskBaro(void);
+static void taskMag(void);
+static void taskSonar(void);
+static void taskTelemetry(void);
+static void taskMotorStats(void);
+static void taskConfig(void);
+static void taskBlackbox(void);
+static void taskSerial(void);
 
 void pass(void)                                                      // Crashpilot Feature pass
 {
-    static uint32_t blinktime, rctimer;
+    static uint32_t blinktime, rctimer, vibtimer;
     static uint8_t  lastpassmotor;
     uint32_t timetmp;
-    computeIMU();
     timetmp = micros();
+    if ((int32_t)(timetmp - vibtimer) >= 0)                          // Sensors at the fixed rate of the vibration analyser
+    {
+        vibtimer += VIB_SAMPLE_US;
+        if ((int32_t)(timetmp - vibtimer) >= 0) vibtimer = timetmp + VIB_SAMPLE_US; // Missed one, resync
+        computeIMU();
+        vibSample(rcData[THROTTLE]);
+    }
+    vibUpdate();                                                     // A step of the analysis when a capture is complete
     if (spektrumFrameComplete() || graupnersumhFrameComplete()) computeRC(); // Generates no rcData yet, but rcDataSAVE
     if ((int32_t)(timetmp - rctimer) >= 0)                           // 50Hz
     {
@@ -148,7 +166,11 @@ void pass(void)                                                      // Crashpil
         if (lastpassmotor != cfg.pass_mot) writeAllMotors(cfg.esc_moff); // Motonumber was changed in cli without saving
         lastpassmotor = cfg.pass_mot;
         if (!cfg.pass_mot) writeAllMotors(rcData[THROTTLE]);        // All Motors?
-        else pwmWriteMotor(cfg.pass_mot - 1, rcData[THROTTLE]);     // Specific Motor?
+        else
+        {
+            pwmWriteMotor(cfg.pass_mot - 1, rcData[THROTTLE]);       // Specific Motor?
+            pwmCompleteMotorUpdate();
+        }
         failsafeCnt++;
     }
     f.ARMED = 0;                                                     // Always set this as a dummy so serial com accepts "#" and "R"
@@ -161,183 +183,283 @@ void pass(void)                                                      // Crashpil
     }
 }
 
+// **********************
+// Mainloop / Scheduler
+// **********************
+// loop() is called endlessly from main and hands over to schedulerRun (scheduler.c). The control chain
+// (gyro, pid, mixer, motors) runs every cfg.looptime with the highest priority, the rest fills the slack.
+// Budgets are worst case guesses for 72MHz, check maxTime and the late/over counters with cli "tasks".
+// name, func, period us, budget us, priority. Order must match the TASK_ enum in mw.h
+task_t tasks[TASK_COUNT] =
+{
+    { "CONTROL",    taskControl,       3000,  1500, 10 },
+    { "RC",         taskRC,           20000,   800,  9 },            // 50Hz
+    { "BARO",       taskBaro,         10000,   400,  8 },            // Reschedules itself after the conversion times
+    { "MAG",        taskMag,          14000,   400,  7 },            // 71Hz this is below 75Hz of the HMC
+    { "SONAR",      taskSonar,        10000,   100,  6 },
+    { "TELEMETRY",  taskTelemetry,   125000,   400,  5 },            // FrSky frame every 125ms
+    { "LEDBUZZER",  DoLEDandBUZZER,    5000,   150,  4 },
+    { "MOTORSTATS", taskMotorStats,  100000,    50,  3 },            // 10Hz
+    { "CONFIG",     taskConfig,       10000,   500,  1 },            // Programs a few words per run, a page erase (20ms, disarmed only) overruns
+    { "BLACKBOX",   taskBlackbox,      2000,   900,  1 },            // Like CONFIG, up to 8 words per run
+    { "SERIAL",     taskSerial,       10000,   300,  2 },            // At least 100Hz, gets all the idle time on top
+};
+
+static uint8_t  rcDelayCommand;                                      // this indicates the number of time (multiple of RC measurement at 50Hz) the sticks must be maintained to run or switch off motors
+static uint32_t RTLGeneralTimer, AltRCTimer0, BaroAutoTimer;
+static uint32_t GPSlogTimer = 0;
+static real_t   lastGyro[3] = { 0, 0, 0 };
+static real_t   delta1[3], delta2[3];
+static real_t   errorGyroI[3] = { 0, 0, 0 }, errorAngleI[2] = { 0, 0 };
+static real_t   lastError[3]  = { 0, 0, 0 };
+static rbiquad3_t DTermLpf;                                          // cfg.maindcut, on the 3 sample delta sum
+static uint8_t  ThrFstTimeCenter, AutolandState, AutostartState, HoverThrcnt, RTLstate;
+static int8_t   Althightchange;
+static uint16_t HoverThrottle;
+static int16_t  BaroLandThrlimiter, SnrLandThrlimiter, initialThrottleHold, LastAltThrottle;
+static int16_t  DistanceToHomeMetersOnRTLstart;
+static int16_t  AutostartTargetHight, AutostartFilterAlt, AutostartFilterVario, AutostartClimbrate;
+static stdev_t  variovariance;
+
+void schedulerInit(void)                                             // Called from main when all sensors are up
+{
+    uint32_t now = micros();
+    uint8_t  i;
+    float    sampleHz;
+
+    tasks[TASK_CONTROL].period = cfg.looptime;
+    if (cfg.gy_drdy && MpuSpecial)                                   // Runs on the data ready interrupt, looptime in whole samples
+    {
+        i = max((cfg.looptime + MPU_SAMPLE_US / 2) / MPU_SAMPLE_US, 1);
+        tasks[TASK_CONTROL].period = i * MPU_SAMPLE_US;
+        schedulerDataReadyInit(i);
+    }
+    sampleHz = tasks[TASK_CONTROL].period ? 1000000.0f / tasks[TASK_CONTROL].period : 0; // Biquads are designed for the nominal rate
+    gyroFilterInit(sampleHz);
+    rbiquad3Lowpass(&DTermLpf, cfg.maindcut, sampleHz);
+    if (sensors(SENSOR_BARO)) tasks[TASK_BARO].period = baro.up_delay;
+    for (i = 0; i < TASK_COUNT; i++)
+    {
+        tasks[i].enabled = true;
+        tasks[i].nextRun = now;
+    }
+    tasks[TASK_BARO].enabled  = sensors(SENSOR_BARO);
+    tasks[TASK_MAG].enabled   = sensors(SENSOR_MAG);
+    tasks[TASK_SONAR].enabled = sensors(SENSOR_SONAR);
+    schedulerClearStats();
+}
+
 void loop(void)
 {
-    static uint8_t  rcDelayCommand;                                  // this indicates the number of time (multiple of RC measurement at 50Hz) the sticks must be maintained to run or switch off motors
-    static uint32_t RTLGeneralTimer, AltRCTimer0, LastLoopTime, rcTime = 0, BaroAutoTimer;
-    static uint32_t GPSlogTimer = 0, LastSerialTimeMS;
-    float           error, errorAngle, AngleRateTmp, RateError, delta, deltaSum;
-    float           PTerm, ITerm, PTermACC = 0, ITermACC = 0, PTermGYRO = 0, ITermGYRO = 0, DTerm;
-    static float    lastGyro[3] = { 0, 0, 0 };
-    static float    delta1[3], delta2[3];
-    static float    errorGyroI[3] = { 0, 0, 0 }, errorAngleI[2] = { 0, 0 };
-    static float    lastError[3]  = { 0, 0, 0 }, lastDTerm[3]   = { 0, 0, 0 }; // pt1 element http://www.multiwii.com/forum/viewtopic.php?f=23&t=2624;
-    float           prop;
-    static uint8_t  ThrFstTimeCenter, AutolandState, AutostartState, HoverThrcnt, RTLstate;
-    static int8_t   Althightchange;
-    static uint16_t HoverThrottle;
-    static int16_t  BaroLandThrlimiter, SnrLandThrlimiter, initialThrottleHold, LastAltThrottle;
-    static int16_t  DistanceToHomeMetersOnRTLstart;
-    static int16_t  AutostartTargetHight, AutostartFilterAlt, AutostartFilterVario, AutostartClimbrate;
-    static stdev_t  variovariance;
-    float           CosYawxPhase, SinYawyPhase, TmpPhase, tmp0flt, dT, MwiiTimescale;
-    int16_t         tmp0, thrdiff;
-    uint8_t         axis, i;    
-    
     // this will return false if spektrum is disabled. shrug.
     if (spektrumFrameComplete() || graupnersumhFrameComplete()) computeRC(); // Generates no rcData yet, but rcDataSAVE
-    if ((currentTime - rcTime) >= 20000)                             // 50Hz
-    {
-        rcTime = currentTime;
-        if (!feature(FEATURE_SPEKTRUM) && !feature(FEATURE_GRAUPNERSUMH)) computeRC();
-        GetActualRCdataOutRCDataSave();                              // Now we have new rcData to deal and MESS with
+    schedulerRun();
+}
+
+static void taskBaro(void)
+{
+#ifdef BARO
+    perfStart(PERF_BARO);
+    Baro_update();
+    perfStop(PERF_BARO);
+#endif
+}
+
+static void taskMag(void)
+{
+#ifdef MAG
+    Mag_getADC();
+#endif
+}
+
+static void taskSonar(void)
+{
+#ifdef SONAR
+    if (GroundAltInitialized) Sonar_update();                        // Update "SonarStatus"
+#endif
+}
+
+static void taskTelemetry(void)
+{
+    if (f.ARMED && cfg.tele_prot == 1) sendFRSKYTelemetry();        // 1=Frsky @9600Baud, serialCom handles the rest
+}
+
+static void taskMotorStats(void)
+{
+    DoMotorStats(false);                                             // False means no hoverthrottlegeneration for failsafe
+}
+
+static void taskConfig(void)
+{
+    cfgStoreUpdate(!f.ARMED);
+}
+
+static void taskBlackbox(void)
+{
+    blackboxUpdate(!f.ARMED);
+}
 
-        if ((rcData[THROTTLE] < cfg.rc_min) && !f.BARO_MODE)         // if ((rcData[THROTTLE] < cfg.rc_min) && !AutolandState)
+static void taskSerial(void)
+{
+    perfStart(PERF_SERIAL);
+    serialCom();
+    perfStop(PERF_SERIAL);
+}
+
+static void taskRC(void)
+{
+    int16_t         tmp0;
+    uint8_t         i;
+
+    if (!feature(FEATURE_SPEKTRUM) && !feature(FEATURE_GRAUPNERSUMH)) computeRC();
+    GetActualRCdataOutRCDataSave();                                  // Now we have new rcData to deal and MESS with
+
+    if ((rcData[THROTTLE] < cfg.rc_min) && !f.BARO_MODE)             // if ((rcData[THROTTLE] < cfg.rc_min) && !AutolandState)
+    {
+        for (i = 0; i < 2; i++) errorGyroI[i] = errorAngleI[i] = 0;
+        errorGyroI[YAW] = 0;
+        rcDelayCommand++;
+        if (rcData[YAW] < cfg.rc_min && rcData[PITCH] < cfg.rc_min && !f.ARMED)
         {
-            for (i = 0; i < 2; i++) errorGyroI[i] = errorAngleI[i] = 0;
-            errorGyroI[YAW] = 0;
-            rcDelayCommand++;
-            if (rcData[YAW] < cfg.rc_min && rcData[PITCH] < cfg.rc_min && !f.ARMED)
+            if (rcDelayCommand == 20)
             {
-                if (rcDelayCommand == 20)
-                {
-                    calibratingG = true;
-                    if (feature(FEATURE_GPS)) GPS_reset_home_position();
-                }
+                calibratingG = true;
+                if (feature(FEATURE_GPS)) GPS_reset_home_position();
             }
-            else if (feature(FEATURE_INFLIGHT_ACC_CAL) && (!f.ARMED && rcData[YAW] < cfg.rc_min && rcData[PITCH] > cfg.rc_max && rcData[ROLL] > cfg.rc_max))
+        }
+        else if (feature(FEATURE_INFLIGHT_ACC_CAL) && (!f.ARMED && rcData[YAW] < cfg.rc_min && rcData[PITCH] > cfg.rc_max && rcData[ROLL] > cfg.rc_max))
+        {
+            if (rcDelayCommand == 20)
             {
-                if (rcDelayCommand == 20)
+                if (AccInflightCalibrationMeasurementDone)           // trigger saving into eeprom after landing
                 {
-                    if (AccInflightCalibrationMeasurementDone)       // trigger saving into eeprom after landing
-                    {
-                        AccInflightCalibrationMeasurementDone = 0;
-                        AccInflightCalibrationSavetoEEProm = 1;
-                    }
-                    else
-                    {
-                        AccInflightCalibrationArmed = !AccInflightCalibrationArmed;
-                        if (AccInflightCalibrationArmed) toggleBeep = 2;
-                        else toggleBeep = 3;
-                    }
+                    AccInflightCalibrationMeasurementDone = 0;
+                    AccInflightCalibrationSavetoEEProm = 1;
                 }
-            }
-            else if (cfg.activate[BOXARM])
-            {
-                if (rcOptions[BOXARM] && f.OK_TO_ARM)
+                else
                 {
-                    if (feature(FEATURE_FAILSAFE))                   // Crashpilot1000
-                    {
-                        if (GoodRCcnt > (5 * cfg.fs_delay)) f.ARMED = 1;
-                        else  f.ARMED = 0;
-                    }
-                    else f.ARMED = 1;
-                    headFreeModeHold = heading;
+                    AccInflightCalibrationArmed = !AccInflightCalibrationArmed;
+                    if (AccInflightCalibrationArmed) toggleBeep = 2;
+                    else toggleBeep = 3;
                 }
-                else if (f.ARMED) f.ARMED = 0;
-                rcDelayCommand = 0;
             }
-            else if ((rcData[YAW] < cfg.rc_min || (cfg.rc_rllrm && rcData[ROLL] < cfg.rc_min)) && f.ARMED)
-            {
-                if (rcDelayCommand == 20)
-                    f.ARMED = 0;                                     // rcDelayCommand = 20 => 20x20ms = 0.4s = time to wait for a specific RC command to be acknowledged
-            }
-            else if ((rcData[YAW] > cfg.rc_max || (rcData[ROLL] > cfg.rc_max && cfg.rc_rllrm)) && rcData[PITCH] < cfg.rc_max && !f.ARMED && !calibratingG && f.ACC_CALIBRATED)
+        }
+        else if (cfg.activate[BOXARM])
+        {
+            if (rcOptions[BOXARM] && f.OK_TO_ARM && !calibratingA)
             {
-                if (rcDelayCommand == 20)
+                if (feature(FEATURE_FAILSAFE))                       // Crashpilot1000
                 {
-                    if (feature(FEATURE_FAILSAFE))                   // Crashpilot1000
-                    {
-                        if (GoodRCcnt > (5 * cfg.fs_delay)) f.ARMED = 1;
-                        else  f.ARMED = 0;
-                    }
-                    else f.ARMED = 1;
-                    headFreeModeHold = heading;
+                    if (GoodRCcnt > (5 * cfg.fs_delay)) f.ARMED = 1;
+                    else  f.ARMED = 0;
                 }
+                else f.ARMED = 1;
+                headFreeModeHold = heading;
             }
-            else
-                rcDelayCommand = 0;
+            else if (f.ARMED) f.ARMED = 0;
+            rcDelayCommand = 0;
         }
-        else if (rcData[THROTTLE] > cfg.rc_max && !f.ARMED)
+        else if ((rcData[YAW] < cfg.rc_min || (cfg.rc_rllrm && rcData[ROLL] < cfg.rc_min)) && f.ARMED)
         {
-            if (rcData[YAW] < cfg.rc_min && rcData[PITCH] < cfg.rc_min) // throttle=max, yaw=left, pitch=min
-            {
-                if (rcDelayCommand == 20)
-                    calibratingA = true;
-                rcDelayCommand++;
-            }
-            else if (rcData[YAW] > cfg.rc_max && rcData[PITCH] < cfg.rc_min) // throttle=max, yaw=right, pitch=min
+            if (rcDelayCommand == 20)
+                f.ARMED = 0;                                         // rcDelayCommand = 20 => 20x20ms = 0.4s = time to wait for a specific RC command to be acknowledged
+        }
+        else if ((rcData[YAW] > cfg.rc_max || (rcData[ROLL] > cfg.rc_max && cfg.rc_rllrm)) && rcData[PITCH] < cfg.rc_max && !f.ARMED && !calibratingG && !calibratingA && f.ACC_CALIBRATED)
+        {
+            if (rcDelayCommand == 20)
             {
-                if (rcDelayCommand == 20)
-                    f.CALIBRATE_MAG = 1;                             // MAG calibration request
-                rcDelayCommand++;
+                if (feature(FEATURE_FAILSAFE))                       // Crashpilot1000
+                {
+                    if (GoodRCcnt > (5 * cfg.fs_delay)) f.ARMED = 1;
+                    else  f.ARMED = 0;
+                }
+                else f.ARMED = 1;
+                headFreeModeHold = heading;
             }
-            else if (rcData[PITCH] > cfg.rc_max)
-            {
-                cfg.angleTrim[PITCH] += 2;
-                writeParams(1);
+        }
+        else
+            rcDelayCommand = 0;
+    }
+    else if (rcData[THROTTLE] > cfg.rc_max && !f.ARMED)
+    {
+        if (rcData[YAW] < cfg.rc_min && rcData[PITCH] < cfg.rc_min) // throttle=max, yaw=left, pitch=min
+        {
+            if (rcDelayCommand == 20)
+                calibratingA = true;
+            rcDelayCommand++;
+        }
+        else if (rcData[YAW] > cfg.rc_max && rcData[PITCH] < cfg.rc_min) // throttle=max, yaw=right, pitch=min
+        {
+            if (rcDelayCommand == 20)
+                f.CALIBRATE_MAG = 1;                                 // MAG calibration request
+            rcDelayCommand++;
+        }
+        else if (rcData[PITCH] > cfg.rc_max)
+        {
+            cfg.angleTrim[PITCH] += 2;
+            writeParams(1);
 #ifdef LEDRING
-                if (feature(FEATURE_LED) && (cfg.LED_Type == 3)) ledringBlink();
+            if (feature(FEATURE_LED) && (cfg.LED_Type == 3)) ledringBlink();
 #endif
-            }
-            else if (rcData[PITCH] < cfg.rc_min)
-            {
-                cfg.angleTrim[PITCH] -= 2;
-                writeParams(1);
+        }
+        else if (rcData[PITCH] < cfg.rc_min)
+        {
+            cfg.angleTrim[PITCH] -= 2;
+            writeParams(1);
 #ifdef LEDRING
-                if (feature(FEATURE_LED) && (cfg.LED_Type == 3)) ledringBlink();
+            if (feature(FEATURE_LED) && (cfg.LED_Type == 3)) ledringBlink();
 #endif
-            }
-            else if (rcData[ROLL] > cfg.rc_max)
-            {
-                cfg.angleTrim[ROLL] += 2;
-                writeParams(1);
+        }
+        else if (rcData[ROLL] > cfg.rc_max)
+        {
+            cfg.angleTrim[ROLL] += 2;
+            writeParams(1);
 #ifdef LEDRING
-                if (feature(FEATURE_LED) && (cfg.LED_Type == 3)) ledringBlink();
+            if (feature(FEATURE_LED) && (cfg.LED_Type == 3)) ledringBlink();
 #endif
-            }
-            else if (rcData[ROLL] < cfg.rc_min)
-            {
-                cfg.angleTrim[ROLL] -= 2;
-                writeParams(1);
+        }
+        else if (rcData[ROLL] < cfg.rc_min)
+        {
+            cfg.angleTrim[ROLL] -= 2;
+            writeParams(1);
 #ifdef LEDRING
-                if (feature(FEATURE_LED) && (cfg.LED_Type == 3)) ledringBlink();
+            if (feature(FEATURE_LED) && (cfg.LED_Type == 3)) ledringBlink();
 #endif
-            }
-            else rcDelayCommand = 0;
         }
+        else rcDelayCommand = 0;
+    }
 
-        if (feature(FEATURE_INFLIGHT_ACC_CAL))
+    if (feature(FEATURE_INFLIGHT_ACC_CAL))
+    {
+        if (AccInflightCalibrationArmed && f.ARMED && rcData[THROTTLE] > cfg.rc_min && !rcOptions[BOXARM])         // Copter is airborne and you are turning it off via boxarm : start measurement
         {
-            if (AccInflightCalibrationArmed && f.ARMED && rcData[THROTTLE] > cfg.rc_min && !rcOptions[BOXARM])     // Copter is airborne and you are turning it off via boxarm : start measurement
-            {
-                InflightcalibratingA = 50;
-                AccInflightCalibrationArmed = 0;
-            }
-            if (rcOptions[BOXPASSTHRU])                              // Use the Passthru Option to activate : Passthru = TRUE Meausrement started, Land and passtrhu = 0 measurement stored
-            {
-                if (!AccInflightCalibrationActive && !AccInflightCalibrationMeasurementDone) InflightcalibratingA = 50;
-            }
-            else if (AccInflightCalibrationMeasurementDone && !f.ARMED)
-            {
-                AccInflightCalibrationMeasurementDone = 0;
-                AccInflightCalibrationSavetoEEProm = 1;
-            }
+            InflightcalibratingA = 50;
+            AccInflightCalibrationArmed = 0;
         }
-
-        GetAuxChannels();
-        DoThrcmmd_DynPid();                                          // Populates rcCommand[THROTTLE] from rcData[THROTTLE] and does empiric pid attenuation
-        
-        if (feature(FEATURE_LCD) && !f.ARMED)
+        if (rcOptions[BOXPASSTHRU])                                  // Use the Passthru Option to activate : Passthru = TRUE Meausrement started, Land and passtrhu = 0 measurement stored
+        {
+            if (!AccInflightCalibrationActive && !AccInflightCalibrationMeasurementDone) InflightcalibratingA = 50;
+        }
+        else if (AccInflightCalibrationMeasurementDone && !f.ARMED)
         {
-            if (rcData[THROTTLE] < cfg.rc_min && rcData[YAW] > cfg.rc_max && rcData[PITCH] > cfg.rc_max) serialOSD();
-            else if (OLED_Type > 0) OLED_Status();
+            AccInflightCalibrationMeasurementDone = 0;
+            AccInflightCalibrationSavetoEEProm = 1;
         }
+    }
 
-        if (!rcOptions[BOXARM]) f.OK_TO_ARM = 1;               // Moved it here
+    GetAuxChannels();
+    DoThrcmmd_DynPid();                                              // Populates rcCommand[THROTTLE] from rcData[THROTTLE] and does empiric pid attenuation
+    
+    if (feature(FEATURE_LCD) && !f.ARMED)
+    {
+        if (rcData[THROTTLE] < cfg.rc_min && rcData[YAW] > cfg.rc_max && rcData[PITCH] > cfg.rc_max) serialOSD();
+        else if (OLED_Type > 0) OLED_Status();
+    }
 
-        if (sensors(SENSOR_BARO) && !GroundAltInitialized) DisArmCopter(); // Keep Copter disarmed until baro init is done
-          
+    if (!rcOptions[BOXARM]) f.OK_TO_ARM = 1;                   // Moved it here
+
+    if (sensors(SENSOR_BARO) && !GroundAltInitialized) DisArmCopter(); // Keep Copter disarmed until baro init is done
+      
 /////// GPS INS TESTCODE
 //				int16_t knob = constrain(rcData[AUX3]-1000,0,1000);
 //				cfg.gps_ins_vel = (500 + (float)knob * 0.5f)/1000.0f;
@@ -349,305 +471,408 @@ void loop(void)
 //				debug[0] = cfg.gps_ins_pos*1000;
 /////// GPS INS TESTCODE
 
-        PHminSat = cfg.gps_ph_minsat;                                // Don't forget to set PH Minsats here!!
+    PHminSat = cfg.gps_ph_minsat;                                    // Don't forget to set PH Minsats here!!
 
-        if (feature(FEATURE_FAILSAFE))
-        {
-            ChkFailSafe();                                           // Only check Failsafe if copter is armed
-            if (failsafeCnt > 2)f.FAILSAFE = 1;                      // Failsafe info for Minimosd
+    if (feature(FEATURE_FAILSAFE))
+    {
+        ChkFailSafe();                                               // Only check Failsafe if copter is armed
+        if (failsafeCnt > 2)f.FAILSAFE = 1;                          // Failsafe info for Minimosd
 	        else f.FAILSAFE = 0;
-        }
-        else
-        {
-            failsafeCnt = 0;
-            FSBaroThrottle = 0;                                      // Set to invalid
-        }
+    }
+    else
+    {
+        failsafeCnt = 0;
+        FSBaroThrottle = 0;                                          // Set to invalid
+    }
 
 //      SPECIAL RTL Crashpilot
 //      Full RTL with Althold+Hightcheck+Autoland+Disarm
-        if (rcOptions[BOXGPSHOME] || rcOptions[BOXGPSHOLD])          // Switch to Angle & MAG mode when GPS is on anyway
-        {
-            rcOptions[BOXHORIZON] = 0;
-            rcOptions[BOXANGLE]   = 1;
-            rcOptions[BOXMAG]     = 1;
-        }
+    if (rcOptions[BOXGPSHOME] || rcOptions[BOXGPSHOLD])              // Switch to Angle & MAG mode when GPS is on anyway
+    {
+        rcOptions[BOXHORIZON] = 0;
+        rcOptions[BOXANGLE]   = 1;
+        rcOptions[BOXMAG]     = 1;
+    }
 
-        if (AutolandState || AutostartState)                         // Switch to Angle mode when AutoBarofunctions anyway
-        {
-            rcOptions[BOXHORIZON] = 0;
-            rcOptions[BOXANGLE]   = 1;
-        }
+    if (AutolandState || AutostartState)                             // Switch to Angle mode when AutoBarofunctions anyway
+    {
+        rcOptions[BOXHORIZON] = 0;
+        rcOptions[BOXANGLE]   = 1;
+    }
 
-#define RTLsettleTime 2000                                           // 2 sec
-        if (sensors(SENSOR_GPS) && sensors(SENSOR_BARO) && f.GPS_FIX_HOME && rcOptions[BOXGPSHOME])
+#define RTLsettleTime 2000                                               // 2 sec
+    if (sensors(SENSOR_GPS) && sensors(SENSOR_BARO) && f.GPS_FIX_HOME && rcOptions[BOXGPSHOME])
+    {
+        rcOptions[BOXBARO]     = 1;                                  // Baro On
+        rcOptions[BOXMAG]      = 1;                                  // MAG ON Idea: Louis
+        rcOptions[BOXGPSHOLD]  = 1;                                  // GPS hold
+        rcOptions[BOXPASSTHRU] = 0;                                  // Passthru off
+        rcOptions[BOXHEADFREE] = 0;                                  // HeadFree off
+        rcOptions[BOXGPSHOME]  = 0;                                  // RTL OFF
+        rcData[THROTTLE] = cfg.rc_mid;                               // Put throttlestick to middle: Althold
+        PHminSat = 5;                                                // Sloppy PH is sufficient
+        if (!RTLstate) RTLstate = 1;                                 // Start RTL Sequence if it isn't already running
+        if (GPS_numSat < 5) RTLstate = 0;                            // Error!
+        if (cfg.rtl_mnd && RTLstate == 1 && GPS_distanceToHome < cfg.rtl_mnd)
+            RTLstate = 0;                                            // Dont Do RTL if too close and RTL not already running
+        
+        switch (RTLstate)
         {
-            rcOptions[BOXBARO]     = 1;                              // Baro On
-            rcOptions[BOXMAG]      = 1;                              // MAG ON Idea: Louis
-            rcOptions[BOXGPSHOLD]  = 1;                              // GPS hold
-            rcOptions[BOXPASSTHRU] = 0;                              // Passthru off
-            rcOptions[BOXHEADFREE] = 0;                              // HeadFree off
-            rcOptions[BOXGPSHOME]  = 0;                              // RTL OFF
-            rcData[THROTTLE] = cfg.rc_mid;                           // Put throttlestick to middle: Althold
-            PHminSat = 5;                                            // Sloppy PH is sufficient
-            if (!RTLstate) RTLstate = 1;                             // Start RTL Sequence if it isn't already running
-            if (GPS_numSat < 5) RTLstate = 0;                        // Error!
-            if (cfg.rtl_mnd && RTLstate == 1 && GPS_distanceToHome < cfg.rtl_mnd)
-                RTLstate = 0;                                        // Dont Do RTL if too close and RTL not already running
-            
-            switch (RTLstate)
+        case 0:                                                      // Error!! Do landing
+            rcData[THROTTLE] = cfg.rc_min - 10;                      // Put throttlestick to lowest-10
+            break;
+        case 1:                                                      // prepare timer
+            RTLGeneralTimer = currentTimeMS + RTLsettleTime;
+            RTLstate++;
+            break;
+        case 2:                                                      // Hover certain time and wait for solid PH
+            if (currentTimeMS > RTLGeneralTimer && ph_status == PH_STATUS_DONE) RTLstate++;
+            break;
+        case 3:                                                      // Check hight and climb if neccessary
+            if (cfg.rtl_mnh)
             {
-            case 0:                                                  // Error!! Do landing
-                rcData[THROTTLE] = cfg.rc_min - 10;                  // Put throttlestick to lowest-10
-                break;
-            case 1:                                                  // prepare timer
-                RTLGeneralTimer = currentTimeMS + RTLsettleTime;
-                RTLstate++;
-                break;
-            case 2:                                                  // Hover certain time and wait for solid PH
-                if (currentTimeMS > RTLGeneralTimer && ph_status == PH_STATUS_DONE) RTLstate++;
-                break;
-            case 3:                                                  // Check hight and climb if neccessary
-                if (cfg.rtl_mnh)
-                {
-                    if (EstAlt < ((uint16_t)cfg.rtl_mnh * 100)) GetClimbrateTorcDataTHROTTLE((int16_t)cfg.rtl_cr);
-                    else RTLstate++;
-                }
-                else RTLstate++;                                     // For safety, skip if turned off
-                break;
-            case 4:                                                  // Wait for Tailstuff before RTL
-                if (cfg.nav_controls_heading)                        // Tail control
-                {
-                    if (cfg.nav_tail_first) magHold = wrap_18000(((float)GPS_directionToHome * 100) - 18000) * 0.01f;
-                    else magHold = GPS_directionToHome;
-                    tmp0 = heading - magHold;                        // tmp0 contains headingdifference
-                    if (tmp0 <= -180) tmp0 += 360;
-                    if (tmp0 >= +180) tmp0 -= 360;
-                    if (abs(tmp0) < 5) RTLstate++;                   // Turns true, when in range of +-5 degrees
-                }
+                if (EstAlt < ((uint16_t)cfg.rtl_mnh * 100)) GetClimbrateTorcDataTHROTTLE((int16_t)cfg.rtl_cr);
                 else RTLstate++;
-                break;
-            case 5:                                                  // Prepare RTL
-                DistanceToHomeMetersOnRTLstart = GPS_distanceToHome; // Set actual distance to Home in meters
-                rcOptions[BOXGPSHOLD] = 0;                           // GPS hold OFF
-                rcOptions[BOXGPSHOME] = 1;                           // Engage RTL
-                RTLstate++;
-                break;
-            case 6:                                                  // OMG Do the f** RTL now
-                rcOptions[BOXGPSHOLD] = 0;                           // GPS hold OFF
-                rcOptions[BOXGPSHOME] = 1;                           // RTL
-                tmp0 = (int16_t)GPS_distanceToHome - DistanceToHomeMetersOnRTLstart; // tmp0 contains flyawayvalue
-                if ((cfg.gps_rtl_flyaway && tmp0 > (int16_t)cfg.gps_rtl_flyaway) ||
-                   (wp_status == WP_STATUS_DONE && ph_status == PH_STATUS_DONE)) RTLstate++;
-                break;
-            case 7:                                                  // Do Autoland
-                rcData[THROTTLE] = cfg.rc_min - 10;                  // Put throttlestick to lowest-10
-                break;                                               // Repeat forever because Autoland will disarm the thing
             }
+            else RTLstate++;                                         // For safety, skip if turned off
+            break;
+        case 4:                                                      // Wait for Tailstuff before RTL
+            if (cfg.nav_controls_heading)                            // Tail control
+            {
+                if (cfg.nav_tail_first) magHold = wrap_18000(((float)GPS_directionToHome * 100) - 18000) * 0.01f;
+                else magHold = GPS_directionToHome;
+                tmp0 = heading - magHold;                            // tmp0 contains headingdifference
+                if (tmp0 <= -180) tmp0 += 360;
+                if (tmp0 >= +180) tmp0 -= 360;
+                if (abs(tmp0) < 5) RTLstate++;                       // Turns true, when in range of +-5 degrees
+            }
+            else RTLstate++;
+            break;
+        case 5:                                                      // Prepare RTL
+            DistanceToHomeMetersOnRTLstart = GPS_distanceToHome; // Set actual distance to Home in meters
+            rcOptions[BOXGPSHOLD] = 0;                               // GPS hold OFF
+            rcOptions[BOXGPSHOME] = 1;                               // Engage RTL
+            RTLstate++;
+            break;
+        case 6:                                                      // OMG Do the f** RTL now
+            rcOptions[BOXGPSHOLD] = 0;                               // GPS hold OFF
+            rcOptions[BOXGPSHOME] = 1;                               // RTL
+            tmp0 = (int16_t)GPS_distanceToHome - DistanceToHomeMetersOnRTLstart; // tmp0 contains flyawayvalue
+            if ((cfg.gps_rtl_flyaway && tmp0 > (int16_t)cfg.gps_rtl_flyaway) ||
+               (wp_status == WP_STATUS_DONE && ph_status == PH_STATUS_DONE)) RTLstate++;
+            break;
+        case 7:                                                      // Do Autoland
+            rcData[THROTTLE] = cfg.rc_min - 10;                      // Put throttlestick to lowest-10
+            break;                                                   // Repeat forever because Autoland will disarm the thing
         }
-        else RTLstate = 0;                                           // No BOXGPSHOME request? Reset Variable
+    }
+    else RTLstate = 0;                                               // No BOXGPSHOME request? Reset Variable
 //      SPECIAL RTL Crashpilot END
 
-        if (rcOptions[BOXANGLE] && sensors(SENSOR_ACC))
+    if (rcOptions[BOXANGLE] && sensors(SENSOR_ACC))
+    {
+        if (!f.ANGLE_MODE)
         {
-            if (!f.ANGLE_MODE)
-            {
-                errorAngleI[ROLL] = errorAngleI[PITCH] = 0;
-                f.ANGLE_MODE = 1;
-            }
+            errorAngleI[ROLL] = errorAngleI[PITCH] = 0;
+            f.ANGLE_MODE = 1;
         }
-        else f.ANGLE_MODE = 0;
+    }
+    else f.ANGLE_MODE = 0;
 
-        if (rcOptions[BOXHORIZON] && sensors(SENSOR_ACC))
+    if (rcOptions[BOXHORIZON] && sensors(SENSOR_ACC))
+    {
+        if (!f.HORIZON_MODE)
         {
-            if (!f.HORIZON_MODE)
-            {
-                errorAngleI[ROLL] = errorAngleI[PITCH] = 0;
-                f.HORIZON_MODE = 1;
-            }
+            errorAngleI[ROLL] = errorAngleI[PITCH] = 0;
+            f.HORIZON_MODE = 1;
         }
-        else f.HORIZON_MODE = 0;
+    }
+    else f.HORIZON_MODE = 0;
 
-        if ((GPS_numSat < 5 || !f.GPS_FIX) &&(f.ANGLE_MODE || f.HORIZON_MODE)) LD1_ON();
-        else LD1_OFF();
+    if ((GPS_numSat < 5 || !f.GPS_FIX) &&(f.ANGLE_MODE || f.HORIZON_MODE)) LD1_ON();
+    else LD1_OFF();
 
-        if (rcOptions[BOXGPSLOG])
-        {
-            if (!f.GPS_LOG_MODE) f.GPS_LOG_MODE = GPSFloppyInitWrite();// Will turn false if not armed or anything else is fucked up
-        } else f.GPS_LOG_MODE = 0;
+    if (rcOptions[BOXGPSLOG])
+    {
+        if (!f.GPS_LOG_MODE) f.GPS_LOG_MODE = GPSFloppyInitWrite();// Will turn false if not armed or anything else is fucked up
+    } else f.GPS_LOG_MODE = 0;
 
 #ifdef BARO
-        if (sensors(SENSOR_BARO))
-        {
-            if (!f.ARMED) {f.BARO_MODE = 0; LastAltThrottle = 0;}    // Reset Baro stuff while not armed
+    if (sensors(SENSOR_BARO))
+    {
+        if (!f.ARMED) {f.BARO_MODE = 0; LastAltThrottle = 0;}        // Reset Baro stuff while not armed
 
-            if (rcOptions[BOXBARO] && GroundAltInitialized)
+        if (rcOptions[BOXBARO] && GroundAltInitialized)
+        {
+            if (!f.BARO_MODE)                                        // Initialize Baromode here if it isn't already
             {
-                if (!f.BARO_MODE)                                    // Initialize Baromode here if it isn't already
-                {
-                    AltRCTimer0 = 0; Althightchange = 0; AutolandState = 0; AutostartState = 0; ThrFstTimeCenter = 0;
-                    AltHold = EstAlt;
-                    if (FSBaroThrottle)
-                    {                                                // Use Baro failsafethrottle here
-                        LastAltThrottle     = FSBaroThrottle;
-                        initialThrottleHold = FSBaroThrottle;
-                    }
-                    else
-                    {
-                        LastAltThrottle     = rcCommand[THROTTLE];
-                        initialThrottleHold = rcCommand[THROTTLE];
-                    }
-                    f.BARO_MODE = 1;                                 // Finally set baromode to initialized
+                AltRCTimer0 = 0; Althightchange = 0; AutolandState = 0; AutostartState = 0; ThrFstTimeCenter = 0;
+                AltHold = EstAlt;
+                if (FSBaroThrottle)
+                {                                                    // Use Baro failsafethrottle here
+                    LastAltThrottle     = FSBaroThrottle;
+                    initialThrottleHold = FSBaroThrottle;
                 }
                 else
-                {                                                    // Baromode initialized check for Autolanding/starting
-                    if(CopterFlying)                                 // Are we somehow airborne?
+                {
+                    LastAltThrottle     = rcCommand[THROTTLE];
+                    initialThrottleHold = rcCommand[THROTTLE];
+                }
+                f.BARO_MODE = 1;                                     // Finally set baromode to initialized
+            }
+            else
+            {                                                        // Baromode initialized check for Autolanding/starting
+                if(CopterFlying)                                     // Are we somehow airborne?
+                {
+                    if(AutostartState)
                     {
-                        if(AutostartState)
+                        if ((abs(rcData[THROTTLE] - cfg.rc_mid) > cfg.rc_dbah))// Autostartus interruptus
                         {
-                            if ((abs(rcData[THROTTLE] - cfg.rc_mid) > cfg.rc_dbah))// Autostartus interruptus
-                            {
-                                AutostartState = 0; ThrFstTimeCenter = 0; Althightchange = 0; AltRCTimer0 = 0;
-                                AltHold             = EstAlt;
-                                initialThrottleHold = LastAltThrottle;
-                            }
-                        }
-                        else
-                        {
-                            if (rcData[THROTTLE] < cfg.rc_min && !AutolandState) AutolandState = 1; // Start Autoland
-                            if (rcData[THROTTLE] > cfg.rc_min && AutolandState)// Autolandus interruptus on Userinput reset some stuff
-                            {
-                                AutolandState = 0; ThrFstTimeCenter = 0; Althightchange = 0; AltRCTimer0 = 0;
-                                AltHold             = EstAlt;
-                                initialThrottleHold = LastAltThrottle;
-                            }
+                            AutostartState = 0; ThrFstTimeCenter = 0; Althightchange = 0; AltRCTimer0 = 0;
+                            AltHold             = EstAlt;
+                            initialThrottleHold = LastAltThrottle;
                         }
                     }
                     else
                     {
-                        if (cfg.as_trgt && !AutostartState && ThrFstTimeCenter) AutostartState = 1; // Start Autostart
+                        if (rcData[THROTTLE] < cfg.rc_min && !AutolandState) AutolandState = 1; // Start Autoland
+                        if (rcData[THROTTLE] > cfg.rc_min && AutolandState)// Autolandus interruptus on Userinput reset some stuff
+                        {
+                            AutolandState = 0; ThrFstTimeCenter = 0; Althightchange = 0; AltRCTimer0 = 0;
+                            AltHold             = EstAlt;
+                            initialThrottleHold = LastAltThrottle;
+                        }
                     }
                 }
-            } else {f.BARO_MODE   = 0; AutolandState = 0; AutostartState = 0;} // No Baroswitch, no Autoland/start
-        } else {f.BARO_MODE   = 0; AutolandState = 0; AutostartState = 0;} // No Baro, no Autoland/start
-#endif
-
-#ifdef MAG
-        if (sensors(SENSOR_MAG) &&  cfg.mag_calibrated)
-        {
-            if (rcOptions[BOXMAG])
-            {
-                if (!f.MAG_MODE)
+                else
                 {
-                    f.MAG_MODE = 1;
-                    magHold = heading;
+                    if (cfg.as_trgt && !AutostartState && ThrFstTimeCenter) AutostartState = 1; // Start Autostart
                 }
             }
-            else f.MAG_MODE = 0;
+        } else {f.BARO_MODE   = 0; AutolandState = 0; AutostartState = 0;} // No Baroswitch, no Autoland/start
+    } else {f.BARO_MODE   = 0; AutolandState = 0; AutostartState = 0;} // No Baro, no Autoland/start
+#endif
 
-            if (rcOptions[BOXHEADFREE])
+#ifdef MAG
+    if (sensors(SENSOR_MAG) &&  cfg.mag_calibrated)
+    {
+        if (rcOptions[BOXMAG])
+        {
+            if (!f.MAG_MODE)
             {
-                if (!f.HEADFREE_MODE) f.HEADFREE_MODE = 1;
+                f.MAG_MODE = 1;
+                magHold = heading;
             }
-            else f.HEADFREE_MODE = 0;
+        }
+        else f.MAG_MODE = 0;
 
-            if (rcOptions[BOXHEADADJ]) headFreeModeHold = heading;   // acquire new heading
+        if (rcOptions[BOXHEADFREE])
+        {
+            if (!f.HEADFREE_MODE) f.HEADFREE_MODE = 1;
         }
+        else f.HEADFREE_MODE = 0;
+
+        if (rcOptions[BOXHEADADJ]) headFreeModeHold = heading;       // acquire new heading
+    }
 #endif
 
-        if (sensors(SENSOR_GPS))
+    if (sensors(SENSOR_GPS))
+    {
+
+        if (f.GPS_FIX && GPS_numSat >= 5)
         {
 
-            if (f.GPS_FIX && GPS_numSat >= 5)
+            if (rcOptions[BOXGPSHOME] && f.GPS_FIX_HOME)             // Crashpilot RTH is possible with 5 Sats for emergency and if homepos is set!
             {
-
-                if (rcOptions[BOXGPSHOME] && f.GPS_FIX_HOME)         // Crashpilot RTH is possible with 5 Sats for emergency and if homepos is set!
+                if (!f.GPS_HOME_MODE)
                 {
-                    if (!f.GPS_HOME_MODE)
-                    {
-                        f.GPS_HOME_MODE = 1;
-                        nav_mode = NAV_MODE_RTL;                     // Set nav_mode before so GPS_set_next_wp can init it.
-                        GPS_set_next_wp(&GPS_home[LAT], &GPS_home[LON]);
-                    }
+                    f.GPS_HOME_MODE = 1;
+                    nav_mode = NAV_MODE_RTL;                         // Set nav_mode before so GPS_set_next_wp can init it.
+                    GPS_set_next_wp(&GPS_home[LAT], &GPS_home[LON]);
                 }
-                else f.GPS_HOME_MODE = 0;
+            }
+            else f.GPS_HOME_MODE = 0;
 
-                if (rcOptions[BOXGPSHOLD] && GPS_numSat >= PHminSat) // Crashpilot Only do poshold with specified Satnr or more
+            if (rcOptions[BOXGPSHOLD] && GPS_numSat >= PHminSat) // Crashpilot Only do poshold with specified Satnr or more
+            {
+                if (!f.GPS_HOLD_MODE)
                 {
-                    if (!f.GPS_HOLD_MODE)
-                    {
-                        f.GPS_HOLD_MODE = 1;
-                        nav_mode = NAV_MODE_POSHOLD;
-                        GPS_set_next_wp(&GPS_coord[LAT], &GPS_coord[LON]);
-                    }
+                    f.GPS_HOLD_MODE = 1;
+                    nav_mode = NAV_MODE_POSHOLD;
+                    GPS_set_next_wp(&GPS_coord[LAT], &GPS_coord[LON]);
                 }
-                else f.GPS_HOLD_MODE = 0;
-
-            }
-            else
-            {
-                f.GPS_HOME_MODE = f.GPS_HOLD_MODE = 0;
-                nav_mode = NAV_MODE_NONE;
             }
+            else f.GPS_HOLD_MODE = 0;
 
-        }                                                            // END of sensors SENSOR_GPS
-
+        }
         else
-
         {
             f.GPS_HOME_MODE = f.GPS_HOLD_MODE = 0;
             nav_mode = NAV_MODE_NONE;
         }
 
-        if (rcOptions[BOXPASSTHRU]) f.PASSTHRU_MODE = 1;
-        else f.PASSTHRU_MODE = 0;
+    }                                                                // END of sensors SENSOR_GPS
 
-        if (cfg.mixerConfiguration == MULTITYPE_FLYING_WING || cfg.mixerConfiguration == MULTITYPE_AIRPLANE) f.HEADFREE_MODE = 0;
+    else
 
-        if (DoingGPS() && cfg.rc_dbgps)                              // Do some additional deadband for GPS, if needed
-        {
-            rcCommand[PITCH] = RCDeadband(rcCommand[PITCH], cfg.rc_dbgps);
-            rcCommand[ROLL]  = RCDeadband(rcCommand[ROLL],  cfg.rc_dbgps);
-        }
+    {
+        f.GPS_HOME_MODE = f.GPS_HOLD_MODE = 0;
+        nav_mode = NAV_MODE_NONE;
+    }
 
-        if (f.HEADFREE_MODE) DoRcHeadfree();                         // Rotates Rc commands according mag and homeheading in headfreemode
-        if (cfg.rc_killt)    DoKillswitch();                         // AT THE VERY END DO SOME KILLSWITCHSTUFF, IF WANTED
+    if (rcOptions[BOXPASSTHRU]) f.PASSTHRU_MODE = 1;
+    else f.PASSTHRU_MODE = 0;
 
-// *********** END OF 50Hz RC LOOP ***********
-    }
-    else
+    if (cfg.mixerConfiguration == MULTITYPE_FLYING_WING || cfg.mixerConfiguration == MULTITYPE_AIRPLANE) f.HEADFREE_MODE = 0;
+
+    if (DoingGPS() && cfg.rc_dbgps)                                  // Do some additional deadband for GPS, if needed
     {
-        DoLEDandBUZZER();                                            // Do that, if not doing RC stuff
+        rcCommand[PITCH] = RCDeadband(rcCommand[PITCH], cfg.rc_dbgps);
+        rcCommand[ROLL]  = RCDeadband(rcCommand[ROLL],  cfg.rc_dbgps);
     }
 
-#ifdef SONAR
-    if (sensors(SENSOR_SONAR) && GroundAltInitialized) Sonar_update();// Update "SonarStatus". Do it here because HC-SR04 will produce delay
-#endif
+    if (f.HEADFREE_MODE) DoRcHeadfree();                             // Rotates Rc commands according mag and homeheading in headfreemode
+    if (cfg.rc_killt)    DoKillswitch();                             // AT THE VERY END DO SOME KILLSWITCHSTUFF, IF WANTED
 
-#ifdef MAG
-    if (sensors(SENSOR_MAG)) Mag_getADC();
-#endif
+// *********** END OF 50Hz RC LOOP ***********
+}
+
+static void computePID(void)                                         // rcCommand, gyroData and angle to axisPID, real_t throughout
+{
+    real_t          error, errorAngle, AngleRateTmp, RateError, delta, deltaSum, gyro;
+    real_t          PTerm, ITerm, PTermACC = 0, ITermACC = 0, PTermGYRO = 0, ITermGYRO = 0, DTerm;
+    real_t          tmp0r, MwiiTimescale;
+    float           tmp0flt;
+    int16_t         prop;
+    uint8_t         axis;
+
+    tmp0flt       = (float)max(cycleTime, 1);                        // The fixedpoint build divides by it
+    MwiiTimescale = ftor(tmp0flt * 3.3333333e-4f);
+    prop          = min(max(abs(rcCommand[PITCH]),abs(rcCommand[ROLL])),500);
 
-    currentTimeMS = millis();                                        // Feed values if needed in outer timeloop
-    currentTime   = micros();
-    if (currentTime - LastLoopTime < cfg.looptime)                   // Waste away some time?
+    switch (cfg.mainpidctrl)
     {
-        serialCom();                                                 // Yes! Do serial then
-        LastSerialTimeMS = currentTimeMS;
-        return;                                                      // Return to main "while" endless loop
+    case 0:                                                          // 0 = OriginalMwiiPid pimped by me
+        for (axis = 0; axis < 3; axis++)
+        {
+            gyro = ftor(gyroData[axis]);
+            if ((f.ANGLE_MODE || f.HORIZON_MODE) && axis < YAW)      // MODE relying on ACC 50 degrees max inclination
+            {
+                errorAngle  = constrain(itor(2 * rcCommand[axis]) + ftor(GPS_angle[axis]), REAL(-500), REAL(500)) - ftor(angle[axis]) + itor(cfg.angleTrim[axis]); //  Removed INFO BRM errorAngle = errorAngle * (float)cycleTime / BasePIDtime; // Crashpilot: Include Cylcletime take 3ms as basis. More deltaT more error
+                PTermACC    = rscale(errorAngle, cfg.P8[PIDLEVEL], 100);
+                tmp0r       = itor(cfg.D8[PIDLEVEL] * 5);
+                PTermACC    = constrain(PTermACC, -tmp0r, +tmp0r);
+                errorAngle  = rmul(errorAngle, MwiiTimescale);
+                errorAngleI[axis] = constrain(errorAngleI[axis] + errorAngle, REAL(-10000), REAL(10000));
+                ITermACC    = rscale(errorAngleI[axis], cfg.I8[PIDLEVEL], 4096);
+            }
+
+            if (!f.ANGLE_MODE || f.HORIZON_MODE || axis == YAW)      // MODE relying on GYRO or YAW axis
+            {
+                error  = rscale(itor(rcCommand[axis]), 80, max(cfg.P8[axis], 1)); // Removed INFO BRM error  = error * (float)cycleTime / BasePIDtime;     // Crashpilot: Include Cylcletime take 3ms as basis. More deltaT more error
+                error -= gyro;
+                PTermGYRO = itor(rcCommand[axis]);
+                error  = rmul(error, MwiiTimescale);
+                errorGyroI[axis] = constrain(errorGyroI[axis] + error, REAL(-16000), REAL(16000));
+                if (abs(gyro) > REAL(640)) errorGyroI[axis] = 0;
+                ITermGYRO = rscale(errorGyroI[axis], cfg.I8[axis], 8000);
+            }
+
+            if (f.HORIZON_MODE && axis < YAW)
+            {
+                PTerm = rscale(PTermACC, 500 - prop, 500) + rscale(PTermGYRO, prop, 500);
+                ITerm = rscale(ITermACC, 500 - prop, 500) + rscale(ITermGYRO, prop, 500);
+            }
+            else
+            {
+                if (f.ANGLE_MODE && axis < YAW)
+                {
+                    PTerm = PTermACC;
+                    ITerm = ITermACC;
+                }
+                else
+                {
+                    PTerm = PTermGYRO;
+                    ITerm = ITermGYRO;
+                }
+            }
+            PTerm          -= rmul(gyro, rscale(dynP8[axis], 1, 80));
+            delta           = rdiv(gyro - lastGyro[axis], MwiiTimescale);
+            lastGyro[axis]  = gyro;
+            deltaSum        = delta1[axis] + delta2[axis] + delta;
+            delta2[axis]    = delta1[axis];
+            delta1[axis]    = delta;
+            deltaSum        = rbiquad3ApplyAxis(&DTermLpf, axis, deltaSum);
+            DTerm           = rmul(deltaSum, rscale(dynD8[axis], 1, 32));
+            axisPID[axis]   = rtoi(PTerm + ITerm - DTerm);
+        }
+        break;      
+
+// Alternative Controller by alex.khoroshko http://www.multiwii.com/forum/viewtopic.php?f=8&t=3671&start=30#p37465
+    case 1:                                                          // 1 = New mwii controller (float pimped + D low-pass)
+        for (axis = 0; axis < 3; axis++)                             // Get the desired angle rate depending on flight mode
+        {
+            if ((f.ANGLE_MODE || f.HORIZON_MODE) && axis < YAW)      // MODE relying on ACC
+            {
+                errorAngle = constrain(itor(2 * rcCommand[axis]) + ftor(GPS_angle[axis]), REAL(-500), REAL(500)) - ftor(angle[axis]) + itor(cfg.angleTrim[axis]);
+            }
+            if (axis == YAW)
+            {
+                AngleRateTmp = rscale(itor(rcCommand[axis]), cfg.yawRate + 27, 32); // AngleRateTmp = (((int32_t)(cfg.yawRate + 27) * rcCommand[2]) >> 5);
+            }
+            else
+            {
+                if (!f.ANGLE_MODE)                                   //control is GYRO based (ACRO and HORIZON - direct sticks control is applied to rate PID
+                {
+                    AngleRateTmp = rscale(itor(rcCommand[axis]), cfg.rollPitchRate + 27, 16); // AngleRateTmp = ((int32_t) (cfg.rollPitchRate + 27) * rcCommand[axis]) >> 4;
+                    if (f.HORIZON_MODE)
+                    {
+                        AngleRateTmp += rscale(errorAngle, cfg.I8[PIDLEVEL] * 5, 128); //increased by x10 //0.00390625f AngleRateTmp += (errorAngle * (float)cfg.I8[PIDLEVEL]) >> 8;
+                    }
+                }
+                else
+                {
+                    AngleRateTmp = rscale(errorAngle, cfg.P8[PIDLEVEL] * 5, 224); // AngleRateTmp = (errorAngle * (float)cfg.P8[PIDLEVEL]) >> 4; * LevelPprescale;
+                }
+            }
+            RateError         = AngleRateTmp - ftor(gyroData[axis]);
+            PTerm             = rscale(RateError, cfg.P8[axis], 128);
+            errorGyroI[axis] += rscale(RateError, (int32_t)cfg.I8[axis] * cycleTime, 2048 * 8192); // Kept in ITerm units, was * I8 * cycleTime / 2048 and / 8192 on use
+            errorGyroI[axis]  = constrain(errorGyroI[axis], -newpidimax, newpidimax);
+            ITerm             = errorGyroI[axis];
+            delta             = RateError - lastError[axis];
+            lastError[axis]   = RateError;
+            delta             = rscale(delta, 65535, max(cycleTime, 1) * 4); // * 16383.75 / cycleTime
+            deltaSum          = delta1[axis] + delta2[axis] + delta;
+            delta2[axis]      = delta1[axis];
+            delta1[axis]      = delta;
+            deltaSum          = rbiquad3ApplyAxis(&DTermLpf, axis, deltaSum);
+            DTerm             = rscale(deltaSum, cfg.D8[axis], 256);
+            axisPID[axis]     = rtoi(PTerm + ITerm + DTerm);
+        }
+        break;
     }
-    LastLoopTime = currentTime;
+}
+
+static void taskControl(void)
+{
+    float           CosYawxPhase, SinYawyPhase, TmpPhase;
+    int16_t         tmp0, thrdiff;
 
+    perfStart(PERF_IMU);
     computeIMU();                                                    // looptime Timeloop starts here on predefined basis
+    perfStop(PERF_IMU);
     currentTimeMS = millis();
     currentTime   = micros();		                                     // Crashpilot moved it here
-    cycleTime     = currentTime - previousTime;
-    previousTime  = currentTime;
+    cycleTime     = (drdyActive ? drdySampleTime : currentTime) - previousTime; // gy_drdy: dt between the samples, not the task starts
+    previousTime  = drdyActive ? drdySampleTime : currentTime;
 
 #ifdef BARO
-    if (sensors(SENSOR_BARO))                                        // The normal stuff to keep it simple
+    if (sensors(SENSOR_BARO))
     {
-        Baro_update();
-        getEstimatedAltitude();                                      // Combine with sonar if possible
+        perfStart(PERF_ALT);
+        getEstimatedAltitude();                                      // Combine with sonar if possible. Baro_update has its own task
+        perfStop(PERF_ALT);
     }
   
 #define HoverTimeBeforeLand     2000                                 // Wait 2 sec in the air for VirtualThrottle to catch up
@@ -847,7 +1072,9 @@ void loop(void)
 
     if (sensors(SENSOR_GPS) && sensors(SENSOR_MAG))                  // Only do GPS stuff if the Mag is available
     {
+        perfStart(PERF_GPS);
         GPS_alltime();                                               // Do INS GPS stuff here
+        perfStop(PERF_GPS);
 
 // GPS/MAG/BARO LOGGING
         if (f.GPS_LOG_MODE && currentTimeMS >= GPSlogTimer)          // Do logging Lat/Lon/Alt/Hdg every 2 secs. Conditions are checked in WriteNextFloppyDataset()
@@ -872,8 +1099,8 @@ void loop(void)
                 if (TmpPhase > 180.0f) TmpPhase = TmpPhase - 360.0f; // Wrap to -180 0 +180 Degree
                 else if (TmpPhase < -180.0f) TmpPhase = TmpPhase + 360.0f;
                 TmpPhase     = TmpPhase * RADX;                      // Degree to RAD
-                CosYawxPhase = cosf(TmpPhase);
-                SinYawyPhase = sinf(TmpPhase);              
+                CosYawxPhase = fastCos(TmpPhase);
+                SinYawyPhase = fastSin(TmpPhase);              
             }
             else
             {
@@ -896,120 +1123,9 @@ void loop(void)
         }
     } else GPS_angle[0] = GPS_angle[1] = 0;
 
-    tmp0flt = (float)cycleTime;
-    MwiiTimescale = tmp0flt * 3.3333333e-4f;
-    dT   = tmp0flt * 0.000001f;                                      // pt1 element http://www.multiwii.com/forum/viewtopic.php?f=23&t=2624
-    prop = (float)min(max(abs(rcCommand[PITCH]),abs(rcCommand[ROLL])),500);
-
-    switch (cfg.mainpidctrl)
-    {
-    case 0:                                                          // 0 = OriginalMwiiPid pimped by me
-        for (axis = 0; axis < 3; axis++)
-        {
-            if ((f.ANGLE_MODE || f.HORIZON_MODE) && axis < YAW)      // MODE relying on ACC 50 degrees max inclination
-            {
-                errorAngle  = constrain(2.0f * (float)rcCommand[axis] + GPS_angle[axis], -500.0f, +500.0f) - angle[axis] + (float)cfg.angleTrim[axis]; //  Removed INFO BRM errorAngle = errorAngle * (float)cycleTime / BasePIDtime; // Crashpilot: Include Cylcletime take 3ms as basis. More deltaT more error
-                PTermACC    = errorAngle * (float)cfg.P8[PIDLEVEL] * 0.01f;
-                tmp0flt     = (float)cfg.D8[PIDLEVEL] * 5.0f;
-                PTermACC    = constrain(PTermACC, -tmp0flt, +tmp0flt);
-                errorAngle *= MwiiTimescale;
-                errorAngleI[axis] = constrain(errorAngleI[axis] + errorAngle, -10000.0f, +10000.0f);
-                ITermACC    = (errorAngleI[axis] * (float)cfg.I8[PIDLEVEL]) / 4096.0f;
-            }
-
-            if (!f.ANGLE_MODE || f.HORIZON_MODE || axis == YAW)      // MODE relying on GYRO or YAW axis
-            {
-                error  = (float)rcCommand[axis] * 80.0f / (float)cfg.P8[axis]; // Removed INFO BRM error  = error * (float)cycleTime / BasePIDtime;     // Crashpilot: Include Cylcletime take 3ms as basis. More deltaT more error
-                error -= gyroData[axis];
-                PTermGYRO = (float)rcCommand[axis];
-                error *= MwiiTimescale;
-                errorGyroI[axis] = constrain(errorGyroI[axis] + error, -16000.0f, +16000.0f);
-                if (abs(gyroData[axis]) > 640.0f) errorGyroI[axis] = 0;
-                ITermGYRO = errorGyroI[axis] * (float)cfg.I8[axis] * 0.000125f;
-            }
-
-            if (f.HORIZON_MODE && axis < YAW)
-            {
-                PTerm = (PTermACC * (500.0f - prop) + PTermGYRO * prop) * 0.002f;
-                ITerm = (ITermACC * (500.0f - prop) + ITermGYRO * prop) * 0.002f;
-            }
-            else
-            {
-                if (f.ANGLE_MODE && axis < YAW)
-                {
-                    PTerm = PTermACC;
-                    ITerm = ITermACC;
-                }
-                else
-                {
-                    PTerm = PTermGYRO;
-                    ITerm = ITermGYRO;
-                }
-            }
-            PTerm          -= (gyroData[axis] * dynP8[axis] * 0.0125f);
-            delta           = (gyroData[axis] - lastGyro[axis]) / MwiiTimescale;
-            lastGyro[axis]  = gyroData[axis];
-            deltaSum        = delta1[axis] + delta2[axis] + delta;
-            delta2[axis]    = delta1[axis];
-            delta1[axis]    = delta;
-            if (cfg.mainpt1cut)						                     // pt1 element http://www.multiwii.com/forum/viewtopic.php?f=23&t=2624
-            {
-                deltaSum        = lastDTerm[axis] + (dT / (MainDpt1Cut + dT)) * (deltaSum - lastDTerm[axis]);
-                lastDTerm[axis] = deltaSum;
-            }
-            DTerm           = deltaSum * dynD8[axis] * 0.03125f;
-            axisPID[axis]   = PTerm + ITerm - DTerm;
-        }
-        break;      
-
-// Alternative Controller by alex.khoroshko http://www.multiwii.com/forum/viewtopic.php?f=8&t=3671&start=30#p37465
-    case 1:                                                          // 1 = New mwii controller (float pimped + pt1element)
-        for (axis = 0; axis < 3; axis++)                             // Get the desired angle rate depending on flight mode
-        {
-            if ((f.ANGLE_MODE || f.HORIZON_MODE) && axis < YAW)      // MODE relying on ACC
-            {
-                errorAngle = constrain(2.0f * (float)rcCommand[axis] + GPS_angle[axis], -500.0f, +500.0f) - angle[axis] + (float)cfg.angleTrim[axis];
-            }
-            if (axis == YAW)
-            {
-                AngleRateTmp = (float)((float)(cfg.yawRate + 27) * (float)rcCommand[axis]) * 0.03125f; // AngleRateTmp = (((int32_t)(cfg.yawRate + 27) * rcCommand[2]) >> 5);
-            }
-            else
-            {
-                if (!f.ANGLE_MODE)                                   //control is GYRO based (ACRO and HORIZON - direct sticks control is applied to rate PID
-                {
-                    AngleRateTmp = (float)((float)(cfg.rollPitchRate + 27) * (float)rcCommand[axis]) * 0.0625f; // AngleRateTmp = ((int32_t) (cfg.rollPitchRate + 27) * rcCommand[axis]) >> 4;
-                    if (f.HORIZON_MODE)
-                    {
-                        AngleRateTmp += (float)((float)cfg.I8[PIDLEVEL] * errorAngle) * 0.0390625f; //increased by x10 //0.00390625f AngleRateTmp += (errorAngle * (float)cfg.I8[PIDLEVEL]) >> 8;
-                    }
-                }
-                else
-                {
-                    AngleRateTmp = (float)((float)cfg.P8[PIDLEVEL] * errorAngle) * 0.0223214286f; // AngleRateTmp = (errorAngle * (float)cfg.P8[PIDLEVEL]) >> 4; * LevelPprescale;
-                }
-            }
-            RateError         = AngleRateTmp - gyroData[axis];
-            PTerm             = (float)((float)cfg.P8[axis] * RateError) * 0.0078125f;
-            errorGyroI[axis] += ((float)cfg.I8[axis] * RateError * (float)cycleTime) / 2048.0f;
-            errorGyroI[axis]  = constrain(errorGyroI[axis], -newpidimax, newpidimax);
-            ITerm             = errorGyroI[axis] / 8192.0f;
-            delta             = RateError - lastError[axis];
-            lastError[axis]   = RateError;
-            delta             = delta * (16383.75f / (float)cycleTime);
-            deltaSum          = delta1[axis] + delta2[axis] + delta;
-            delta2[axis]      = delta1[axis];
-            delta1[axis]      = delta;
-            if (cfg.mainpt1cut)						                     // pt1 element http://www.multiwii.com/forum/viewtopic.php?f=23&t=2624
-            {
-                deltaSum        = lastDTerm[axis] + (dT / (MainDpt1Cut + dT)) * (deltaSum - lastDTerm[axis]);
-                lastDTerm[axis] = deltaSum;
-            }
-            DTerm             = (float)((float)cfg.D8[axis] * deltaSum) * 0.00390625f;
-            axisPID[axis]     = PTerm + ITerm + DTerm;
-        }
-        break;
-    }
+    perfStart(PERF_PID);
+    computePID();
+    perfStop(PERF_PID);
     
     if (f.ARMED)
     {
@@ -1029,22 +1145,20 @@ void loop(void)
       
     }
     
+    perfStart(PERF_MIXER);
     mixTable();
+    perfStop(PERF_MIXER);
+    perfStart(PERF_MOTORS);
     writeServos();
     writeMotors();
-    DoMotorStats(false);                                             // False means no hoverthrottlegeneration for failsafe
-
-    if (currentTimeMS - LastSerialTimeMS >= 10)                      // If Serial wasn't possible during timewaste (user set looptime too small), do it now and ensure 100Hz
-    {
-        serialCom();
-        LastSerialTimeMS = currentTimeMS;
-    }
+    perfStop(PERF_MOTORS);
+    blackboxLog();
 }
 
 // END OF MAINLOOP
-static int16_t DoMotorStats(bool JustDoRcThrStat)
+static int16_t DoMotorStats(bool JustDoRcThrStat)                   // Statistics part is TASK_MOTORSTATS at 10Hz
 {
-    static uint32_t motortotal[MAX_MONITORED_MOTORS], DatasetCnt, LastMotorStatTimeMS;
+    static uint32_t motortotal[MAX_MONITORED_MOTORS], DatasetCnt;
     static uint8_t  maxmotnr, motcasestate = 0;
     uint32_t Onepercent, Sum;
     uint8_t i;
@@ -1057,35 +1171,31 @@ static int16_t DoMotorStats(bool JustDoRcThrStat)
         return Sum / maxmotnr;
     }
 
-    if (currentTimeMS - LastMotorStatTimeMS >= 100)                  // Do Motorstats at 10 Hz rate
+    switch(motcasestate)
     {
-        LastMotorStatTimeMS = currentTimeMS;
-        switch(motcasestate)
+    case 0:                                                          // Bootuprun / Reset state
+        for (i = 0; i < MAX_MONITORED_MOTORS; i++) motortotal[i] = 0; // Clear sum
+        DatasetCnt = 0;
+        maxmotnr = min(NumberOfMotors, MAX_MONITORED_MOTORS);        
+        if (f.ARMED) motcasestate++;                                 // Wait for Arming
+        break;
+    case 1:                                                          // Collect data here
+        if (f.ARMED)
         {
-        case 0:                                                      // Bootuprun / Reset state
-            for (i = 0; i < MAX_MONITORED_MOTORS; i++) motortotal[i] = 0; // Clear sum
-            DatasetCnt = 0;
-            maxmotnr = min(NumberOfMotors, MAX_MONITORED_MOTORS);        
-            if (f.ARMED) motcasestate++;                             // Wait for Arming
-            break;
-        case 1:                                                      // Collect data here
-            if (f.ARMED)
-            {
-                for (i = 0; i < maxmotnr; i++) motortotal[i] += motor[i] - cfg.esc_min;
-                DatasetCnt++; 
-            } else motcasestate++;                                   // Disarmed! Go on to calculate
-            break;
-        case 2:                                                      // Calculate percentage and reset statemachine
-            Onepercent = 0;
-            for (i = 0; i < maxmotnr; i++)
-            {
-                Onepercent += motortotal[i] / 100;                   // Overflow very unlikely but /100 saves us anyway. Precision is not relevant.
-                motorabspwm[i] = (motortotal[i] / DatasetCnt) + cfg.esc_min;
-            }
-            for (i = 0; i < maxmotnr; i++) motorpercent[i] = motortotal[i] / Onepercent;
-            motcasestate = 0;
-            break;
+            for (i = 0; i < maxmotnr; i++) motortotal[i] += motor[i] - cfg.esc_min;
+            DatasetCnt++; 
+        } else motcasestate++;                                       // Disarmed! Go on to calculate
+        break;
+    case 2:                                                          // Calculate percentage and reset statemachine
+        Onepercent = 0;
+        for (i = 0; i < maxmotnr; i++)
+        {
+            Onepercent += motortotal[i] / 100;                       // Overflow very unlikely but /100 saves us anyway. Precision is not relevant.
+            motorabspwm[i] = (motortotal[i] / DatasetCnt) + cfg.esc_min;
         }
+        for (i = 0; i < maxmotnr; i++) motorpercent[i] = motortotal[i] / Onepercent;
+        motcasestate = 0;
+        break;
     }
     return 0;                                                        // Not necessary
 }
@@ -1209,8 +1319,8 @@ static void DoThrcmmd_DynPid(void)
             rcCommand[axis] = tmp;
             prop1 -= (uint16_t)cfg.yawRate * tmp / 500;
         }
-        dynP8[axis] = (float)cfg.P8[axis] * prop1 / 100;          // dynI8[axis] = (uint16_t) cfg.I8[axis] * prop1 / 100;
-        dynD8[axis] = (float)cfg.D8[axis] * prop1 / 100;
+        dynP8[axis] = rscale(itor(cfg.P8[axis]), prop1, 100);     // dynI8[axis] = (uint16_t) cfg.I8[axis] * prop1 / 100;
+        dynD8[axis] = rscale(itor(cfg.D8[axis]), prop1, 100);
         if (rcData[axis] < cfg.rc_mid) rcCommand[axis] = -rcCommand[axis];
     }
     tmp = constrain(rcData[THROTTLE], cfg.rc_min, 2000);
@@ -1227,8 +1337,8 @@ static void DoRcHeadfree(void)
     if (radDiff > 180.0f)       radDiff = radDiff - 360.0f;      // Wrap to -180 0 +180 Degree
     else if (radDiff < -180.0f) radDiff = radDiff + 360.0f;
     radDiff = radDiff * RADX;                                    // Degree to RAD
-    cosDiff = cosf(radDiff);
-    sinDiff = sinf(radDiff);
+    cosDiff = fastCos(radDiff);
+    sinDiff = fastSin(radDiff);
     rcCommand_PITCH  = (float)rcCommand[PITCH] * cosDiff + (float)rcCommand[ROLL]  * sinDiff;
     rcCommand[ROLL]  = (float)rcCommand[ROLL]  * cosDiff - (float)rcCommand[PITCH] * sinDiff;
     rcCommand[PITCH] = rcCommand_PITCH;
@@ -1377,7 +1487,7 @@ static void DoLEDandBUZZER(void)
 
     buzzer(buzzerFreq);                                              // external buzzer routine that handles buzzer events globally now
 
-    if ((calibratingA && sensors(SENSOR_ACC)) || calibratingG)
+    if ((calibratingA && sensors(SENSOR_ACC)) || calibratingG || (f.CALIBRATE_MAG && sensors(SENSOR_MAG) && !f.ARMED)) // Mag cal may run in flight, LED0 shows armed there
     {
         LED0_TOGGLE;                                                 // Calibration phasis
     }
@@ -1633,4 +1743,9 @@ float devStandardDeviation(stdev_t *dev)
 {
     return sqrtf(devVariance(dev));
 }
+
+float devMean(stdev_t *dev)
+{
+    return dev->m_n ? dev->m_newM : 0.0f;
+}
 // SOME OTHER FUNCTIONS END
@@ -18,12 +18,54 @@
 #define ACCZ_25deg       464.029587f        // acc_1G * cos(3.1415927/180*25)
 #define SQacc_1G         262144
 
+// Numeric layer of the PID controllers and the mixer. float by default, OPTIONS=FIXEDPOINT makes it Q20.12
+// (+-524287, resolution 1/4096) with 64 bit intermediates, no soft-float on the F103 in these paths.
+// rscale(a, n, d) is a * n / d with integer n, d. Constant d gets folded into a multiply in the float build.
+#ifdef FIXEDPOINT
+typedef int32_t real_t;
+#define REAL(x)          ((real_t)((x) * 4096.0f + ((x) >= 0 ? 0.5f : -0.5f))) // Constants only
+#define itor(i)          ((real_t)(i) * 4096)
+#define ftor(x)          ((real_t)((x) * 4096.0f))
+#define rtof(r)          ((float)(r) * (1.0f / 4096.0f))
+#define rtoi(r)          ((r) >= 0 ? (r) >> 12 : -((-(r)) >> 12))     // Truncates like a float to int cast
+#define rmul(a, b)       ((real_t)(((int64_t)(a) * (b)) >> 12))
+#define rmuli(a, i)      ((a) * (i))
+#define rdiv(a, b)       ((real_t)(((int64_t)(a) * 4096) / (b)))
+#define rscale(a, n, d)  ((real_t)((int64_t)(a) * (n) / (d)))
+#else
+typedef float   real_t;
+#define REAL(x)          ((float)(x))
+#define itor(i)          ((float)(i))
+#define ftor(x)          ((float)(x))
+#define rtof(r)          ((float)(r))
+#define rtoi(r)          ((int32_t)(r))
+#define rmul(a, b)       ((a) * (b))
+#define rmuli(a, i)      ((a) * (float)(i))
+#define rdiv(a, b)       ((a) / (b))
+#define rscale(a, n, d)  ((a) * (float)(n) * (1.0f / (float)(d)))
+#endif
+
 typedef struct stdev_t
 {
     float m_oldM, m_newM, m_oldS, m_newS;
     int m_n;
 } stdev_t;
 
+typedef struct sphereFit_t                  // Running sums for the streaming sphere fit, see sensors.c
+{
+    float    x, y, z, x2, y2, z2, x3, y3, z3;
+    float    xy, xz, yz, x2y, x2z, y2x, y2z, z2x, z2y;
+    uint32_t n;
+} sphereFit_t;
+
+typedef struct ellipsoidFit_t               // Normal equations of the 9 parameter ellipsoid fit, see sensors.c
+{
+    float    ata[45];                       // Upper triangle of A'A
+    float    atb[9];
+    float    scale;                         // 1 / length of the first point
+    uint32_t n;
+} ellipsoidFit_t;
+
 // Serial GPS only variables
 typedef enum NavigationMode
 {
@@ -186,6 +228,40 @@ typedef struct motorMixer_t
     float yaw;
 } motorMixer_t;
 
+typedef struct motorMixerReal_t             // Runtime copy of the mix in the PID numeric layer, see mixer.c
+{
+    real_t throttle;
+    real_t roll;
+    real_t pitch;
+    real_t yaw;
+} motorMixerReal_t;
+
+typedef struct kalman3_t                    // One axis: position, velocity, acc bias. See kalman.c
+{
+    float x[3];
+    float P[6];                             // Symmetric covariance 00 01 02 11 12 22
+} kalman3_t;
+
+typedef struct biquad3_t                    // Biquad for three axes, shared coefficients, state per axis. See filter.c
+{
+    float b0, b1, b2, a1, a2;
+    float s1[3], s2[3];
+    bool  enabled;
+} biquad3_t;
+
+#ifdef FIXEDPOINT
+typedef struct rbiquad3_t                   // biquad3_t on real_t: Q28 coefficients, state Q40 in 64 bit. See filter.c
+{
+    int32_t b0, b1, b2, a1, a2;
+    int64_t s1[3], s2[3];
+    bool    enabled;
+} rbiquad3_t;
+#else
+typedef biquad3_t rbiquad3_t;
+#define rbiquad3Lowpass   biquad3Lowpass
+#define rbiquad3ApplyAxis biquad3ApplyAxis
+#endif
+
 typedef struct mixer_t
 {
     uint8_t numberMotor;
@@ -208,8 +284,8 @@ typedef struct config_t
     uint8_t  mixerConfiguration;
     uint32_t enabledFeatures;
     uint16_t looptime;                      // imu loop time in us
-    uint8_t  mainpidctrl;                   // 0 = OriginalMwiiPid pimped by me, 1 = New mwii controller (experimental, float pimped + pt1)
-    uint8_t  mainpt1cut;                    // (0-50Hz) 0 Disables pt1element. Cuf Off Frequency for pt1 element D term in Hz of main Pid controller
+    uint8_t  mainpidctrl;                   // 0 = OriginalMwiiPid pimped by me, 1 = New mwii controller (experimental, float pimped + D low-pass)
+    uint8_t  maindcut;                      // (0-200Hz) 0 = off. Cut off frequency of the biquad low-pass on the D term of the main Pid controller
     uint16_t newpidimax;                    // [10-65000) 256 Default. Imax for Gyropart (incl. Yaw) of new Pidcontroller
     uint8_t  gpspt1cut;                     // (1-50Hz) Cuf Off Frequency for D term in Hz of GPS Pid controller 
     uint8_t  P8[PIDITEMS];
@@ -225,6 +301,7 @@ typedef struct config_t
     float    accZero[3];
     float    sens_1G;
     float    magZero[3];
+    float    magSoft[3][3];                 // Soft iron matrix from the ellipsoid fit, identity otherwise
 #ifdef debugmode
     float    accstddev[3];
 #endif
@@ -233,23 +310,39 @@ typedef struct config_t
     int16_t  mag_dec;                       // Get your magnetic decliniation from here : http://magnetic-declination.com/
     uint8_t  mag_time;                      // Mag calib time in minutes
     uint8_t  mag_gain;                      // 0(default) = 1.9 GAUSS ; 1 = 2.5 GAUSS (problematic copters)
+    uint8_t  mag_ellip;                     // 1 = Mag calibration fits an ellipsoid (hard & soft iron), 0 = sphere (hard iron only)
+    uint8_t  mag_aux;                       // 1 = HMC5883L is read by the i2c master of the MPU6050, comes with the gyro / acc burst
     int16_t  angleTrim[2];                  // accelerometer trim
     // sensor-related stuff
     int8_t   align[3][3];                   // acc, gyro, mag alignment (ex: with sensor output of X, Y, Z, align of 1 -3 2 would return X, -Z, Y)
     uint8_t  acc_hdw;                       // Which acc hardware to use on boards with more than one device
     uint8_t  acc_lpf;                       // Set the Low Pass Filter factor for ACC. Increasing this value would reduce ACC noise (visible in GUI), but would increase ACC lag time. Zero = no filter
     uint16_t gy_lpf;                        // mpuX050 LPF setting (TODO make it work on L3GD as well)
+    uint8_t  gy_fifo;                       // 1 = MPU6050 FIFO at 1KHz, every gyro sample is integrated (coning corrected), not just one per loop
+    uint8_t  gy_drdy;                       // 1 = Control loop runs on the MPU6050 data ready interrupt (MPU_INT), looptime in whole 1KHz samples
     uint16_t gy_cmpf;                       // Set the Gyro Weight for Gyro/Acc complementary filter. Increasing this value would reduce and delay Acc influence on the output of the filter.
     uint16_t gy_cmpfm;
-    uint8_t  gy_smrll;
-    uint8_t  gy_smptc;
-    uint8_t  gy_smyw;
+    uint8_t  imu_mode;                      // 0 = EstG/EstM complementary filter, 1 = Quaternion with Mahony PI correction
+    float    imu_kp;                        // Mahony proportional gain (1/s) on the acc/mag error
+    float    imu_ki;                        // Mahony integral gain (1/s^2), gyro bias estimation. 0 = off
+    uint16_t gy_lpfcut;                     // Biquad low-pass on gyroData (Pid input) in Hz, 0 = off
+    uint16_t gy_ntch1;                      // Gyro notch 1 centre frequency in Hz, 0 = off
+    uint8_t  gy_ntch1q;                     // Notch 1 Q * 10, bandwidth is gy_ntch1 / Q
+    uint16_t gy_ntch2;                      // Gyro notch 2 centre frequency in Hz, 0 = off
+    uint8_t  gy_ntch2q;                     // Notch 2 Q * 10
+    uint8_t  gy_lpfyw;                      // Biquad low-pass on gyroData[YAW] only in Hz, on top of gy_lpfcut, 0 = off. Tricopter yaw
     float    accz_vcf;                      // Crashpilot: Value for complementary filter accz and barovelocity
     float    accz_acf;                      // Crashpilot: Value for complementary filter accz and altitude
+    uint8_t  alt_mode;                      // Altitude estimator 0 = complementary filter (accz_vcf/accz_acf) 1 = Kalman filter
+    float    alt_acc_n;                     // Kalman: acc_up noise (cm/s^2)
+    float    alt_bias_n;                    // Kalman: acc bias random walk (cm/s^2 per sqrt(s))
+    float    alt_baro_n;                    // Kalman: baro noise (cm)
+    float    alt_snr_n;                     // Kalman: sonar noise (cm)
     float    bar_lag;                       // Lag of Baro
     float    bar_dscl;                      // Scale downmovement down
     uint8_t  bar_dbg;                       // Crashpilot: 1 = Debug Barovalues
     uint8_t  gy_stdev;                      // people keep forgetting that moving model while init results in wrong gyro offsets. and then they never reset gyro. so this is now on by default.
+    uint8_t  gy_tcomp;                      // 1 = Learn the temperature coefficient of the gyro bias while disarmed and follow the temperature in flight
 
     uint32_t activate[CHECKBOXITEMS];       // activate switches
     uint8_t  vbatscale;                     // adjust this to match battery voltage to reported value
@@ -288,6 +381,7 @@ typedef struct config_t
     uint16_t esc_moff;                      // This is the value for the ESCs when they are not armed. In some cases, this value must be lowered down to 900 for some specific ESCs
     uint16_t esc_nfly;                      // This is the absolute throttle that kicks off the "has landed timer" if it is too low cfg.rc_min is taken.
     uint16_t esc_pwm;                       // The update rate of motor outputs (50-498Hz)
+    uint8_t  esc_oneshot;                   // 1 = OneShot125 ESCs, one 125-250us pulse right after every motor update instead of esc_pwm
     uint16_t srv_pwm;                       // The update rate of servo outputs (50-498Hz)
     uint8_t  pass_mot;                      // Crashpilot: Only used with feature pass. If 0 = all Motors, otherwise specific Motor
     int16_t  servotrim[8];                  // Adjust Servo MID Offset & Swash angles
@@ -338,6 +432,12 @@ typedef struct config_t
     uint8_t  gps_type;                      // Type of GPS hardware. 0: NMEA 1: UBX 2+ ??
     float    gps_ins_vel;                   // Crashpilot: Value for complementary filter INS and GPS Velocity
     uint8_t  gps_ins_mdl;                   // GPS ins model. 1 = Based on lat/lon, 2 = based on Groundcourse & speed, 3 = based on ublx velned
+    uint8_t  gps_ins_kf;                    // GPS ins fusion. 0 = complementary filter (gps_ins_vel) 1 = Kalman filter
+    float    gps_kf_acc;                    // Kalman: earthframe acc noise (cm/s^2)
+    float    gps_kf_bias;                   // Kalman: acc bias random walk (cm/s^2 per sqrt(s))
+    float    gps_kf_pos;                    // Kalman: gps position noise at HDOP 1 (cm)
+    float    gps_kf_vel;                    // Kalman: gps speed noise at HDOP 1 (cm/s), 0 = don't use speed & course
+    uint16_t gps_ins_dly;                   // Kalman: age of a fix on arrival (ms), compensated with the INS history. 0 = off
 
     uint16_t gps_lag;                       // GPS Lag in ms
     int8_t   gps_phase;                     // Make a phaseshift +-30 Deg max of GPS output
@@ -398,6 +498,9 @@ typedef struct config_t
 
     // LOGGING
     uint8_t  stat_clear;                    // This will clear the stats between flights, or you can set to 0 and treasue overallstats
+    uint8_t  bb_div;                        // Blackbox: a frame every bb_div control loops while armed, 0 = off
+    uint8_t  st_div;                        // Stream on uart1: a frame every st_div control loops, 0 = off
+    uint8_t  st_fields;                     // Stream field groups: 1 gyro, 2 rc, 4 pid, 8 alt/vario, 16 flags, 32 motors
     uint16_t GPS_MaxDistToHome;             // Treasure Maximal distance from home for later Statistic chart
     uint16_t MAXGPSspeed;                   // Maxspeed in cm/s
     int16_t  MaxAltMeter;
@@ -406,7 +509,7 @@ typedef struct config_t
     int32_t  WP_BASE[2];                    // Base LAT/LON Coordinates for WP stuff
     int16_t  WP_BASE_HIGHT;                 // Starthight, normally "0"
     uint16_t FDUsedDatasets;                // Number of valid datasets of current type
-    int8_t   FloppyDisk[FDByteSize];        // Reserve 2200 general purpose SIGNED Bytes
+    int8_t   FloppyDisk[FDByteSize];        // Reserve FDByteSize general purpose SIGNED Bytes
     uint8_t  magic_ef;                      // magic number, should be 0xEF
     uint8_t  chk;                           // XOR checksum
 } config_t;
@@ -432,10 +535,154 @@ typedef struct flags_t
     uint8_t FAILSAFE;
 } flags_t;
 
+// Scheduler tasks, see scheduler.c. Table lives in mw.c
+enum
+{
+    TASK_CONTROL = 0,                       // Gyro/Acc -> IMU -> PID -> Mixer -> Motors
+    TASK_RC,
+    TASK_BARO,
+    TASK_MAG,
+    TASK_SONAR,
+    TASK_TELEMETRY,
+    TASK_LEDBUZZER,
+    TASK_MOTORSTATS,
+    TASK_CONFIG,                            // Flash writes of the config store
+    TASK_BLACKBOX,                          // Flash writes of the blackbox
+    TASK_SERIAL,
+    TASK_COUNT
+};
+
+// Profiling probes, see perf.c
+enum
+{
+    PERF_IMU = 0,                           // computeIMU
+    PERF_BARO,                              // Baro_update
+    PERF_ALT,                               // getEstimatedAltitude
+    PERF_PID,                               // The pid controller switch
+    PERF_MIXER,                             // mixTable
+    PERF_MOTORS,                            // writeServos & writeMotors
+    PERF_SERIAL,                            // serialCom
+    PERF_GPS,                               // GPS_alltime
+    PERF_COUNT
+};
+
+#define PERF_BUCKETS   8
+#define PERF_BUCKET_US 25                   // Upper limit of the first histogram bucket, doubles for every next one
+
+typedef struct perfProbe_t
+{
+    uint32_t start;                         // DWT cycles at perfStart
+    uint32_t min, max, sum;                 // us
+    uint32_t count;
+    uint32_t hist[PERF_BUCKETS];
+} perfProbe_t;
+
+// Vibration analyser of feature pass, see fft.c
+#define VIB_LOG2N      7
+#define VIB_N          (1 << VIB_LOG2N)     // Samples per capture (an axis pair) and FFT length
+#define VIB_SAMPLE_US  2000                 // 500Hz, spectrum 0 - 250Hz in 3.9Hz bins
+#define VIB_AXES       6                    // accADC X Y Z, gyroADC X Y Z
+#define VIB_PEAKS      3
+#define VIB_SLOTS      11                   // pass_mot 0 (all motors) - 10
+
+typedef struct vibPeak_t
+{
+    uint16_t freq;                          // 0.1Hz
+    uint16_t amp;                           // Sensor LSB
+} vibPeak_t;
+
+typedef struct vibSlot_t
+{
+    uint16_t  captures;                     // Analysed rounds of VIB_AXES / 2 captures, the peaks are from the last one
+    uint16_t  throttle;                     // Average throttle of the last round
+    vibPeak_t peak[VIB_AXES][VIB_PEAKS];    // Strongest first
+} vibSlot_t;
+
+// Cli variables, the table is in cli.c. Together with the fields cli can't set it's the schema for the config migration
+typedef enum
+{
+    VAR_UINT8,
+    VAR_INT8,
+    VAR_UINT16,
+    VAR_INT16,
+    VAR_UINT32,
+    VAR_FLOAT
+} vartype_e;
+
+typedef struct
+{
+    const char *name;
+    const uint8_t type; // vartype_e
+    void *ptr;
+    const int32_t min;
+    const int32_t max;
+    const uint8_t lcd; // 1 = Displayed in LCD // 0 = Not displayed
+} clivalue_t;
+
+// Journaled config store, see cfgstore.c
+typedef struct cfgStoreStats_t
+{
+    uint8_t  bank;                          // Active bank, 0xFF = none
+    uint32_t seq;                           // Banks written since the flash was blank
+    uint16_t logUsed;                       // Bytes of records in the active bank
+    uint16_t logSize;
+    uint16_t queued;                        // Bytes waiting for TASK_CONFIG
+    uint16_t saves;                         // Since boot
+    uint16_t compactions;                   // Since boot, in the background
+    uint16_t fullWrites;                    // Since boot, rewrites of cfg as a whole
+    uint16_t failures;                      // Since boot, compactions / rewrites / schemas given up after flash errors
+    bool     rewrite;                       // A rewrite of cfg as a whole is pending
+    bool     parked;                        // Flash errors: what is pending waits for the next save
+    uint16_t schemaFields;                  // Fields in the stored schema, 0 = none
+    uint16_t migrated;                      // Fields taken over from the old layout at boot, 0 = none
+    uint8_t  legacy;                        // Their EEPROM_CONF_VERSION, when it was a config of before the store
+} cfgStoreStats_t;
+
+// Blackbox, see blackbox.c
+typedef struct blackboxStats_t
+{
+    uint32_t size;                          // Bytes of flash for the logs
+    uint32_t used;                          // Bytes programmed
+    uint16_t queued;                        // Bytes waiting for TASK_BLACKBOX
+    uint32_t frames;                        // Of the current / last log
+    uint32_t dropped;                       // Frames of the current / last log that didn't fit the RAM ring
+    uint32_t stFrames;                      // Stream frames sent
+    uint32_t stDropped;                     // Stream frames the uart had no room for
+    bool     erasing;
+    bool     logging;
+} blackboxStats_t;
+
+typedef struct task_t
+{
+    const char *name;
+    void     (*func)(void);
+    uint32_t period;                        // us between two runs
+    uint16_t budget;                        // us worst case, a task only runs in the slack before TASK_CONTROL if it fits
+    uint8_t  priority;                      // Higher wins when more than one task is due
+    bool     enabled;
+    uint32_t nextRun;                       // micros() when due
+    uint32_t maxTime;                       // us longest run seen
+    uint32_t runCnt;
+    uint32_t lateCnt;                       // Started more than 1/4 period after its deadline
+    uint32_t overCnt;                       // Took longer than its budget
+} task_t;
+
+#define LOOP_BUCKETS 8                      // Jitter histogram, |cycle - looptime| <10 <25 <50 <100 <250 <500 <1000 and above us
+
+typedef struct loopStats_t
+{
+    uint32_t hist[LOOP_BUCKETS];
+    uint32_t cycles;                        // Control cycles measured
+    uint32_t overruns;                      // Cycles more than 1/4 looptime too long
+    uint32_t maxCycle;                      // us longest cycle seen
+    uint8_t  stallTask;                     // Task with the longest run inside that cycle
+    uint32_t maxLatency;                    // gy_drdy: us longest data ready to end of TASK_CONTROL (motors written)
+} loopStats_t;
+
 extern float    gyroData[3];
 extern float    angle[2];
 extern int16_t  axisPID[3];
-extern float    newpidimax;
+extern real_t   newpidimax;
 
 extern int16_t  rcCommand[4];
 extern uint8_t  rcOptions[CHECKBOXITEMS];
@@ -464,7 +711,7 @@ extern float    BaroDeltaTime;
 extern int16_t  BaroP;
 extern int16_t  BaroI;
 extern int16_t  BaroD;
-extern bool     newbaroalt;
+extern bool     newbaroalt, newsonaralt;
 extern bool     GroundAltInitialized;
 
 extern int16_t  motor[MAX_MOTORS];
@@ -485,13 +732,15 @@ extern uint8_t  NumberOfMotors;             // Store number of Motors used
 
 // IMU
 extern float    ACC_speed[2];
+extern float    ACC_earth[2];
 extern float    ACCDeltaTimeINS;
 
 // Sensors
-extern float    MainDpt1Cut;
 extern float    GPSDpt1freqCut;
 extern bool     MpuSpecial;
 extern float    gyroZero[3];                // Populated upon initialization
+extern float    GyroDelta[3];               // gy_fifo: coning corrected rotation (rad) over the samples of this loop, like deltaGyroAngle
+extern bool     GyroDeltaValid;             // GyroDelta is there, instead of gyroADC * loop time
 extern float    magCal[3];
 #ifdef debugmode
 extern float    gyrostddev[3];
@@ -519,6 +768,7 @@ extern int32_t  Real_GPS_coord[2];          // RAW GPS Coords
 extern int32_t  GPS_home[2];
 extern int32_t  GPS_WP[2];                  // Currently used WP
 extern uint8_t  GPS_numSat;
+extern uint16_t GPS_hdop;                   // HDOP * 100, 0 = unknown (MTK)
 extern uint16_t GPS_distanceToHome;         // distance to home
 extern int16_t  GPS_directionToHome;        // direction to home
 extern uint16_t GPS_altitude, GPS_speed;    // altitude in m and speed in cm/s
@@ -537,7 +787,7 @@ extern int16_t  WP_Desired_Climbrate;
 extern bool     WP_Fastcorner;              // Dont decrease Speed at Target
 extern float    sin_yaw_y;
 extern float    cos_yaw_x;
-extern uint32_t TimestampNewGPSdata;        // Crashpilot in micros
+extern uint32_t TimestampNewGPSdata;        // millis() when the last fix arrived, gps_ins_dly is subtracted from it
 extern float    dTnav;                      // Delta Time in milliseconds for navigation computations, updated with every good GPS read
 extern int32_t  target_bearing;             // target_bearing is where we should be heading
 extern uint32_t wp_distance;
@@ -556,6 +806,28 @@ extern baro_t   baro;
 extern uint8_t  Currentprotocol;
 extern uint32_t ScheduleEEPROMwriteMS;
 
+// Scheduler
+extern task_t   tasks[TASK_COUNT];
+extern loopStats_t loopStats;
+extern bool     drdyActive;                 // gy_drdy: TASK_CONTROL is started by the MPU data ready interrupt
+extern uint32_t drdySampleTime;             // gy_drdy: micros() of the data ready the running TASK_CONTROL works on
+
+// Perf
+extern const char * const perfNames[PERF_COUNT];
+extern perfProbe_t perfProbes[PERF_COUNT];
+
+// Vibration
+extern vibSlot_t * const vibSlots;          // In the blackbox ring, valid after vibInit
+extern bool     vibRunning;                 // vibInit: booted into feature pass, the analyser runs
+
+// Config store
+extern cfgStoreStats_t cfgStoreStats;
+extern const clivalue_t valueTable[];
+extern const uint16_t valueTableCount;
+
+// Blackbox
+extern blackboxStats_t blackboxStats;
+
 // Serial
 extern bool BlockProtocolChange;
 
@@ -567,6 +839,7 @@ extern uint8_t  LED_Value_Delay;
 // Main
 void     loop(void);
 void     pass(void);
+void     schedulerInit(void);
 void     LD0_OFF(void);                         // Crashpilot LED Inverter stuff
 void     LD1_OFF(void);
 void     LD0_ON(void);
@@ -574,10 +847,34 @@ void     LD1_ON(void);
 void     devClear(stdev_t *dev);
 void     devPush(stdev_t *dev, float x);
 float    devStandardDeviation(stdev_t *dev);
+float    devMean(stdev_t *dev);
+
+// Scheduler
+void     schedulerRun(void);
+void     schedulerDelayTask(uint8_t id, uint32_t us);
+void     schedulerClearStats(void);
+void     schedulerDataReadyInit(uint8_t div);
+void     schedulerDataReady(void);
+
+// Perf
+void     perfStart(uint8_t id);
+void     perfStop(uint8_t id);
+uint32_t perfAvg(uint8_t id);
+void     perfClear(void);
+
+// FFT, vibration analyser
+void     fftQ15(int16_t *re, int16_t *im, uint8_t log2n);
+void     vibInit(void);
+void     vibSample(uint16_t throttle);
+void     vibUpdate(void);
+void     vibClear(void);
+const vibSlot_t *vibResult(uint8_t slot);
+const char *vibAxisName(uint8_t axis);
 
 // IMU
 void     imuInit(void);
 void     computeIMU(void);
+void     gyroFilterInit(float sampleHz);
 void     blinkLED(uint8_t num, uint8_t wait, uint8_t repeat);
 void     getEstimatedAltitude(void);
 void     getAltitudePID(void);
@@ -591,11 +888,19 @@ void     alignSensors(uint8_t type, int16_t *data);
 void     Baro_update(void);
 void     Gyro_getADC(void);
 void     Mag_init(void);
-int      Mag_getADC(void);
+void     Mag_getADC(void);
 void     Sonar_init(void);
 void     Sonar_update(void);
-void     MPU6050ReadAllShit(int16_t *accData, float *tempData, int16_t *gyroData);
+int8_t   MPU6050ReadAllShit(int16_t *accData, float *tempData, int16_t (*gyroData)[3]);
+void     MPU6050Prefetch(void);
 void     GETMPU6050(void);
+void     sensorsPrefetch(void);
+void     sphereFitClear(sphereFit_t *fit);
+void     sphereFitPush(sphereFit_t *fit, float x, float y, float z);
+void     sphereFitSolve(sphereFit_t *fit, uint16_t max_iterations, float delta, float *sphere);
+void     ellipsoidFitClear(ellipsoidFit_t *fit);
+void     ellipsoidFitPush(ellipsoidFit_t *fit, float x, float y, float z);
+bool     ellipsoidFitSolve(ellipsoidFit_t *fit, float *center, float soft[3][3]);
 
 // Output
 uint8_t  mixerInit(void);
@@ -619,6 +924,16 @@ void     parseRcChannels(const char *input);
 void     readEEPROM(void);
 void     writeParams(uint8_t b);
 void     checkFirstTime(bool reset);
+bool     cfgStoreLoad(void);
+bool     cfgStoreMigrate(void);
+void     cfgStoreSave(void);
+void     cfgStoreUpdate(bool disarmed);
+void     cfgStoreFlush(void);
+void     blackboxInit(void);
+void     blackboxErase(void);
+void     blackboxLog(void);
+void     blackboxUpdate(bool disarmed);
+uint16_t blackboxRead(uint32_t offset, uint8_t *buf, uint16_t len);
 bool     sensors(uint32_t mask);
 void     sensorsSet(uint32_t mask);
 void     sensorsClear(uint32_t mask);
@@ -676,3 +991,25 @@ void     ledToggleUpdate(bool activated);
 
 // Mathematic helper functions here
 int16_t  _atan2f(float y, float x);
+float    fastSin(float x);
+float    fastCos(float x);
+float    fastAtan2(float y, float x);
+float    fastInvSqrt(float x);
+float    fastBaroAlt(float pressure);
+
+// Kalman
+void     kalman3Reset(kalman3_t *k, float pos, float posNoise, float velNoise, float biasNoise);
+void     kalman3Predict(kalman3_t *k, float acc, float dt, float accNoise, float biasNoise);
+void     kalman3Correct(kalman3_t *k, float innovation, float noise);
+void     kalman3CorrectVel(kalman3_t *k, float innovation, float noise);
+
+// Biquad filters
+void     biquad3Lowpass(biquad3_t *f, float hz, float sampleHz);
+void     biquad3Notch(biquad3_t *f, float hz, float q, float sampleHz);
+void     biquad3Reset(biquad3_t *f);
+void     biquad3Apply(biquad3_t *f, float *v);
+float    biquad3ApplyAxis(biquad3_t *f, uint8_t axis, float x);
+#ifdef FIXEDPOINT
+void     rbiquad3Lowpass(rbiquad3_t *f, float hz, float sampleHz);
+real_t   rbiquad3ApplyAxis(rbiquad3_t *f, uint8_t axis, real_t x);
+#endif
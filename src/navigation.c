@@ -46,7 +46,24 @@ static int16_t   maxbankbrake100;         // Maximum GPS Brake Tiltangle < maxba
 static float     Real_GPS_speed[2] = { 0, 0 }; // Is the earthframespeed measured by GPS Coord Difference
 static float     MIX_speed[2]      = { 0, 0 }; // That is a 1:1 Mix of Acc speed and GPS Earthframespeed
 static int32_t   Last_Real_GPS_coord[2];
-uint32_t         TimestampNewGPSdata;     // Crashpilot in micros
+uint32_t         TimestampNewGPSdata;     // millis() when the last fix arrived
+
+// Kalman INS Variables (gps_ins_kf 1)
+static kalman3_t GpsKf[2];                // North / east: position in cm from GpsKfOrigin, speed in cm/s, acc bias
+static int32_t   GpsKfOrigin[2];          // GPS coords of position 0
+static bool      GpsKfValid;
+static uint32_t  GpsKfLastRun;
+
+#define GPS_HIST_SIZE    32                                             // INS history for the gps latency, 32 * 20ms covers gps_ins_dly up to 620ms
+#define GPS_HIST_STEP    20                                             // ms
+typedef struct gpsHist_t
+{
+    uint32_t time;                                                      // millis()
+    float    pos[2];
+    float    vel[2];
+} gpsHist_t;
+static gpsHist_t GpsHist[GPS_HIST_SIZE];
+static uint8_t   GpsHistIdx, GpsHistCnt;                               // Idx is the next free slot
 
 // PH Variables
 static float     GpsPhAbsTub;             // Defines a "bathtub" around current PH Position, so the PosP will not brutally follow GPS wandering
@@ -60,6 +77,8 @@ static float     get_P(float error, struct PID_PARAM_* pid);
 static float     get_I(float error, float* dt, struct PID_* pid, struct PID_PARAM_* pid_param);
 static float     get_D(float error, float* dt, struct PID_* pid, struct PID_PARAM_* pid_param);
 static int32_t   wrap_36000(int32_t angle);
+static void      GPS_calc_velocity_kf(bool newfix);
+static gpsHist_t *GPS_hist_at(uint32_t time);
 
 
 ////////////////////////////////////////////////////////////////////////////////////
@@ -77,6 +96,11 @@ void GPS_calc_velocity(void)
     if (CosLatScaleLon == 0.0f) GPS_calc_longitude_scaling();                   // Init CosLatScaleLon if not already done to avoid div by zero etc..
     RealGPSDeltaTime = TimestampNewGPSdata - LastTimestampNewGPSdata;           // RealGPSDeltaTime in ms! NOT us!
     LastTimestampNewGPSdata = TimestampNewGPSdata;
+    if (cfg.gps_ins_kf)
+    {
+        GPS_calc_velocity_kf(RealGPSDeltaTime != 0);
+        return;
+    }
     if (RealGPSDeltaTime != 0)                                                  // New GPS Data?
     {
         INSusable = false;                                                      // Set INS to ununsable in advance we will see later
@@ -100,8 +124,8 @@ void GPS_calc_velocity(void)
                 break;
             case 2:                                                             // 2 = based on Groundcourse & Speed
                 tmp0 = GPS_ground_course * RADX10;
-                Real_GPS_speed[LON] = (float)GPS_speed * sinf(tmp0);            // cm/s
-                Real_GPS_speed[LAT] = (float)GPS_speed * cosf(tmp0);
+                Real_GPS_speed[LON] = (float)GPS_speed * fastSin(tmp0);            // cm/s
+                Real_GPS_speed[LAT] = (float)GPS_speed * fastCos(tmp0);
                 break;
             }
 
@@ -132,6 +156,99 @@ void GPS_calc_velocity(void)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////
+// gps_ins_kf 1: Kalman filter per axis instead of the complementary filter above. Predicts at looprate with the
+// earthframe acc, every fix is a position and a speed & course measurement weighted by HDOP (satcount without HDOP).
+// The gps speed is needed, the acc alone underestimates horizontal acceleration, because the attitude leans to the thrust axis.
+// A late or missing fix just lets the uncertainty grow, nav is only reset when the position is more than GPS_KF_MAXERR off
+// or the filter didn't run.
+// Latency: a fix describes the copter gps_ins_dly ms before it arrived. So it is compared to the INS state of that time
+// (GpsHist) and the correction is applied to the current state, which carries it forward to now.
+#define GPS_KF_MAXERR   500.0f                                                  // cm 1 sigma
+#define GPS_KF_TIMEOUT  100                                                     // ms without predict (no fix / too few sats), start over
+static void GPS_calc_velocity_kf(bool newfix)
+{
+    gpsHist_t *hist;
+    float     dop, vel[2], pos, spd;
+    uint8_t   i, j;
+
+    if (millis() - GpsKfLastRun > GPS_KF_TIMEOUT) GpsKfValid = false;
+    GpsKfLastRun = millis();
+    if (newfix)
+    {
+        hist = GPS_hist_at(TimestampNewGPSdata - cfg.gps_ins_dly);
+        if (GPS_hdop) dop = (float)GPS_hdop * 0.01f;
+        else dop = 10.0f / (float)max(GPS_numSat, 1);                          // Rough HDOP from satcount
+        dop    = max(dop, 1.0f);
+        vel[0] = (float)GPS_ground_course * RADX10;
+        vel[1] = (float)GPS_speed * fastSin(vel[0]);                            // East
+        vel[0] = (float)GPS_speed * fastCos(vel[0]);                            // North
+        for (i = 0; i < 2; i++)
+        {
+            if (!GpsKfValid)
+            {
+                GpsKfOrigin[i] = Real_GPS_coord[i];
+                kalman3Reset(&GpsKf[i], 0, cfg.gps_kf_pos * dop, 100.0f, 50.0f);
+                GpsHistCnt = GpsHistIdx = 0;
+                continue;
+            }
+            pos = GpsKf[i].x[0];
+            spd = GpsKf[i].x[1];
+            kalman3Correct(&GpsKf[i], (float)(Real_GPS_coord[i] - GpsKfOrigin[i]) / OneCmTo[i] - (hist ? hist->pos[i] : pos), cfg.gps_kf_pos * dop);
+            if (cfg.gps_kf_vel) kalman3CorrectVel(&GpsKf[i], vel[i] - (hist ? hist->vel[i] : spd) - (GpsKf[i].x[1] - spd), cfg.gps_kf_vel * dop);
+            pos = GpsKf[i].x[0] - pos;                                          // Shift the history by the same correction, so the next fix
+            spd = GpsKf[i].x[1] - spd;                                          // doesn't see this error again
+            for (j = 0; j < GpsHistCnt; j++)
+            {
+                GpsHist[j].pos[i] += pos;
+                GpsHist[j].vel[i] += spd;
+            }
+        }
+        GpsKfValid = true;
+    }
+    if (!GpsKfValid)                                                            // Timed out, wait for the next fix
+    {
+        GPS_coord[LAT] = Real_GPS_coord[LAT];
+        GPS_coord[LON] = Real_GPS_coord[LON];
+        GPS_reset_nav();
+        return;
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        kalman3Predict(&GpsKf[i], ACC_earth[i], ACCDeltaTimeINS, cfg.gps_kf_acc, cfg.gps_kf_bias);
+        GPS_coord[i] = GpsKfOrigin[i] + (int32_t)(GpsKf[i].x[0] * OneCmTo[i]);
+        ACC_speed[i] = MIX_speed[i] = GpsKf[i].x[1];
+    }
+    if (cfg.gps_ins_dly && (!GpsHistCnt || GpsKfLastRun - GpsHist[(GpsHistIdx + GPS_HIST_SIZE - 1) % GPS_HIST_SIZE].time >= GPS_HIST_STEP))
+    {
+        hist = &GpsHist[GpsHistIdx];
+        hist->time = GpsKfLastRun;
+        for (i = 0; i < 2; i++)
+        {
+            hist->pos[i] = GpsKf[i].x[0];
+            hist->vel[i] = GpsKf[i].x[1];
+        }
+        GpsHistIdx = (GpsHistIdx + 1) % GPS_HIST_SIZE;
+        if (GpsHistCnt < GPS_HIST_SIZE) GpsHistCnt++;
+    }
+    if (GpsKf[LAT].P[0] > GPS_KF_MAXERR * GPS_KF_MAXERR || GpsKf[LON].P[0] > GPS_KF_MAXERR * GPS_KF_MAXERR) GPS_reset_nav();
+}
+
+static gpsHist_t *GPS_hist_at(uint32_t time)                                   // Newest INS state not younger than "time", NULL if gps_ins_dly is off or the history doesn't reach back
+{
+    gpsHist_t *hist;
+    uint8_t   i;
+
+    if (!cfg.gps_ins_dly) return NULL;
+    for (i = 1; i <= GpsHistCnt; i++)
+    {
+        hist = &GpsHist[(GpsHistIdx + GPS_HIST_SIZE - i) % GPS_HIST_SIZE];
+        if ((int32_t)(time - hist->time) >= 0) return hist;
+    }
+    return NULL;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 // Get distance between two points in cm Get bearing from pos1 to pos2, returns an 1deg = 100 precision
 // Now with more correct BEARING calclation according to this: http://www.movable-type.co.uk/scripts/latlong.html
@@ -149,10 +266,10 @@ void GPS_distance_cm_bearing(int32_t * lat1, int32_t * lon1, int32_t * lat2, int
         dLonRAW    = dLonRAW * GPSRAWtoRAD;
         lat1RAD    = *lat1   * GPSRAWtoRAD;
         lat2RAD    = *lat2   * GPSRAWtoRAD;
-        Coslat2RAD = cosf(lat2RAD);
-        y          = sinf(dLonRAW) * Coslat2RAD;
-        x          = cosf(lat1RAD) * sinf(lat2RAD) - sinf(lat1RAD) * Coslat2RAD * cos(dLonRAW);
-        *bearing   = constrain((int32_t)(atan2f(y, x) * RADtoDEG100), -18000, 18000);
+        Coslat2RAD = fastCos(lat2RAD);
+        y          = fastSin(dLonRAW) * Coslat2RAD;
+        x          = fastCos(lat1RAD) * fastSin(lat2RAD) - fastSin(lat1RAD) * Coslat2RAD * fastCos(dLonRAW);
+        *bearing   = constrain((int32_t)(fastAtan2(y, x) * RADtoDEG100), -18000, 18000);
         if (*bearing < 0) *bearing += 36000;
     }
     else                                                                        // Error!
@@ -232,15 +349,15 @@ void GPS_calc_nav_rate(uint16_t max_speed)
     if ((abs(wrap_18000(target_bearing - original_target_bearing)) < 4500) && cfg.nav_ctrkgain != 0)// If we are too far off or too close we don't do track following
     {
         temp = (float)(target_bearing - original_target_bearing) * RADX100;
-        crosstrack_error = sinf(temp) * (float)wp_distance * cfg.nav_ctrkgain;  // Meters we are off track line
+        crosstrack_error = fastSin(temp) * (float)wp_distance * cfg.nav_ctrkgain;  // Meters we are off track line
         nav_bearing = target_bearing + constrain(crosstrack_error, -3000, 3000);
         nav_bearing = wrap_36000(nav_bearing);
     }
     else nav_bearing = target_bearing;
 
     temp = (float)(9000l - nav_bearing) * RADX100;                              // nav_bearing and maybe crosstrack
-    trig[GPS_X] = cosf(temp);
-    trig[GPS_Y] = sinf(temp);
+    trig[GPS_X] = fastCos(temp);
+    trig[GPS_Y] = fastSin(temp);
     for (axis = 0; axis < 2; axis++)
     {
         trgtspeed  = (trig[axis] * (float)max_speed);                           // Target speed
@@ -362,7 +479,7 @@ void GPS_reset_nav(void)
     uint8_t i;
     for (i = 0; i < 2; i++)
     {
-        GPS_coord[i] = Real_GPS_coord[i];                                  // Discard INS GPS pos and use the real
+        if (!cfg.gps_ins_kf) GPS_coord[i] = Real_GPS_coord[i];             // Discard INS GPS pos and use the real. The Kalman filter keeps its estimate
         Last_Real_GPS_coord[i] = Real_GPS_coord[i];
         ACC_speed[i] = MIX_speed[i] = Real_GPS_speed[i] = 0;
         LocError[i]  = 0;
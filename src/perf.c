@@ -0,0 +1,39 @@
+#include "board.h"
+#include "mw.h"
+
+// Named profiling probes on the DWT cycle counter. perfStart / perfStop around a region,
+// cli "perf" and MSP_PERF show min / avg / max in us and a coarse histogram.
+// Histogram buckets double from PERF_BUCKET_US: <25 <50 <100 <200 <400 <800 <1600 and above.
+
+const char * const perfNames[PERF_COUNT] = { "IMU", "BARO", "ALT", "PID", "MIXER", "MOTORS", "SERIAL", "GPS" };
+perfProbe_t perfProbes[PERF_COUNT];
+
+void perfStart(uint8_t id)
+{
+    perfProbes[id].start = cycles();
+}
+
+void perfStop(uint8_t id)
+{
+    perfProbe_t *p = &perfProbes[id];
+    uint32_t    us = (cycles() - p->start) / cyclesPerMicro();
+    uint8_t     bucket = 0;
+
+    if (!p->count || us < p->min) p->min = us;
+    if (us > p->max) p->max = us;
+    p->sum += us;
+    p->count++;
+    while (bucket < PERF_BUCKETS - 1 && us >= ((uint32_t)PERF_BUCKET_US << bucket)) bucket++;
+    p->hist[bucket]++;
+}
+
+uint32_t perfAvg(uint8_t id)
+{
+    if (!perfProbes[id].count) return 0;
+    return perfProbes[id].sum / perfProbes[id].count;
+}
+
+void perfClear(void)
+{
+    memset(perfProbes, 0, sizeof(perfProbes));
+}
@@ -0,0 +1,173 @@
+#include "board.h"
+#include "mw.h"
+
+// Cooperative scheduler. Runs at most one task per call, so loop() gets back here after every task
+// and TASK_CONTROL is never more than one task runtime late.
+// Rules:
+// 1. Of all due tasks the one with the highest priority runs.
+// 2. A lower task only runs when its budget fits into the slack before TASK_CONTROL is due again.
+// 3. Anti starvation: a task that is late (more than 1/4 period behind) runs anyway.
+// 4. Nothing due: the last task of the table (serial) gets the spare time, its period is just the guaranteed rate then.
+// The task table itself and schedulerInit are in mw.c
+// Every TASK_CONTROL start is also a loop time sample for loopStats: jitter histogram, overruns and the
+// longest cycle together with the task that ran longest in it (cli "status", MSP_STATUS, MAVLink "LOOP*").
+// PREFETCH_US before TASK_CONTROL is due its sensor read is put on the i2c queue, so it runs on the bus while
+// other tasks or the idle loop run, and computeIMU only collects it.
+// gy_drdy: the MPU data ready interrupt (schedulerDataReady) counts the samples, every drdyDiv-th one is timestamped,
+// starts the sensor read and makes TASK_CONTROL due. nextRun is then the predicted next interrupt, so rule 2 keeps the
+// other tasks in between the interrupts. No interrupt for a whole period falls back to the clock.
+
+#define LATE_FRACTION 4                                              // Late, when more than period / 4 behind
+#define PREFETCH_US   550                                            // The MPU burst takes ca. 400us @400KHz, 520us with the aux mag
+
+loopStats_t loopStats;
+
+static const uint16_t loopBucketUs[LOOP_BUCKETS - 1] = { 10, 25, 50, 100, 250, 500, 1000 };
+static uint32_t lastControlStart;
+static uint32_t hogTime;                                             // Longest task run since the last control start
+static uint8_t  hogTask;
+static bool     loopSkip = true;                                     // No valid start, or the gyro calibration is running
+static volatile uint32_t drdyTime;                                   // Timestamp of the data ready that is waiting for TASK_CONTROL
+static volatile bool     drdyPending;
+static uint8_t  drdyDiv;                                             // Samples per TASK_CONTROL run
+static volatile bool     controlRunning;
+static volatile bool     drdyLost;                                   // No interrupt for a whole period, TASK_CONTROL goes by the clock
+
+bool     drdyActive;
+uint32_t drdySampleTime;
+
+static void runTask(task_t *task);
+static void loopStatsUpdate(uint32_t now);
+
+void schedulerRun(void)
+{
+    task_t   *task, *best = NULL;
+    uint32_t now = micros(), latency;
+    int32_t  slack, overdue;
+    uint8_t  i;
+    bool     controlReady, skip = loopSkip;
+
+    i2cPoll();                                                       // A job chained behind an i2c stop goes on the bus between the tasks
+    if (drdyPending) tasks[TASK_CONTROL].nextRun = drdyTime;         // gy_drdy: due with the interrupt, not by the clock
+    slack = (int32_t)(tasks[TASK_CONTROL].nextRun - now);            // Time left until the next control run
+    if (drdyActive && !drdyPending && slack < -(int32_t)tasks[TASK_CONTROL].period) drdyLost = true;
+    if ((!drdyActive || drdyLost) && slack <= PREFETCH_US) sensorsPrefetch(); // gy_drdy: the interrupt starts the read
+    controlReady = !drdyActive || drdyPending || drdyLost;
+    for (i = 0; i < TASK_COUNT; i++)
+    {
+        task = &tasks[i];
+        if (!task->enabled) continue;
+        if (i == TASK_CONTROL && !controlReady) continue;             // gy_drdy: waiting for the interrupt
+        overdue = (int32_t)(now - task->nextRun);
+        if (overdue < 0) continue;                                   // Not due
+        if (i != TASK_CONTROL && task->budget > slack && (uint32_t)overdue <= task->period / LATE_FRACTION) continue; // Doesn't fit and isn't starving
+        if (!best || task->priority > best->priority) best = task;
+    }
+
+    if (best)
+    {
+        if (best->period && now - best->nextRun > best->period / LATE_FRACTION) best->lateCnt++;
+        best->nextRun += best->period;                               // Keep the phase
+        if ((int32_t)(now - best->nextRun) >= 0) best->nextRun = now + best->period; // Missed a whole period, resync
+        if (best == &tasks[TASK_CONTROL])
+        {
+            __disable_irq();
+            drdySampleTime = drdyPending ? drdyTime : now;
+            drdyPending    = false;
+            controlRunning = true;
+            __enable_irq();
+            loopStatsUpdate(now);
+        }
+        runTask(best);                                               // Task may override nextRun with schedulerDelayTask
+        if (best == &tasks[TASK_CONTROL])
+        {
+            controlRunning = false;
+            latency        = micros() - drdySampleTime;              // Data ready to motors written
+            if (drdyActive && !skip && latency > loopStats.maxLatency) loopStats.maxLatency = latency;
+        }
+    }
+    else
+    {
+        task = &tasks[TASK_COUNT - 1];
+        if (task->enabled && task->budget <= slack) runTask(task);   // Idle, fill the slack
+    }
+}
+
+static void runTask(task_t *task)
+{
+    uint32_t start, elapsed;
+    start         = micros();
+    currentTime   = start;                                           // Feed values for the tasks
+    currentTimeMS = millis();
+    task->func();
+    elapsed = micros() - start;
+    task->runCnt++;
+    if (elapsed > task->maxTime) task->maxTime = elapsed;
+    if (elapsed > task->budget)  task->overCnt++;
+    if (elapsed >= hogTime)
+    {
+        hogTime = elapsed;
+        hogTask = task - tasks;
+    }
+}
+
+static void loopStatsUpdate(uint32_t now)
+{
+    uint32_t cycle, period = tasks[TASK_CONTROL].period;
+    int32_t  jitter;
+    uint8_t  bucket = 0;
+
+    cycle            = now - lastControlStart;
+    lastControlStart = now;
+    if (!loopSkip)
+    {
+        loopStats.cycles++;
+        jitter = (int32_t)(cycle - period);
+        if (jitter < 0) jitter = -jitter;
+        while (bucket < LOOP_BUCKETS - 1 && (uint32_t)jitter >= loopBucketUs[bucket]) bucket++;
+        loopStats.hist[bucket]++;
+        if (period && cycle > period + period / LATE_FRACTION) loopStats.overruns++;
+        if (cycle > loopStats.maxCycle)
+        {
+            loopStats.maxCycle  = cycle;
+            loopStats.stallTask = hogTask;
+        }
+    }
+    loopSkip = calibratingG;
+    hogTime  = 0;
+}
+
+void schedulerDataReadyInit(uint8_t div)                             // gy_drdy: TASK_CONTROL every div samples, 0 = by the clock
+{
+    drdyDiv    = div;
+    drdyActive = div != 0;
+}
+
+void schedulerDataReady(void)                                        // Interrupt: MPU data ready, a new sample is in the registers
+{
+    static uint8_t cnt;
+    uint32_t now = micros();
+
+    if (!drdyActive || ++cnt < drdyDiv) return;
+    cnt         = 0;
+    drdyTime    = now;
+    drdyPending = true;
+    drdyLost    = false;
+    if (!controlRunning) sensorsPrefetch();                          // Not while computeIMU may still collect the last one
+}
+
+void schedulerDelayTask(uint8_t id, uint32_t us)                     // Next run of task "id" in "us" from now, instead of after its period
+{
+    tasks[id].nextRun = micros() + us;
+}
+
+void schedulerClearStats(void)
+{
+    uint8_t i;
+    for (i = 0; i < TASK_COUNT; i++)
+    {
+        tasks[i].maxTime = tasks[i].runCnt = tasks[i].lateCnt = tasks[i].overCnt = 0;
+    }
+    memset(&loopStats, 0, sizeof(loopStats));
+    loopSkip = true;
+}
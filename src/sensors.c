@@ -7,7 +7,7 @@ float gyrostddev[3];
 
 bool     calibratingA = false;                       // the calibration is done is the main loop. Calibrating decreases at each cycle down to 0, then we enter in a normal mode.
 bool     calibratingG = false;                       // So no Gyrocal when feature pass
-float    MainDpt1Cut, GPSDpt1freqCut;
+float    GPSDpt1freqCut;
 bool     MpuSpecial;
 extern uint16_t InflightcalibratingA;
 extern int16_t  AccInflightCalibrationArmed;
@@ -17,6 +17,8 @@ extern uint16_t AccInflightCalibrationActive;
 extern uint16_t batteryWarningVoltage;
 extern uint8_t  batteryCellCount;
 float  gyroZero[3];                                  // Populated upon initialization
+float  GyroDelta[3];                                 // gy_fifo: rotation over the FIFO samples of this loop, see gyroConing
+bool   GyroDeltaValid;
 float  magCal[3];                                    // Gain for each axis, populated at sensor init
 
 sensor_t acc;                                        // acc access functions
@@ -25,9 +27,9 @@ baro_t   baro;                                       // barometer access functio
 uint8_t  accHardware = ACC_DEFAULT;                  // which accel chip is used/detected
 
 static void Mag_Calibration(void);
-static void sphere_fit_least_squares(const float x[], const float y[], const float z[], uint16_t size, uint16_t max_iterations, float delta, float *sphere);
 static void ACC_getRawRot(void);
 static void Gyro_getRawRot(void);
+static void gyroConing(int16_t (*gyroSample)[3], uint8_t n);
 
 void sensorsAutodetect(void)                         // AfroFlight32 i2c sensors
 {
@@ -138,14 +140,13 @@ retry:                                               // Accelerometer. Fuck it.
     magneticDeclination = ((float)deg + ((float)min / 60.0f)); // heading is in decimaldeg units NO 0.1 deg shit here
 #endif
 
-    // Initialize Cut off frequencies for mainpid D and gps D (later)
+    // Initialize Cut off frequency for gps D (later), the main pid D term has a biquad (filter.c)
     // Examples for _filter: "1 / ( 2 * PI * f_cut )"
     // 10 Hz filter = 15.9155e-3 
     // 15 Hz filter = 10.6103e-3
     // 20 Hz filter =  7.9577e-3
     // 25 Hz filter =  6.3662e-3
     // 30 Hz filter =  5.3052e-3
-    if (cfg.mainpt1cut) MainDpt1Cut = 1.0f / (2.0f * M_PI * (float)cfg.mainpt1cut);
     GPSDpt1freqCut = 1.0f / (2.0f * M_PI * (float)cfg.gpspt1cut);
 }
 
@@ -199,68 +200,85 @@ void alignSensors(uint8_t type, int16_t *data)
     }
 }
 
-static void Acc_1KHz_Calib_SumUp(float *x, float *y, float *z, uint16_t count)
+// Acc calibration runs as a state machine on the normal acc reads, one sample per control cycle.
+// The FC keeps flying its loop (serial, LEDs, telemetry stay alive), arming is blocked until it is done.
+// Samples go straight into the running sums of the sphere fit, so no sample arrays are needed.
+// The counts are the ones of the blocking 1KHz calibration, at a 3ms looptime that takes ca. 33s.
+#define ACCdiscardcnt  100
+#define ACC1Gcount    1000
+#define ACCmaxcount    500
+#define ACCavgcount     20
+static void Acc_Calibrate(void)                                   // Total Samples = ACCdiscardcnt + ACC1Gcount + ACCmaxcount * ACCavgcount
 {
-    uint16_t i;
-    *x = *y = *z = 0;
-    for (i = 0; i < count; i++)
+    static sphereFit_t fit;
+    static float       Temp[3], sens1G;
+    static uint16_t    cnt;
+    static uint8_t     state, avgcnt;
+#ifdef debugmode
+    static stdev_t     var[3];
+#endif
+    uint8_t            i;
+
+    if (f.ARMED)                                                  // Never while flying, start over next time
     {
-        delay(1);
-        ACC_getRawRot();
-        *x += accADC[0];
-        *y += accADC[1];
-        *z += accADC[2];
+        cnt          = 0;
+        state        = 0;
+        calibratingA = false;
+        return;
     }
-}
-
-#define ACC1Gcount   1000
-#define ACCmaxcount   500
-#define ACCdiscardcnt 100
-#define ACCavgcount    20
-static void Acc_Calibrate(void)                                   // Total Samples = ACCmaxcount * ACCavgcount + ACC1Gcount + ACCdiscardcnt
-{
-    float    x[ACCmaxcount], y[ACCmaxcount], z[ACCmaxcount];
-    float    TempX, TempY, TempZ;
-    uint16_t i;
-#ifdef debugmode  
-    stdev_t  var[3];
-#endif
-    Acc_1KHz_Calib_SumUp(&TempX, &TempY, &TempZ, ACCdiscardcnt);  // Discard the first 100 Values
-    Acc_1KHz_Calib_SumUp(&TempX, &TempY, &TempZ, ACC1Gcount);     // Summ up 1000 values to get the sensor 1G
-    cfg.sens_1G = sqrtf(TempX * TempX + TempY * TempY + TempZ * TempZ) / ACC1Gcount;
 
+    switch (state)
+    {
+    case 0:                                                       // Discard the first values
+        if (++cnt < ACCdiscardcnt) break;
+        for (i = 0; i < 3; i++) Temp[i] = 0;
+        cnt = 0;
+        state++;
+        break;
+    case 1:                                                       // Sum up values to get the sensor 1G
+        for (i = 0; i < 3; i++) Temp[i] += accADC[i];
+        if (++cnt < ACC1Gcount) break;
+        sens1G = sqrtf(Temp[0] * Temp[0] + Temp[1] * Temp[1] + Temp[2] * Temp[2]) / ACC1Gcount;
+        for (i = 0; i < 3; i++) Temp[i] = 0;
+        sphereFitClear(&fit);
 #ifdef debugmode
-    for (i = 0; i < 3; i++) devClear(&var[i]);
+        for (i = 0; i < 3; i++) devClear(&var[i]);
 #endif
-
-    for (i = 0; i < ACCmaxcount; i++)
-    {
-        Acc_1KHz_Calib_SumUp(&TempX, &TempY, &TempZ, ACCavgcount);// Average 20 ACC Values here
-        x[i] = TempX / ACCavgcount;
-        y[i] = TempY / ACCavgcount;
-        z[i] = TempZ / ACCavgcount - cfg.sens_1G;
+        cnt = avgcnt = 0;
+        state++;
+        break;
+    case 2:                                                       // Average ACCavgcount values per fit point
+        for (i = 0; i < 3; i++) Temp[i] += accADC[i];
+        if (++avgcnt < ACCavgcount) break;
+        for (i = 0; i < 3; i++) Temp[i] /= ACCavgcount;
+        Temp[2] -= sens1G;
+        sphereFitPush(&fit, Temp[0], Temp[1], Temp[2]);
 #ifdef debugmode
-        devPush(&var[0], x[i]);
-        devPush(&var[1], y[i]);
-        devPush(&var[2], z[i]);
+        for (i = 0; i < 3; i++) devPush(&var[i], Temp[i]);
 #endif
-    }
-    sphere_fit_least_squares(x, y, z, ACCmaxcount, 100, 0.0f, cfg.accZero);
-    cfg.angleTrim[ROLL] = cfg.angleTrim[PITCH] = 0;
+        for (i = 0; i < 3; i++) Temp[i] = 0;
+        avgcnt = 0;
+        if (++cnt < ACCmaxcount) break;
+        sphereFitSolve(&fit, 100, 0.0f, cfg.accZero);
+        cfg.sens_1G = sens1G;
+        cfg.angleTrim[ROLL] = cfg.angleTrim[PITCH] = 0;
 #ifdef debugmode
-    cfg.accstddev[0] = devStandardDeviation(&var[0]);
-    cfg.accstddev[1] = devStandardDeviation(&var[1]);
-    cfg.accstddev[2] = devStandardDeviation(&var[2]);
+        for (i = 0; i < 3; i++) cfg.accstddev[i] = devStandardDeviation(&var[i]);
 #endif
-    writeParams(1);
-    systemReset(false);
+        writeParams(0);                                           // No blinkLED here, that would freeze again
+        toggleBeep   = 2;                                         // Done
+        cnt          = 0;
+        state        = 0;
+        calibratingA = false;
+        break;
+    }
 }
 
 static void ACC_Common(void)
 {
     uint8_t axis;
 
-    if (calibratingA) Acc_Calibrate();                            // Dead end (Freeze, Calibrate, Save, Reset)
+    if (calibratingA) Acc_Calibrate();                            // One step per sample, uses the raw values, accADC is scaled with the old zero below
 
     if (feature(FEATURE_INFLIGHT_ACC_CAL))                        // THAT IS ATAVISTIC AND MUST BE REDONE
     {
@@ -308,60 +326,97 @@ static void ACC_Common(void)
             cfg.accZero[YAW]   -= cfg.sens_1G;
             cfg.angleTrim[ROLL] = cfg.angleTrim[PITCH] = 0;
             writeParams(1);                                       // write accZero in EEPROM
+            cfgStoreFlush();
             systemReset(false);
         }
     }
     for (axis = 0; axis < 3; axis++) accADC[axis] = ((accADC[axis] - cfg.accZero[axis]) * acc_1G) / cfg.sens_1G; // Scale to mwii shit 512
 }
 
-#define Gyromaxcount   500
-#define Gyrodiscardcnt 100
-#define Gyroavgcount     3
-static void Gyro_Calibrate(void)                                  // Total Samples = Gyromaxcount * Gyroavgcount + Gyrodiscardcnt
+// Gyro bias, tracked in the loop instead of the blocking calibration. While disarmed the raw gyro of every loop goes into
+// a window of GYRO_BIAS_WINDOW_MS, as averages of GYRO_BIAS_AVG. A window with the summed standard deviation of the axes below gy_stdev is still:
+// with calibratingG (boot, stick command) its mean becomes the bias at once, after that every still window pulls the
+// bias towards its mean (GYRO_BIAS_GAIN). Moving windows are dropped, only calibratingG gives up after GYRO_BIAS_TRIES.
+// gy_tcomp: bias = b + k * (T - Tref) with the gyro temperature, b and k learnt per window by normalized LMS. In flight
+// gyroZero follows the temperature with the learnt k, so the drift of the warming board is gone without a recalibration.
+#define GYRO_BIAS_WINDOW_MS 500
+#define GYRO_BIAS_AVG       3                                     // Loop samples averaged per window value, gy_stdev was set for 3 sample averages
+#define GYRO_BIAS_GAIN      0.1f                                  // Per still window, ca. 5s time constant
+#define GYRO_BIAS_TRIES     14                                    // 7s of shaky hands, then calibratingG takes what it has
+#define GYRO_BIAS_TSCALE    0.2f                                  // 1/degC, keeps the temperature regressor in the size of the offset one
+
+static stdev_t  gyroVar[3];
+static uint32_t gyroWindowStart;
+static float    gyroWindowTemp;                                   // Temperature sum of the window
+static float    gyroAvg[3];
+static uint8_t  gyroAvgCnt;
+static float    gyroBias[3], gyroTco[3], gyroTref;                // Bias model, raw gyro units and units per GYRO_BIAS_TSCALE degC
+static uint8_t  gyroBiasTries;
+
+static void gyroBiasUpdate(void)                                  // Raw gyroADC, before gyroZero is taken off
 {
-    float    xyz[3][Gyromaxcount];
-    float    Temp[3];                                             // Code is shorter with Temp variable
-    uint16_t i;
-    uint8_t  k, l, breakout = 0;
-    stdev_t  var[3];
+    float   mean, dT, r, std = 0;
+    uint8_t axis;
 
-    for (i = 0; i < Gyrodiscardcnt; i++)                          // Discard first 100 reads
+    if (cfg.gy_tcomp && !calibratingG)
     {
-        delay(1);
-        Gyro_getRawRot();
+        dT = (telemTemperature1 - gyroTref) * GYRO_BIAS_TSCALE;
+        for (axis = 0; axis < 3; axis++) gyroZero[axis] = gyroBias[axis] + gyroTco[axis] * dT;
     }
-  
-    do                                                            // Shaky Hands Loop
+    if (f.ARMED)
     {
-        for (k = 0; k < 3; k++) devClear(&var[k]);
-        breakout++;
-        for (i = 0; i < Gyromaxcount; i++)
+        for (axis = 0; axis < 3; axis++)                          // Fresh window after disarming
         {
-            for (k = 0; k < 3; k++) Temp[k] = 0;
-            for (k = 0; k < Gyroavgcount; k++)
-            {
-                delay(1);
-                Gyro_getRawRot();
-                for (l = 0; l < 3; l++) Temp[l] += gyroADC[l];
-            }
-            for (k = 0; k < 3; k++)
-            {
-                xyz[k][i] = Temp[k] / Gyroavgcount;
-                devPush(&var[k], xyz[k][i]);
-            }
+            devClear(&gyroVar[axis]);
+            gyroAvg[axis] = 0;
         }
-        Temp[0] = 0;
-        for (k = 0; k < 3; k++)
-        {
-            Temp[0] += devStandardDeviation(&var[k]);
+        gyroAvgCnt = 0;
+        return;
+    }
+    if (!gyroVar[0].m_n && !gyroAvgCnt)                           // Empty, a new window starts
+    {
+        gyroWindowStart = millis();
+        gyroWindowTemp  = 0;
+    }
+    for (axis = 0; axis < 3; axis++) gyroAvg[axis] += gyroADC[axis];
+    gyroWindowTemp += telemTemperature1;
+    if (++gyroAvgCnt < GYRO_BIAS_AVG) return;
+    for (axis = 0; axis < 3; axis++)
+    {
+        devPush(&gyroVar[axis], gyroAvg[axis] / GYRO_BIAS_AVG);
+        gyroAvg[axis] = 0;
+    }
+    gyroAvgCnt = 0;
+    if (millis() - gyroWindowStart < GYRO_BIAS_WINDOW_MS) return;
+
+    for (axis = 0; axis < 3; axis++)
+    {
+        std += devStandardDeviation(&gyroVar[axis]);
 #ifdef debugmode
-            gyrostddev[k] = devStandardDeviation(&var[k]);
+        gyrostddev[axis] = devStandardDeviation(&gyroVar[axis]);
 #endif
+    }
+    gyroWindowTemp /= gyroVar[0].m_n * GYRO_BIAS_AVG;
+    if (calibratingG && (std <= cfg.gy_stdev || ++gyroBiasTries >= GYRO_BIAS_TRIES))
+    {
+        for (axis = 0; axis < 3; axis++) gyroZero[axis] = gyroBias[axis] = devMean(&gyroVar[axis]);
+        gyroTref      = gyroWindowTemp;                           // Keeps a learnt temperature coefficient
+        gyroBiasTries = 0;
+        calibratingG  = false;
+    }
+    else if (!calibratingG && std <= cfg.gy_stdev)
+    {
+        dT = cfg.gy_tcomp ? (gyroWindowTemp - gyroTref) * GYRO_BIAS_TSCALE : 0;
+        for (axis = 0; axis < 3; axis++)
+        {
+            mean = devMean(&gyroVar[axis]);
+            r    = (mean - gyroBias[axis] - gyroTco[axis] * dT) * GYRO_BIAS_GAIN / (1.0f + dT * dT); // NLMS on [1 dT]
+            gyroBias[axis] += r;
+            gyroTco[axis]  += r * dT;
+            if (!cfg.gy_tcomp) gyroZero[axis] = gyroBias[axis];
         }
     }
-    while (Temp[0] > cfg.gy_stdev && breakout < 14);              // Breakout prevents endlessloop after 21 sec
-    sphere_fit_least_squares(xyz[0], xyz[1], xyz[2], Gyromaxcount, 100, 0.0f, gyroZero);
-    calibratingG = false;
+    for (axis = 0; axis < 3; axis++) devClear(&gyroVar[axis]);
 }
 
 static void GYRO_Common(void)
@@ -369,10 +424,10 @@ static void GYRO_Common(void)
     int8_t axis;
     static int16_t previousGyroADC[3] = { 0, 0, 0 };
 
-    if (calibratingG) Gyro_Calibrate();
-
+    gyroBiasUpdate();
     for (axis = 0; axis < 3; axis++)
     {
+        if (calibratingG) gyroADC[axis] = gyroZero[axis];         // No bias yet, no rotation
         gyroADC[axis]  = (gyroADC[axis] - gyroZero[axis]) * 0.25f;
         gyroADC[axis]  = constrain(gyroADC[axis], previousGyroADC[axis] - 800, previousGyroADC[axis] + 800); // gyroADC[axis]  = constrain(gyroADC[axis], previousGyroADC[axis] - 3200, previousGyroADC[axis] + 3200);//anti gyro glitch, limit the variation between two consecutive readings
         gyroData[axis] = gyroADC[axis];   // Feed gyroData here as well
@@ -380,21 +435,65 @@ static void GYRO_Common(void)
     }
 }
 
+void sensorsPrefetch(void)                                    // Scheduler: TASK_CONTROL is about due, start its gyro / acc read
+{
+    if (MpuSpecial) MPU6050Prefetch();
+}
+
 void GETMPU6050(void)
 {
     int16_t accADC16[3];  
-    int16_t gyroADC16[3];
-    uint8_t i;
-    MPU6050ReadAllShit(accADC16, &telemTemperature1, gyroADC16);
+    int16_t gyroADC16[MPU_FIFO_MAX][3];
+    int32_t gyroSum[3] = { 0, 0, 0 };
+    int8_t  n;
+    uint8_t i, k, cnt;
+    n = MPU6050ReadAllShit(accADC16, &telemTemperature1, gyroADC16);
+    GyroDeltaValid = n != 0;
+    if (n < 0)                                                 // FIFO, no new sample since the last loop. No time covered, no rotation
+    {
+        GyroDelta[0] = GyroDelta[1] = GyroDelta[2] = 0;
+        return;
+    }
+    cnt = n ? n : 1;                                           // 0 = one sample from the data registers
     if (cfg.align[ALIGN_ACCEL][0]) alignSensors(ALIGN_ACCEL, accADC16); else acc.align(accADC16);
-    if (cfg.align[ALIGN_GYRO][0])  alignSensors(ALIGN_GYRO, gyroADC16); else gyro.align(gyroADC16);  
+    for (k = 0; k < cnt; k++)
+    {
+        if (cfg.align[ALIGN_GYRO][0])  alignSensors(ALIGN_GYRO, gyroADC16[k]); else gyro.align(gyroADC16[k]);
+        for (i = 0; i < 3; i++) gyroSum[i] += gyroADC16[k][i];
+    }
     for (i = 0; i < 3; i++)
     {
         accADC[i]  = accADC16[i];
-        gyroADC[i] = gyroADC16[i];
+        gyroADC[i] = (float)gyroSum[i] / cnt;                  // PIDs get the average over the loop
     }
     ACC_Common();
     GYRO_Common();
+    if (n) gyroConing(gyroADC16, n);
+}
+
+// gy_fifo: the FIFO samples of one loop to one rotation vector. Adding up the samples alone drops the non-commutative part
+// of the rotation (coning), under vibration that shows up as attitude drift. Per sample: phi += alpha + 1/2 phi x alpha,
+// in the frame of rotateV / quaternionUpdate (PITCH, -ROLL, -YAW). The result goes into deltaGyroAngle as it is.
+static void gyroConing(int16_t (*gyroSample)[3], uint8_t n)
+{
+    float   phi[3] = { 0, 0, 0 }, a[3], c[3], scale = 0.25f * GyroScale * MPU_SAMPLE_US; // 0.25 as in GYRO_Common
+    uint8_t i;
+    if (calibratingG) n = 0;                                      // No bias yet, no rotation
+    for (i = 0; i < n; i++)
+    {
+        a[0]    =  (gyroSample[i][PITCH] - gyroZero[PITCH]) * scale;
+        a[1]    = -(gyroSample[i][ROLL]  - gyroZero[ROLL])  * scale;
+        a[2]    = -(gyroSample[i][YAW]   - gyroZero[YAW])   * scale;
+        c[0]    = phi[1] * a[2] - phi[2] * a[1];
+        c[1]    = phi[2] * a[0] - phi[0] * a[2];
+        c[2]    = phi[0] * a[1] - phi[1] * a[0];
+        phi[0] += a[0] + 0.5f * c[0];
+        phi[1] += a[1] + 0.5f * c[1];
+        phi[2] += a[2] + 0.5f * c[2];
+    }
+    GyroDelta[PITCH] =  phi[0];
+    GyroDelta[ROLL]  = -phi[1];
+    GyroDelta[YAW]   = -phi[2];
 }
 
 static void ACC_getRawRot(void)
@@ -431,24 +530,21 @@ void Gyro_getADC(void)
 
 #ifdef BARO
 void Baro_update(void)                                            // Note Pressure is now global for telemetry 1hPa = 1mBar
-{
+{                                                                 // Scheduler task, every state tells when it wants to be called again
     static float    BaroSpikeTab[5];
-    static uint32_t LastBaroTime, LastGeneraltime;
-    static uint16_t TimeTable[10], baroDeadline = 0;
+    static uint32_t LastBaroTime;
+    static uint16_t TimeTable[10];
     static uint8_t  state = 0, idx = 0, SkipCnt = 0;
     float           extmp;
     bool            rdy;
     uint8_t         sortidx, maxsortidx, i;
     uint32_t        TimeNowMicros, TimeSum = 0;
 
-    newbaroalt = false;                                           // Reset Newbarovalue since it's iterative and not interrupt driven it's OK
-    if (micros() - LastGeneraltime < baroDeadline) return;        // Make it rollover friendly
     switch (state)
     {
     case 0:
         baro.start_ut();                                          // Temperature Conversion start
-        LastGeneraltime = micros();
-        baroDeadline    = baro.ut_delay - 1;
+        schedulerDelayTask(TASK_BARO, baro.ut_delay - 1);
         SkipCnt = 0;                                              // Reset Skipcounter, reduces 27ms delay to average 20ms delay for ms baro (37Hz to 50Hz)
         state++;
         break;
@@ -457,13 +553,12 @@ void Baro_update(void)                                            // Note Pressu
         state++;
     case 2:
         baro.start_up();                                          // Pressure Conversion start
-        LastGeneraltime = micros();
-        baroDeadline    = baro.up_delay - 1;
+        schedulerDelayTask(TASK_BARO, baro.up_delay - 1);
         state++;
         break;
     case 3:
         baro.get_up();                                            // Readout Pressure
-        baroDeadline    = 0;                                      // Don't use delay between read. Cycletime is enough. Before: TimeNowMicros + baro.repeat_delay - 1;
+        schedulerDelayTask(TASK_BARO, 0);                         // Don't use delay between read, next conversion starts in the next slack. Before: TimeNowMicros + baro.repeat_delay - 1;
         ActualPressure  = baro.calculate();
         TimeNowMicros   = micros();                               // Do timestuff
         TimeTable[idx]  = TimeNowMicros - LastBaroTime;           // Filter Timejitter here
@@ -492,11 +587,11 @@ void Baro_update(void)                                            // Note Pressu
             maxsortidx --;
         }
         if(GroundAltInitialized) ActualPressure = BaroSpikeTab[2];// Do Groundalt with raw values to prevent runup from old sikefilter value
-        BaroAlt = (1.0f - pow(ActualPressure / 101325.0f, 0.190295f)) * 4433000.0f; // Centimeter. Actual mwii/bf does it the apm way, no doubt it's faster but better? I stick to the slower, more precise method.
+        BaroAlt = fastBaroAlt(ActualPressure);                   // Centimeter. Same formula as before, polynomial instead of the double pow(), < 0.4cm off
         SkipCnt++ ;
         if (SkipCnt == 2 || baro.baro_type == 1) state = 0;       // Read new Temp every 2nd run gives us little more speed without loosing resolution. However it worsens BMP - so not done there // baro_type: 1 = BMP 2 = MS
         else state = 2;
-        newbaroalt = true;
+        newbaroalt = true;                                        // Consumed and reset by getEstimatedAltitude
         break;
     }
 }
@@ -596,6 +691,7 @@ void Sonar_update(void)
         }
         else
         {
+            newsonaralt = true;                                                       // Consumed and reset by getEstimatedAltitude
             switch(SonarStatus)
             {
             case 0:
@@ -627,6 +723,7 @@ void Mag_init(void)                                               // initialize
     LD1_ON();
     hmc5883lInit(magCal);                                         // Crashpilot: Calculate Gains / Scale
     LD1_OFF();
+    if (cfg.mag_aux && MpuSpecial) mpu6050AuxMagInit();           // Falls back to direct reads, when there is no mag on the MPU aux bus
 }
 
 static void Mag_getRawADC(void)                                   // Read aligned
@@ -637,61 +734,60 @@ static void Mag_getRawADC(void)                                   // Read aligne
     for (i = 0; i < 3; i++) magADCfloat[i] = (float)magADC[i];    // Put into floats
 }
 
-int Mag_getADC(void)
+void Mag_getADC(void)                                             // Scheduler task, 71Hz in normal operation this is below 75 hz
 {
-    static uint32_t Lasttime = 0, Deadline = 0;
-    uint8_t         i;
-    uint32_t        TimeNow = micros();
-    if (TimeNow - Lasttime < Deadline) return 0;                  // Make it rollover friendly that (int_32) stuff actually didn't work on baro
-    Lasttime = TimeNow;
-    Deadline = 14000;                                             // Do 71Hz in normal operation this is below 75 hz
-    if (f.CALIBRATE_MAG)                                          // Lets calibrate
-    {
-        Mag_Calibration();                                        // Calibrates and saves whatever result
-        f.CALIBRATE_MAG = false;                                  // Dont do this again...      
-    }
-    else                                                          // Normal stuff here. We apply scale & bias if calib is done
-    {
-        Mag_getRawADC();                                          // Read mag sensor with orientation correction do nothing more for now
-        for (i = 0; i < 3; i++)
-        {
-            magADCfloat[i]   = magADCfloat[i] * magCal[i];        // Adjust Mag readout by GAIN/SCALE
-            magADCfloat[i]  -= cfg.magZero[i];                    // AND by BIAS
-        }
-    }
-    return 1;                                                     // Signalize something was done with 1
+    float   tmp[3];
+    uint8_t i;
+    Mag_getRawADC();                                              // Read mag sensor with orientation correction
+    for (i = 0; i < 3; i++) magADCfloat[i] = magADCfloat[i] * magCal[i]; // Adjust Mag readout by GAIN/SCALE
+    if (f.CALIBRATE_MAG) Mag_Calibration();                       // Runs along in the background, on the gain adjusted values
+    for (i = 0; i < 3; i++) tmp[i] = magADCfloat[i] - cfg.magZero[i]; // AND by BIAS
+    for (i = 0; i < 3; i++) magADCfloat[i] = cfg.magSoft[i][0] * tmp[0] + cfg.magSoft[i][1] * tmp[1] + cfg.magSoft[i][2] * tmp[2]; // AND soft iron, identity without ellipsoid fit
 }
 
-static void Mag_Calibration(void)                                 // Called from XHz loop normally....
-{
-#define MAGmaxcount      500                                      // Take 500 samples at 10Hz rate i.e 50Sec
+// Mag calibration takes one step per mag read, the FC keeps running, armed or not.
+// Every point (average of some reads) goes into the running sums of the sphere fit and, with mag_ellip = 1,
+// into the normal equations of the ellipsoid fit. Nothing is stored, RAM use is constant.
+// The result is saved with the next disarmed eeprom write (ScheduleEEPROMwriteMS), so no flash write in flight.
+#define MAGmaxcount      500                                      // Fit points, cfg.mag_time minutes for all of them
 #define MAGerror       10000
 #define MAGdiscardcnt     50
-    float    xyz[3][MAGmaxcount], Temp[3];
-    uint16_t ValIDX;
-    uint8_t  i, k;
-    uint8_t  gathercnt = cfg.mag_time * 5;
-
-    for (i = 0; i < MAGdiscardcnt; i++)                           // Discard first reads at 50Hz Rate
-    {
-        delay(20);
-        Mag_getRawADC();
-    }
-
-    for (ValIDX = 0; ValIDX < MAGmaxcount; ValIDX++)              // Gather up Mag Data. Freeze FC. Adjust Mag readout JUST by GAIN/SCALE
+static void Mag_Calibration(void)
+{
+    static sphereFit_t    fit;
+    static ellipsoidFit_t efit;
+    static float          Temp[3];
+    static uint16_t       ValIDX, discard;
+    static uint8_t        cnt;
+    uint8_t               i, k, gathercnt;
+
+    if (discard < MAGdiscardcnt)                                  // Discard first reads
     {
-        for (i = 0; i < 3; i++) Temp[i] = 0;                      // Clear accumulator
-        for (i = 0; i < gathercnt; i++)                           // Get some!
+        if (!discard++)
         {
-            delay(24);                                            // Do 42 Hz // Math 24ms * 500 * 5 = 60000ms = 1 Minute
-            Mag_getRawADC();                                      // Read mag sensor with correct orientation
-            for (k = 0; k < 3; k++) Temp[k] += magADCfloat[k];
+            sphereFitClear(&fit);
+            ellipsoidFitClear(&efit);
+            for (i = 0; i < 3; i++) Temp[i] = 0;
+            ValIDX = cnt = 0;
         }
-        for (i = 0; i < 3; i++) xyz[i][ValIDX] = (Temp[i] / (float)gathercnt) * magCal[i];
-        LED0_TOGGLE;
+        return;
     }
 
-    sphere_fit_least_squares(xyz[0], xyz[1], xyz[2], MAGmaxcount, 100, 0.0f, cfg.magZero);
+    gathercnt = constrain(((uint32_t)cfg.mag_time * (60000000 / MAGmaxcount)) / tasks[TASK_MAG].period, 1, 255);
+    for (i = 0; i < 3; i++) Temp[i] += magADCfloat[i];
+    if (++cnt < gathercnt) return;
+    for (i = 0; i < 3; i++) Temp[i] /= (float)cnt;
+    sphereFitPush(&fit, Temp[0], Temp[1], Temp[2]);
+    if (cfg.mag_ellip) ellipsoidFitPush(&efit, Temp[0], Temp[1], Temp[2]);
+    for (i = 0; i < 3; i++) Temp[i] = 0;
+    cnt = 0;
+    if (++ValIDX < MAGmaxcount) return;
+
+    for (i = 0; i < 3; i++)                                       // Sphere: no soft iron
+    {
+        for (k = 0; k < 3; k++) cfg.magSoft[i][k] = (i == k) ? 1.0f : 0.0f;
+    }
+    if (!cfg.mag_ellip || !ellipsoidFitSolve(&efit, cfg.magZero, cfg.magSoft)) sphereFitSolve(&fit, 100, 0.0f, cfg.magZero); // Fall back to the sphere when the ellipsoid is degenerated
     cfg.mag_calibrated = 1;
     for (i = 0; i < 3; i++)
     {
@@ -702,9 +798,14 @@ static void Mag_Calibration(void)                                 // Called from
         }
     }
     cfg.mag_motorcompusable = 0;                                  // Future: After mag calibration a new motorcompensation is needed
-    writeParams(1);                                               // Calibration done, save whatever result
+    ScheduleEEPROMwriteMS = 1;                                    // Calibration done, save whatever result when disarmed
+    toggleBeep      = 2;
+    discard         = 0;
+    f.CALIBRATE_MAG = false;                                      // Dont do this again...
 }
 
+#endif
+
 /****************************************************************************
  *
  *   Copyright (C) 2012 PX4 Development Team. All rights reserved.
@@ -742,45 +843,50 @@ static void Mag_Calibration(void)                                 // Called from
  *
  * Crashpilot note: Parameter slightly changed. Size to float.
  * Docu is here: https://pixhawk.ethz.ch/px4/docs/calibration__routines_8cpp.html
+ * Split into sphereFitClear / sphereFitPush / sphereFitSolve: the fit only needs the running sums,
+ * so the callers push samples as they come and need no sample arrays.
  ****************************************************************************/
-void sphere_fit_least_squares(const float x[], const float y[], const float z[], uint16_t size, uint16_t max_iterations, float delta, float *sphere)
+void sphereFitClear(sphereFit_t *fit)
+{
+    memset(fit, 0, sizeof(sphereFit_t));
+}
+
+void sphereFitPush(sphereFit_t *fit, float x, float y, float z)
 {
-    uint16_t i, n;
-    float x_sumplain = 0.0f, x_sumsq = 0.0f, x_sumcube = 0.0f, y_sumplain = 0.0f, y_sumsq = 0.0f;
-    float y_sumcube = 0.0f, z_sumplain = 0.0f, z_sumsq = 0.0f, z_sumcube = 0.0f, xy_sum = 0.0f;
-    float xz_sum = 0.0f, yz_sum = 0.0f, x2y_sum = 0.0f, x2z_sum = 0.0f, y2x_sum = 0.0f, y2z_sum = 0.0f;
-    float z2x_sum = 0.0f, z2y_sum = 0.0f, x2 = 0.0f, y2 = 0.0f, z2 = 0.0f, x_sum = 0.0f, x_sum2 = 0.0f;
+    float x2 = x * x, y2 = y * y, z2 = z * z;
+    fit->x   += x;
+    fit->y   += y;
+    fit->z   += z;
+    fit->x2  += x2;
+    fit->y2  += y2;
+    fit->z2  += z2;
+    fit->x3  += x2 * x;
+    fit->y3  += y2 * y;
+    fit->z3  += z2 * z;
+    fit->xy  += x * y;
+    fit->xz  += x * z;
+    fit->yz  += y * z;
+    fit->x2y += x2 * y;
+    fit->x2z += x2 * z;
+    fit->y2x += y2 * x;
+    fit->y2z += y2 * z;
+    fit->z2x += z2 * x;
+    fit->z2y += z2 * y;
+    fit->n++;
+}
+
+void sphereFitSolve(sphereFit_t *fit, uint16_t max_iterations, float delta, float *sphere)
+{
+    uint16_t n;
+    float x_sum = 0.0f, x_sum2 = 0.0f;
     float x_sum3 = 0.0f, y_sum = 0.0f, y_sum2 = 0.0f, y_sum3 = 0.0f, z_sum = 0.0f, z_sum2 = 0.0f, z_sum3 = 0.0f;
     float XY = 0.0f, XZ = 0.0f, YZ = 0.0f, X2Y = 0.0f, X2Z = 0.0f, Y2X = 0.0f, Y2Z = 0.0f, Z2X = 0.0f, Z2Y = 0.0f;
     float F0 = 0.0f, F1 = 0.0f, F2 = 0.0f, F3 = 0.0f, F4 = 0.0f, A = 0.0f, B = 0.0f, C = 0.0f, A2 = 0.0f, B2 = 0.0f;
     float C2 = 0.0f, QS = 0.0f, QB = 0.0f, Rsq = 0.0f, Q0 = 0.0f, Q1 = 0.0f, Q2 = 0.0f, aA = 0.0f, aB = 0.0f, aC = 0.0f;
     float nA = 0.0f, nB = 0.0f, nC = 0.0f, dA = 0.0f, dB = 0.0f, dC = 0.0f;
-    float fltsize = (float)size;
-  
-    for (i = 0; i < size; i++)
-    {
-        x2 = x[i] * x[i];
-        y2 = y[i] * y[i];
-        z2 = z[i] * z[i];
-        x_sumplain += x[i];
-        x_sumsq += x2;
-        x_sumcube += x2 * x[i];
-        y_sumplain += y[i];
-        y_sumsq += y2;
-        y_sumcube += y2 * y[i];
-        z_sumplain += z[i];
-        z_sumsq += z2;
-        z_sumcube += z2 * z[i];
-        xy_sum += x[i] * y[i];
-        xz_sum += x[i] * z[i];
-        yz_sum += y[i] * z[i];
-        x2y_sum += x2 * y[i];
-        x2z_sum += x2 * z[i];
-        y2x_sum += y2 * x[i];
-        y2z_sum += y2 * z[i];
-        z2x_sum += z2 * x[i];
-        z2y_sum += z2 * y[i];
-    }
+    float fltsize = (float)fit->n;
+
+    if (!fit->n) return;                                          // Nothing pushed, keep the old values
 
     //Least Squares Fit a sphere A,B,C with radius squared Rsq to 3D data
     //
@@ -799,24 +905,24 @@ void sphere_fit_least_squares(const float x[], const float y[], const float z[],
     //
     //This method should converge; maybe 5-100 iterations or more.
     //
-    x_sum  = x_sumplain / fltsize;    //sum( X[n] )
-    x_sum2 = x_sumsq    / fltsize;    //sum( X[n]^2 )
-    x_sum3 = x_sumcube  / fltsize;    //sum( X[n]^3 )
-    y_sum  = y_sumplain / fltsize;    //sum( Y[n] )
-    y_sum2 = y_sumsq    / fltsize;    //sum( Y[n]^2 )
-    y_sum3 = y_sumcube  / fltsize;    //sum( Y[n]^3 )
-    z_sum  = z_sumplain / fltsize;    //sum( Z[n] )
-    z_sum2 = z_sumsq    / fltsize;    //sum( Z[n]^2 )
-    z_sum3 = z_sumcube  / fltsize;    //sum( Z[n]^3 )
-    XY     = xy_sum     / fltsize;    //sum( X[n] * Y[n] )
-    XZ     = xz_sum     / fltsize;    //sum( X[n] * Z[n] )
-    YZ     = yz_sum     / fltsize;    //sum( Y[n] * Z[n] )
-    X2Y    = x2y_sum    / fltsize;    //sum( X[n]^2 * Y[n] )
-    X2Z    = x2z_sum    / fltsize;    //sum( X[n]^2 * Z[n] )
-    Y2X    = y2x_sum    / fltsize;    //sum( Y[n]^2 * X[n] )
-    Y2Z    = y2z_sum    / fltsize;    //sum( Y[n]^2 * Z[n] )
-    Z2X    = z2x_sum    / fltsize;    //sum( Z[n]^2 * X[n] )
-    Z2Y    = z2y_sum    / fltsize;    //sum( Z[n]^2 * Y[n] )
+    x_sum  = fit->x   / fltsize;    //sum( X[n] )
+    x_sum2 = fit->x2  / fltsize;    //sum( X[n]^2 )
+    x_sum3 = fit->x3  / fltsize;    //sum( X[n]^3 )
+    y_sum  = fit->y   / fltsize;    //sum( Y[n] )
+    y_sum2 = fit->y2  / fltsize;    //sum( Y[n]^2 )
+    y_sum3 = fit->y3  / fltsize;    //sum( Y[n]^3 )
+    z_sum  = fit->z   / fltsize;    //sum( Z[n] )
+    z_sum2 = fit->z2  / fltsize;    //sum( Z[n]^2 )
+    z_sum3 = fit->z3  / fltsize;    //sum( Z[n]^3 )
+    XY     = fit->xy  / fltsize;    //sum( X[n] * Y[n] )
+    XZ     = fit->xz  / fltsize;    //sum( X[n] * Z[n] )
+    YZ     = fit->yz  / fltsize;    //sum( Y[n] * Z[n] )
+    X2Y    = fit->x2y / fltsize;    //sum( X[n]^2 * Y[n] )
+    X2Z    = fit->x2z / fltsize;    //sum( X[n]^2 * Z[n] )
+    Y2X    = fit->y2x / fltsize;    //sum( Y[n]^2 * X[n] )
+    Y2Z    = fit->y2z / fltsize;    //sum( Y[n]^2 * Z[n] )
+    Z2X    = fit->z2x / fltsize;    //sum( Z[n]^2 * X[n] )
+    Z2Y    = fit->z2y / fltsize;    //sum( Z[n]^2 * Y[n] )
 
     //Reduction of multiplications
      F0 = x_sum2 + y_sum2 + z_sum2;
@@ -890,4 +996,176 @@ void sphere_fit_least_squares(const float x[], const float y[], const float z[],
     sphere[1] = B;
     sphere[2] = C;
 }
-#endif
+
+// Ellipsoid fit for hard and soft iron. Least squares on the quadric
+// a*x^2 + b*y^2 + c*z^2 + 2d*xy + 2e*xz + 2f*yz + 2g*x + 2h*y + 2i*z = 1 over running sums (normal equations).
+// Result is the center and the symmetric matrix W that maps the ellipsoid on a sphere of the same volume,
+// corrected = W * (raw - center). Symmetric, so the heading gets no extra rotation.
+#define ELLIPmaxratio 2.0f                                        // Longest / shortest axis, more is no soft iron but bad data
+
+void ellipsoidFitClear(ellipsoidFit_t *fit)
+{
+    memset(fit, 0, sizeof(ellipsoidFit_t));
+}
+
+void ellipsoidFitPush(ellipsoidFit_t *fit, float x, float y, float z)
+{
+    float   d[9];
+    uint8_t i, j, k = 0;
+
+    if (fit->scale == 0.0f)                                       // Scale by the first point, keeps the float sums in range
+    {
+        fit->scale = sqrtf(x * x + y * y + z * z);
+        if (fit->scale == 0.0f) return;
+        fit->scale = 1.0f / fit->scale;
+    }
+    x *= fit->scale;
+    y *= fit->scale;
+    z *= fit->scale;
+    d[0] = x * x;
+    d[1] = y * y;
+    d[2] = z * z;
+    d[3] = 2.0f * x * y;
+    d[4] = 2.0f * x * z;
+    d[5] = 2.0f * y * z;
+    d[6] = 2.0f * x;
+    d[7] = 2.0f * y;
+    d[8] = 2.0f * z;
+    for (i = 0; i < 9; i++)
+    {
+        for (j = i; j < 9; j++) fit->ata[k++] += d[i] * d[j];     // Upper triangle only
+        fit->atb[i] += d[i];
+    }
+    fit->n++;
+}
+
+static void jacobiEigen3(float a[3][3], float v[3][3])           // a symmetric, ends up diagonal with the eigenvalues, columns of v are the eigenvectors
+{
+    float   theta, t, c, s, tp, tq;
+    uint8_t sweep, p, q, k;
+
+    for (p = 0; p < 3; p++)
+    {
+        for (q = 0; q < 3; q++) v[p][q] = (p == q) ? 1.0f : 0.0f;
+    }
+    for (sweep = 0; sweep < 10; sweep++)
+    {
+        for (p = 0; p < 2; p++)
+        {
+            for (q = p + 1; q < 3; q++)
+            {
+                if (fabsf(a[p][q]) < 1e-9f) continue;
+                theta = (a[q][q] - a[p][p]) / (2.0f * a[p][q]);
+                t = 1.0f / (fabsf(theta) + sqrtf(theta * theta + 1.0f));
+                if (theta < 0.0f) t = -t;
+                c = 1.0f / sqrtf(t * t + 1.0f);
+                s = t * c;
+                for (k = 0; k < 3; k++)                           // a = a * J
+                {
+                    tp = a[k][p];
+                    tq = a[k][q];
+                    a[k][p] = c * tp - s * tq;
+                    a[k][q] = s * tp + c * tq;
+                }
+                for (k = 0; k < 3; k++)                           // a = J' * a
+                {
+                    tp = a[p][k];
+                    tq = a[q][k];
+                    a[p][k] = c * tp - s * tq;
+                    a[q][k] = s * tp + c * tq;
+                }
+                for (k = 0; k < 3; k++)                           // v = v * J
+                {
+                    tp = v[k][p];
+                    tq = v[k][q];
+                    v[k][p] = c * tp - s * tq;
+                    v[k][q] = s * tp + c * tq;
+                }
+            }
+        }
+    }
+}
+
+bool ellipsoidFitSolve(ellipsoidFit_t *fit, float *center, float soft[3][3])
+{
+    float   m[9][10], M[3][3], V[3][3], inv[3][3], sq[3], det, k, tmp;
+    uint8_t i, j, r, piv, idx = 0;
+
+    if (fit->n < 9) return false;
+    for (i = 0; i < 9; i++)                                       // Rebuild the full normal equations
+    {
+        for (j = i; j < 9; j++) m[i][j] = m[j][i] = fit->ata[idx++];
+        m[i][9] = fit->atb[i];
+    }
+    for (i = 0; i < 9; i++)                                       // Gauss with partial pivoting
+    {
+        piv = i;
+        for (r = i + 1; r < 9; r++) if (fabsf(m[r][i]) > fabsf(m[piv][i])) piv = r;
+        if (fabsf(m[piv][i]) < 1e-12f) return false;
+        if (piv != i)
+        {
+            for (j = 0; j < 10; j++)
+            {
+                tmp = m[i][j];
+                m[i][j] = m[piv][j];
+                m[piv][j] = tmp;
+            }
+        }
+        for (r = i + 1; r < 9; r++)
+        {
+            tmp = m[r][i] / m[i][i];
+            for (j = i; j < 10; j++) m[r][j] -= tmp * m[i][j];
+        }
+    }
+    for (i = 9; i-- > 0; )                                        // Back substitution, solution ends up in m[i][9]
+    {
+        for (j = i + 1; j < 9; j++) m[i][9] -= m[i][j] * m[j][9];
+        m[i][9] /= m[i][i];
+    }
+
+    M[0][0] = m[0][9]; M[1][1] = m[1][9]; M[2][2] = m[2][9];
+    M[0][1] = M[1][0] = m[3][9];
+    M[0][2] = M[2][0] = m[4][9];
+    M[1][2] = M[2][1] = m[5][9];
+    inv[0][0] =   M[1][1] * M[2][2] - M[1][2] * M[2][1];             // Cofactors, M is symmetric
+    inv[0][1] = -(M[0][1] * M[2][2] - M[0][2] * M[2][1]);
+    inv[0][2] =   M[0][1] * M[1][2] - M[0][2] * M[1][1];
+    inv[1][1] =   M[0][0] * M[2][2] - M[0][2] * M[2][0];
+    inv[1][2] = -(M[0][0] * M[1][2] - M[0][2] * M[1][0]);
+    inv[2][2] =   M[0][0] * M[1][1] - M[0][1] * M[1][0];
+    inv[1][0] = inv[0][1];
+    inv[2][0] = inv[0][2];
+    inv[2][1] = inv[1][2];
+    det = M[0][0] * inv[0][0] + M[0][1] * inv[1][0] + M[0][2] * inv[2][0];
+    if (det <= 0.0f || M[0][0] <= 0.0f || inv[2][2] <= 0.0f) return false; // Not positive definite, no ellipsoid
+    for (i = 0; i < 3; i++)                                       // center = -M^-1 * (g, h, i)
+    {
+        sq[i] = -(inv[i][0] * m[6][9] + inv[i][1] * m[7][9] + inv[i][2] * m[8][9]) / det;
+    }
+    k = 1.0f;                                                     // (v - c)' M (v - c) = 1 + c' M c
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 3; j++) k += sq[i] * M[i][j] * sq[j];
+    }
+    if (k <= 0.0f) return false;
+    for (i = 0; i < 3; i++)
+    {
+        center[i] = sq[i] / fit->scale;
+        for (j = 0; j < 3; j++) M[i][j] /= k;
+    }
+
+    jacobiEigen3(M, V);                                           // W = V * sqrt(eigenvalues) * V', scaled to determinant 1
+    for (i = 0; i < 3; i++)
+    {
+        if (M[i][i] <= 0.0f) return false;
+        sq[i] = sqrtf(M[i][i]);
+    }
+    tmp = max(sq[0], max(sq[1], sq[2])) / min(sq[0], min(sq[1], sq[2]));
+    if (tmp > ELLIPmaxratio) return false;
+    tmp = 1.0f / cbrtf(sq[0] * sq[1] * sq[2]);
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 3; j++) soft[i][j] = (V[i][0] * sq[0] * V[j][0] + V[i][1] * sq[1] * V[j][1] + V[i][2] * sq[2] * V[j][2]) * tmp;
+    }
+    return true;
+}
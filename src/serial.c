@@ -7,7 +7,7 @@
 #define PLATFORM_32BIT           0x80000000
 
 #define MSP_IDENT                100    //out message         multitype + version
-#define MSP_STATUS               101    //out message         cycletime & errors_count & sensor present & box activation
+#define MSP_STATUS               101    //out message         cycletime & errors_count & sensor present & box activation, then loop stats
 #define MSP_RAW_IMU              102    //out message         9 DOF
 #define MSP_SERVO                103    //out message         8 servos
 #define MSP_MOTOR                104    //out message         8 motors
@@ -25,6 +25,9 @@
 #define MSP_BOXNAMES             116    //out message         the aux switch names
 #define MSP_PIDNAMES             117    //out message         the PID names
 #define MSP_WP                   118    //out message         get a WP, WP# is in the payload, returns (WP#, lat, lon, alt, flags) WP#0-home, WP#16-poshold
+#define MSP_PERF                 130    //out message         perf probes: count, buckets, then min, avg, max (us) and histogram per probe
+#define MSP_VIBRATION            131    //out message         vibration peaks of pass_mot slot in the payload (0 = all motors): slot, axes, peaks, sample Hz, captures, throttle, freq (0.1Hz) & amp per peak
+#define MSP_BLACKBOX             132    //out message         blackbox log from the offset (u32) in the payload: bytes used, offset, up to 128 bytes of the log
 
 #define MSP_SET_RAW_RC           200    //in message          8 rc chan
 #define MSP_SET_RAW_GPS          201    //in message          fix, numsat, lat, lon, alt, speed
@@ -36,6 +39,7 @@
 #define MSP_SET_MISC             207    //in message          powermeter trig + 8 free for future use
 #define MSP_RESET_CONF           208    //in message          no param
 #define MSP_WP_SET               209    //in message          sets a given WP (WP#,lat, lon, alt, flags)
+#define MSP_BLACKBOX_ERASE       210    //in message          erase the blackbox, in the background while disarmed
 
 #define MSP_EEPROM_WRITE         250    //in message          no param
 
@@ -43,8 +47,11 @@
 #define MSP_DEBUG                254    //out message         debug1,debug2,debug3,debug4
 
 #define INBUF_SIZE 64
+#define OUTBUF_SIZE (6 + 255)                   // Header, payload size is 8 bit, checksum
 
 static uint8_t  checksum, indRX, inBuf[INBUF_SIZE];
+static uint8_t  outBuf[OUTBUF_SIZE];            // The reply is collected and goes to the uart whole, or not at all when it has no room
+static uint16_t outLen;
 static uint8_t  cmdMSP;
 static uint32_t LastValidProtocolTimestampMS;
 uint8_t  Currentprotocol;               // 0=Dont Know 1=Mwii 2=Mavlink
@@ -52,38 +59,24 @@ uint8_t  Currentprotocol;               // 0=Dont Know 1=Mwii 2=Mavlink
 // static bool guiConnected = false;
 uint8_t cliMode = 0;                                    // signal that we're in cli mode
 
-void serialize32(uint32_t a)
+void serialize8(uint8_t a)
 {
-    static uint8_t t;
-    t = a;
-    uartWrite(t);
-    checksum ^= t;
-    t = a >> 8;
-    uartWrite(t);
-    checksum ^= t;
-    t = a >> 16;
-    uartWrite(t);
-    checksum ^= t;
-    t = a >> 24;
-    uartWrite(t);
-    checksum ^= t;
+    if (outLen < OUTBUF_SIZE) outBuf[outLen++] = a;
+    checksum ^= a;
 }
 
-void serialize16(int16_t a)
+void serialize32(uint32_t a)
 {
-    static uint8_t t;
-    t = a;
-    uartWrite(t);
-    checksum ^= t;
-    t = a >> 8 & 0xff;
-    uartWrite(t);
-    checksum ^= t;
+    serialize8(a);
+    serialize8(a >> 8);
+    serialize8(a >> 16);
+    serialize8(a >> 24);
 }
 
-void serialize8(uint8_t a)
+void serialize16(int16_t a)
 {
-    uartWrite(a);
-    checksum ^= a;
+    serialize8(a);
+    serialize8(a >> 8 & 0xff);
 }
 
 uint8_t read8(void)
@@ -107,6 +100,7 @@ uint32_t read32(void)
 
 void headSerialResponse(uint8_t err, uint8_t s)
 {
+    outLen = 0;
     serialize8('$');
     serialize8('M');
     serialize8(err ? '!' : '>');
@@ -125,9 +119,10 @@ void headSerialError(uint8_t s)
     headSerialResponse(1, s);
 }
 
-void tailSerialReply(void)
+void tailSerialReply(void)                      // A dropped reply is counted in uartTxStats, the GUI asks again
 {
     serialize8(checksum);
+    uartWriteBlock(outBuf, outLen);
 }
 
 void serializeNames(const char *s)
@@ -204,7 +199,7 @@ static void evaluateCommand(void)
         serialize32(PLATFORM_32BIT);        // "capability"
         break;
     case MSP_STATUS:
-        headSerialReply(11);
+        headSerialReply(11 + 10 + LOOP_BUCKETS * 2);
         serialize16(cycleTime);
         serialize16(i2cGetErrorCounter());
         serialize16(sensors(SENSOR_ACC)                   |
@@ -229,6 +224,12 @@ static void evaluateCommand(void)
                     rcOptions[BOXOSD]      << BOXOSD      |
 	            f.FAILSAFE             << BOXFAILSAFE );
         serialize8(0);
+        serialize16(tasks[TASK_CONTROL].period);            // Appended, old GUIs just read the first 11 bytes
+        serialize32(loopStats.overruns);
+        serialize16(min(loopStats.maxCycle, 0xFFFF));
+        serialize8(loopStats.stallTask);
+        serialize8(LOOP_BUCKETS);
+        for (i = 0; i < LOOP_BUCKETS; i++) serialize16(min(loopStats.hist[i], 0xFFFF)); // Saturated
         break;
     case MSP_RAW_IMU:
         headSerialReply(18);
@@ -368,6 +369,10 @@ static void evaluateCommand(void)
         checkFirstTime(true);
         headSerialReply(0);
         break;
+    case MSP_BLACKBOX_ERASE:
+        if (!f.ARMED) blackboxErase();
+        headSerialReply(0);
+        break;
     case MSP_ACC_CALIBRATION:
         calibratingA = true;
         headSerialReply(0);
@@ -380,6 +385,49 @@ static void evaluateCommand(void)
         writeParams(0);
         headSerialReply(0);
         break;
+    case MSP_PERF:
+        headSerialReply(2 + PERF_COUNT * (3 + PERF_BUCKETS) * 2);
+        serialize8(PERF_COUNT);
+        serialize8(PERF_BUCKETS);
+        for (i = 0; i < PERF_COUNT; i++)
+        {
+            serialize16(min(perfProbes[i].min, 0xFFFF));
+            serialize16(min(perfAvg(i), 0xFFFF));
+            serialize16(min(perfProbes[i].max, 0xFFFF));
+            for (tmpu32 = 0; tmpu32 < PERF_BUCKETS; tmpu32++) serialize16(min(perfProbes[i].hist[tmpu32], 0xFFFF)); // Saturated
+        }
+        break;
+    case MSP_VIBRATION:
+        wp_no = read8();                                    // Slot, like the WP number of MSP_WP
+        if (wp_no >= VIB_SLOTS) wp_no = cfg.pass_mot < VIB_SLOTS ? cfg.pass_mot : 0;
+        headSerialReply(9 + VIB_AXES * VIB_PEAKS * 4);
+        serialize8(wp_no);
+        serialize8(VIB_AXES);
+        serialize8(VIB_PEAKS);
+        serialize16(1000000 / VIB_SAMPLE_US);
+        serialize16(vibResult(wp_no)->captures);
+        serialize16(vibResult(wp_no)->throttle);
+        for (i = 0; i < VIB_AXES; i++)
+        {
+            for (tmpu32 = 0; tmpu32 < VIB_PEAKS; tmpu32++)
+            {
+                serialize16(vibResult(wp_no)->peak[i][tmpu32].freq);
+                serialize16(vibResult(wp_no)->peak[i][tmpu32].amp);
+            }
+        }
+        break;
+    case MSP_BLACKBOX:
+        tmpu32 = read32();                                  // Offset, the host asks for the next one until it has "bytes used"
+        i = tmpu32 < blackboxStats.used ? min(blackboxStats.used - tmpu32, 128) : 0;
+        headSerialReply(8 + i);
+        serialize32(blackboxStats.used);
+        serialize32(tmpu32);
+        while (i--)
+        {
+            blackboxRead(tmpu32++, &wp_no, 1);
+            serialize8(wp_no);
+        }
+        break;
     case MSP_DEBUG:
         headSerialReply(8);
         for (i = 0; i < 4; i++) serialize16(debug[i]);      // 4 variables are here for general monitoring purpose
@@ -482,8 +530,7 @@ void serialCom(void)
         case 0:
             Currentprotocol = PROTOCOL_MWII21;
             break;
-        case 1:                                                                     // Do Frsky here
-            sendFRSKYTelemetry();
+        case 1:                                                                     // Frsky is sent by its own scheduler task (TASK_TELEMETRY)
             break;
         case 2:
         case 3:
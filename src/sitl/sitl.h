@@ -0,0 +1,55 @@
+#pragma once
+
+// SITL: software in the loop build of the flight code for the host (make TARGET=SITL)
+// The drv_ layer is replaced by the files in src/sitl, everything above it is the unchanged firmware.
+// Time is virtual: micros() / millis() only advance when the simulation says so, so the
+// firmware runs as fast as the host allows and a run is reproducible.
+
+#define SITL_MODEL_DT_US   1000                             // Physics step, 1KHz
+#define SITL_LOOP_COST_US  20                               // Virtual cpu time charged for one pass through loop()
+#define SITL_I2C_BYTE_US   23                               // 9 bits @ 400KHz
+
+typedef struct sitlState_t
+{
+    float    pos[3];                                        // NED, m. Home is 0,0,0
+    float    vel[3];                                        // NED, m/s
+    float    q[4];                                          // Attitude, body (FRD) to NED
+    float    rate[3];                                       // Body rates p q r rad/s
+    float    motorSpeed[4];                                 // 0..1 after motor lag
+    float    specForce[3];                                  // Specific force in body frame m/s^2 (what an acc measures)
+    float    magBody[3];                                    // Earth field in body frame Gauss
+    float    roll, pitch, yaw;                              // Euler angles deg, for logging and the pilot
+    bool     onGround;
+} sitlState_t;
+
+extern sitlState_t sitl;
+extern uint16_t    sitlMotorPwm[MAX_MOTORS];
+extern uint16_t    sitlServoPwm[MAX_SERVOS];
+
+// sitl_system.c
+void     sitlInit(int argc, char *argv[]);
+void     sitlConfig(void);
+void     sitlLoop(void);
+void     sitlAdvance(uint32_t us);
+uint64_t sitlMicros64(void);
+float    sitlNoise(float sigma);
+
+// sitl_model.c
+void     sitlModelInit(void);
+void     sitlModelStep(float dt);
+void     sitlPilotUpdate(void);
+uint16_t sitlPilotChannel(uint8_t chan);
+bool     sitlPilotDone(void);
+
+// sitl_i2c.c
+void     sitlI2cInit(void);
+void     sitlI2cUpdate(void);
+void     sitlMpuSample(void);
+
+// sitl_io.c
+void     sitlEscUpdate(uint64_t now);
+
+// sitl_uart.c
+void     sitlUartInit(uint16_t port);
+void     sitlUartPoll(void);
+void     sitlGpsUpdate(void);
@@ -0,0 +1,118 @@
+#pragma once
+
+// SITL: host stand-ins for the few stm32 stdperiph / cmsis bits the flight code touches.
+// Included by board.h instead of stm32f10x_conf.h and core_cm3.h when building TARGET=SITL.
+// Peripheral "registers" are plain structs in host memory, flash lives in an array that is backed by a file.
+
+typedef enum { RESET = 0, SET = !RESET } FlagStatus, ITStatus;
+typedef enum { DISABLE = 0, ENABLE = !DISABLE } FunctionalState;
+
+typedef struct
+{
+    volatile uint32_t CRL;
+    volatile uint32_t CRH;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t BRR;
+    volatile uint32_t LCKR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+    volatile uint16_t CCR1;
+    volatile uint16_t CCR2;
+    volatile uint16_t CCR3;
+    volatile uint16_t CCR4;
+} TIM_TypeDef;
+
+typedef struct
+{
+    volatile uint16_t DR;
+} I2C_TypeDef;
+
+extern GPIO_TypeDef sitlGPIO[3];
+extern I2C_TypeDef  sitlI2C[2];
+#define GPIOA       (&sitlGPIO[0])
+#define GPIOB       (&sitlGPIO[1])
+#define GPIOC       (&sitlGPIO[2])
+#define I2C1        (&sitlI2C[0])
+#define I2C2        (&sitlI2C[1])
+
+#define GPIO_Pin_0  ((uint16_t)0x0001)
+#define GPIO_Pin_1  ((uint16_t)0x0002)
+#define GPIO_Pin_2  ((uint16_t)0x0004)
+#define GPIO_Pin_3  ((uint16_t)0x0008)
+#define GPIO_Pin_4  ((uint16_t)0x0010)
+#define GPIO_Pin_5  ((uint16_t)0x0020)
+#define GPIO_Pin_6  ((uint16_t)0x0040)
+#define GPIO_Pin_7  ((uint16_t)0x0080)
+#define GPIO_Pin_8  ((uint16_t)0x0100)
+#define GPIO_Pin_9  ((uint16_t)0x0200)
+#define GPIO_Pin_10 ((uint16_t)0x0400)
+#define GPIO_Pin_11 ((uint16_t)0x0800)
+#define GPIO_Pin_12 ((uint16_t)0x1000)
+#define GPIO_Pin_13 ((uint16_t)0x2000)
+#define GPIO_Pin_14 ((uint16_t)0x4000)
+#define GPIO_Pin_15 ((uint16_t)0x8000)
+
+typedef enum
+{
+    GPIO_Speed_10MHz = 1,
+    GPIO_Speed_2MHz,
+    GPIO_Speed_50MHz
+} GPIOSpeed_TypeDef;
+
+typedef enum
+{
+    GPIO_Mode_AIN         = 0x0,
+    GPIO_Mode_IN_FLOATING = 0x04,
+    GPIO_Mode_IPD         = 0x28,
+    GPIO_Mode_IPU         = 0x48,
+    GPIO_Mode_Out_OD      = 0x14,
+    GPIO_Mode_Out_PP      = 0x10,
+    GPIO_Mode_AF_OD       = 0x1C,
+    GPIO_Mode_AF_PP       = 0x18
+} GPIOMode_TypeDef;
+
+typedef struct
+{
+    uint16_t          GPIO_Pin;
+    GPIOSpeed_TypeDef GPIO_Speed;
+    GPIOMode_TypeDef  GPIO_Mode;
+} GPIO_InitTypeDef;
+
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct);
+
+// Flash emulation. config.c and friends address the config pages through FLASH_WRITE_ADDR,
+// so FLASH_BASE points at a host array of FLASH_PAGE_COUNT pages instead of 0x08000000.
+typedef enum
+{
+    FLASH_BUSY = 1,
+    FLASH_ERROR_PG,
+    FLASH_ERROR_WRP,
+    FLASH_COMPLETE,
+    FLASH_TIMEOUT
+} FLASH_Status;
+
+#define FLASH_FLAG_BSY      ((uint32_t)0x00000001)
+#define FLASH_FLAG_EOP      ((uint32_t)0x00000020)
+#define FLASH_FLAG_PGERR    ((uint32_t)0x00000004)
+#define FLASH_FLAG_WRPRTERR ((uint32_t)0x00000010)
+
+extern uint8_t   sitlFlash[];
+extern uintptr_t sitlFlashWorn;                         // Page whose erase fails with FLASH_ERROR_PG, 0 = none. For the host tests
+#define FLASH_BASE          ((uintptr_t)sitlFlash)
+#define FLASH_IMAGE_END     (FLASH_BASE + 115 * 1024)   // No firmware in the array, the blackbox gets what the ca. 115KB NAZE image leaves
+
+void         FLASH_Unlock(void);
+void         FLASH_Lock(void);
+void         FLASH_ClearFlag(uint32_t FLASH_FLAG);
+FLASH_Status FLASH_ErasePage(uintptr_t Page_Address);
+FLASH_Status FLASH_ProgramWord(uintptr_t Address, uint32_t Data);
+
+extern uint32_t SystemCoreClock;
+
+void NVIC_SystemReset(void);
+#define __disable_irq()
+#define __enable_irq()
@@ -0,0 +1,301 @@
+#include "board.h"
+#include "mw.h"
+#include "sitl.h"
+
+// SITL replacement for drv_i2c.c. The bus talks to register level models of the Naze sensors,
+// so the real drv_mpu6050.c, drv_ms5611.c and drv_hmc5883l.c run unchanged on top of it.
+// Every transfer takes the time it would on the wire at 400KHz. Jobs are queued like on the real driver and finish
+// in virtual time: sitlI2cUpdate (from sitlAdvance) plays the interrupt, so a submitted job runs while the firmware goes on.
+
+#define MPU6050_ADDRESS 0x68
+#define MS5611_ADDR     0x77
+#define MAG_ADDRESS     0x1E
+#define HOME_ALT        400.0f                              // m above sea level
+#define MPU_T0          25.0f                               // Die temperature at power on, then the board warms up
+#define MPU_TRISE       15.0f
+#define MPU_TWARM_S     120.0f                              // Warm up time constant
+
+#define I2C_QUEUE_SIZE  8
+
+static uint16_t i2cErrorCount;
+static i2cJob_t *queue[I2C_QUEUE_SIZE];
+static uint8_t  qHead, qTail;
+static i2cJob_t *job;                                       // On the bus, NULL = idle
+static uint64_t jobEnd;                                     // Virtual time the running job is through
+static uint8_t  mpuRegs[128];
+static uint8_t  magRegs[13];
+static uint16_t msProm[8] = { 0, 40127, 36924, 23317, 23282, 33464, 28312, 0 }; // Datasheet example coefficients
+static uint32_t msAdc;                                      // Result of the last conversion
+static uint8_t  msConv;                                     // Conversion in progress
+static uint8_t  mpuFifo[1024];
+static uint16_t mpuFifoHead, mpuFifoCount;
+static const float gyroOffset[3] = { 1.0f, -0.7f, 0.5f };   // Zero rate offset dps at MPU_T0, chip axes
+static const float gyroTco[3]    = { 0.05f, -0.04f, 0.03f };// Its drift, dps per degC
+
+static void mpuUpdate(void);
+static void magUpdate(void);
+static bool busWrite(uint8_t addr_, uint8_t reg_, uint8_t len_, uint8_t *data);
+static bool busRead(uint8_t addr_, uint8_t reg, uint8_t len, uint8_t* buf);
+static uint32_t msPressureToD1(float pa);
+static void put16(uint8_t *p, float v);
+
+void sitlI2cInit(void)
+{
+    uint16_t crc = 0;
+    uint8_t  i, k;
+
+    mpuRegs[0x75] = MPU6050_ADDRESS;                        // WHO_AM_I
+    magRegs[10] = 'H';
+    magRegs[11] = '4';
+    magRegs[12] = '3';
+    magRegs[1]  = 0x20;
+
+    for (i = 0; i < 16; i++)                                // CRC4 as in AN520, result goes into the low nibble of word 7
+    {
+        if (i % 2 == 1) crc ^= msProm[i >> 1] & 0x00FF;
+        else crc ^= msProm[i >> 1] >> 8;
+        for (k = 8; k > 0; k--)
+        {
+            if (crc & 0x8000) crc = (crc << 1) ^ 0x3000;
+            else crc = crc << 1;
+        }
+    }
+    msProm[7] |= (crc >> 12) & 0xF;
+}
+
+void i2cInit(I2C_TypeDef *I2Cx)
+{
+}
+
+uint16_t i2cGetErrorCounter(void)
+{
+    return i2cErrorCount;
+}
+
+static void startNext(uint64_t now)
+{
+    if (job || qHead == qTail) return;
+    job        = queue[qHead];
+    qHead      = (qHead + 1) % I2C_QUEUE_SIZE;
+    job->state = I2C_JOB_BUSY;
+    jobEnd     = now + (job->len + (job->read ? 3 : 2)) * SITL_I2C_BYTE_US;
+}
+
+void sitlI2cUpdate(void)                                    // The "interrupt": finish everything that is through by now
+{
+    i2cJob_t *done;
+    bool     ok;
+
+    while (job && jobEnd <= sitlMicros64())
+    {
+        done = job;
+        job  = NULL;
+        if (done->read) ok = busRead(done->addr, done->reg, done->len, done->buf);
+        else ok = busWrite(done->addr, done->reg, done->len, done->buf);
+        if (!ok) i2cErrorCount++;
+        startNext(jobEnd);                                  // Back to back, like the chained start in drv_i2c.c
+        done->state = ok ? I2C_JOB_DONE : I2C_JOB_ERROR;
+        if (done->done) done->done(done);
+    }
+}
+
+bool i2cSubmit(i2cJob_t *j)
+{
+    uint8_t next = (qTail + 1) % I2C_QUEUE_SIZE;
+    if (next == qHead) return false;                        // Full
+    j->state     = I2C_JOB_QUEUED;
+    queue[qTail] = j;
+    qTail        = next;
+    startNext(sitlMicros64());
+    return true;
+}
+
+bool i2cWait(i2cJob_t *j)
+{
+    while (j->state == I2C_JOB_QUEUED || j->state == I2C_JOB_BUSY) sitlAdvance(jobEnd - sitlMicros64());
+    return j->state == I2C_JOB_DONE;
+}
+
+void i2cPoll(void)                                          // Jobs chain back to back here, nothing waits for a stop
+{
+}
+
+static bool i2cTransfer(uint8_t addr_, uint8_t reg_, uint8_t len_, uint8_t *buf, bool read)
+{
+    i2cJob_t j = { addr_, reg_, len_, read, buf, NULL, I2C_JOB_IDLE };
+    if (!i2cSubmit(&j))
+    {
+        i2cErrorCount++;
+        return false;
+    }
+    return i2cWait(&j);
+}
+
+bool i2cWriteBuffer(uint8_t addr_, uint8_t reg_, uint8_t len_, uint8_t *data)
+{
+    return i2cTransfer(addr_, reg_, len_, data, false);
+}
+
+bool i2cWrite(uint8_t addr_, uint8_t reg, uint8_t data)
+{
+    return i2cWriteBuffer(addr_, reg, 1, &data);
+}
+
+bool i2cRead(uint8_t addr_, uint8_t reg, uint8_t len, uint8_t* buf)
+{
+    return i2cTransfer(addr_, reg, len, buf, true);
+}
+
+static bool busWrite(uint8_t addr_, uint8_t reg_, uint8_t len_, uint8_t *data)
+{
+    uint8_t i;
+    switch (addr_)
+    {
+    case MPU6050_ADDRESS:
+        for (i = 0; i < len_ && reg_ + i < sizeof(mpuRegs); i++) mpuRegs[reg_ + i] = data[i];
+        if (mpuRegs[0x6A] & 0x04)                           // FIFO_RESET, self clearing
+        {
+            mpuRegs[0x6A] &= ~0x04;
+            mpuFifoCount = 0;
+        }
+        return true;
+    case MAG_ADDRESS:
+        for (i = 0; i < len_ && reg_ + i < sizeof(magRegs); i++) magRegs[reg_ + i] = data[i];
+        return true;
+    case MS5611_ADDR:                                       // Commands only, the data byte is a dummy
+        if ((reg_ & 0xE0) == 0x40)
+        {
+            msConv = reg_;
+            if (reg_ & 0x10) msAdc = 8569150;               // D2, 20.07 degC
+            else msAdc = msPressureToD1(101325.0f * powf(1.0f - (HOME_ALT - sitl.pos[2]) / 44330.77f, 5.25588f) + sitlNoise(1.2f));
+        }
+        return true;
+    }
+    return false;
+}
+
+static bool busRead(uint8_t addr_, uint8_t reg, uint8_t len, uint8_t* buf)
+{
+    uint8_t i;
+    switch (addr_)
+    {
+    case MPU6050_ADDRESS:
+        if (reg == 0x74)                                    // FIFO_R_W doesn't auto increment, every byte comes from the FIFO
+        {
+            for (i = 0; i < len; i++)
+            {
+                buf[i] = mpuFifoCount ? mpuFifo[(mpuFifoHead + sizeof(mpuFifo) - mpuFifoCount) % sizeof(mpuFifo)] : 0;
+                if (mpuFifoCount) mpuFifoCount--;
+            }
+            return true;
+        }
+        mpuUpdate();
+        mpuRegs[0x72] = mpuFifoCount >> 8;
+        mpuRegs[0x73] = mpuFifoCount & 0xFF;
+        for (i = 0; i < len; i++) buf[i] = (reg + i < sizeof(mpuRegs)) ? mpuRegs[reg + i] : 0;
+        return true;
+    case MAG_ADDRESS:
+        magUpdate();
+        for (i = 0; i < len; i++) buf[i] = (reg + i < sizeof(magRegs)) ? magRegs[reg + i] : 0;
+        return true;
+    case MS5611_ADDR:
+        if (reg == 0x00)                                    // ADC read
+        {
+            buf[0] = msConv ? msAdc >> 16 : 0;
+            buf[1] = msConv ? msAdc >> 8 : 0;
+            buf[2] = msConv ? msAdc : 0;
+            msConv = 0;
+            return true;
+        }
+        if (reg >= 0xA0 && reg <= 0xAE)                     // PROM
+        {
+            buf[0] = msProm[(reg - 0xA0) >> 1] >> 8;
+            if (len > 1) buf[1] = msProm[(reg - 0xA0) >> 1];
+            return true;
+        }
+        break;                                              // Anything else NACKs, that is how sensors.c tells us from a BMP085
+    }
+    return false;
+}
+
+static void put16(uint8_t *p, float v)
+{
+    int16_t s = constrain(v, -32768.0f, 32767.0f);
+    p[0] = (uint16_t)s >> 8;
+    p[1] = s & 0xFF;
+}
+
+// Raw chip axes from the model. mpu6050Acc/GyroAlign turn them into the firmware frame.
+// With the i2c master enabled (mag_aux) the mag shows up in EXT_SENS_DATA, as if it hung on the aux bus.
+static void mpuUpdate(void)
+{
+    float accScale  = 8192.0f / 9.80665f;                   // 4G range
+    float gyroScale = 16.4f * RADtoDEG;                     // 2000dps range
+    float temp      = MPU_T0 + MPU_TRISE * (1.0f - expf(-(float)sitlMicros64() * 1e-6f / MPU_TWARM_S));
+    uint8_t i;
+    put16(&mpuRegs[0x3B],  sitl.specForce[0] * accScale + sitlNoise(20));
+    put16(&mpuRegs[0x3D], -sitl.specForce[1] * accScale + sitlNoise(20));
+    put16(&mpuRegs[0x3F], -sitl.specForce[2] * accScale + sitlNoise(20));
+    put16(&mpuRegs[0x41], (temp - 36.53f) * 340.0f);
+    put16(&mpuRegs[0x43],  sitl.rate[0] * gyroScale + (gyroOffset[0] + gyroTco[0] * (temp - MPU_T0)) * 16.4f + sitlNoise(2));
+    put16(&mpuRegs[0x45], -sitl.rate[1] * gyroScale + (gyroOffset[1] + gyroTco[1] * (temp - MPU_T0)) * 16.4f + sitlNoise(2));
+    put16(&mpuRegs[0x47], -sitl.rate[2] * gyroScale + (gyroOffset[2] + gyroTco[2] * (temp - MPU_T0)) * 16.4f + sitlNoise(2));
+    if ((mpuRegs[0x6A] & 0x20) && (mpuRegs[0x27] & 0x80) && mpuRegs[0x25] == (0x80 | MAG_ADDRESS)) // I2C master on, SLV0 reads the mag into EXT_SENS_DATA
+    {
+        magUpdate();
+        for (i = 0; i < (mpuRegs[0x27] & 0x0F); i++) mpuRegs[0x49 + i] = (mpuRegs[0x26] + i < sizeof(magRegs)) ? magRegs[mpuRegs[0x26] + i] : 0;
+    }
+}
+
+// A new sample every model step (1KHz). It goes into the FIFO, order of the enabled groups as in the datasheet: acc, temp,
+// gyro x y z. A full FIFO drops the new sample and the count sticks at the top, which the driver takes as overflow.
+// DATA_RDY_EN raises MPU_INT, that is the EXTI interrupt of drv_system.c called directly.
+void sitlMpuSample(void)
+{
+    static const uint8_t groups[5][3] = { { 0x08, 0x3B, 6 }, { 0x80, 0x41, 2 }, { 0x40, 0x43, 2 }, { 0x20, 0x45, 2 }, { 0x10, 0x47, 2 } };
+    uint8_t g, i;
+    if ((mpuRegs[0x6A] & 0x40) && mpuRegs[0x23])            // USER_CTRL FIFO_EN, FIFO_EN
+    {
+        mpuUpdate();
+        for (g = 0; g < 5; g++)
+        {
+            if (!(mpuRegs[0x23] & groups[g][0])) continue;
+            for (i = 0; i < groups[g][2] && mpuFifoCount < sizeof(mpuFifo); i++)
+            {
+                mpuFifo[mpuFifoHead] = mpuRegs[groups[g][1] + i];
+                mpuFifoHead = (mpuFifoHead + 1) % sizeof(mpuFifo);
+                mpuFifoCount++;
+            }
+        }
+    }
+    if (mpuRegs[0x38] & 0x01) schedulerDataReady();        // INT_ENABLE DATA_RDY_EN
+}
+
+// Chip order in the data registers is X Z Y. The default mag align (-2, -3, 1) of the Naze is undone here.
+static void magUpdate(void)
+{
+    static const float gainTab[8] = { 1370, 1090, 820, 660, 440, 390, 330, 230 };
+    float gain = gainTab[(magRegs[1] >> 5) & 7], field[3];
+    uint8_t bias = magRegs[0] & 3;
+    field[0] = -sitl.magBody[0];
+    field[1] =  sitl.magBody[1];
+    field[2] = -sitl.magBody[2];
+    if (bias == 1 || bias == 2)                             // Self test, positive or negative bias current
+    {
+        float s = (bias == 1) ? 1.0f : -1.0f;
+        field[0] += s * 1.16f;
+        field[1] += s * 1.16f;
+        field[2] += s * 1.08f;
+    }
+    put16(&magRegs[3], field[0] * gain + sitlNoise(1.5f));
+    put16(&magRegs[5], field[2] * gain + sitlNoise(1.5f));
+    put16(&magRegs[7], field[1] * gain + sitlNoise(1.5f));
+}
+
+static uint32_t msPressureToD1(float pa)                    // Inverse of ms5611_calculate for the fixed D2 above
+{
+    int64_t dT   = 8569150 - ((int64_t)msProm[5] << 8);
+    int64_t off  = ((int64_t)msProm[2] << 16) + ((dT * msProm[4]) >> 7);
+    int64_t sens = ((int64_t)msProm[1] << 15) + ((dT * msProm[3]) >> 8);
+    return (uint32_t)(((((int64_t)pa << 15) + off) << 21) / sens);
+}
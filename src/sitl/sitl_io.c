@@ -0,0 +1,104 @@
+#include "board.h"
+#include "mw.h"
+#include "sitl.h"
+
+// SITL replacement for drv_pwm.c, drv_adc.c, drv_sonar.c and drv_bmp085.c.
+// Motor and servo outputs go to the model, rc input comes from the scripted pilot.
+// The motor timers are modelled with their latency: pwmWriteMotor only sets the compare register, an ESC takes
+// the new value at the end of the pulse that carries it. Free running PWM latches the register at the next frame start
+// (0 .. 1/esc_pwm later), OneShot125 fires the pulse in pwmCompleteMotorUpdate, 125 - 250us.
+
+#define ONESHOT_BUSY_US 256                                 // drv_pwm.c ONESHOT_PERIOD @ 8MHz, a new pulse can't start before
+
+static bool     escOneshot;
+static uint32_t escPeriod;                                  // PWM frame us
+static uint16_t escReg[MAX_MOTORS];                         // Timer compare registers
+static uint16_t escPulse[MAX_MOTORS];                       // Pulses of the current frame
+static uint16_t escPending;                                 // Motors whose pulse hasn't ended yet
+static uint64_t escFrame;                                   // Start of the current frame or OneShot pulse
+
+bool pwmInit(drv_pwm_config_t *init)
+{
+    escOneshot = init->oneshot;
+    escPeriod  = 1000000 / init->motorPwmRate;
+    return false;
+}
+
+void pwmWriteMotor(uint8_t index, uint16_t value)
+{
+    if (index < MAX_MOTORS) escReg[index] = value;
+}
+
+void pwmCompleteMotorUpdate(void)
+{
+    sitlEscUpdate(sitlMicros64());
+    if (!escOneshot || sitlMicros64() - escFrame < ONESHOT_BUSY_US) return; // Still in the last pulse, like the timer
+    escFrame   = sitlMicros64();
+    memcpy(escPulse, escReg, sizeof(escPulse));
+    escPending = (1 << MAX_MOTORS) - 1;
+}
+
+void sitlEscUpdate(uint64_t now)                            // Called from sitlAdvance, the ESCs see the ends of the pulses
+{
+    uint32_t width;
+    uint8_t  i;
+
+    if (!escOneshot && escPeriod && now - escFrame >= escPeriod)
+    {
+        escFrame  += (now - escFrame) / escPeriod * escPeriod; // Update event, the preloaded register goes out
+        memcpy(escPulse, escReg, sizeof(escPulse));
+        escPending = (1 << MAX_MOTORS) - 1;
+    }
+    for (i = 0; escPending && i < MAX_MOTORS; i++)
+    {
+        width = escOneshot ? escPulse[i] / 8 : escPulse[i];
+        if (!(escPending & (1 << i)) || now - escFrame < width) continue;
+        sitlMotorPwm[i] = escPulse[i];
+        escPending     &= ~(1 << i);
+    }
+}
+
+void pwmWriteServo(uint8_t index, uint16_t value)
+{
+    if (index < MAX_SERVOS) sitlServoPwm[index] = value;
+}
+
+uint16_t pwmRead(uint8_t channel)
+{
+    return sitlPilotChannel(channel);
+}
+
+void adcInit(drv_adc_config_t *init)
+{
+}
+
+uint16_t adcGetChannel(uint8_t channel)
+{
+    if (channel == ADC_BATTERY) return 1365;                // 12.1V with the default vbatscale of 110
+    return 0;
+}
+
+bool Snr_init(void)
+{
+    return false;
+}
+
+bool hcsr04_get_distancePWM(volatile int32_t *distance)
+{
+    return false;
+}
+
+bool MaxBotix_get_distancePWM(volatile int32_t *distance)
+{
+    return false;
+}
+
+bool DaddyW_get_i2c_distance(int32_t *distance)
+{
+    return false;
+}
+
+bool bmp085Detect(baro_t *baro)                             // Not modelled, the sim board carries a MS5611
+{
+    return false;
+}
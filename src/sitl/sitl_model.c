@@ -0,0 +1,227 @@
+#include "board.h"
+#include "mw.h"
+#include "sitl.h"
+
+// SITL: rigid body model of a 450 class QuadX and a scripted pilot.
+// Body frame is FRD, world frame NED, home at the origin. Motors are numbered like mixerQuadX:
+// 0 REAR_R, 1 FRONT_R, 2 REAR_L, 3 FRONT_L. Yaw torque follows the mixer yaw column (FRONT_R and REAR_L turn CCW).
+
+#define GRAVITY      9.80665f
+#define MASS         1.0f                                   // kg
+#define ARM          0.16f                                  // m, motor offset along x and y
+#define THRUST_MAX   8.0f                                   // N per motor at full throttle
+#define TORQUE_COEF  0.016f                                 // Nm yaw torque per N thrust
+#define MOTOR_TAU    0.03f                                  // s, motor spin up time constant
+#define DRAG_LIN     0.35f                                  // N per m/s
+#define DRAG_ROT     0.003f                                 // Nm per rad/s
+#define IXX          0.010f
+#define IYY          0.010f
+#define IZZ          0.018f
+
+sitlState_t sitl;
+uint16_t    sitlMotorPwm[MAX_MOTORS];
+uint16_t    sitlServoPwm[MAX_SERVOS];
+
+static const float motorPos[4][2] = { { -ARM, ARM }, { ARM, ARM }, { -ARM, -ARM }, { ARM, -ARM } };
+static const float motorYaw[4]    = { -1.0f, 1.0f, 1.0f, -1.0f };
+static const float earthMag[3]    = { 0.21f, 0.01f, 0.43f };  // Gauss NED, central europe
+
+static void quatToDcm(float r[3][3]);
+static void updateDerived(void);
+
+void sitlModelInit(void)
+{
+    memset(&sitl, 0, sizeof(sitl));
+    sitl.q[0]     = 1.0f;
+    sitl.onGround = true;
+    updateDerived();
+}
+
+static void quatToDcm(float r[3][3])                        // Body to NED
+{
+    float q0 = sitl.q[0], q1 = sitl.q[1], q2 = sitl.q[2], q3 = sitl.q[3];
+    r[0][0] = 1 - 2 * (q2 * q2 + q3 * q3);
+    r[0][1] = 2 * (q1 * q2 - q0 * q3);
+    r[0][2] = 2 * (q1 * q3 + q0 * q2);
+    r[1][0] = 2 * (q1 * q2 + q0 * q3);
+    r[1][1] = 1 - 2 * (q1 * q1 + q3 * q3);
+    r[1][2] = 2 * (q2 * q3 - q0 * q1);
+    r[2][0] = 2 * (q1 * q3 - q0 * q2);
+    r[2][1] = 2 * (q2 * q3 + q0 * q1);
+    r[2][2] = 1 - 2 * (q1 * q1 + q2 * q2);
+}
+
+static void updateDerived(void)
+{
+    float r[3][3];
+    uint8_t i;
+    quatToDcm(r);
+    for (i = 0; i < 3; i++) sitl.magBody[i] = r[0][i] * earthMag[0] + r[1][i] * earthMag[1] + r[2][i] * earthMag[2];
+    sitl.roll  = atan2f(r[2][1], r[2][2]) * RADtoDEG;
+    sitl.pitch = -asinf(constrain(r[2][0], -1.0f, 1.0f)) * RADtoDEG;
+    sitl.yaw   = atan2f(r[1][0], r[0][0]) * RADtoDEG;
+    if (sitl.yaw < 0) sitl.yaw += 360.0f;
+}
+
+void sitlModelStep(float dt)
+{
+    float   r[3][3], thrust = 0, torque[3] = { 0, 0, 0 }, accNED[3], T, u, qd[4], norm;
+    float   p = sitl.rate[0], q = sitl.rate[1], w = sitl.rate[2];
+    uint8_t i;
+
+    for (i = 0; i < 4; i++)
+    {
+        u = constrain(((float)sitlMotorPwm[i] - 1000.0f) * 0.001f, 0.0f, 1.0f);
+        sitl.motorSpeed[i] += (u - sitl.motorSpeed[i]) * dt / MOTOR_TAU;
+        T = THRUST_MAX * sitl.motorSpeed[i] * sitl.motorSpeed[i];
+        thrust    += T;
+        torque[0] -= motorPos[i][1] * T;
+        torque[1] += motorPos[i][0] * T;
+        torque[2] += motorYaw[i] * TORQUE_COEF * T;
+    }
+
+    quatToDcm(r);
+    for (i = 0; i < 3; i++) accNED[i] = (-r[i][2] * thrust - DRAG_LIN * sitl.vel[i]) / MASS;
+    accNED[2] += GRAVITY;
+
+    if (sitl.onGround && accNED[2] >= 0)                    // Sitting on the ground, keep heading, kill the rest
+    {
+        float yaw = atan2f(r[1][0], r[0][0]) * 0.5f;
+        memset(sitl.vel, 0, sizeof(sitl.vel));
+        memset(sitl.rate, 0, sizeof(sitl.rate));
+        memset(accNED, 0, sizeof(accNED));
+        sitl.pos[2] = 0;
+        sitl.q[0] = cosf(yaw);
+        sitl.q[1] = sitl.q[2] = 0;
+        sitl.q[3] = sinf(yaw);
+    }
+    else
+    {
+        sitl.onGround = false;
+        sitl.rate[0] += (torque[0] - DRAG_ROT * p - (IZZ - IYY) * q * w) / IXX * dt;
+        sitl.rate[1] += (torque[1] - DRAG_ROT * q - (IXX - IZZ) * p * w) / IYY * dt;
+        sitl.rate[2] += (torque[2] - DRAG_ROT * w - (IYY - IXX) * p * q) / IZZ * dt;
+        p = sitl.rate[0];
+        q = sitl.rate[1];
+        w = sitl.rate[2];
+        qd[0] = 0.5f * (-sitl.q[1] * p - sitl.q[2] * q - sitl.q[3] * w);
+        qd[1] = 0.5f * ( sitl.q[0] * p + sitl.q[2] * w - sitl.q[3] * q);
+        qd[2] = 0.5f * ( sitl.q[0] * q - sitl.q[1] * w + sitl.q[3] * p);
+        qd[3] = 0.5f * ( sitl.q[0] * w + sitl.q[1] * q - sitl.q[2] * p);
+        norm = 0;
+        for (i = 0; i < 4; i++)
+        {
+            sitl.q[i] += qd[i] * dt;
+            norm += sitl.q[i] * sitl.q[i];
+        }
+        norm = 1.0f / sqrtf(norm);
+        for (i = 0; i < 4; i++) sitl.q[i] *= norm;
+        for (i = 0; i < 3; i++)
+        {
+            sitl.vel[i] += accNED[i] * dt;
+            sitl.pos[i] += sitl.vel[i] * dt;
+        }
+        if (sitl.pos[2] >= 0)                               // Touchdown
+        {
+            sitl.pos[2]   = 0;
+            sitl.onGround = true;
+        }
+    }
+
+    accNED[2] -= GRAVITY;                                   // Specific force = a - g, rotated into the body
+    quatToDcm(r);
+    for (i = 0; i < 3; i++) sitl.specForce[i] = r[0][i] * accNED[0] + r[1][i] * accNED[1] + r[2][i] * accNED[2];
+    updateDerived();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+// Scripted pilot. Wait for the gyro calibration, arm by yaw right, climb to 5m and hover with
+// a simple altitude loop on the model truth, descend, disarm by yaw left. AUX1 high = ANGLE.
+// Channels are in the default AETR1234 order.
+////////////////////////////////////////////////////////////////////////////////////
+enum { PILOT_WAIT = 0, PILOT_ARM, PILOT_CLIMB, PILOT_HOVER, PILOT_DESCEND, PILOT_DISARM, PILOT_DONE };
+
+static uint8_t  pilotState;
+static uint32_t pilotTimer;
+static uint16_t pilotRc[8] = { 1500, 1500, 1000, 1500, 2000, 1000, 1000, 1000 };
+static float    pilotTarget, pilotI;
+
+#define HOVER_ALT   5.0f
+#define HOVER_TIME  10000
+
+static void pilotAltitude(void)                             // Throttle from an altitude PI + velocity D loop
+{
+    float err = pilotTarget - (-sitl.pos[2]);
+    pilotI = constrain(pilotI + err * 0.02f * 8.0f, -200.0f, 300.0f);
+    pilotRc[2] = constrain(1450.0f + pilotI + err * 60.0f + sitl.vel[2] * 80.0f, 1150.0f, 1850.0f);
+}
+
+void sitlPilotUpdate(void)
+{
+    uint32_t now = millis();
+
+    failsafeCnt = 0;                                        // A frame was received, like the pwm/ppm callbacks do
+    switch (pilotState)
+    {
+    case PILOT_WAIT:
+        if (now > 6000 && !calibratingG && !calibratingA && f.ACC_CALIBRATED)
+        {
+            pilotState = PILOT_ARM;
+            pilotTimer = now;
+        }
+        break;
+    case PILOT_ARM:
+        pilotRc[3] = (now - pilotTimer) % 1500 < 1000 ? 2000 : 1500; // Not armed after 1s? Center yaw and try again, like a pilot would
+        if (f.ARMED)
+        {
+            pilotRc[3]  = 1500;
+            pilotTarget = 0;
+            pilotState  = PILOT_CLIMB;
+        }
+        else if (now - pilotTimer > 10000) pilotState = PILOT_DONE; // Refused to arm
+        break;
+    case PILOT_CLIMB:
+        pilotTarget = min(pilotTarget + 0.02f, HOVER_ALT);     // 1m/s
+        pilotAltitude();
+        if (pilotTarget >= HOVER_ALT)
+        {
+            pilotState = PILOT_HOVER;
+            pilotTimer = now;
+        }
+        break;
+    case PILOT_HOVER:
+        pilotAltitude();
+        if (now - pilotTimer > HOVER_TIME) pilotState = PILOT_DESCEND;
+        break;
+    case PILOT_DESCEND:
+        pilotTarget -= 0.01f;                                // 0.5m/s
+        pilotAltitude();
+        if (sitl.onGround && pilotTarget < -0.5f)
+        {
+            pilotRc[2] = 1000;
+            pilotState = PILOT_DISARM;
+        }
+        break;
+    case PILOT_DISARM:
+        pilotRc[3] = 1000;
+        if (!f.ARMED)
+        {
+            pilotRc[3] = 1500;
+            pilotState = PILOT_DONE;
+        }
+        break;
+    case PILOT_DONE:
+        break;
+    }
+}
+
+uint16_t sitlPilotChannel(uint8_t chan)
+{
+    if (chan < 8) return pilotRc[chan];
+    return 1500;
+}
+
+bool sitlPilotDone(void)
+{
+    return pilotState == PILOT_DONE;
+}
@@ -0,0 +1,344 @@
+#include "board.h"
+#include "mw.h"
+#include "sitl.h"
+#include <unistd.h>
+#include <time.h>
+
+// SITL replacement for drv_system.c plus the flash emulation and the command line.
+// The flash follows the NOR rules of the F103 (program only erased half words or 0) and can lose power on request (-f).
+// The virtual clock runs in 64 bit, micros() / millis() roll over like the real ones.
+
+GPIO_TypeDef sitlGPIO[3];
+I2C_TypeDef  sitlI2C[2];
+uint8_t      sitlFlash[FLASH_PAGE_COUNT * FLASH_PAGE_SIZE];
+uintptr_t    sitlFlashWorn;
+uint32_t     hse_value = 8000000;                           // Naze rev4, 8MHz crystal
+uint32_t     SystemCoreClock = 72000000;
+
+static uint64_t simTime;                                    // Virtual time in us
+static uint64_t modelTime;                                  // Time the physics model has reached
+static uint64_t runTime;                                    // Stop after that, 0 = forever
+static uint64_t nextLogTime;
+static bool     realtime;
+static struct timespec wallStart;
+static FILE     *logFile;
+static char     *flashFile = "eeprom_SITL.bin";
+static char     **savedArgv;
+static uint32_t randState = 0x12345678;
+static uint32_t flashOps;                                   // Erases and word programs so far
+static uint32_t flashFailOp;                                // -f: the power fails during that one, 0 = never
+static bool     flashDirty;                                 // Flash changed since the file was written
+static uint64_t flashSaveTime;                              // Not before that again, the blackbox locks the flash every few ms
+
+static void sitlFlashSave(void);
+static bool sitlFlashFails(void);
+static void sitlLog(void);
+static void sitlUsage(const char *name);
+
+void sitlInit(int argc, char *argv[])
+{
+    FILE     *fp;
+    uint16_t port = 5760;
+    int      opt;
+
+    savedArgv = argv;
+    while ((opt = getopt(argc, argv, "d:e:f:l:p:rh")) != -1)
+    {
+        switch (opt)
+        {
+        case 'd':
+            runTime = (uint64_t)(atof(optarg) * 1000000.0);
+            break;
+        case 'e':
+            flashFile = optarg;
+            break;
+        case 'f':
+            flashFailOp = atoi(optarg);
+            break;
+        case 'l':
+            logFile = fopen(optarg, "w");
+            if (!logFile) perror(optarg);
+            break;
+        case 'p':
+            port = atoi(optarg);
+            break;
+        case 'r':
+            realtime = true;
+            break;
+        default:
+            sitlUsage(argv[0]);
+            exit(opt == 'h' ? 0 : 1);
+        }
+    }
+
+    memset(sitlFlash, 0xFF, sizeof(sitlFlash));             // Erased flash
+    fp = fopen(flashFile, "rb");
+    if (fp)
+    {
+        if (fread(sitlFlash, 1, sizeof(sitlFlash), fp) != sizeof(sitlFlash)) memset(sitlFlash, 0xFF, sizeof(sitlFlash));
+        fclose(fp);
+    }
+
+    if (logFile) fprintf(logFile, "time_ms,armed,roll,pitch,yaw,est_roll,est_pitch,est_heading,alt_cm,est_alt_cm,vz_cms,est_vario_cms,cycletime,m0,m1,m2,m3\n");
+    clock_gettime(CLOCK_MONOTONIC, &wallStart);
+    sitlModelInit();
+    sitlI2cInit();
+    sitlUartInit(port);
+}
+
+static void sitlUsage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [-d seconds] [-e eeprom.bin] [-f n] [-l log.csv] [-p port] [-r]\n", name);
+    fprintf(stderr, "  -d  stop after that much virtual time (default: run forever)\n");
+    fprintf(stderr, "  -e  file backing the emulated flash (default: eeprom_SITL.bin)\n");
+    fprintf(stderr, "  -f  power fails during the n-th flash erase / program, the flash file keeps the torn state\n");
+    fprintf(stderr, "  -l  write a 100Hz csv log of model truth vs. firmware estimates\n");
+    fprintf(stderr, "  -p  tcp port for uart1 (MSP/CLI/MAVLink), 0 = off (default: 5760)\n");
+    fprintf(stderr, "  -r  run in realtime instead of as fast as possible\n");
+}
+
+// A blank eeprom gets what a user would have done on the bench: acc calibrated (the model has
+// no acc offsets, MPU6050 @ 4G is 8192 LSB/g), mag calibrated, NMEA gps and ANGLE on AUX1 high.
+void sitlConfig(void)
+{
+    uint8_t i;
+    if (cfg.sens_1G > 1) return;
+    for (i = 0; i < 3; i++)
+    {
+        cfg.accZero[i] = 0;
+        cfg.magZero[i] = 0;
+    }
+    cfg.sens_1G        = 8192;
+    cfg.mag_calibrated = 1;
+    cfg.gps_type       = 0;
+    cfg.activate[BOXANGLE] = 1 << 2;                        // AUX1 high
+    writeParams(0);
+}
+
+uint64_t sitlMicros64(void)
+{
+    return simTime;
+}
+
+void sitlAdvance(uint32_t us)
+{
+    simTime += us;
+    while (modelTime + SITL_MODEL_DT_US <= simTime)
+    {
+        modelTime += SITL_MODEL_DT_US;
+        sitlEscUpdate(modelTime);                           // Motor pulses up to the model step
+        sitlModelStep(SITL_MODEL_DT_US * 1e-6f);
+        sitlMpuSample();                                    // MPU FIFO runs at the model rate
+        if ((modelTime % 20000) == 0) sitlPilotUpdate();    // RC frames @ 50Hz
+        sitlGpsUpdate();
+        if (modelTime >= nextLogTime)
+        {
+            nextLogTime = modelTime + 10000;
+            sitlLog();
+        }
+    }
+    sitlI2cUpdate();
+    sitlEscUpdate(simTime);
+    if (realtime)
+    {
+        struct timespec now;
+        int64_t ahead;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        ahead = (int64_t)simTime - ((int64_t)(now.tv_sec - wallStart.tv_sec) * 1000000 + (now.tv_nsec - wallStart.tv_nsec) / 1000);
+        if (ahead > 1000) usleep(ahead);
+    }
+}
+
+void sitlLoop(void)                                         // Called after every pass through loop()
+{
+    sitlAdvance(SITL_LOOP_COST_US);
+    sitlUartPoll();
+    if (runTime && simTime >= runTime)
+    {
+        fprintf(stderr, "SITL: %.1fs done, alt %.2fm, att %.1f/%.1f/%.1f deg, %s\n", simTime * 1e-6,
+                -sitl.pos[2], sitl.roll, sitl.pitch, sitl.yaw, f.ARMED ? "armed" : "disarmed");
+        if (flashDirty) sitlFlashSave();
+        if (logFile) fclose(logFile);
+        exit(0);
+    }
+}
+
+float sitlNoise(float sigma)                                // Cheap gaussian-ish noise, sum of 4 uniforms
+{
+    float sum = 0;
+    uint8_t i;
+    for (i = 0; i < 4; i++)
+    {
+        randState = randState * 1664525 + 1013904223;
+        sum += (float)(randState >> 8) / 16777216.0f - 0.5f;
+    }
+    return sum * sigma * 1.732f;
+}
+
+static void sitlLog(void)
+{
+    uint8_t i;
+    if (!logFile) return;
+    fprintf(logFile, "%llu,%d,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.1f,%.1f,%.1f,%.1f,%u",
+            (unsigned long long)(modelTime / 1000), f.ARMED, sitl.roll, sitl.pitch, sitl.yaw,
+            angle[ROLL] * 0.1f, angle[PITCH] * 0.1f, heading, -sitl.pos[2] * 100.0f, EstAlt,
+            -sitl.vel[2] * 100.0f, vario, cycleTime);
+    for (i = 0; i < 4; i++) fprintf(logFile, ",%d", motor[i]);
+    fprintf(logFile, "\n");
+}
+
+uint32_t micros(void)
+{
+    return (uint32_t)simTime;
+}
+
+uint32_t millis(void)
+{
+    return (uint32_t)(simTime / 1000);
+}
+
+uint32_t cycles(void)                                       // DWT stand-in, the virtual cpu runs at SystemCoreClock
+{
+    return (uint32_t)(simTime * (SystemCoreClock / 1000000));
+}
+
+uint32_t cyclesPerMicro(void)
+{
+    return SystemCoreClock / 1000000;
+}
+
+void systemInit(void)
+{
+    LED0_OFF;
+    LED1_OFF;
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    sitlAdvance(us);
+}
+
+void delay(uint32_t ms)
+{
+    while (ms--)
+    {
+        sitlAdvance(1000);
+        sitlUartPoll();
+    }
+}
+
+void failureMode(uint8_t mode)
+{
+    fprintf(stderr, "SITL: failureMode(%d)\n", mode);
+    exit(1);
+}
+
+void systemReset(bool toBootloader)
+{
+    if (toBootloader) fprintf(stderr, "SITL: no bootloader, plain reset\n");
+    NVIC_SystemReset();
+}
+
+void NVIC_SystemReset(void)                                 // Save flash and restart the process, like a real reboot
+{
+    sitlFlashSave();
+    if (logFile) fclose(logFile);
+    fflush(NULL);
+    execv("/proc/self/exe", savedArgv);
+    perror("execv");
+    exit(1);
+}
+
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct)
+{
+}
+
+void gpioInit(GPIO_TypeDef *gpio, gpio_config_t *config)
+{
+}
+
+void mpuIntInit(void)                                       // The MPU model raises data ready itself, see sitlMpuSample
+{
+}
+
+static bool sitlFlashFails(void)                            // -f: true for the operation that is cut
+{
+    return flashFailOp && ++flashOps == flashFailOp;
+}
+
+static void sitlPowerFail(void)
+{
+    fprintf(stderr, "SITL: power fail in flash operation %u\n", flashFailOp);
+    sitlFlashSave();
+    if (logFile) fclose(logFile);
+    exit(3);
+}
+
+static void sitlFlashSave(void)
+{
+    FILE *fp = fopen(flashFile, "wb");
+    flashDirty    = false;
+    flashSaveTime = simTime + 1000000;
+    if (!fp) return;
+    fwrite(sitlFlash, 1, sizeof(sitlFlash), fp);
+    fclose(fp);
+}
+
+void FLASH_Unlock(void)
+{
+}
+
+void FLASH_Lock(void)                                       // Writes the file, at most once per virtual second. Exit and reset always do
+{
+    if (flashDirty && simTime >= flashSaveTime) sitlFlashSave();
+}
+
+void FLASH_ClearFlag(uint32_t FLASH_FLAG)
+{
+}
+
+static void sitlFlashFault(uintptr_t address)              // The F103 has no flash there: a bus fault, not a status
+{
+    fprintf(stderr, "SITL: flash access at 0x%05lx, past the %d pages\n", (unsigned long)(address - FLASH_BASE), FLASH_PAGE_COUNT);
+    exit(1);
+}
+
+FLASH_Status FLASH_ErasePage(uintptr_t Page_Address)
+{
+    uintptr_t offs = Page_Address - FLASH_BASE;
+    if (offs >= sizeof(sitlFlash)) sitlFlashFault(Page_Address);
+    offs -= offs % FLASH_PAGE_SIZE;
+    if (FLASH_BASE + offs == sitlFlashWorn)
+    {
+        sitlAdvance(20000);
+        return FLASH_ERROR_PG;                              // Worn out, the page keeps what it has
+    }
+    if (sitlFlashFails())                                   // Torn erase, half the page is still the old data
+    {
+        memset(&sitlFlash[offs], 0xFF, FLASH_PAGE_SIZE / 2);
+        sitlPowerFail();
+    }
+    memset(&sitlFlash[offs], 0xFF, FLASH_PAGE_SIZE);
+    flashDirty = true;
+    sitlAdvance(20000);                                     // Page erase takes 20ms on the F103
+    return FLASH_COMPLETE;
+}
+
+FLASH_Status FLASH_ProgramWord(uintptr_t Address, uint32_t Data) // Two half words like the F103, each must be erased or get 0
+{
+    uintptr_t offs = Address - FLASH_BASE;
+    uint16_t  half[2], data[2] = { Data, Data >> 16 };
+    if (offs + 4 > sizeof(sitlFlash)) sitlFlashFault(Address);
+    if (offs & 3) return FLASH_ERROR_PG;
+    memcpy(half, &sitlFlash[offs], 4);
+    if ((half[0] != 0xFFFF && data[0]) || (half[1] != 0xFFFF && data[1])) return FLASH_ERROR_PG;
+    if (sitlFlashFails())                                   // Torn, only the low half word made it
+    {
+        memcpy(&sitlFlash[offs], &data[0], 2);
+        sitlPowerFail();
+    }
+    memcpy(&sitlFlash[offs], &Data, 4);
+    flashDirty = true;
+    sitlAdvance(50);
+    return FLASH_COMPLETE;
+}
@@ -0,0 +1,263 @@
+#include "board.h"
+#include "mw.h"
+#include "sitl.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+// SITL replacement for drv_uart.c.
+// USART1 is a tcp socket, so MSP / MAVLink / CLI tools can connect (e.g. "nc localhost 5760"). The bytes go out at once,
+// but uartTxFree follows a TX ring of the real size that drains at the baud rate of uartInit (10 bit per byte), and
+// uartWrite / uartWriteBlock lose what wouldn't fit into it, like drv_uart.c.
+// USART2 is wired to a NMEA GPS model that reports the model position at 5Hz, GPS_DELAY_US after the fix like a real receiver.
+
+#define UART_BUFFER_SIZE 256
+#define HOME_LAT         47.0f                              // Degrees
+#define HOME_LON         8.0f
+#define HOME_ALT         400.0f
+#define GPS_PERIOD_US    200000                             // 5Hz
+#define GPS_DELAY_US     120000                             // Age of the fix when it arrives. Must be below GPS_PERIOD_US
+
+static int      listenFd = -1, clientFd = -1;
+static uint8_t  rxBuffer[UART_BUFFER_SIZE];
+static uint32_t rxHead, rxTail;
+static uint8_t  txBuffer[UART_BUFFER_SIZE];
+static uint32_t txLen;
+static uint32_t txBaud;                                     // 0 = uartInit not called yet, no limit
+static uint32_t txQueued;                                   // Bytes the real uart would still have to send, the ring holds UART_TX_BUFFER_SIZE - 1
+static uint64_t txDrainTime;                                // txQueued is up to that time
+static uartReceiveCallbackPtr uart2Callback;
+uartTxStats_t   uartTxStats = { UART_TX_BUFFER_SIZE - 1 };
+static uint64_t gpsNext, gpsSendTime;
+static char     gpsRmc[100], gpsGga[100];                   // Sampled fix, waiting for gpsSendTime
+
+static void uartFlush(void);
+static void gpsSend(const char *body);
+
+void sitlUartInit(uint16_t port)
+{
+    struct sockaddr_in addr;
+    int one = 1;
+
+    if (!port) return;
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) return;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listenFd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listenFd, 1) < 0)
+    {
+        perror("SITL: uart1 socket");
+        close(listenFd);
+        listenFd = -1;
+        return;
+    }
+    fcntl(listenFd, F_SETFL, O_NONBLOCK);
+    fprintf(stderr, "SITL: uart1 on tcp port %d\n", port);
+}
+
+void sitlUartPoll(void)
+{
+    uint8_t buf[64];
+    ssize_t n, i;
+
+    if (listenFd < 0) return;
+    if (clientFd < 0)
+    {
+        int one = 1;
+        clientFd = accept(listenFd, NULL, NULL);
+        if (clientFd < 0) return;
+        fcntl(clientFd, F_SETFL, O_NONBLOCK);
+        setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    uartFlush();
+    n = recv(clientFd, buf, sizeof(buf), 0);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+    {
+        close(clientFd);
+        clientFd = -1;
+        return;
+    }
+    for (i = 0; i < n; i++)
+    {
+        if (rxHead - rxTail >= UART_BUFFER_SIZE) break;     // Full, drop like an overrun
+        rxBuffer[rxHead++ % UART_BUFFER_SIZE] = buf[i];
+    }
+}
+
+static void uartFlush(void)
+{
+    if (clientFd >= 0 && txLen) send(clientFd, txBuffer, txLen, MSG_NOSIGNAL);
+    txLen = 0;
+}
+
+void uartInit(uint32_t speed)
+{
+    txBaud      = speed;
+    txQueued    = 0;
+    txDrainTime = sitlMicros64();
+}
+
+static void uartDrain(void)
+{
+    uint64_t sent = (sitlMicros64() - txDrainTime) * txBaud / 10000000;
+
+    if (!sent) return;                                      // Keeps the fraction of a byte for the next call
+    txDrainTime += sent * 10000000 / txBaud;
+    txQueued     = sent < txQueued ? txQueued - sent : 0;
+}
+
+bool uartAvailable(void)
+{
+    if (rxHead == rxTail) sitlUartPoll();
+    return rxHead != rxTail;
+}
+
+bool uartTransmitEmpty(void)                                // printf spins on it, so the virtual time has to go on meanwhile
+{
+    if (uartTxFree() == UART_TX_BUFFER_SIZE - 1) return true;
+    sitlAdvance(100);
+    return false;
+}
+
+uint16_t uartTxFree(void)
+{
+    if (!txBaud) return UART_TX_BUFFER_SIZE - 1;
+    uartDrain();
+    return txQueued < UART_TX_BUFFER_SIZE - 1 ? UART_TX_BUFFER_SIZE - 1 - txQueued : 0;
+}
+
+uint8_t uartRead(void)
+{
+    if (rxHead == rxTail) return 0;
+    return rxBuffer[rxTail++ % UART_BUFFER_SIZE];
+}
+
+uint8_t uartReadPoll(void)
+{
+    while (!uartAvailable()) sitlAdvance(100);              // wait for some bytes
+    return uartRead();
+}
+
+static void uartQueue(uint16_t len)                         // len bytes into the modelled ring, uartTxFree said they fit
+{
+    if (!txBaud) return;
+    if (!txQueued) txDrainTime = sitlMicros64();            // Idle line, no credit for the time before
+    txQueued += len;
+    if (txQueued > uartTxStats.highWater) uartTxStats.highWater = txQueued;
+}
+
+static void uartPut(uint8_t ch)
+{
+    txBuffer[txLen++] = ch;
+    if (txLen == sizeof(txBuffer)) uartFlush();
+}
+
+void uartWrite(uint8_t ch)
+{
+    if (!uartTxFree())
+    {
+        uartTxStats.overflows++;
+        return;
+    }
+    uartQueue(1);
+    uartPut(ch);
+}
+
+bool uartWriteBlock(const uint8_t *data, uint16_t len)
+{
+    if (uartTxFree() < len)
+    {
+        uartTxStats.dropped++;
+        return false;
+    }
+    uartQueue(len);
+    while (len--) uartPut(*data++);
+    return true;
+}
+
+void uartWriteWait(uint8_t ch)                              // Waits for room like drv_uart.c, the virtual time runs meanwhile
+{
+    while (!uartTxFree()) sitlAdvance(100);
+    uartWrite(ch);
+}
+
+void uartPrint(char *str)
+{
+    while (*str) uartWriteWait(*(str++));
+}
+
+void uart2Init(uint32_t speed, uartReceiveCallbackPtr func, bool rxOnly)
+{
+    uart2Callback = func;
+}
+
+void uart2ChangeBaud(uint32_t speed)
+{
+}
+
+bool uart2TransmitEmpty(void)
+{
+    return true;
+}
+
+void uart2Write(uint8_t ch)                                 // Configuration for the GPS goes nowhere
+{
+}
+
+static void gpsSend(const char *body)
+{
+    char    line[128];
+    uint8_t sum = 0;
+    const char *p;
+    for (p = body; *p; p++) sum ^= *p;
+    snprintf(line, sizeof(line), "$%s*%02X\r\n", body, sum);
+    for (p = line; *p; p++) uart2Callback(*p);
+}
+
+static void nmeaCoord(char *buf, size_t len, float deg, uint8_t degDigits)
+{
+    float    a = fabsf(deg);
+    uint16_t d = (uint16_t)a;
+    snprintf(buf, len, "%0*d%07.4f", degDigits, d, (a - d) * 60.0f);
+}
+
+void sitlGpsUpdate(void)
+{
+    char     lat[16], lon[16];
+    double   latDeg, lonDeg;
+    float    speed, course;
+    uint32_t tod;
+
+    if (!uart2Callback) return;
+    if (gpsSendTime && sitlMicros64() >= gpsSendTime)
+    {
+        gpsSend(gpsRmc);
+        gpsSend(gpsGga);
+        gpsSendTime = 0;
+    }
+    if (sitlMicros64() < gpsNext) return;
+    gpsNext     = sitlMicros64() + GPS_PERIOD_US;
+    gpsSendTime = sitlMicros64() + GPS_DELAY_US;
+
+    latDeg = HOME_LAT + (sitl.pos[0] + sitlNoise(0.3f)) / 111319.5;
+    lonDeg = HOME_LON + (sitl.pos[1] + sitlNoise(0.3f)) / (111319.5 * cos(HOME_LAT * RADX));
+    nmeaCoord(lat, sizeof(lat), latDeg, 2);
+    nmeaCoord(lon, sizeof(lon), lonDeg, 3);
+    speed  = sqrtf(sitl.vel[0] * sitl.vel[0] + sitl.vel[1] * sitl.vel[1]) * 1.943844f; // knots
+    course = atan2f(sitl.vel[1], sitl.vel[0]) * RADtoDEG;
+    if (course < 0) course += 360.0f;
+    tod = (uint32_t)(sitlMicros64() / 1000000) + 12 * 3600;
+
+    snprintf(gpsRmc, sizeof(gpsRmc), "GPRMC,%02u%02u%02u.%02u,A,%s,%c,%s,%c,%.1f,%.1f,010113,,,A",
+             tod / 3600 % 24, tod / 60 % 60, tod % 60, (uint32_t)(sitlMicros64() / 10000 % 100),
+             lat, latDeg < 0 ? 'S' : 'N', lon, lonDeg < 0 ? 'W' : 'E', speed, course);
+    snprintf(gpsGga, sizeof(gpsGga), "GPGGA,%02u%02u%02u.%02u,%s,%c,%s,%c,1,10,0.9,%.1f,M,0.0,M,,",
+             tod / 3600 % 24, tod / 60 % 60, tod % 60, (uint32_t)(sitlMicros64() / 10000 % 100),
+             lat, latDeg < 0 ? 'S' : 'N', lon, lonDeg < 0 ? 'W' : 'E', HOME_ALT - sitl.pos[2]);
+}
@@ -5,8 +5,6 @@
 #include "mw.h"
 #include "baseflight_mavlink.h"
 
-#define CYCLETIME             125
-
 #define PROTOCOL_HEADER       0x5E
 #define PROTOCOL_TAIL         0x5E
 
@@ -229,48 +227,43 @@ void initMinimOSDTelemetry(bool State)
     }
 }
 
-void sendFRSKYTelemetry(void)
+void sendFRSKYTelemetry(void)                                      // Scheduler task, every 125ms when armed
 {
-    static uint32_t lastCycleTime = 0;
     static uint8_t  cycleNum = 0;
 
-    if (currentTimeMS - lastCycleTime >= CYCLETIME)
-    {
-        lastCycleTime = currentTimeMS;
-        cycleNum++;
+    cycleNum++;
+
+    // Sent every 125ms
+    sendAccel();
+    sendTelemetryTail();
 
-        // Sent every 125ms
-        sendAccel();
+    if ((cycleNum % 4) == 0)        // Sent every 500ms
+    {
+        sendBaro();
+        sendHeading();
         sendTelemetryTail();
+    }
 
-        if ((cycleNum % 4) == 0)        // Sent every 500ms
-        {
-            sendBaro();
-            sendHeading();
-            sendTelemetryTail();
-        }
+    if ((cycleNum % 8) == 0)        // Sent every 1s
+    {
+        sendTemperature1();
 
-        if ((cycleNum % 8) == 0)        // Sent every 1s
+        if (feature(FEATURE_VBAT))
         {
-            sendTemperature1();
-
-            if (feature(FEATURE_VBAT))
-            {
-                sendVoltage();
-                sendVoltageAmp();
-            }
+            sendVoltage();
+            sendVoltageAmp();
+        }
 
-            if (sensors(SENSOR_GPS))
-                sendGPS();
+        if (sensors(SENSOR_GPS))
+            sendGPS();
 
-            sendTelemetryTail();
-        }
+        sendTelemetryTail();
+    }
 
-        if (cycleNum == 40)       //Frame 3: Sent every 5s
-        {
-            cycleNum = 0;
-            sendTime();
-            sendTelemetryTail();
-        }
+    if (cycleNum == 40)       //Frame 3: Sent every 5s
+    {
+        cycleNum = 0;
+        sendTime();
+        sendTelemetryTail();
     }
 }
@@ -0,0 +1,64 @@
+// blackbox.c frames through the decoder of tools/bbdecode.c. Values at the int32_t limits and the time across the
+// micros() wrap, where the straight prediction 2 * prev[0] - prev[1] leaves int32_t, have to come back exactly.
+// Encoder and decoder do that modulo 2^32: built with -fsanitize=undefined there is no signed overflow report.
+
+#include "test.h"
+#include "blackbox.c"
+#define main    bbdecodeMain                                // The decoder as a library: header() and values()
+#define crc8Dvb bbdecodeCrc8
+#include "../tools/bbdecode.c"
+#undef main
+
+#define FRAMES 200
+
+static int32_t frameValue(uint8_t field, uint32_t n)       // Field values of frame n
+{
+    switch (field)
+    {
+    case 0:  return 0x7FFFF000 + n * 2000u;                 // time, unsigned in the log: through INT32_MAX
+    case 1:  return n & 1 ? INT32_MAX : INT32_MIN;          // gyro0: the worst for the straight prediction
+    case 2:  return INT32_MAX - n;
+    case 3:  return 0x80000000u + n * n;
+    case 4:  return n & 2 ? INT32_MIN : INT32_MAX;          // rc0: previous as the prediction
+    default: return (int32_t)(n * 2654435761u) >> (field & 7);
+    }
+}
+
+static void testWrap(uint32_t start)                       // time from 0x7FFFF000 + start * 2000, 1073744 is the micros() wrap
+{
+    static uint8_t buf[BB_HEADER_MAX + BB_FRAME_MAX];
+    bbEncoder_t    enc;
+    bbLog_t        log;
+    int32_t        v[BB_FIELDS];
+    size_t         pos;
+    uint16_t       n, len, bad = 0;
+    uint8_t        i;
+
+    NumberOfMotors = 4;
+    bbEncoderInit(&enc, 1, BB_GYRO | BB_RC | BB_PID | BB_MOTOR);
+    memset(&log, 0, sizeof(log));
+    len  = bbHeader(&enc, buf);
+    data = buf;
+    size = len;
+    pos  = 1;
+    CHECK(header(&log, &pos) && log.count == enc.count);
+    for (n = 0; n < FRAMES; n++)
+    {
+        for (i = 0; i < BB_FIELDS; i++) v[i] = frameValue(i, start + n);
+        len  = bbFrame(&enc, v, buf);
+        size = len;
+        pos  = 1;
+        if (!values(&log, &pos, buf[0] == 'I') || pos != len) bad++;
+        for (i = 0; i < enc.count; i++) bad += log.prev[0][i] != v[enc.field[i]];
+        bbCommit(&enc, v);
+    }
+    testLog("time from 0x%08x: %d frames, %d bad values\n", (uint32_t)frameValue(0, start), FRAMES, bad);
+    CHECK(!bad);
+}
+
+int main(void)
+{
+    testWrap(0);
+    testWrap(1073744 - FRAMES / 2);
+    return testDone("blackbox");
+}
@@ -0,0 +1,451 @@
+// cfgstore.c on the SITL flash emulation (sitl_system.c from libfw): the steps of a full rewrite, that cfgStoreSave
+// itself never touches the flash, bounded retries on flash errors with the save kept pending, and a power loss sweep.
+// Sweep: a child process runs a sequence of saves (first boot, small saves through two compactions, two saves too big
+// for the queue) with SITL's "-f n", the power fails in the n-th erase / word program. A second child boots from the
+// torn flash file. It must have either the config of the save that was running or the one before, byte for byte.
+// n goes through every flash operation of the sequence, until the writer gets through without a power loss.
+// Schema: every field of valueTable and schemaExtra has its entry in the schema pages.
+// Legacy: config_t blobs of v34 - v39 the way the firmware before the store left them at the end of the flash, with the
+// offsets of those versions (offsetof with their mw.h), not the frozen layouts of cfgstore.c.
+
+#include "test.h"
+#include "cfgstore.c"
+#include "sitl.h"
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#define FLASH_FILE  "cfgstore_test.bin"
+#define SAVES       90                                      // Of the sweep
+#define BIG_SAVE(s) ((s) == 30 || (s) == 70)                // 600 bytes changed, more than the queue takes
+
+typedef struct
+{
+    uint16_t save;                                          // Running in the writer, 0 = first boot
+} sweep_t;
+
+static sweep_t *sweep;
+
+static void boot(uint32_t failOp)                          // sitlInit with the flash file, -f failOp
+{
+    char fail[12], *argv[] = { "cfgstore_test", "-e", FLASH_FILE, "-p", "0", "-f", fail, NULL };
+
+    snprintf(fail, sizeof(fail), "%u", failOp);
+    optind = 1;
+    sitlInit(7, argv);
+}
+
+static void saveChange(uint16_t s)                         // Save s of the sequence onto cfg
+{
+    uint8_t  *c = (uint8_t *)&cfg;
+    uint16_t i;
+
+    if (BIG_SAVE(s))
+        for (i = 0; i < 600; i++) cfg.FloppyDisk[i] = s + i;
+    else
+    {
+        c[(s * 37) % sizeof(config_t)]  += s;
+        c[(s * 101) % sizeof(config_t)] ^= s;
+    }
+}
+
+static void stateOf(uint16_t saves)                        // cfg as it is after that many saves
+{
+    uint16_t s;
+
+    checkFirstTime(true);
+    for (s = 1; s <= saves; s++)
+    {
+        saveChange(s);
+        writeParams(0);
+    }
+}
+
+static void writer(uint32_t failOp)                        // Exits with 3 when the power fails (sitlPowerFail)
+{
+    uint16_t s;
+
+    unlink(FLASH_FILE);
+    boot(failOp);
+    sweep->save = 0;
+    checkFirstTime(false);
+    cfgStoreFlush();
+    for (s = 1; s <= SAVES; s++)
+    {
+        sweep->save = s;
+        saveChange(s);
+        writeParams(0);
+        cfgStoreFlush();
+    }
+    exit(0);
+}
+
+static void reader(void)                                   // Exits with 0: the save before the cut, 1: the cut one, 2: neither
+{
+    static config_t got;
+
+    boot(0);
+    checkFirstTime(false);
+    got = cfg;
+    stateOf(sweep->save);
+    if (!memcmp(&got, &cfg, sizeof(config_t))) exit(1);
+    if (sweep->save) stateOf(sweep->save - 1);
+    exit(memcmp(&got, &cfg, sizeof(config_t)) ? 2 : 0);
+}
+
+static int child(void (*run)(uint32_t), uint32_t arg)
+{
+    int   status;
+    pid_t pid;
+
+    fflush(NULL);                                           // Or the children write out what the parent has buffered
+    pid = fork();
+
+    if (!pid)
+    {
+        fclose(stdout);                                     // The children only talk with their exit code
+        fclose(stderr);
+        run(arg);
+    }
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+static void readerRun(uint32_t arg)
+{
+    (void)arg;
+    reader();
+}
+
+static void testPowerLoss(void)
+{
+    uint32_t n, cuts = 0, older = 0, bad = 0, lastSave = 0, backwards = 0;
+    int      w, r;
+
+    sweep = mmap(NULL, sizeof(sweep_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    for (n = 1; ; n++)
+    {
+        w = child(writer, n);
+        if (w != 3) break;                                  // Through without a cut
+        cuts++;
+        r = child(readerRun, 0);
+        if (r == 0) older++;
+        else if (r != 1)
+        {
+            if (bad++ < 5) testLog("power loss in flash operation %u, save %u: neither the old nor the new config (%d)\n", n, sweep->save, r);
+        }
+        if (sweep->save < lastSave) backwards++;
+        lastSave = sweep->save;
+    }
+    testLog("power loss sweep: %u flash operations, %u with the save before, %u with the running one, %u bad\n", cuts, older, cuts - older - bad, bad);
+    CHECK(w == 0 && cuts > 2500 && lastSave == SAVES);
+    CHECK(bad == 0 && !backwards);
+    CHECK(older > 0 && cuts - older > 0);
+    munmap(sweep, sizeof(sweep_t));
+}
+
+// In process
+
+static void storeRun(bool disarmed, uint32_t *maxUs)      // TASK_CONFIG until there is nothing to do, longest step in virtual us
+{
+    uint64_t t;
+    uint16_t runs = 0;
+    bool     schema;
+
+    while ((storeState != STORE_IDLE || qHead != qTail || storeRewrite || schemaDue) && !storeParked && runs++ < 2000)
+    {
+        t      = sitlMicros64();
+        schema = schemaDue && storeState == STORE_IDLE;
+        cfgStoreUpdate(disarmed);
+        if (maxUs && !schema) *maxUs = max(*maxUs, sitlMicros64() - t); // Once after a new layout, blocks for the 2 pages
+    }
+}
+
+static const config_t *hasCfg;
+
+static void storeHasRun(uint32_t arg)
+{
+    (void)arg;
+    exit(cfgStoreLoad() && !memcmp(&cfg, hasCfg, sizeof(config_t)) ? 0 : 1);
+}
+
+static bool storeHas(const config_t *c)                    // What a boot loads. In a child, the store here keeps its state
+{
+    hasCfg = c;
+    return child(storeHasRun, 0) == 0;
+}
+
+static void testRewrite(void)
+{
+    static config_t old;
+    uint32_t        maxUs = 0;
+    uint64_t        t;
+    uint16_t        i;
+
+    unlink(FLASH_FILE);
+    boot(0);
+    t = sitlMicros64();
+    checkFirstTime(false);                                  // Blank: the defaults are a rewrite, nothing written yet
+    CHECK(sitlMicros64() == t && cfgStoreStats.rewrite && cfgStoreStats.bank == 0xFF);
+    for (i = 0; i < 100; i++) cfgStoreUpdate(false);        // Armed: no erase
+    CHECK(sitlMicros64() == t && storeState == STORE_IDLE && cfgStoreStats.bank == 0xFF);
+    storeRun(true, &maxUs);
+    CHECK(!cfgStoreStats.rewrite && cfgStoreStats.fullWrites == 1 && cfgStoreStats.bank == 0 && cfgStoreStats.schemaFields == schemaCount());
+    CHECK(storeHas(&cfg));
+    testLog("rewrite: longest TASK_CONFIG step %u us (virtual, a page erase is 20000)\n", maxUs);
+    CHECK(maxUs <= 20000 + CFG_CHUNK_WORDS * 50);
+
+    old = cfg;                                              // Too big for the queue, armed: only the copy may run, no erase
+    saveChange(30);
+    t = sitlMicros64();
+    writeParams(0);
+    CHECK(sitlMicros64() == t && cfgStoreStats.rewrite && !cfgStoreStats.queued);
+    for (i = 0; i < 100; i++) cfgStoreUpdate(false);
+    CHECK(sitlMicros64() == t && storeHas(&old));
+    maxUs = 0;
+    storeRun(true, &maxUs);
+    CHECK(cfgStoreStats.fullWrites == 2 && cfgStoreStats.bank == 1 && storeHas(&cfg));
+    CHECK(maxUs <= 20000 + CFG_CHUNK_WORDS * 50);
+
+    saveChange(1);                                          // Small ones go the queue again
+    writeParams(0);
+    CHECK(!cfgStoreStats.rewrite && cfgStoreStats.queued > 0);
+    storeRun(false, NULL);
+    CHECK(cfgStoreStats.logUsed > 0 && storeHas(&cfg));
+
+    saveChange(70);                                         // A save while the copy runs: starts over, the newest goes in
+    writeParams(0);
+    while (storeState != STORE_COPY || targetPos < CFG_WORDS / 2) cfgStoreUpdate(true);
+    saveChange(2);
+    writeParams(0);
+    CHECK(cfgStoreStats.rewrite && storeState == STORE_IDLE);
+    storeRun(true, NULL);
+    CHECK(cfgStoreStats.fullWrites == 3 && storeHas(&cfg));
+
+    saveChange(30);                                         // cfg changed without a save (cli set) while copying: copied again
+    writeParams(0);
+    while (storeState != STORE_COPY || targetPos < CFG_WORDS / 2) cfgStoreUpdate(true);
+    cfg.FloppyDisk[0]++;
+    storeRun(true, NULL);
+    CHECK(cfgStoreStats.fullWrites == 4 && storeHas(&cfg));
+    cfg.FloppyDisk[0]--;
+    writeParams(0);
+    storeRun(true, NULL);
+}
+
+static void testFlashErrors(void)
+{
+    static config_t old;
+    uint32_t        pokes = 0;
+
+    old = cfg;
+    CHECK(storeHas(&old));
+    saveChange(70);                                         // Program errors in every copy: parked after CFG_TRIES
+    writeParams(0);
+    while (!storeParked && pokes < 10)
+    {
+        cfgStoreUpdate(true);
+        if (storeState == STORE_COPY && targetPos == 0 && FLASH_WORD(target + CFG_SNAPSHOT + 20) == CFG_ERASED)
+        {
+            sitlFlash[target + CFG_SNAPSHOT + 20 - FLASH_BASE] = 0x5A;  // Not erased: programming it fails
+            pokes++;
+        }
+    }
+    CHECK(storeParked && pokes == CFG_TRIES && cfgStoreStats.failures == 1);
+    CHECK(cfgStoreStats.parked && cfgStoreStats.rewrite);
+    cfgStoreFlush();                                        // Returns, the save stays pending
+    CHECK(cfgStoreStats.parked && storeHas(&old));
+
+    writeParams(0);                                         // The next save tries again
+    CHECK(!cfgStoreStats.parked && cfgStoreStats.rewrite);
+    cfgStoreFlush();
+    CHECK(!cfgStoreStats.parked && !cfgStoreStats.rewrite && cfgStoreStats.failures == 1 && storeHas(&cfg));
+
+    old = cfg;                                              // A worn page in the other bank: erase errors, parked too
+    sitlFlashWorn = bankAddr == FLASH_WRITE_ADDR ? FLASH_WRITE_ADDR + CFG_BANK_SIZE : FLASH_WRITE_ADDR;
+    saveChange(30);
+    writeParams(0);
+    cfgStoreFlush();
+    CHECK(cfgStoreStats.parked && cfgStoreStats.failures == 2 && storeHas(&old));
+
+    sitlFlashWorn = CFG_SCHEMA_ADDR;                        // Schema: bounded too
+    sitlFlash[CFG_SCHEMA_ADDR + 4 - FLASH_BASE] ^= 1;       // Stale
+    schemaWrite();
+    CHECK(cfgStoreStats.failures == 3);
+    sitlFlashWorn = 0;
+    schemaWrite();
+    CHECK(cfgStoreStats.failures == 3 && FLASH_WORD(CFG_SCHEMA_ADDR + 4) == schemaLayout());
+
+    writeParams(0);
+    cfgStoreFlush();
+    CHECK(!cfgStoreStats.parked && storeHas(&cfg));
+}
+
+// Legacy blobs
+
+enum { L_MIXER, L_FEATURES, L_PROLL, L_RCRATE, L_LOOPTIME, L_ACCZERO, L_SENS1G, L_MAGZERO, L_ACCSTDDEV, L_TRIMROLL, L_GYSMRLL,
+       L_ACCZVCF, L_BARLAG, L_ACTIVATE, L_ESCMIN, L_GPSLAG, L_GPSBAUD, L_CUSTOM, L_FDUSED, L_FLOPPY, L_MAGSOFT, L_MAGELLIP,
+       L_IMUKP, L_ALTACCN, L_GPSKFPOS, L_GYNTCH1, L_FIELDS };
+
+static const struct
+{
+    uint8_t  version;
+    uint16_t size;
+    uint16_t off[L_FIELDS];                                 // 0 = not in that version
+} legacyBlobs[] =
+{
+    { 34, 3004, { 5, 8, 19, 49, 12, 56, 68, 72,  84, 102, 124, 128, 136, 148, 260, 358, 372, 444, 658, 660,  0,   0,   0,   0,   0,   0 } },
+    { 35, 3044, { 5, 8, 19, 49, 12, 56, 68, 72, 120, 140, 162, 168, 176, 188, 300, 398, 412, 484, 698, 700, 84, 138,   0,   0,   0,   0 } },
+    { 36, 3052, { 5, 8, 19, 49, 12, 56, 68, 72, 120, 140, 172, 176, 184, 196, 308, 406, 420, 492, 706, 708, 84, 138, 164,   0,   0,   0 } },
+    { 37, 3072, { 5, 8, 19, 49, 12, 56, 68, 72, 120, 140, 172, 176, 204, 216, 328, 426, 440, 512, 726, 728, 84, 138, 164, 188,   0,   0 } },
+    { 38, 3052, { 5, 8, 19, 49, 12, 56, 68, 72, 120, 140, 172, 176, 204, 216, 328, 444, 460, 532, 746, 748, 84, 138, 164, 188, 436,   0 } },
+    { 39, 3052, { 5, 8, 19, 49, 12, 56, 68, 72, 120, 140, 172, 176, 204, 216, 328, 446, 460, 532, 746, 748, 84, 138, 164, 188, 436,   0 } },
+    { 39, 3056, { 5, 8, 19, 49, 12, 56, 68, 72, 120, 140, 176, 180, 208, 220, 332, 450, 464, 536, 750, 752, 84, 138, 168, 192, 440,   0 } },
+    { 39, 3060, { 5, 8, 19, 49, 12, 56, 68, 72, 120, 140, 176, 180, 208, 220, 332, 454, 468, 540, 754, 756, 84, 138, 168, 192, 444,   0 } },
+    { 39, 3068, { 5, 8, 19, 49, 12, 56, 68, 72, 120, 140,   0, 188, 216, 228, 340, 462, 476, 548, 762, 764, 84, 138, 168, 200, 452, 178 } },
+};
+
+static void legacyPut(uint8_t *blob, uint8_t v, uint8_t field, uint16_t index, const void *value, uint8_t len)
+{
+    if (legacyBlobs[v].off[field]) memcpy(blob + legacyBlobs[v].off[field] + index * len, value, len);
+}
+
+static void legacyWrite(uint8_t v, bool broken, uint16_t size) // Blob of legacyBlobs[v] at the end of the flash, the banks and schema erased
+{
+    static uint8_t blob[CFG_LEGACY_SIZE];
+    const float    accZero[3] = { 12.5f, -7.25f, 3 }, magZero[3] = { -101, 55.5f, 12 }, magSoft = 1.0625f, imuKp = 0.75f;
+    const float    sens1G = 4096, accstddev = 0.5f, vcf = 0.985f, barLag = 0.3f, mix = -0.875f, altAccN = 42, kfPos = 310;
+    const uint32_t features = FEATURE_GPS | FEATURE_PASS, act = 0x1234, baud = 57600;
+    const uint16_t loop = 12000, escMin = 1080, gpsLag = 1500, fdUsed = 575, notch = 95;
+    const int16_t  trim = -42;
+    const uint8_t  mixer = MULTITYPE_HEX6, pRoll = 51, rcRate = 77, smooth = 3, ellip = 1;
+    uint16_t       i;
+    uint8_t        chk = 0;
+
+    memset(blob, 0, sizeof(blob));
+    blob[0] = legacyBlobs[v].version;
+    memcpy(blob + 2, &size, 2);
+    blob[4]        = 0xBE;
+    blob[size - 4] = 0xEF;
+    legacyPut(blob, v, L_MIXER, 0, &mixer, 1);
+    legacyPut(blob, v, L_FEATURES, 0, &features, 4);
+    legacyPut(blob, v, L_PROLL, 0, &pRoll, 1);
+    legacyPut(blob, v, L_RCRATE, 0, &rcRate, 1);
+    legacyPut(blob, v, L_LOOPTIME, 0, &loop, 2);
+    legacyPut(blob, v, L_SENS1G, 0, &sens1G, 4);
+    for (i = 0; i < 3; i++)
+    {
+        legacyPut(blob, v, L_ACCZERO, i, &accZero[i], 4);
+        legacyPut(blob, v, L_MAGZERO, i, &magZero[i], 4);
+        legacyPut(blob, v, L_ACCSTDDEV, i, &accstddev, 4);
+    }
+    legacyPut(blob, v, L_TRIMROLL, 0, &trim, 2);
+    legacyPut(blob, v, L_GYSMRLL, 0, &smooth, 1);
+    legacyPut(blob, v, L_ACCZVCF, 0, &vcf, 4);
+    legacyPut(blob, v, L_BARLAG, 0, &barLag, 4);
+    legacyPut(blob, v, L_ACTIVATE, 2, &act, 4);
+    legacyPut(blob, v, L_ESCMIN, 0, &escMin, 2);
+    legacyPut(blob, v, L_GPSLAG, 0, &gpsLag, 2);
+    legacyPut(blob, v, L_GPSBAUD, 0, &baud, 4);
+    legacyPut(blob, v, L_CUSTOM, 5, &mix, 4);
+    legacyPut(blob, v, L_FDUSED, 0, &fdUsed, 2);
+    for (i = 0; i < FDByteSize; i++) blob[legacyBlobs[v].off[L_FLOPPY] + i] = i * 7;
+    legacyPut(blob, v, L_MAGSOFT, 4, &magSoft, 4);
+    legacyPut(blob, v, L_MAGELLIP, 0, &ellip, 1);
+    legacyPut(blob, v, L_IMUKP, 0, &imuKp, 4);
+    legacyPut(blob, v, L_ALTACCN, 0, &altAccN, 4);
+    legacyPut(blob, v, L_GPSKFPOS, 0, &kfPos, 4);
+    legacyPut(blob, v, L_GYNTCH1, 0, &notch, 2);
+    for (i = 0; i < size; i++) chk ^= blob[i];
+    blob[size - 3] = chk ^ broken;
+
+    memset(sitlFlash + FLASH_WRITE_ADDR - FLASH_BASE, 0xFF, (uint32_t)FLASH_PAGES_FORCONFIG * FLASH_PAGE_SIZE);
+    memcpy(sitlFlash + CFG_LEGACY_ADDR - FLASH_BASE, blob, size);
+}
+
+static bool legacyCarried(uint8_t v)                       // cfg has what legacyWrite put, as far as legacyBlobs[v] had it
+{
+    uint16_t i;
+    bool     ok = true;
+
+    ok &= cfg.mixerConfiguration == MULTITYPE_HEX6 && cfg.enabledFeatures == (FEATURE_GPS | FEATURE_PASS);
+    ok &= cfg.P8[ROLL] == 51 && cfg.rcRate8 == 77 && cfg.looptime == 9000;                 // 12000: constrained to the cli max
+    ok &= cfg.accZero[0] == 12.5f && cfg.accZero[1] == -7.25f && cfg.accZero[2] == 3 && cfg.sens_1G == 4096;
+    ok &= cfg.magZero[0] == -101 && cfg.magZero[1] == 55.5f && cfg.magZero[2] == 12 && cfg.accstddev[2] == 0.5f;
+    ok &= cfg.angleTrim[ROLL] == -42 && cfg.accz_vcf == 0.985f && cfg.bar_lag == 0.3f && cfg.activate[2] == 0x1234;
+    ok &= cfg.esc_min == 1080 && cfg.gps_lag == 1500 && cfg.gps_baudrate == 57600 && cfg.customMixer[1].roll == -0.875f;
+    ok &= cfg.FDUsedDatasets == FDByteSize / 4;                                           // 575 of the 2340 bytes: cut with them
+    for (i = 0; i < FDByteSize; i++) ok &= cfg.FloppyDisk[i] == (int8_t)(i * 7);
+    if (legacyBlobs[v].off[L_MAGSOFT]) ok &= cfg.magSoft[1][1] == 1.0625f && cfg.mag_ellip == 1;
+    if (legacyBlobs[v].off[L_IMUKP]) ok &= cfg.imu_kp == 0.75f;
+    if (legacyBlobs[v].off[L_ALTACCN]) ok &= cfg.alt_acc_n == 42;
+    if (legacyBlobs[v].off[L_GPSKFPOS]) ok &= cfg.gps_kf_pos == 310;
+    if (legacyBlobs[v].off[L_GYNTCH1]) ok &= cfg.gy_ntch1 == 95;
+    return ok;
+}
+
+static void testLegacy(void)
+{
+    static config_t defaults;
+    uint8_t         v;
+
+    checkFirstTime(true);
+    defaults = cfg;
+    for (v = 0; v < sizeof(legacyBlobs) / sizeof(legacyBlobs[0]); v++)
+    {
+        legacyWrite(v, false, legacyBlobs[v].size);
+        checkFirstTime(false);
+        testLog("legacy v%d %d bytes: %d fields migrated\n", legacyBlobs[v].version, legacyBlobs[v].size, cfgStoreStats.migrated);
+        CHECK(cfgStoreStats.legacy == legacyBlobs[v].version && cfgStoreStats.migrated > 150 && legacyCarried(v));
+        CHECK(legacyBlobs[v].off[L_MAGSOFT] || cfg.magSoft[1][1] == defaults.magSoft[1][1]);  // New since: the defaults
+        CHECK(legacyBlobs[v].off[L_ALTACCN] || cfg.alt_acc_n == defaults.alt_acc_n);
+        CHECK(legacyBlobs[v].off[L_GPSKFPOS] || cfg.gps_kf_pos == defaults.gps_kf_pos);
+        CHECK(legacyBlobs[v].off[L_GYNTCH1] || cfg.gy_ntch1 == defaults.gy_ntch1);
+        cfgStoreFlush();                                    // The rewrite goes to bank 0, the blob stays until that is committed
+        CHECK(cfgStoreStats.bank == 0 && FLASH_WORD(CFG_SCHEMA_ADDR + 4) == schemaLayout() && storeHas(&cfg));
+    }
+    legacyWrite(v - 1, false, 3064);                        // A size no v39 build had: the defaults
+    checkFirstTime(false);
+    CHECK(!cfgStoreStats.legacy && !cfgStoreStats.migrated && cfg.P8[ROLL] == defaults.P8[ROLL] && cfg.esc_min == defaults.esc_min);
+    cfgStoreFlush();
+    legacyWrite(0, true, legacyBlobs[0].size);                                   // Checksum wrong: the defaults
+    checkFirstTime(false);
+    CHECK(!cfgStoreStats.legacy && cfg.P8[ROLL] == defaults.P8[ROLL] && cfg.accZero[0] == defaults.accZero[0]);
+    cfgStoreFlush();
+}
+
+static void testOldBank(void)                              // Bank of the builds with 4 page banks: not loaded, the defaults
+{
+    static config_t defaults;
+    const uint32_t  header[3] = { 5, CFG_MAGIC | 3068, 0 };
+
+    checkFirstTime(true);
+    defaults = cfg;
+    memset(sitlFlash + FLASH_WRITE_ADDR - FLASH_BASE, 0xFF, (uint32_t)FLASH_PAGES_FORCONFIG * FLASH_PAGE_SIZE);
+    memcpy(sitlFlash + FLASH_WRITE_ADDR - FLASH_BASE, header, sizeof(header));
+    memset(sitlFlash + FLASH_WRITE_ADDR - FLASH_BASE + CFG_SNAPSHOT, 0x11, CFG_BANK_SIZE - CFG_SNAPSHOT);
+    checkFirstTime(false);
+    CHECK(cfgStoreStats.bank == 0xFF && !cfgStoreStats.migrated && cfg.P8[ROLL] == defaults.P8[ROLL]);
+    cfgStoreFlush();
+    CHECK(cfgStoreStats.bank <= 1 && storeHas(&cfg));
+}
+
+static void testSchemaSize(void)                           // schemaCount cuts at CFG_SCHEMA_MAX, a field past it would never migrate
+{
+    uint16_t fields = valueTableCount + sizeof(schemaExtra) / sizeof(schemaExtra[0]);
+
+    testLog("schema: %u fields, %u fit the %u pages\n", fields, (uint32_t)CFG_SCHEMA_MAX, (uint32_t)(CFG_SCHEMA_SIZE / FLASH_PAGE_SIZE));
+    CHECK(fields <= CFG_SCHEMA_MAX && schemaCount() == fields);
+}
+
+int main(void)
+{
+    testSchemaSize();
+    testPowerLoss();                                        // First: the children count the flash operations from 0
+    testRewrite();
+    testFlashErrors();
+    testLegacy();
+    testOldBank();
+    unlink(FLASH_FILE);
+    return testDone("cfgstore");
+}
@@ -0,0 +1,422 @@
+// drv_i2c.c against a faked I2C peripheral and one slave (a register file at SLAVE_ADDR).
+// The model moves one bus event per step and raises the interrupts the way the reference manual has them:
+// SB, ADDR, TXE / RXNE with BTF when the data register and the shift register are both waiting, AF for a NACKed
+// address. A repeated start completes at once, a stop takes stopSteps steps to clear. It counts every START the
+// driver generates while a STOP is still going out. The ISRs can't spin on a register the model would have to
+// change: that hangs the test instead of failing it.
+// Steps run from __enable_irq, so i2cWait and i2cPoll drive the bus like the real interrupts would.
+
+#include "test.h"
+#include "board.h"
+
+static GPIO_TypeDef fakeGpioB;
+#undef  GPIOB
+#define GPIOB (&fakeGpioB)                                  // i2cUnstick toggles the pins, SCL always reads high
+
+#include "drv_i2c.c"
+
+#define SLAVE_ADDR 0x68
+
+#define SR1_SB     0x0001
+#define SR1_ADDR   0x0002
+#define SR1_BTF    0x0004
+#define SR1_RXNE   0x0040
+#define SR1_TXE    0x0080
+#define SR1_AF     0x0400
+#define CR1_START  0x0100
+#define CR1_STOP   0x0200
+#define CR1_ACK    0x0400
+#define CR1_POS    0x0800
+
+typedef enum { BUS_IDLE, BUS_ADDR, BUS_TX, BUS_RX, BUS_NACK } busState_e;
+
+static I2C_TypeDef fakeI2C1;
+static struct
+{
+    busState_e state;
+    bool       irqOff, inIrq;
+    bool       freeze;                                      // Nothing moves on the bus
+    uint8_t    stopSteps, stopLeft;
+    uint8_t    addr;                                        // Address byte of the transfer
+    uint8_t    tx, txFull;                                  // Data register, transmit
+    uint8_t    txWait;                                      // Steps the data register was empty
+    bool       regSet;                                      // First byte of a write is the register pointer
+    uint8_t    rx[2], rxCount;                              // Data register and shift register, receive
+    bool       rxLast, nackNext;
+    uint8_t    mem[256], ptr;                               // The slave
+    uint32_t   startInStop, starts, steps;
+} bus;
+
+// stdperiph and the rest of the board the driver calls
+
+void I2C_GenerateSTART(I2C_TypeDef *I2C, FunctionalState NewState)
+{
+    if (!NewState) return;
+    bus.starts++;
+    if (I2C->CR1 & CR1_STOP) bus.startInStop++;
+    if (bus.state == BUS_TX || bus.state == BUS_RX)        // Repeated start, right behind the byte
+    {
+        I2C->SR1  = SR1_SB;
+        bus.state = BUS_ADDR;
+        bus.addr  = 0xFF;
+        return;
+    }
+    I2C->CR1 |= CR1_START;
+}
+
+void I2C_GenerateSTOP(I2C_TypeDef *I2C, FunctionalState NewState)
+{
+    if (!NewState) return;
+    I2C->CR1     |= CR1_STOP;
+    bus.stopLeft  = bus.stopSteps;
+}
+
+void I2C_Send7bitAddress(I2C_TypeDef *I2C, uint8_t Address, uint8_t I2C_Direction)
+{
+    I2C->SR1 &= ~SR1_SB;
+    bus.addr  = Address | (I2C_Direction ? 1 : 0);
+}
+
+void I2C_SendData(I2C_TypeDef *I2C, uint8_t Data)
+{
+    I2C->SR1    &= ~(SR1_TXE | SR1_BTF);
+    bus.tx       = Data;
+    bus.txFull   = 1;
+    bus.txWait   = 0;
+}
+
+uint8_t I2C_ReceiveData(I2C_TypeDef *I2C)
+{
+    uint8_t d = bus.rx[0];
+
+    if (!bus.rxCount) return 0xEE;
+    bus.rx[0] = bus.rx[1];
+    bus.rxCount--;
+    I2C->SR1 &= ~(SR1_RXNE | SR1_BTF);
+    if (bus.rxCount) I2C->SR1 |= SR1_RXNE;
+    return d;
+}
+
+void I2C_AcknowledgeConfig(I2C_TypeDef *I2C, FunctionalState NewState)
+{
+    if (NewState) I2C->CR1 |= CR1_ACK;
+    else I2C->CR1 &= ~CR1_ACK;
+}
+
+void I2C_ITConfig(I2C_TypeDef *I2C, uint16_t I2C_IT, FunctionalState NewState)
+{
+    if (NewState) I2C->CR2 |= I2C_IT;
+    else I2C->CR2 &= ~I2C_IT;
+}
+
+void I2C_DeInit(I2C_TypeDef *I2C)
+{
+    memset(I2C, 0, sizeof(*I2C));
+    bus.state   = BUS_IDLE;
+    bus.rxCount = bus.txFull = 0;
+}
+
+void I2C_StructInit(I2C_InitTypeDef *I2C_InitStruct) { memset(I2C_InitStruct, 0, sizeof(*I2C_InitStruct)); }
+void I2C_Init(I2C_TypeDef *I2C, I2C_InitTypeDef *I2C_InitStruct) { (void)I2C; (void)I2C_InitStruct; }
+void I2C_Cmd(I2C_TypeDef *I2C, FunctionalState NewState) { (void)I2C; (void)NewState; }
+void NVIC_PriorityGroupConfig(uint32_t NVIC_PriorityGroup) { (void)NVIC_PriorityGroup; }
+void NVIC_Init(NVIC_InitTypeDef *NVIC_InitStruct) { (void)NVIC_InitStruct; }
+void gpioInit(GPIO_TypeDef *gpio, gpio_config_t *config) { (void)gpio; (void)config; fakeGpioB.IDR = 0xFFFF; }
+void delayMicroseconds(uint32_t us) { (void)us; }
+void __DMB(void) { }
+void __NOP(void) { }
+
+// The bus
+
+static void busStep(void)
+{
+    I2C_TypeDef *I2C = &fakeI2C1;
+
+    bus.steps++;
+    if (bus.freeze) return;
+    if (bus.state == BUS_IDLE || bus.state == BUS_NACK)
+    {
+        if ((I2C->CR1 & CR1_STOP) && !bus.stopLeft--)
+        {
+            I2C->CR1  &= ~CR1_STOP;
+            bus.state  = BUS_IDLE;
+        }
+        else if (bus.state == BUS_IDLE && (I2C->CR1 & CR1_START) && !(I2C->CR1 & CR1_STOP))
+        {
+            I2C->CR1 &= ~CR1_START;
+            I2C->SR1 |= SR1_SB;
+            bus.state = BUS_ADDR;
+            bus.addr  = 0xFF;
+        }
+        return;
+    }
+    switch (bus.state)
+    {
+    case BUS_ADDR:
+        if (bus.addr == 0xFF) return;                       // Waiting for the address
+        if ((bus.addr >> 1) != SLAVE_ADDR)
+        {
+            I2C->SR1  |= SR1_AF;
+            bus.state  = BUS_NACK;
+            return;
+        }
+        I2C->SR1       |= SR1_ADDR;
+        bus.state       = bus.addr & 1 ? BUS_RX : BUS_TX;
+        bus.regSet      = !(bus.addr & 1);
+        bus.rxCount     = 0;
+        bus.rxLast      = bus.nackNext = false;
+        bus.txFull      = 0;
+        bus.txWait      = 0;
+        break;
+    case BUS_TX:
+        if (I2C->SR1 & SR1_ADDR) return;                    // Clock stretched until the ISR took ADDR
+        if (bus.txFull)
+        {
+            if (bus.regSet) bus.ptr = bus.tx;
+            else bus.mem[bus.ptr++] = bus.tx;
+            bus.regSet = false;
+            bus.txFull = 0;
+            I2C->SR1  |= SR1_TXE;
+        }
+        else if (I2C->CR1 & CR1_STOP)                       // Last byte is out, stop on the bus
+        {
+            I2C->SR1  &= ~(SR1_TXE | SR1_BTF);
+            bus.state  = BUS_IDLE;
+        }
+        else if (bus.txWait++)
+            I2C->SR1 |= SR1_BTF;
+        else
+            I2C->SR1 |= SR1_TXE;
+        break;
+    case BUS_RX:
+        if (I2C->SR1 & SR1_ADDR) return;
+        if (bus.rxLast)                                     // The NACKed byte is in, the stop follows it
+        {
+            if (I2C->CR1 & CR1_STOP) bus.state = BUS_IDLE;
+            return;
+        }
+        if (bus.rxCount == 2) return;                       // BTF, clock stretched
+        bus.rx[bus.rxCount++] = bus.mem[bus.ptr++];
+        bus.rxLast = bus.nackNext || !(I2C->CR1 & CR1_ACK);
+        if (!(I2C->CR1 & CR1_ACK) && (I2C->CR1 & CR1_POS) && !bus.nackNext)
+        {
+            bus.rxLast   = false;                           // POS: the NACK goes to the next byte
+            bus.nackNext = true;
+        }
+        I2C->SR1 |= SR1_RXNE;
+        if (bus.rxCount == 2) I2C->SR1 |= SR1_BTF;
+        break;
+    default:
+        break;
+    }
+}
+
+static void busIrq(void)                                    // Interrupts pending in SR1, as enabled in CR2
+{
+    I2C_TypeDef *I2C = &fakeI2C1;
+    uint16_t     sr1;
+    int          n;
+
+    if (bus.irqOff || bus.inIrq) return;
+    bus.inIrq = true;
+    for (n = 0; n < 16; n++)
+    {
+        sr1 = I2C->SR1;
+        if ((I2C->CR2 & I2C_IT_ERR) && (sr1 & 0x0F00))
+            I2C1_ER_IRQHandler();
+        else if ((I2C->CR2 & I2C_IT_EVT) && ((sr1 & (SR1_SB | SR1_ADDR | SR1_BTF)) || ((I2C->CR2 & I2C_IT_BUF) && (sr1 & (SR1_TXE | SR1_RXNE)))))
+        {
+            I2C1_EV_IRQHandler();
+            if (sr1 & SR1_ADDR) I2C->SR1 &= ~SR1_ADDR;      // The ISR read SR1 and SR2
+        }
+        else
+            break;
+    }
+    bus.inIrq = false;
+}
+
+void __disable_irq(void)
+{
+    bus.irqOff = true;
+}
+
+void __enable_irq(void)
+{
+    bus.irqOff = false;
+    if (bus.inIrq) return;
+    busStep();
+    busIrq();
+}
+
+static void busRun(uint32_t steps)                          // Time passes, no systick
+{
+    while (steps--)
+    {
+        busStep();
+        busIrq();
+    }
+}
+
+// The tests
+
+static uint8_t doneOrder[16], doneCount;
+static i2cJob_t chained;
+static uint8_t chainedBuf[4];
+
+static void jobDone(i2cJob_t *j)
+{
+    doneOrder[doneCount++] = j->reg;
+}
+
+static void jobDoneChain(i2cJob_t *j)                       // Interrupt: submits the next job, like mpuFifoCountDone
+{
+    jobDone(j);
+    CHECK(i2cSubmit(&chained));
+}
+
+static void setJob(i2cJob_t *j, uint8_t addr_, uint8_t reg_, uint8_t len, bool read, uint8_t *buf, void (*done)(i2cJob_t *))
+{
+    j->addr  = addr_;
+    j->reg   = reg_;
+    j->len   = len;
+    j->read  = read;
+    j->buf   = buf;
+    j->done  = done;
+    j->state = I2C_JOB_IDLE;
+}
+
+static void testBlocking(void)
+{
+    static const uint8_t lens[] = { 1, 2, 3, 4, 6, 14 };
+    uint8_t data[16], buf[16], i, k;
+
+    CHECK(i2cWrite(SLAVE_ADDR, 0x10, 0xAB));
+    CHECK(bus.mem[0x10] == 0xAB);
+    for (i = 0; i < 16; i++) data[i] = 0x30 + i * 7;
+    CHECK(i2cWriteBuffer(SLAVE_ADDR, 0x20, 16, data));
+    CHECK(!memcmp(&bus.mem[0x20], data, 16));
+    for (k = 0; k < sizeof(lens); k++)
+    {
+        memset(buf, 0, sizeof(buf));
+        CHECK(i2cRead(SLAVE_ADDR, 0x20, lens[k], buf));
+        CHECK(!memcmp(buf, data, lens[k]));
+        CHECK(bus.ptr == 0x20 + lens[k]);                   // The slave gave exactly len bytes
+    }
+    CHECK(i2cRead(SLAVE_ADDR, 0x10, 1, buf) && buf[0] == 0xAB);
+}
+
+static void testChain(void)                                 // Jobs back to back, one of them submitted by the interrupt
+{
+    i2cJob_t j[4];
+    uint8_t  b[4][4], w[2] = { 0x55, 0x66 };
+    uint32_t starts = bus.starts, i;
+
+    busRun(10);                                             // The stop of the last test is out
+    doneCount = 0;
+    memset(b, 0, sizeof(b));
+    setJob(&j[0], SLAVE_ADDR, 0x20, 3, true, b[0], jobDone);
+    setJob(&j[1], SLAVE_ADDR, 0x40, 2, false, w, jobDoneChain);
+    setJob(&j[2], SLAVE_ADDR, 0x22, 1, true, b[2], jobDone);
+    setJob(&j[3], SLAVE_ADDR, 0x40, 2, true, b[3], jobDone);
+    setJob(&chained, SLAVE_ADDR, 0x41, 1, true, chainedBuf, jobDone);
+    for (i = 0; i < 4; i++) CHECK(i2cSubmit(&j[i]));
+    CHECK(j[0].state == I2C_JOB_BUSY && j[1].state == I2C_JOB_QUEUED);
+    CHECK(!i2cSubmit(&j[0]) && !i2cSubmit(&j[1]));          // In already: refused, each runs once
+    CHECK(((qTail - qHead) & (I2C_QUEUE_SIZE - 1)) == 3);
+
+    busRun(200);                                            // No systick, no scheduler: the first job ends with a stop
+    CHECK(j[0].state == I2C_JOB_DONE);
+    CHECK(j[1].state == I2C_JOB_QUEUED);                    // and the next one waits for i2cPoll instead of the ISR spinning on it
+    for (i = 0; i < 20 && doneCount < 5; i++)
+    {
+        i2cPoll();                                          // The scheduler loop
+        busRun(100);
+    }
+    CHECK(doneCount == 5);
+    CHECK(doneOrder[0] == 0x20 && doneOrder[1] == 0x40 && doneOrder[2] == 0x22 && doneOrder[3] == 0x40 && doneOrder[4] == 0x41);
+    for (i = 0; i < 4; i++) CHECK(j[i].state == I2C_JOB_DONE);
+    CHECK(chained.state == I2C_JOB_DONE);
+    CHECK(!memcmp(b[0], &bus.mem[0x20], 3));
+    CHECK(b[2][0] == bus.mem[0x22]);
+    CHECK(b[3][0] == 0x55 && b[3][1] == 0x66);
+    CHECK(chainedBuf[0] == 0x66);
+    CHECK(bus.starts - starts >= 5 + 4);                    // Reads have a repeated start
+}
+
+static void testFull(void)
+{
+    i2cJob_t j[I2C_QUEUE_SIZE + 1];
+    uint8_t  b[I2C_QUEUE_SIZE + 1], w = 0;
+    uint16_t errors = i2cGetErrorCounter();
+    int      i;
+
+    bus.freeze = true;
+    for (i = 0; i < I2C_QUEUE_SIZE + 1; i++) setJob(&j[i], SLAVE_ADDR, 0x20 + i, 1, true, &b[i], NULL);
+    for (i = 0; i < I2C_QUEUE_SIZE; i++) CHECK(i2cSubmit(&j[i]));          // One on the bus, 7 in the queue
+    CHECK(!i2cSubmit(&j[I2C_QUEUE_SIZE]));
+    CHECK(j[I2C_QUEUE_SIZE].state == I2C_JOB_IDLE);
+    CHECK(!i2cWrite(SLAVE_ADDR, 0x10, w));                  // Blocking call with the queue full: error, no wait
+    CHECK(i2cGetErrorCounter() == errors + 1);
+    bus.freeze = false;
+    CHECK(i2cWait(&j[I2C_QUEUE_SIZE - 1]));
+    for (i = 0; i < I2C_QUEUE_SIZE; i++) CHECK(j[i].state == I2C_JOB_DONE && b[i] == bus.mem[0x20 + i]);
+    CHECK(i2cSubmit(&j[I2C_QUEUE_SIZE]) && i2cWait(&j[I2C_QUEUE_SIZE]));
+}
+
+static void testError(void)                                 // Nobody at the address: AF, the job fails, the bus goes on
+{
+    i2cJob_t bad, good;
+    uint8_t  b[2], g[2];
+
+    CHECK(!i2cRead(0x50, 0x00, 2, b));
+    setJob(&bad, 0x50, 0x00, 2, true, b, NULL);
+    setJob(&good, SLAVE_ADDR, 0x20, 2, true, g, NULL);
+    CHECK(i2cSubmit(&bad) && i2cSubmit(&good));
+    CHECK(!i2cWait(&bad));
+    CHECK(bad.state == I2C_JOB_ERROR);
+    CHECK(i2cWait(&good) && !memcmp(g, &bus.mem[0x20], 2));
+    CHECK(!(fakeI2C1.SR1 & 0x0F00));
+}
+
+static void testTimeout(void)                               // A stuck bus: i2cWait times out, flushes the queue and resets
+{
+    i2cJob_t j[3];
+    uint8_t  b[3][2];
+    uint16_t errors = i2cGetErrorCounter();
+    uint32_t steps;
+    int      i;
+
+    bus.freeze = true;
+    for (i = 0; i < 3; i++)
+    {
+        setJob(&j[i], SLAVE_ADDR, 0x20, 2, true, b[i], NULL);
+        CHECK(i2cSubmit(&j[i]));
+    }
+    steps = bus.steps;
+    CHECK(!i2cWait(&j[0]));
+    CHECK(bus.steps - steps >= I2C_DEFAULT_TIMEOUT - 1);
+    CHECK(i2cGetErrorCounter() == errors + 1);
+    for (i = 0; i < 3; i++) CHECK(j[i].state == I2C_JOB_ERROR);
+    CHECK(job == NULL && qHead == qTail);
+    CHECK(fakeI2C1.CR1 == 0 && fakeI2C1.CR2 == 0);          // i2cInit
+    bus.freeze = false;
+    CHECK(i2cRead(SLAVE_ADDR, 0x20, 2, b[0]) && !memcmp(b[0], &bus.mem[0x20], 2));
+}
+
+int main(void)
+{
+    int i;
+
+    for (i = 0; i < 256; i++) bus.mem[i] = i ^ 0x5A;
+    bus.stopSteps = 3;
+    i2cInit(&fakeI2C1);
+
+    testBlocking();
+    testChain();
+    testFull();
+    testError();
+    testTimeout();
+    testLog("%u starts, %u of them while a stop was pending\n", (unsigned)bus.starts, (unsigned)bus.startInStop);
+    CHECK(bus.startInStop == 0);
+    return testDone("drv_i2c");
+}
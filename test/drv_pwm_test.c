@@ -0,0 +1,237 @@
+// drv_pwm.c OneShot125 against faked TIM1..4 and a pulse model of their compare outputs.
+// The timers are plain structs, stm32f10x_tim.c is compiled in on top of them. Per model tick every running timer
+// counts once: PWM2 output active from the compare value to the update event, the compare value is CCR itself, or with
+// OCxPE its shadow, loaded by an update event (overflow or UG). One pulse mode clears CEN at the overflow.
+// Every edge of the motor outputs is recorded, so a pulse that pwmWriteMotor cuts, stretches or splits shows.
+
+#include "test.h"
+#include "board.h"
+
+static TIM_TypeDef  fakeTim[4];
+static GPIO_TypeDef fakeGpio[2];
+#undef  TIM1
+#undef  TIM2
+#undef  TIM3
+#undef  TIM4
+#undef  GPIOA
+#undef  GPIOB
+#define TIM1  (&fakeTim[0])
+#define TIM2  (&fakeTim[1])
+#define TIM3  (&fakeTim[2])
+#define TIM4  (&fakeTim[3])
+#define GPIOA (&fakeGpio[0])
+#define GPIOB (&fakeGpio[1])
+
+#include "stm32f10x_tim.c"
+#include "drv_pwm.c"
+
+#define MOTORS   10                                         // multiPPM: PWM9..14, PWM5..8
+#define MAX_EDGE 8
+
+uint16_t failsafeCnt;
+uint32_t SystemCoreClock = 72000000;
+
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct) { (void)GPIOx; (void)GPIO_InitStruct; }
+void GPIO_StructInit(GPIO_InitTypeDef *GPIO_InitStruct) { memset(GPIO_InitStruct, 0, sizeof(*GPIO_InitStruct)); }
+void NVIC_Init(NVIC_InitTypeDef *NVIC_InitStruct) { (void)NVIC_InitStruct; }
+void RCC_APB1PeriphResetCmd(uint32_t RCC_APB1Periph, FunctionalState NewState) { (void)RCC_APB1Periph; (void)NewState; }
+void RCC_APB2PeriphResetCmd(uint32_t RCC_APB2Periph, FunctionalState NewState) { (void)RCC_APB2Periph; (void)NewState; }
+void __enable_irq(void) { }
+void __disable_irq(void) { }
+void __DMB(void) { }
+void __NOP(void) { }
+
+// The timers
+
+static uint16_t shadow[4][4];                               // Compare values in use, per timer and channel
+static uint32_t tick;
+static struct
+{
+    bool     level;
+    uint8_t  pulses;                                        // Rising edges since pulseClear
+    uint16_t width[MAX_EDGE];                               // Counts from each rising to its falling edge
+    uint32_t rise;
+} out[MAX_PORTS];
+
+static volatile uint16_t *ccrReg(TIM_TypeDef *tim, uint8_t ch)
+{
+    volatile uint16_t *r[4] = { &tim->CCR1, &tim->CCR2, &tim->CCR3, &tim->CCR4 };
+    return r[ch];
+}
+
+static bool ccrPreload(TIM_TypeDef *tim, uint8_t ch)       // OCxPE
+{
+    return ((ch < 2 ? tim->CCMR1 : tim->CCMR2) >> (ch & 1 ? 8 : 0)) & TIM_CCMR1_OC1PE;
+}
+
+static void timUpdate(uint8_t t)                            // Update event: counter to 0, preloaded compare values in
+{
+    uint8_t ch;
+
+    fakeTim[t].CNT = 0;
+    for (ch = 0; ch < 4; ch++) shadow[t][ch] = *ccrReg(&fakeTim[t], ch);
+}
+
+static uint16_t timCompare(uint8_t t, uint8_t ch)
+{
+    return ccrPreload(&fakeTim[t], ch) ? shadow[t][ch] : *ccrReg(&fakeTim[t], ch);
+}
+
+static void timOutputs(void)                                // Motor outputs at the current counts, edges recorded
+{
+    uint8_t port, t, ch;
+    bool    level;
+
+    for (port = 0; port < MAX_PORTS; port++)
+    {
+        if (!pwmPorts[port].ccr || pwmPorts[port].callback) continue;
+        t     = timerHardware[port].tim - fakeTim;
+        ch    = timerHardware[port].channel >> 2;
+        level = fakeTim[t].CNT >= timCompare(t, ch);         // PWM2
+        if (fakeTim[t].CCER & (TIM_CCER_CC1P << (ch * 4))) level = !level;
+        if (level == out[port].level) continue;
+        out[port].level = level;
+        if (level)
+        {
+            out[port].rise = tick;
+            out[port].pulses++;
+        }
+        else if (out[port].pulses && out[port].pulses <= MAX_EDGE)
+            out[port].width[out[port].pulses - 1] = tick - out[port].rise;
+    }
+}
+
+static void timRun(uint32_t counts)
+{
+    uint8_t t;
+
+    while (counts--)
+    {
+        for (t = 0; t < 4; t++)
+        {
+            if (fakeTim[t].EGR & TIM_EGR_UG)
+            {
+                fakeTim[t].EGR = 0;
+                timUpdate(t);
+            }
+        }
+        timOutputs();
+        tick++;
+        for (t = 0; t < 4; t++)
+        {
+            if (!(fakeTim[t].CR1 & TIM_CR1_CEN)) continue;
+            if (fakeTim[t].CNT < fakeTim[t].ARR)
+                fakeTim[t].CNT++;
+            else
+            {
+                timUpdate(t);
+                if (fakeTim[t].CR1 & TIM_CR1_OPM) fakeTim[t].CR1 &= ~TIM_CR1_CEN;
+            }
+        }
+    }
+}
+
+static bool timRunning(void)
+{
+    uint8_t t;
+    for (t = 0; t < 4; t++) if (fakeTim[t].CR1 & TIM_CR1_CEN) return true;
+    return false;
+}
+
+// The tests
+
+static const uint8_t motorPort[MOTORS] = { PWM9, PWM10, PWM11, PWM12, PWM13, PWM14, PWM5, PWM6, PWM7, PWM8 };
+
+static void pulseClear(void)
+{
+    uint8_t i;
+    for (i = 0; i < MAX_PORTS; i++)
+    {
+        out[i].pulses = 0;
+        memset(out[i].width, 0, sizeof(out[i].width));
+    }
+}
+
+static void motorsWrite(uint16_t base, int16_t step)
+{
+    uint8_t i;
+    for (i = 0; i < MOTORS; i++) pwmWriteMotor(i, base + i * step);
+}
+
+static bool pulsesAre(uint16_t base, int16_t step)         // One pulse per motor, of its value in counts
+{
+    uint8_t i, p;
+    bool    ok = true;
+
+    for (i = 0; i < MOTORS; i++)
+    {
+        p = motorPort[i];
+        if (out[p].pulses != 1 || out[p].width[0] != base + i * step || out[p].level)
+        {
+            testLog("motor %u: %u pulses, first %u counts, expected 1 of %u\n", i, out[p].pulses, out[p].width[0], base + i * step);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+int main(void)
+{
+    drv_pwm_config_t init;
+
+    memset(&init, 0, sizeof(init));
+    init.usePPM       = true;
+    init.motorPwmRate = 400;
+    init.servoPwmRate = 50;
+    init.oneshot      = true;
+    pwmInit(&init);
+    CHECK(numMotors == MOTORS && numMotorTimers == 3);
+    CHECK(!timRunning());
+
+    timRun(100);                                            // Nothing goes out before the first update
+    CHECK(out[PWM9].pulses == 0);
+    pwmCompleteMotorUpdate();                               // The init value
+    timRun(ONESHOT_PERIOD + 10);
+    CHECK(pulsesAre(PULSE_1MS, 0));
+    CHECK(!timRunning());
+
+    pulseClear();                                           // A loop: write all, fire
+    motorsWrite(1100, 90);
+    pwmCompleteMotorUpdate();
+    timRun(ONESHOT_PERIOD + 10);
+    CHECK(pulsesAre(1100, 90));
+
+    pulseClear();                                           // New values while the pulses are on: they go out whole, the old ones
+    motorsWrite(1900, -90);
+    pwmCompleteMotorUpdate();
+    timRun(ONESHOT_PERIOD - 600);                           // All outputs high
+    CHECK(out[PWM9].level && out[PWM8].level);
+    motorsWrite(1000, 100);
+    pwmCompleteMotorUpdate();                               // Still in the pulse: left alone
+    timRun(300);
+    motorsWrite(1050, 100);                                 // and once more, the last one counts
+    timRun(310);
+    CHECK(pulsesAre(1900, -90));
+    CHECK(!timRunning());
+    pulseClear();
+    pwmCompleteMotorUpdate();
+    timRun(ONESHOT_PERIOD + 10);
+    CHECK(pulsesAre(1050, 100));
+
+    pulseClear();                                           // Before the compare: a write then doesn't shorten the pulse either
+    motorsWrite(1000, 0);
+    pwmCompleteMotorUpdate();
+    timRun(200);
+    motorsWrite(2000, 0);
+    timRun(ONESHOT_PERIOD);
+    CHECK(pulsesAre(1000, 0));
+
+    pulseClear();                                           // Out of range values: at most ONESHOT_PERIOD - 1 counts
+    motorsWrite(2100, 0);
+    pwmCompleteMotorUpdate();
+    timRun(ONESHOT_PERIOD + 10);
+    CHECK(pulsesAre(ONESHOT_PERIOD - 1, 0));
+
+    testLog("%u timer counts\n", (unsigned)tick);
+    return testDone("drv_pwm");
+}
@@ -0,0 +1,172 @@
+// drv_uart.c USART1 transmit ring against a faked DMA1 channel 4. The model moves a byte per step from CMAR on while
+// the channel is enabled, counts CNDTR down and raises the transfer complete interrupt at 0, like the DMA does.
+// What it moves is the wire: it must be exactly the bytes uartWrite / uartWriteBlock took, in order, across the wrap
+// of the ring, with a full ring and with empty blocks. A transfer of the stale ring or an overwritten byte shows.
+
+#include "test.h"
+#include "board.h"
+
+static DMA_Channel_TypeDef fakeDma[2];
+#undef  DMA1_Channel4
+#undef  DMA1_Channel5
+#define DMA1_Channel4 (&fakeDma[0])
+#define DMA1_Channel5 (&fakeDma[1])
+
+#include "drv_uart.c"
+
+#define WIRE_MAX 100000
+
+static struct
+{
+    uint32_t done;                                          // Bytes of the running transfer
+    uint32_t transfers, stale;                              // Started, started with nothing to send
+    uint8_t  wire[WIRE_MAX];
+    uint32_t wireLen;
+    uint8_t  sent[WIRE_MAX];                                // What the driver took
+    uint32_t sentLen;
+} dma;
+
+// stdperiph and the rest of the board the driver calls
+
+void DMA_Cmd(DMA_Channel_TypeDef *ch, FunctionalState NewState)
+{
+    if (!NewState)
+    {
+        ch->CCR &= ~1;
+        return;
+    }
+    ch->CCR |= 1;
+    dma.done = 0;
+    dma.transfers++;
+    if (ch == DMA1_Channel4 && txBufferHead == (uint32_t)(ch->CMAR - (uint32_t)(uintptr_t)txBuffer)) dma.stale++;
+}
+
+uint16_t DMA_GetCurrDataCounter(DMA_Channel_TypeDef *ch) { return ch->CNDTR; }
+void DMA_ClearITPendingBit(uint32_t DMAy_IT) { (void)DMAy_IT; }
+void DMA_DeInit(DMA_Channel_TypeDef *ch) { memset(ch, 0, sizeof(*ch)); }
+void DMA_Init(DMA_Channel_TypeDef *ch, DMA_InitTypeDef *init) { (void)ch; (void)init; }
+void DMA_ITConfig(DMA_Channel_TypeDef *ch, uint32_t it, FunctionalState NewState) { (void)ch; (void)it; (void)NewState; }
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct) { (void)GPIOx; (void)GPIO_InitStruct; }
+void NVIC_Init(NVIC_InitTypeDef *NVIC_InitStruct) { (void)NVIC_InitStruct; }
+void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState) { (void)RCC_APB1Periph; (void)NewState; }
+void USART_Init(USART_TypeDef *USARTx, USART_InitTypeDef *init) { (void)USARTx; (void)init; }
+void USART_StructInit(USART_InitTypeDef *init) { memset(init, 0, sizeof(*init)); }
+void USART_Cmd(USART_TypeDef *USARTx, FunctionalState NewState) { (void)USARTx; (void)NewState; }
+void USART_DMACmd(USART_TypeDef *USARTx, uint16_t req, FunctionalState NewState) { (void)USARTx; (void)req; (void)NewState; }
+void USART_ITConfig(USART_TypeDef *USARTx, uint16_t it, FunctionalState NewState) { (void)USARTx; (void)it; (void)NewState; }
+uint16_t USART_ReceiveData(USART_TypeDef *USARTx) { (void)USARTx; return 0; }
+
+// The DMA
+
+static void dmaRun(uint32_t steps)                          // A byte per step, TC interrupt when CNDTR gets to 0
+{
+    while (steps-- && (DMA1_Channel4->CCR & 1))
+    {
+        if (!DMA1_Channel4->CNDTR)                          // Enabled with nothing to move: the hardware does nothing either
+            return;
+        if (dma.wireLen < WIRE_MAX)
+            dma.wire[dma.wireLen++] = txBuffer[(uint32_t)(DMA1_Channel4->CMAR - (uint32_t)(uintptr_t)txBuffer) + dma.done];
+        dma.done++;
+        if (!--DMA1_Channel4->CNDTR)
+            DMA1_Channel4_IRQHandler();
+    }
+}
+
+static void txReset(void)
+{
+    memset(&dma, 0, sizeof(dma));
+    memset(fakeDma, 0, sizeof(fakeDma));
+    memset((void *)txBuffer, 0xEE, sizeof(txBuffer));        // Stale: what a wrong transfer would put on the wire
+    txBufferHead = txBufferTail = 0;
+    memset(&uartTxStats, 0, sizeof(uartTxStats));
+    uartTxStats.size = UART_TX_BUFFER_SIZE - 1;
+}
+
+static bool blockWrite(const uint8_t *data, uint16_t len)  // uartWriteBlock, what it took goes to sent
+{
+    if (!uartWriteBlock(data, len)) return false;
+    memcpy(&dma.sent[dma.sentLen], data, len);
+    dma.sentLen += len;
+    return true;
+}
+
+static bool wireIsSent(void)
+{
+    return dma.wireLen == dma.sentLen && !memcmp(dma.wire, dma.sent, dma.sentLen);
+}
+
+static uint32_t rnd(void)
+{
+    static uint32_t s = 12345;
+    s = s * 1664525 + 1013904223;
+    return s >> 8;
+}
+
+static void testWrap(void)                                 // Frames of odd sizes, the DMA at its own pace: the ring wraps ca. 100 times
+{
+    uint8_t  frame[200];
+    uint16_t len, i, n, drops = 0;
+
+    txReset();
+    for (n = 0; n < 1000; n++)
+    {
+        len = rnd() % 150;
+        for (i = 0; i < len; i++) frame[i] = n + i * 3;
+        if (!blockWrite(frame, len)) drops++;
+        if (n % 7 == 0 && uartTxFree())
+        {
+            dma.sent[dma.sentLen++] = n;                     // A single byte in between
+            uartWrite(n);
+        }
+        dmaRun(rnd() % 120);
+    }
+    dmaRun(10000);
+    testLog("wrap: %u bytes, %u transfers, %d frames dropped\n", dma.wireLen, dma.transfers, drops);
+    CHECK(wireIsSent() && dma.sentLen > 50 * UART_TX_BUFFER_SIZE);
+    CHECK(!dma.stale && uartTxStats.dropped == drops && !uartTxStats.overflows);
+    CHECK(uartTransmitEmpty() && uartTxFree() == UART_TX_BUFFER_SIZE - 1 && !(DMA1_Channel4->CCR & 1));
+}
+
+static void testFull(void)                                 // The DMA stalls: the ring fills to size - 1, nothing is overwritten
+{
+    uint8_t  frame[UART_TX_BUFFER_SIZE];
+    uint16_t i;
+
+    txReset();
+    for (i = 0; i < sizeof(frame); i++) frame[i] = i * 7 + 1;
+    txBufferHead = txBufferTail = 300;                      // The full ring wraps
+    CHECK(blockWrite(frame, 100));                          // The DMA takes 100 to 400, stays there
+    dmaRun(1);
+    CHECK(uartTxFree() == UART_TX_BUFFER_SIZE - 1 - 100 + 1);  // What the DMA has read is free again
+    CHECK(!blockWrite(frame, uartTxFree() + 1) && uartTxStats.dropped == 1);
+    CHECK(blockWrite(frame + 100, uartTxFree()) && uartTxFree() == 0);  // Exactly full, across the end of the ring
+    CHECK(!blockWrite(frame, 1) && uartTxStats.dropped == 2);
+    uartWrite(0x55);
+    CHECK(uartTxStats.overflows == 1 && uartTxStats.highWater == UART_TX_BUFFER_SIZE - 1);
+    CHECK(blockWrite(frame, 0));                            // Nothing fits, but nothing is asked for
+    dmaRun(10000);
+    CHECK(wireIsSent() && !dma.stale);
+}
+
+static void testEmpty(void)                                // Empty blocks start no transfer
+{
+    uint8_t frame[10] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+    txReset();
+    txBufferHead = txBufferTail = 200;
+    CHECK(blockWrite(frame, 0) && !dma.transfers && !(DMA1_Channel4->CCR & 1));
+    dmaRun(10000);
+    CHECK(dma.wireLen == 0 && uartTxStats.highWater == 0);
+    CHECK(blockWrite(frame, 10));                           // Idle ring at 200: one transfer of the 10
+    dmaRun(10000);
+    CHECK(wireIsSent() && dma.transfers == 1 && !dma.stale && txBufferTail == 210);
+    CHECK(blockWrite(frame, 0) && dma.transfers == 1);
+}
+
+int main(void)
+{
+    testWrap();
+    testFull();
+    testEmpty();
+    return testDone("drv_uart");
+}
@@ -0,0 +1,23 @@
+// fast_math.c against the libm calls it replaces
+
+#include "test.h"
+#include "fast_math.c"
+
+int main(void)
+{
+    static volatile float sink;
+    volatile float        in = 0.7f, p = 97000.0f;                   // volatile: no constant folding
+
+    BENCH("fastSin", 1000000, sink = fastSin(in));
+    BENCH("sinf", 1000000, sink = sinf(in));
+    BENCH("fastCos", 1000000, sink = fastCos(in));
+    BENCH("cosf", 1000000, sink = cosf(in));
+    BENCH("fastAtan2", 1000000, sink = fastAtan2(in, 0.3f));
+    BENCH("atan2f", 1000000, sink = atan2f(in, 0.3f));
+    BENCH("fastInvSqrt", 1000000, sink = fastInvSqrt(in));
+    BENCH("1 / sqrtf", 1000000, sink = 1.0f / sqrtf(in));
+    BENCH("fastBaroAlt", 1000000, sink = fastBaroAlt(p));
+    BENCH("powf baro altitude", 1000000, sink = (1.0f - powf(p * (1.0f / 101325.0f), 0.190295f)) * 4433000.0f);
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,51 @@
+// fast_math.c against double libm: the error bounds in the header of fast_math.c
+
+#include "test.h"
+#include "fast_math.c"
+
+int main(void)
+{
+    double e, eSin = 0, eCos = 0, eSinf = 0, eAtan = 0, eInv = 0, eBaro = 0;
+    float  x, y, a;
+    int    i, j;
+
+    for (i = -4000000; i <= 4000000; i++)                                  // |x| < 64 PI, 50 samples per degree
+    {
+        x = (float)i * (float)(64.0 * M_PI / 4000000.0);
+        e = fabs(fastSin(x) - sin(x));
+        if (e > eSin) eSin = e;
+        e = fabs(fastCos(x) - cos(x));
+        if (e > eCos) eCos = e;
+        e = fabs(sinf(x) - sin(x));
+        if (e > eSinf) eSinf = e;
+    }
+    for (i = -1000; i <= 1000; i++)                                        // Both signs, all octants, and the axes
+        for (j = -1000; j <= 1000; j++)
+        {
+            x = i * 0.37f;
+            y = j * 0.41f;
+            e = fabs(fastAtan2(y, x) - atan2(y, x));
+            if (x == 0 && y == 0) e = fabs(fastAtan2(y, x));
+            if (e > eAtan) eAtan = e;
+        }
+    for (a = 1e-6f; a < 1e7f; a *= 1.0001f)
+    {
+        e = fabs(fastInvSqrt(a) * sqrt(a) - 1.0);
+        if (e > eInv) eInv = e;
+    }
+    for (a = 50662.5f; a <= 109431.0f; a += 0.25f)                          // p/p0 0.5 .. 1.08
+    {
+        e = fabs(fastBaroAlt(a) - (1.0 - pow(a / 101325.0, 0.190295)) * 4433000.0);
+        if (e > eBaro) eBaro = e;
+    }
+
+    testLog("fastSin %.3g fastCos %.3g (sinf %.3g) fastAtan2 %.3g fastInvSqrt %.3g (rel) fastBaroAlt %.3g cm\n", eSin, eCos, eSinf, eAtan, eInv, eBaro);
+    CHECK(eSin < 1.6e-7);
+    CHECK(eCos < 3.5e-7);
+    CHECK(eAtan < 2.0e-6);
+    CHECK(eInv < 4.8e-6);
+    CHECK(eBaro < 0.4);
+    CHECK(fastAtan2(0, 0) == 0);
+    CHECK(fastAtan2(0, -1) > 3.14159f);                                    // +PI for y = +0, like atan2
+    return testDone("fast_math");
+}
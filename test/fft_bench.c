@@ -0,0 +1,42 @@
+// fft.c: cost of the vibration analysis, the FFT and the three vibUpdate steps of a capture (an axis pair).
+// Step 1 less step 0 is the split of the spectra (64 x 2 isqrt32) and the peaks of one axis.
+
+#include "test.h"
+#include "fft.c"
+
+static int16_t  capture[2][VIB_N];
+
+static void captureLoad(void)                              // What vibSample leaves: two axes of 2 tones and an offset
+{
+    memcpy(vibBuf, capture, sizeof(vibBuf));
+    vibCount = VIB_N;
+    vibStep  = 0;
+}
+
+int main(void)
+{
+    static volatile int32_t sink;
+    uint16_t                i;
+
+    checkFirstTime(true);
+    vibInit();
+    for (i = 0; i < VIB_N; i++)
+    {
+        capture[0][i] = 512 + 200 * sin(2 * M_PI * 87.3 * i / 500) + 80 * sin(2 * M_PI * 161.1 * i / 500);
+        capture[1][i] = -7 + 40 * sin(2 * M_PI * 44.4 * i / 500);
+    }
+
+    BENCH("fftQ15 128 points", 20000, memcpy(vibBuf, capture, sizeof(vibBuf)); fftQ15(vibBuf[0], vibBuf[1], VIB_LOG2N); sink = vibBuf[0][5]);
+    BENCH("  memcpy of the capture alone", 20000, memcpy(vibBuf, capture, sizeof(vibBuf)); sink = vibBuf[0][5]);
+    BENCH("vibPrepare (one axis)", 20000, memcpy(vibBuf, capture, sizeof(vibBuf)); sink = vibPrepare(vibBuf[0]));
+    captureLoad();
+    vibUpdate();
+    vibSplit();
+    BENCH("vibPeaks (one axis)", 20000, vibPeaks((const uint16_t *)vibBuf[0], vibShift[0], vibSlots[0].peak[0]); sink = vibSlots[0].peak[0][0].freq);
+
+    BENCH("vibUpdate step 0: prepare, FFT", 20000, captureLoad(); vibUpdate(); sink = vibBuf[0][5]);
+    BENCH("vibUpdate step 0 - 1: + split, peaks", 20000, captureLoad(); vibUpdate(); vibUpdate(); sink = vibBuf[0][5]);
+    BENCH("vibUpdate, the 3 steps of a capture", 20000, captureLoad(); vibUpdate(); vibUpdate(); vibUpdate(); vibPair = 0; sink = vibSlots[0].peak[0][0].freq);
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,243 @@
+// fft.c: fftQ15 against a double DFT, and the vibration analyser on synthetic sines through vibSample / vibUpdate as
+// pass() calls them. Every axis of a pair gets its own tone, so what one axis leaks into the other shows.
+
+#include "test.h"
+#include "fft.c"
+
+#define DFT_TOL   0.0011                                    // Of the largest bin
+#define FREQ_TOL  3                                         // 0.1Hz
+#define AMP_TOL   0.04
+#define SAMPLE_HZ (1000000.0 / VIB_SAMPLE_US)
+#define THROTTLE  1400
+
+static double simTime;
+static double toneHz[VIB_AXES], toneAmp[VIB_AXES], tone2Hz, tone2Amp;
+
+static uint32_t rnd(void)
+{
+    static uint32_t s = 12345;
+    s = s * 1664525 + 1013904223;
+    return s >> 8;
+}
+
+// fftQ15 on random complex input at 2^13 - 2^14, as vibPrepare gives it
+static void testFft(void)
+{
+    static int16_t re[VIB_N], im[VIB_N];
+    double         xr[VIB_N], xi[VIB_N], er, ei, err = 0, peak = 0;
+    uint16_t       i, k, n, run;
+
+    for (run = 0; run < 20; run++)
+    {
+        for (i = 0; i < VIB_N; i++)
+        {
+            re[i] = xr[i] = (int16_t)(rnd() % 32768) - 16384;
+            im[i] = xi[i] = run & 1 ? (int16_t)(rnd() % 32768) - 16384 : 0;
+        }
+        if (run == 2)                                        // One complex tone, all in bin 5
+            for (i = 0; i < VIB_N; i++)
+            {
+                re[i] = xr[i] = round(16000 * cos(2 * M_PI * 5 * i / VIB_N));
+                im[i] = xi[i] = round(16000 * sin(2 * M_PI * 5 * i / VIB_N));
+            }
+        fftQ15(re, im, VIB_LOG2N);
+        for (k = 0; k < VIB_N; k++)
+        {
+            for (er = ei = 0, n = 0; n < VIB_N; n++)
+            {
+                er += xr[n] * cos(2 * M_PI * k * n / VIB_N) + xi[n] * sin(2 * M_PI * k * n / VIB_N);
+                ei += xi[n] * cos(2 * M_PI * k * n / VIB_N) - xr[n] * sin(2 * M_PI * k * n / VIB_N);
+            }
+            er  /= VIB_N;
+            ei  /= VIB_N;
+            peak = fmax(peak, hypot(er, ei));
+            err  = fmax(err, hypot(re[k] - er, im[k] - ei));
+        }
+        if (run == 2) CHECK(re[5] > 15990 && abs(re[4]) < 3 && abs(im[6]) < 3);
+    }
+    testLog("fftQ15 %d points: max error %.4f%% of the largest bin\n", VIB_N, 100 * err / peak);
+    CHECK(err / peak < DFT_TOL);
+}
+
+// The analyser
+
+static void sensorsAt(double t)
+{
+    uint8_t axis;
+    double  v;
+
+    for (axis = 0; axis < VIB_AXES; axis++)
+    {
+        v = toneAmp[axis] * sin(2 * M_PI * toneHz[axis] * t + axis);
+        if (!axis) v += tone2Amp * sin(2 * M_PI * tone2Hz * t);
+        if (axis < 3) accADC[axis] = v + (axis == 2 ? 512 : 30);     // Offsets for the mean removal
+        else gyroADC[axis - 3] = v - 7;
+    }
+}
+
+static void passRun(uint32_t samples, uint16_t throttle)   // pass(): sample, then at least one vibUpdate per sample
+{
+    while (samples--)
+    {
+        sensorsAt(simTime);
+        simTime += 1.0 / SAMPLE_HZ;
+        vibSample(throttle);
+        vibUpdate();
+    }
+}
+
+static uint16_t passRound(uint16_t throttle)               // Until the slot of pass_mot has one more result
+{
+    uint16_t captures = vibResult(cfg.pass_mot)->captures, n = 0;
+
+    while (vibResult(cfg.pass_mot)->captures == captures && n++ < 10 * VIB_N) passRun(1, throttle);
+    return n;
+}
+
+static bool peakIs(const vibPeak_t *p, double hz, double amp)
+{
+    return abs(p->freq - (int)round(hz * 10)) <= FREQ_TOL && fabs(p->amp - amp) <= AMP_TOL * amp;
+}
+
+static void testSweep(void)                                // 200 tones 8 - 238Hz, different per axis
+{
+    const vibSlot_t *slot = vibResult(0);
+    double           freqErr = 0, ampErr = 0;
+    uint8_t          axis;
+    uint16_t         run, fails = 0;
+
+    for (run = 0; run < 200; run++)
+    {
+        for (axis = 0; axis < VIB_AXES; axis++)
+        {
+            toneHz[axis]  = 8 + fmod(run * 1.15 + axis * 37.3, 230);
+            toneAmp[axis] = axis < 3 ? 150 + axis * 100 : 20 + axis * 30;
+        }
+        passRound(THROTTLE);
+        for (axis = 0; axis < VIB_AXES; axis++)
+        {
+            freqErr = fmax(freqErr, fabs(slot->peak[axis][0].freq / 10.0 - toneHz[axis]));
+            ampErr  = fmax(ampErr, fabs(slot->peak[axis][0].amp / toneAmp[axis] - 1));
+            if (!peakIs(&slot->peak[axis][0], toneHz[axis], toneAmp[axis]))
+            {
+                if (fails++ < 5) testLog("%s %.2fHz / %.0f: %d.%dHz / %d\n", vibAxisName(axis), toneHz[axis], toneAmp[axis],
+                                         slot->peak[axis][0].freq / 10, slot->peak[axis][0].freq % 10, slot->peak[axis][0].amp);
+            }
+        }
+    }
+    testLog("analyser, 200 x %d tones: frequency within %.2fHz, amplitude within %.1f%%\n", VIB_AXES, freqErr, 100 * ampErr);
+    CHECK(!fails);
+    CHECK(slot->captures >= 200 && slot->throttle == THROTTLE);
+}
+
+static void testPair(void)                                 // Axes of a pair don't show in each other
+{
+    const vibSlot_t *slot = vibResult(0);
+    uint8_t          axis, odd;
+
+    for (odd = 0; odd < 2; odd++)                           // One axis silent: no peaks at all there
+    {
+        for (axis = 0; axis < VIB_AXES; axis++)
+        {
+            toneHz[axis]  = 50 + axis * 31.3;
+            toneAmp[axis] = (axis & 1) == odd ? 3000 : 0;
+        }
+        passRound(THROTTLE);
+        passRound(THROTTLE);
+        for (axis = odd; axis < VIB_AXES; axis += 2)
+        {
+            CHECK(peakIs(&slot->peak[axis][0], toneHz[axis], toneAmp[axis]));
+            CHECK(!slot->peak[axis ^ 1][0].amp);
+        }
+    }
+    for (axis = 0; axis < VIB_AXES; axis++)                 // 3000 next to 25 LSB
+    {
+        toneAmp[axis] = axis & 1 ? 25 : 3000;
+    }
+    passRound(THROTTLE);
+    passRound(THROTTLE);
+    for (axis = 0; axis < VIB_AXES; axis++) CHECK(peakIs(&slot->peak[axis][0], toneHz[axis], toneAmp[axis]));
+}
+
+static void testTwoTones(void)
+{
+    const vibSlot_t *slot = vibResult(0);
+
+    toneHz[0]  = 87.3;
+    toneAmp[0] = 200;
+    tone2Hz    = 161.1;
+    tone2Amp   = 450;
+    passRound(THROTTLE);
+    passRound(THROTTLE);
+    CHECK(peakIs(&slot->peak[0][0], tone2Hz, tone2Amp));    // Strongest first
+    CHECK(peakIs(&slot->peak[0][1], toneHz[0], toneAmp[0]));
+    tone2Amp = 0;
+}
+
+static void testSlots(void)
+{
+    uint16_t captures, n;
+
+    cfg.pass_mot = 3;                                       // A motor gets its own slot, the others stay
+    captures = vibResult(0)->captures;
+    n = passRound(THROTTLE + 100);
+    CHECK(vibResult(3)->captures == 1 && vibResult(3)->throttle == THROTTLE + 100 && vibResult(0)->captures == captures);
+    testLog("one result every %d samples\n", n);
+    CHECK(n <= VIB_N * VIB_AXES / 2 + 10);
+
+    passRun(VIB_N + 10, THROTTLE);                          // Motors off in the middle of a round: starts over
+    passRun(1, cfg.esc_min - 1);
+    n = passRound(THROTTLE);
+    CHECK(vibResult(3)->captures == 2 && n > VIB_N * VIB_AXES / 2);
+
+    passRun(VIB_N + 10, THROTTLE);                          // Motor changed: the new slot gets a whole round
+    cfg.pass_mot = 4;
+    n = passRound(THROTTLE);
+    CHECK(vibResult(4)->captures == 1 && vibResult(3)->captures == 2 && n > VIB_N * VIB_AXES / 2);
+
+    cfg.pass_mot = VIB_SLOTS;                               // No slot, no capture
+    passRun(4 * VIB_N, THROTTLE);
+    CHECK(vibCount == 0);
+    cfg.pass_mot = 0;
+
+    vibClear();
+    CHECK(!vibResult(0)->captures && !vibResult(3)->captures && !vibResult(4)->peak[0][0].amp);
+}
+
+static void testNotRunning(void)                           // Booted into loop(): vibSlots is the blackbox ring, hands off
+{
+    uint8_t  ring[sizeof(vibSlot_t) * VIB_SLOTS];
+    uint16_t i;
+
+    passRound(THROTTLE);
+    vibRunning = false;
+    featureSet(FEATURE_PASS);                               // Set in cli, not running before the reboot
+    for (i = 0; i < sizeof(ring); i++) ring[i] = i * 7;
+    memcpy(vibSlots, ring, sizeof(ring));                   // What the blackbox has in there
+    CHECK(!vibResult(0)->captures && !vibResult(0)->peak[0][0].amp);
+    vibClear();
+    passRun(2 * VIB_N * VIB_AXES, THROTTLE);
+    CHECK(vibCount == 0 && !memcmp(vibSlots, ring, sizeof(ring)));
+    CHECK(sizeof(vibSlot_t) * VIB_SLOTS <= FLASH_PAGE_SIZE); // The union doesn't grow the ring (BB_RING_SIZE)
+
+    vibInit();
+    CHECK(!vibResult(0)->captures);
+    passRound(THROTTLE);
+    CHECK(vibResult(0)->captures == 1);
+}
+
+int main(void)
+{
+    checkFirstTime(true);
+    vibInit();
+    cfg.esc_min  = 1150;
+    cfg.pass_mot = 0;
+
+    testFft();
+    testSweep();
+    testPair();
+    testTwoTones();
+    testSlots();
+    testNotRunning();
+    return testDone("fft");
+}
@@ -0,0 +1,35 @@
+// imu.c: cost of one attitude update, quaternion (imu_mode 1) against the EstG / EstM rotation (imu_mode 0)
+
+#include "test.h"
+#include "imu.c"
+
+int main(void)
+{
+    static volatile float sink;
+    float                 delta[3] = { 0.0012f, -0.0007f, 0.0021f };     // About 25 / 15 / 40 deg/s at 3ms
+    t_fp_vector           EstM = { { 300.0f, 0.0f, 400.0f } }, G, M;
+
+    checkFirstTime(true);
+    imuInit();                                                           // Before the mag is on, there is no mag driver to init
+    sensorsSet(SENSOR_ACC | SENSOR_MAG);
+    cfg.mag_calibrated = 1;
+    accADC[2]          = accSmooth[2] = acc_1G;
+    magADCfloat[0]     = 300.0f;
+    magADCfloat[2]     = 400.0f;
+    EstG.V.Z           = acc_1G;
+    ACCDeltaTimeINS    = 0.003f;
+    GyroDelta[0]       = delta[0];                                       // gy_fifo style input, so getEstimatedAttitude really turns
+    GyroDelta[1]       = delta[1];
+    GyroDelta[2]       = delta[2];
+    GyroDeltaValid     = true;
+
+    BENCH("quaternionUpdate (acc + mag)", 100000, quaternionUpdate(delta, true, &EstM); sink = EstG.V.Z);
+    BENCH("quaternionUpdate (gyro only)", 100000, quaternionUpdate(delta, false, &EstM); sink = EstG.V.Z);
+    BENCH("rotateV EstG + EstM", 100000, G = EstG; M = EstM; rotateV(&G.V, delta); rotateV(&M.V, delta); sink = G.V.Z + M.V.Z); // Unfiltered repeats would drift off
+    cfg.imu_mode = 0;
+    BENCH("getEstimatedAttitude imu_mode 0", 100000, getEstimatedAttitude(); sink = angle[0]);
+    cfg.imu_mode = 1;
+    BENCH("getEstimatedAttitude imu_mode 1", 100000, getEstimatedAttitude(); sink = angle[0]);
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,31 @@
+// mw.c / mixer.c: cost of one computePID + mixTable on the recorded flight of mw_sequence.h, per controller and mode.
+// Run for the float and the OPTIONS=FIXEDPOINT build (FIXEDPOINT_TESTS in the Makefile).
+
+#include "test.h"
+#include "mw.c"
+#include "mw_replay.h"
+
+int main(void)
+{
+    static volatile int16_t sink;
+    char                    name[48];
+    uint32_t                r, n = 0;
+
+    checkFirstTime(true);
+    NumberOfMotors = mixerInit();
+    newpidimax     = itor(cfg.newpidimax);
+    f.ARMED        = 1;
+
+    for (r = 0; r < PID_RUNS; r++)
+    {
+        pidReset(r);
+#ifdef FIXEDPOINT
+        snprintf(name, sizeof(name), "%s FIXEDPOINT", pidRuns[r].name);
+#else
+        snprintf(name, sizeof(name), "%s", pidRuns[r].name);
+#endif
+        BENCH(name, 30000, pidStep(&pidSequence[n]); n = (n + 1) % PID_SAMPLES; sink = motor[0]);
+    }
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+// The recorded flight of mw_sequence.h and its replay through mw.c, for mw_test.c and mw_bench.c.
+// Include after mw.c.
+
+#define PID_RUNS       5
+
+typedef struct
+{
+    uint16_t cycleTime;
+    int16_t  rcData[4];
+    int16_t  rcCommand[4];
+    float    gyroData[3];
+    float    angle[2];
+    int16_t  motor[PID_RUNS][4];                            // Float build, one set per entry of pidRuns
+} pidSample_t;
+
+#include "mw_sequence.h"
+
+#define PID_SAMPLES (sizeof(pidSequence) / sizeof(pidSequence[0]))
+
+static const struct
+{
+    uint8_t    ctrl;                                        // cfg.mainpidctrl
+    uint8_t    mode;                                        // 0 acro, 1 ANGLE, 2 HORIZON
+    const char *name;
+} pidRuns[PID_RUNS] =
+{
+    { 0, 1, "mainpidctrl 0 angle"   },
+    { 0, 2, "mainpidctrl 0 horizon" },
+    { 0, 0, "mainpidctrl 0 acro"    },
+    { 1, 1, "mainpidctrl 1 angle"   },
+    { 1, 0, "mainpidctrl 1 acro"    },
+};
+
+static void pidReset(uint8_t r)                             // Controller state as after boot, the run's mode
+{
+    memset(lastGyro, 0, sizeof(lastGyro));
+    memset(delta1, 0, sizeof(delta1));
+    memset(delta2, 0, sizeof(delta2));
+    memset(errorGyroI, 0, sizeof(errorGyroI));
+    memset(errorAngleI, 0, sizeof(errorAngleI));
+    memset(lastError, 0, sizeof(lastError));
+    rbiquad3Lowpass(&DTermLpf, cfg.maindcut, 1000000.0f / cfg.looptime);
+    cfg.mainpidctrl = pidRuns[r].ctrl;
+    f.ANGLE_MODE    = pidRuns[r].mode == 1;
+    f.HORIZON_MODE  = pidRuns[r].mode == 2;
+}
+
+static void pidStep(const pidSample_t *s)                  // taskRC's stick processing, then taskControl's PID and mixer
+{
+    uint8_t i;
+
+    for (i = 0; i < 4; i++) rcData[i] = s->rcData[i];
+    DoThrcmmd_DynPid();
+    for (i = 0; i < 4; i++) rcCommand[i] = s->rcCommand[i]; // As recorded, after althold & co
+    for (i = 0; i < 3; i++) gyroData[i] = s->gyroData[i];
+    angle[ROLL]  = s->angle[ROLL];
+    angle[PITCH] = s->angle[PITCH];
+    cycleTime    = s->cycleTime;
+    computePID();
+    mixTable();
+}
@@ -0,0 +1,308 @@
+// Recorded sequence for test/mw_test.c, 300 consecutive taskControl inputs (looptime 3000).
+// Recorded in SITL in ANGLE mode during the hover, with a roll stick sine, pitch and yaw stick steps,
+// by printing the inputs of computePID. The motor columns are the outputs of the float build for each
+// entry of pidRuns in mw_test.c: obj/test/float/mw_test -g > test/mw_sequence.h rewrites them.
+
+static const pidSample_t pidSequence[] =
+{
+    { 2994, { 1254, 1698, 1648, 1517 }, { -62, 45, 128, 1553 }, { -166.281, -6.774, 189.106 }, { -59.6, 103.9 }, { { 1523, 1509, 1571, 1609 }, { 1531, 1505, 1575, 1601 }, { 1591, 1469, 1611, 1541 }, { 1567, 1501, 1529, 1615 }, { 1598, 1468, 1562, 1584 } } },
+    { 3000, { 1254, 1698, 1648, 1517 }, { -62, 45, 128, 1553 }, { -165.781, -6.274, 189.106 }, { -61.0, 103.6 }, { { 1502, 1486, 1592, 1632 }, { 1510, 1482, 1596, 1624 }, { 1571, 1445, 1633, 1563 }, { 1560, 1496, 1532, 1624 }, { 1600, 1454, 1574, 1584 } } },
+    { 3000, { 1254, 1698, 1648, 1517 }, { -62, 45, 128, 1553 }, { -164.781, -6.024, 187.606 }, { -62.4, 103.4 }, { { 1472, 1456, 1624, 1660 }, { 1479, 1451, 1629, 1653 }, { 1542, 1414, 1666, 1590 }, { 1550, 1490, 1538, 1634 }, { 1604, 1436, 1592, 1580 } } },
+    { 3007, { 1254, 1698, 1648, 1517 }, { -62, 45, 128, 1553 }, { -162.281, -5.274, 188.106 }, { -63.8, 103.1 }, { { 1453, 1435, 1645, 1679 }, { 1460, 1430, 1650, 1672 }, { 1524, 1394, 1686, 1608 }, { 1544, 1484, 1542, 1642 }, { 1607, 1423, 1603, 1579 } } },
+    { 3000, { 1254, 1698, 1648, 1517 }, { -62, 45, 128, 1553 }, { -161.531, -5.774, 188.856 }, { -65.1, 102.8 }, { { 1456, 1436, 1642, 1678 }, { 1464, 1432, 1646, 1670 }, { 1527, 1395, 1683, 1607 }, { 1545, 1483, 1541, 1643 }, { 1609, 1423, 1601, 1579 } } },
+    { 3007, { 1254, 1698, 1648, 1517 }, { -62, 45, 128, 1553 }, { -160.531, -5.524, 187.606 }, { -66.5, 102.5 }, { { 1473, 1457, 1623, 1659 }, { 1481, 1453, 1627, 1651 }, { 1545, 1417, 1663, 1587 }, { 1549, 1485, 1539, 1639 }, { 1608, 1434, 1590, 1580 } } },
+    { 2987, { 1254, 1698, 1648, 1517 }, { -62, 45, 128, 1553 }, { -158.281, -5.274, 188.106 }, { -67.8, 102.2 }, { { 1494, 1480, 1600, 1638 }, { 1503, 1475, 1605, 1629 }, { 1568, 1440, 1640, 1564 }, { 1557, 1487, 1535, 1633 }, { 1608, 1446, 1576, 1582 } } },
+    { 3000, { 1254, 1698, 1648, 1517 }, { -62, 45, 128, 1553 }, { -156.781, -5.024, 188.106 }, { -69.1, 101.9 }, { { 1513, 1499, 1581, 1619 }, { 1521, 1495, 1585, 1611 }, { 1587, 1461, 1619, 1545 }, { 1562, 1490, 1532, 1628 }, { 1608, 1458, 1564, 1582 } } },
+    { 3000, { 1258, 1698, 1648, 1517 }, { -60, 45, 128, 1553 }, { -155.531, -4.774, 187.106 }, { -70.5, 101.7 }, { { 1522, 1510, 1570, 1610 }, { 1531, 1505, 1575, 1601 }, { 1598, 1472, 1608, 1534 }, { 1563, 1489, 1533, 1627 }, { 1606, 1464, 1558, 1584 } } },
+    { 3014, { 1258, 1698, 1648, 1517 }, { -60, 45, 128, 1553 }, { -154.031, -4.524, 187.356 }, { -71.8, 101.4 }, { { 1529, 1517, 1563, 1603 }, { 1538, 1512, 1568, 1594 }, { 1606, 1480, 1600, 1526 }, { 1565, 1487, 1533, 1627 }, { 1607, 1467, 1553, 1585 } } },
+    { 3000, { 1258, 1698, 1648, 1517 }, { -60, 45, 128, 1553 }, { -151.781, -4.524, 187.606 }, { -73.0, 101.1 }, { { 1533, 1521, 1559, 1599 }, { 1542, 1516, 1564, 1590 }, { 1610, 1484, 1596, 1522 }, { 1566, 1486, 1532, 1628 }, { 1609, 1467, 1551, 1585 } } },
+    { 3000, { 1258, 1698, 1648, 1517 }, { -60, 45, 128, 1553 }, { -150.281, -4.024, 187.356 }, { -74.3, 100.8 }, { { 1533, 1521, 1559, 1599 }, { 1543, 1517, 1563, 1589 }, { 1611, 1485, 1595, 1521 }, { 1565, 1485, 1533, 1629 }, { 1609, 1467, 1551, 1585 } } },
+    { 3058, { 1258, 1698, 1648, 1517 }, { -60, 45, 128, 1553 }, { -149.031, -2.774, 187.356 }, { -75.6, 100.5 }, { { 1533, 1521, 1559, 1599 }, { 1542, 1516, 1564, 1590 }, { 1611, 1485, 1595, 1521 }, { 1566, 1484, 1532, 1630 }, { 1610, 1466, 1550, 1586 } } },
+    { 2940, { 1258, 1698, 1648, 1517 }, { -60, 45, 128, 1553 }, { -147.281, -2.024, 187.106 }, { -76.8, 100.2 }, { { 1531, 1521, 1559, 1601 }, { 1540, 1516, 1564, 1592 }, { 1611, 1485, 1595, 1521 }, { 1565, 1483, 1531, 1633 }, { 1611, 1465, 1549, 1587 } } },
+    { 2987, { 1258, 1698, 1648, 1517 }, { -60, 45, 128, 1553 }, { -145.281, -4.024, 186.356 }, { -78.0, 100.0 }, { { 1531, 1519, 1561, 1601 }, { 1541, 1515, 1565, 1591 }, { 1612, 1484, 1596, 1520 }, { 1566, 1482, 1532, 1632 }, { 1613, 1463, 1551, 1585 } } },
+    { 3000, { 1266, 1615, 1648, 1517 }, { -57, 21, 128, 1553 }, { -142.781, -3.274, 185.606 }, { -79.2, 99.7 }, { { 1489, 1551, 1531, 1641 }, { 1500, 1546, 1536, 1630 }, { 1584, 1506, 1576, 1546 }, { 1536, 1506, 1508, 1662 }, { 1599, 1475, 1539, 1599 } } },
+    { 3007, { 1266, 1615, 1648, 1517 }, { -57, 21, 128, 1553 }, { -141.031, -2.774, 186.606 }, { -80.4, 99.4 }, { { 1490, 1550, 1530, 1642 }, { 1501, 1545, 1535, 1631 }, { 1586, 1506, 1574, 1546 }, { 1528, 1512, 1500, 1672 }, { 1597, 1477, 1535, 1603 } } },
+    { 3000, { 1266, 1615, 1648, 1517 }, { -57, 21, 128, 1553 }, { -138.281, -3.024, 185.356 }, { -81.6, 99.1 }, { { 1489, 1551, 1531, 1641 }, { 1500, 1546, 1536, 1630 }, { 1587, 1507, 1575, 1543 }, { 1517, 1521, 1491, 1683 }, { 1592, 1482, 1530, 1608 } } },
+    { 3000, { 1266, 1615, 1648, 1517 }, { -57, 21, 128, 1553 }, { -135.781, -5.024, 186.606 }, { -82.7, 98.8 }, { { 1492, 1550, 1530, 1640 }, { 1503, 1545, 1535, 1629 }, { 1590, 1506, 1574, 1542 }, { 1511, 1525, 1485, 1691 }, { 1592, 1484, 1526, 1610 } } },
+    { 2994, { 1266, 1615, 1648, 1517 }, { -57, 21, 128, 1553 }, { -134.281, -7.274, 185.356 }, { -83.8, 98.4 }, { { 1493, 1549, 1533, 1637 }, { 1505, 1545, 1537, 1625 }, { 1592, 1506, 1576, 1538 }, { 1513, 1523, 1485, 1691 }, { 1594, 1482, 1526, 1610 } } },
+    { 3000, { 1266, 1615, 1648, 1517 }, { -57, 21, 128, 1553 }, { -130.531, -10.524, 185.606 }, { -84.9, 98.1 }, { { 1498, 1548, 1532, 1634 }, { 1509, 1543, 1537, 1623 }, { 1597, 1505, 1575, 1535 }, { 1522, 1516, 1492, 1682 }, { 1601, 1479, 1529, 1603 } } },
+    { 3000, { 1276, 1527, 1648, 1517 }, { -53, 1, 128, 1553 }, { -128.531, -15.524, 185.106 }, { -86.0, 97.7 }, { { 1465, 1569, 1513, 1665 }, { 1477, 1565, 1517, 1653 }, { 1577, 1519, 1563, 1553 }, { 1506, 1524, 1482, 1700 }, { 1596, 1482, 1524, 1610 } } },
+    { 3007, { 1276, 1527, 1648, 1517 }, { -53, 1, 128, 1553 }, { -125.781, -21.524, 186.106 }, { -87.1, 97.3 }, { { 1471, 1565, 1515, 1661 }, { 1484, 1560, 1520, 1648 }, { 1585, 1515, 1565, 1547 }, { 1509, 1521, 1483, 1699 }, { 1600, 1478, 1526, 1608 } } },
+    { 3007, { 1276, 1527, 1648, 1517 }, { -53, 1, 128, 1553 }, { -123.531, -28.024, 184.606 }, { -88.1, 96.8 }, { { 1476, 1562, 1520, 1654 }, { 1488, 1556, 1526, 1642 }, { 1590, 1512, 1570, 1540 }, { 1507, 1521, 1483, 1701 }, { 1602, 1476, 1528, 1606 } } },
+    { 3000, { 1276, 1527, 1648, 1517 }, { -53, 1, 128, 1553 }, { -119.031, -35.524, 184.856 }, { -89.1, 96.2 }, { { 1483, 1557, 1525, 1647 }, { 1496, 1552, 1530, 1634 }, { 1598, 1508, 1574, 1532 }, { 1506, 1520, 1484, 1702 }, { 1605, 1475, 1529, 1603 } } },
+    { 2987, { 1276, 1527, 1648, 1517 }, { -53, 1, 128, 1553 }, { -117.281, -45.024, 183.856 }, { -90.1, 95.6 }, { { 1491, 1551, 1531, 1639 }, { 1503, 1545, 1537, 1627 }, { 1605, 1501, 1581, 1525 }, { 1513, 1513, 1489, 1697 }, { 1612, 1470, 1532, 1598 } } },
+    { 3000, { 1276, 1527, 1648, 1517 }, { -53, 1, 128, 1553 }, { -113.781, -55.274, 183.606 }, { -91.1, 94.9 }, { { 1499, 1545, 1537, 1631 }, { 1512, 1540, 1542, 1618 }, { 1615, 1495, 1587, 1515 }, { 1524, 1504, 1498, 1686 }, { 1621, 1463, 1539, 1589 } } },
+    { 3000, { 1276, 1527, 1648, 1517 }, { -53, 1, 128, 1553 }, { -111.281, -65.024, 185.356 }, { -92.0, 94.2 }, { { 1508, 1538, 1542, 1624 }, { 1520, 1532, 1548, 1612 }, { 1625, 1489, 1591, 1507 }, { 1537, 1495, 1505, 1675 }, { 1632, 1456, 1544, 1580 } } },
+    { 2994, { 1289, 1440, 1648, 1517 }, { -49, -9, 128, 1553 }, { -108.531, -75.274, 184.606 }, { -92.9, 93.3 }, { { 1496, 1540, 1540, 1636 }, { 1507, 1535, 1545, 1625 }, { 1619, 1489, 1591, 1513 }, { 1533, 1491, 1507, 1681 }, { 1634, 1452, 1546, 1580 } } },
+    { 3000, { 1289, 1440, 1648, 1517 }, { -49, -9, 128, 1553 }, { -105.281, -85.274, 183.356 }, { -93.8, 92.4 }, { { 1501, 1535, 1547, 1629 }, { 1514, 1530, 1552, 1616 }, { 1627, 1485, 1597, 1503 }, { 1537, 1487, 1511, 1677 }, { 1638, 1448, 1550, 1576 } } },
+    { 3000, { 1289, 1440, 1648, 1517 }, { -49, -9, 128, 1553 }, { -102.281, -96.024, 184.106 }, { -94.6, 91.5 }, { { 1509, 1529, 1553, 1621 }, { 1521, 1525, 1557, 1609 }, { 1635, 1479, 1603, 1495 }, { 1538, 1482, 1514, 1678 }, { 1642, 1444, 1552, 1574 } } },
+    { 3007, { 1289, 1440, 1648, 1517 }, { -49, -9, 128, 1553 }, { -99.031, -106.024, 183.606 }, { -95.5, 90.4 }, { { 1516, 1524, 1558, 1614 }, { 1528, 1520, 1562, 1602 }, { 1643, 1475, 1607, 1487 }, { 1539, 1481, 1515, 1677 }, { 1646, 1442, 1554, 1570 } } },
+    { 3000, { 1289, 1440, 1648, 1517 }, { -49, -9, 128, 1553 }, { -95.531, -116.274, 182.856 }, { -96.2, 89.3 }, { { 1522, 1520, 1562, 1608 }, { 1535, 1515, 1567, 1595 }, { 1649, 1471, 1611, 1481 }, { 1544, 1476, 1520, 1672 }, { 1651, 1439, 1557, 1565 } } },
+    { 3007, { 1289, 1440, 1648, 1517 }, { -49, -9, 128, 1553 }, { -92.281, -125.524, 183.856 }, { -97.0, 88.1 }, { { 1529, 1517, 1565, 1601 }, { 1541, 1513, 1569, 1589 }, { 1656, 1468, 1614, 1474 }, { 1551, 1471, 1523, 1667 }, { 1658, 1434, 1560, 1560 } } },
+    { 2987, { 1289, 1440, 1648, 1517 }, { -49, -9, 128, 1553 }, { -88.781, -134.274, 183.356 }, { -97.7, 86.8 }, { { 1534, 1514, 1568, 1596 }, { 1546, 1510, 1572, 1584 }, { 1663, 1465, 1617, 1467 }, { 1560, 1466, 1526, 1660 }, { 1665, 1431, 1561, 1555 } } },
+    { 3000, { 1305, 1352, 1648, 1517 }, { -44, -31, 128, 1553 }, { -85.531, -142.524, 182.106 }, { -98.4, 85.5 }, { { 1498, 1538, 1546, 1630 }, { 1510, 1532, 1552, 1618 }, { 1640, 1482, 1602, 1488 }, { 1537, 1481, 1511, 1683 }, { 1656, 1438, 1554, 1564 } } },
+    { 3000, { 1305, 1352, 1648, 1517 }, { -44, -31, 128, 1553 }, { -83.531, -148.024, 182.856 }, { -99.1, 84.1 }, { { 1501, 1535, 1547, 1629 }, { 1514, 1530, 1552, 1616 }, { 1644, 1480, 1602, 1486 }, { 1533, 1483, 1507, 1689 }, { 1656, 1438, 1552, 1566 } } },
+    { 3014, { 1305, 1352, 1648, 1517 }, { -44, -31, 128, 1553 }, { -79.531, -155.274, 182.356 }, { -99.8, 82.7 }, { { 1503, 1535, 1549, 1625 }, { 1516, 1530, 1554, 1612 }, { 1648, 1480, 1604, 1480 }, { 1524, 1488, 1502, 1698 }, { 1654, 1440, 1550, 1568 } } },
+    { 3000, { 1305, 1352, 1648, 1517 }, { -44, -31, 128, 1553 }, { -76.531, -161.524, 182.606 }, { -100.4, 81.3 }, { { 1507, 1533, 1549, 1623 }, { 1520, 1528, 1554, 1610 }, { 1651, 1479, 1603, 1479 }, { 1520, 1490, 1498, 1704 }, { 1653, 1441, 1547, 1571 } } },
+    { 3000, { 1305, 1352, 1648, 1517 }, { -44, -31, 128, 1553 }, { -73.031, -168.024, 182.106 }, { -101.0, 79.8 }, { { 1509, 1533, 1551, 1619 }, { 1522, 1528, 1556, 1606 }, { 1654, 1480, 1604, 1474 }, { 1522, 1488, 1500, 1702 }, { 1656, 1440, 1548, 1568 } } },
+    { 3058, { 1305, 1352, 1648, 1517 }, { -44, -31, 128, 1553 }, { -70.031, -175.774, 182.856 }, { -101.5, 78.2 }, { { 1514, 1530, 1552, 1616 }, { 1527, 1525, 1557, 1603 }, { 1659, 1477, 1605, 1471 }, { 1532, 1482, 1504, 1694 }, { 1664, 1436, 1550, 1562 } } },
+    { 2940, { 1322, 1352, 1648, 1517 }, { -39, -31, 128, 1553 }, { -66.781, -181.524, 181.106 }, { -102.1, 76.6 }, { { 1510, 1522, 1562, 1618 }, { 1522, 1518, 1566, 1606 }, { 1658, 1472, 1612, 1470 }, { 1536, 1470, 1516, 1690 }, { 1668, 1430, 1556, 1558 } } },
+    { 2987, { 1322, 1352, 1648, 1517 }, { -39, -31, 128, 1553 }, { -64.031, -188.774, 182.356 }, { -102.6, 75.0 }, { { 1515, 1517, 1565, 1615 }, { 1526, 1514, 1568, 1604 }, { 1663, 1469, 1613, 1467 }, { 1546, 1460, 1524, 1682 }, { 1675, 1425, 1559, 1553 } } },
+    { 3000, { 1322, 1352, 1648, 1517 }, { -39, -31, 128, 1553 }, { -61.531, -194.524, 181.606 }, { -103.0, 73.3 }, { { 1518, 1516, 1568, 1610 }, { 1530, 1512, 1572, 1598 }, { 1668, 1468, 1616, 1460 }, { 1551, 1453, 1531, 1677 }, { 1680, 1420, 1564, 1548 } } },
+    { 3007, { 1322, 1352, 1648, 1517 }, { -39, -31, 128, 1553 }, { -57.531, -199.774, 181.606 }, { -103.5, 71.5 }, { { 1522, 1514, 1570, 1606 }, { 1533, 1511, 1573, 1595 }, { 1671, 1467, 1617, 1457 }, { 1555, 1447, 1535, 1675 }, { 1684, 1416, 1566, 1546 } } },
+    { 3000, { 1322, 1352, 1648, 1517 }, { -39, -31, 128, 1553 }, { -54.531, -206.024, 182.606 }, { -103.9, 69.8 }, { { 1527, 1511, 1571, 1603 }, { 1538, 1508, 1574, 1592 }, { 1678, 1464, 1618, 1452 }, { 1560, 1442, 1538, 1672 }, { 1689, 1413, 1567, 1543 } } },
+    { 3000, { 1322, 1352, 1648, 1517 }, { -39, -31, 128, 1553 }, { -51.281, -211.274, 181.856 }, { -104.3, 68.0 }, { { 1531, 1509, 1573, 1599 }, { 1543, 1507, 1575, 1587 }, { 1682, 1464, 1618, 1448 }, { 1564, 1442, 1538, 1668 }, { 1693, 1413, 1567, 1539 } } },
+    { 2994, { 1322, 1352, 1648, 1517 }, { -39, -31, 128, 1553 }, { -46.781, -215.524, 181.856 }, { -104.7, 66.1 }, { { 1534, 1510, 1572, 1596 }, { 1547, 1507, 1575, 1583 }, { 1686, 1464, 1618, 1444 }, { 1569, 1441, 1537, 1665 }, { 1697, 1411, 1567, 1537 } } },
+    { 3000, { 1342, 1352, 1648, 1517 }, { -34, -31, 128, 1553 }, { -44.031, -218.274, 181.856 }, { -105.0, 64.3 }, { { 1530, 1502, 1580, 1600 }, { 1541, 1499, 1583, 1589 }, { 1685, 1459, 1623, 1445 }, { 1566, 1438, 1540, 1668 }, { 1697, 1409, 1569, 1537 } } },
+    { 3000, { 1342, 1352, 1648, 1517 }, { -34, -31, 128, 1553 }, { -39.781, -223.024, 181.106 }, { -105.3, 62.4 }, { { 1533, 1503, 1581, 1595 }, { 1544, 1500, 1584, 1584 }, { 1688, 1460, 1624, 1440 }, { 1568, 1436, 1540, 1668 }, { 1702, 1408, 1568, 1534 } } },
+    { 3007, { 1342, 1352, 1648, 1517 }, { -34, -31, 128, 1553 }, { -36.781, -225.024, 180.606 }, { -105.6, 60.5 }, { { 1535, 1503, 1581, 1593 }, { 1545, 1501, 1583, 1583 }, { 1690, 1462, 1622, 1438 }, { 1567, 1433, 1543, 1669 }, { 1702, 1408, 1568, 1534 } } },
+    { 3007, { 1342, 1352, 1648, 1517 }, { -34, -31, 128, 1553 }, { -33.031, -227.274, 180.356 }, { -105.8, 58.6 }, { { 1537, 1505, 1579, 1591 }, { 1548, 1502, 1582, 1580 }, { 1692, 1464, 1620, 1436 }, { 1569, 1431, 1543, 1669 }, { 1705, 1407, 1567, 1533 } } },
+    { 3000, { 1342, 1352, 1648, 1517 }, { -34, -31, 128, 1553 }, { -29.281, -228.024, 180.106 }, { -106.0, 56.7 }, { { 1538, 1506, 1578, 1590 }, { 1549, 1503, 1581, 1579 }, { 1694, 1466, 1618, 1434 }, { 1571, 1431, 1543, 1667 }, { 1706, 1408, 1566, 1532 } } },
+    { 2987, { 1342, 1352, 1648, 1517 }, { -34, -31, 128, 1553 }, { -26.781, -228.274, 180.356 }, { -106.2, 54.7 }, { { 1539, 1507, 1577, 1589 }, { 1550, 1504, 1580, 1578 }, { 1694, 1468, 1616, 1434 }, { 1573, 1431, 1541, 1667 }, { 1708, 1408, 1564, 1532 } } },
+    { 3000, { 1342, 1352, 1648, 1517 }, { -34, -31, 128, 1553 }, { -22.531, -228.274, 179.856 }, { -106.4, 52.8 }, { { 1540, 1510, 1574, 1588 }, { 1551, 1507, 1577, 1577 }, { 1696, 1470, 1614, 1432 }, { 1575, 1433, 1539, 1665 }, { 1711, 1411, 1561, 1529 } } },
+    { 3000, { 1363, 1352, 1648, 1517 }, { -27, -31, 128, 1553 }, { -20.031, -226.524, 180.106 }, { -106.5, 50.9 }, { { 1529, 1501, 1583, 1599 }, { 1539, 1499, 1585, 1589 }, { 1689, 1467, 1617, 1439 }, { 1570, 1426, 1544, 1672 }, { 1708, 1408, 1562, 1534 } } },
+    { 3014, { 1363, 1352, 1648, 1517 }, { -27, -31, 128, 1553 }, { -15.531, -226.024, 178.856 }, { -106.6, 49.0 }, { { 1529, 1505, 1581, 1597 }, { 1538, 1502, 1584, 1588 }, { 1688, 1472, 1614, 1438 }, { 1569, 1425, 1545, 1673 }, { 1709, 1409, 1561, 1533 } } },
+    { 3000, { 1363, 1352, 1648, 1517 }, { -27, -31, 128, 1553 }, { -12.281, -225.274, 181.106 }, { -106.7, 47.1 }, { { 1531, 1505, 1577, 1599 }, { 1541, 1503, 1579, 1589 }, { 1690, 1472, 1610, 1440 }, { 1567, 1423, 1545, 1677 }, { 1710, 1408, 1560, 1534 } } },
+    { 3000, { 1363, 1352, 1648, 1517 }, { -27, -31, 128, 1553 }, { -10.281, -223.774, 180.106 }, { -106.7, 45.3 }, { { 1529, 1507, 1577, 1599 }, { 1539, 1505, 1579, 1589 }, { 1690, 1476, 1608, 1438 }, { 1566, 1422, 1546, 1678 }, { 1710, 1408, 1560, 1534 } } },
+    { 2987, { 1363, 1352, 1648, 1517 }, { -27, -31, 128, 1553 }, { -7.031, -222.524, 179.606 }, { -106.7, 43.4 }, { { 1531, 1509, 1575, 1597 }, { 1540, 1508, 1576, 1588 }, { 1690, 1478, 1606, 1438 }, { 1568, 1420, 1546, 1678 }, { 1712, 1408, 1558, 1534 } } },
+    { 3000, { 1363, 1352, 1648, 1517 }, { -27, -31, 128, 1553 }, { -3.781, -220.274, 179.356 }, { -106.7, 41.6 }, { { 1532, 1510, 1574, 1596 }, { 1541, 1509, 1575, 1587 }, { 1691, 1481, 1603, 1437 }, { 1570, 1422, 1544, 1676 }, { 1713, 1411, 1555, 1533 } } },
+    { 3007, { 1385, 1352, 1648, 1517 }, { -21, -31, 128, 1553 }, { 0.719, -218.524, 178.606 }, { -106.7, 39.7 }, { { 1522, 1504, 1582, 1604 }, { 1532, 1504, 1582, 1594 }, { 1686, 1478, 1608, 1440 }, { 1567, 1419, 1547, 1679 }, { 1712, 1410, 1556, 1534 } } },
+    { 3007, { 1385, 1352, 1648, 1517 }, { -21, -31, 128, 1553 }, { 2.969, -216.774, 178.606 }, { -106.6, 37.9 }, { { 1523, 1505, 1581, 1603 }, { 1532, 1504, 1582, 1594 }, { 1686, 1480, 1606, 1440 }, { 1568, 1418, 1546, 1680 }, { 1715, 1409, 1555, 1533 } } },
+    { 3000, { 1385, 1352, 1648, 1517 }, { -21, -31, 128, 1553 }, { 6.719, -214.274, 178.856 }, { -106.5, 36.1 }, { { 1524, 1508, 1578, 1602 }, { 1533, 1507, 1579, 1593 }, { 1687, 1483, 1603, 1439 }, { 1569, 1415, 1547, 1681 }, { 1715, 1409, 1553, 1535 } } },
+    { 3000, { 1385, 1352, 1648, 1517 }, { -21, -31, 128, 1553 }, { 9.969, -213.024, 179.356 }, { -106.4, 34.3 }, { { 1526, 1508, 1576, 1602 }, { 1536, 1508, 1576, 1592 }, { 1689, 1485, 1599, 1439 }, { 1570, 1414, 1546, 1682 }, { 1718, 1408, 1552, 1534 } } },
+    { 2994, { 1385, 1352, 1648, 1517 }, { -21, -31, 128, 1553 }, { 14.969, -210.524, 179.106 }, { -106.3, 32.6 }, { { 1528, 1510, 1574, 1600 }, { 1537, 1511, 1573, 1591 }, { 1692, 1488, 1596, 1436 }, { 1571, 1415, 1545, 1681 }, { 1720, 1410, 1550, 1532 } } },
+    { 3000, { 1385, 1352, 1648, 1517 }, { -21, -31, 128, 1553 }, { 17.719, -208.274, 179.356 }, { -106.1, 30.8 }, { { 1529, 1513, 1571, 1599 }, { 1538, 1512, 1572, 1590 }, { 1692, 1490, 1594, 1436 }, { 1576, 1416, 1542, 1678 }, { 1723, 1411, 1547, 1531 } } },
+    { 3000, { 1385, 1352, 1648, 1517 }, { -21, -31, 128, 1553 }, { 22.469, -205.524, 179.106 }, { -105.9, 29.1 }, { { 1531, 1515, 1569, 1597 }, { 1540, 1516, 1568, 1588 }, { 1694, 1494, 1590, 1434 }, { 1579, 1419, 1539, 1675 }, { 1726, 1414, 1544, 1528 } } },
+    { 3007, { 1409, 1352, 1648, 1517 }, { -16, -31, 128, 1553 }, { 27.469, -203.274, 179.356 }, { -105.6, 27.4 }, { { 1525, 1511, 1573, 1603 }, { 1535, 1511, 1573, 1593 }, { 1691, 1493, 1591, 1437 }, { 1577, 1415, 1541, 1679 }, { 1727, 1413, 1543, 1529 } } },
+    { 3000, { 1409, 1352, 1648, 1517 }, { -16, -31, 128, 1553 }, { 29.969, -202.024, 179.356 }, { -105.3, 25.7 }, { { 1527, 1513, 1571, 1601 }, { 1536, 1512, 1572, 1592 }, { 1693, 1495, 1589, 1435 }, { 1578, 1414, 1542, 1678 }, { 1728, 1414, 1542, 1528 } } },
+    { 2987, { 1409, 1352, 1648, 1517 }, { -16, -31, 128, 1553 }, { 33.219, -199.524, 177.856 }, { -105.0, 24.0 }, { { 1527, 1515, 1571, 1599 }, { 1537, 1515, 1571, 1589 }, { 1693, 1499, 1587, 1433 }, { 1578, 1414, 1542, 1678 }, { 1729, 1415, 1541, 1527 } } },
+    { 3009, { 1409, 1352, 1648, 1517 }, { -16, -31, 128, 1553 }, { 36.469, -199.024, 178.106 }, { -104.7, 22.3 }, { { 1530, 1516, 1570, 1596 }, { 1538, 1516, 1570, 1588 }, { 1696, 1500, 1586, 1430 }, { 1579, 1411, 1543, 1679 }, { 1731, 1413, 1541, 1527 } } },
+    { 2989, { 1409, 1352, 1648, 1517 }, { -16, -31, 128, 1553 }, { 41.719, -196.524, 178.356 }, { -104.3, 20.7 }, { { 1532, 1518, 1568, 1594 }, { 1540, 1518, 1568, 1586 }, { 1697, 1503, 1583, 1429 }, { 1582, 1410, 1542, 1678 }, { 1734, 1414, 1538, 1526 } } },
+    { 3000, { 1409, 1352, 1648, 1517 }, { -16, -31, 128, 1553 }, { 43.969, -195.774, 176.856 }, { -103.9, 19.1 }, { { 1531, 1519, 1569, 1593 }, { 1541, 1519, 1569, 1583 }, { 1698, 1504, 1584, 1426 }, { 1584, 1412, 1542, 1674 }, { 1736, 1416, 1538, 1522 } } },
+    { 3000, { 1409, 1352, 1648, 1517 }, { -16, -31, 128, 1553 }, { 47.719, -193.524, 178.856 }, { -103.5, 17.4 }, { { 1535, 1519, 1565, 1593 }, { 1545, 1519, 1565, 1583 }, { 1702, 1504, 1580, 1426 }, { 1588, 1412, 1538, 1674 }, { 1740, 1416, 1534, 1522 } } },
+    { 3014, { 1433, 1352, 1648, 1517 }, { -10, -31, 128, 1553 }, { 50.719, -191.524, 177.606 }, { -103.1, 15.8 }, { { 1527, 1511, 1575, 1599 }, { 1536, 1512, 1574, 1590 }, { 1696, 1502, 1584, 1430 }, { 1584, 1406, 1544, 1678 }, { 1738, 1414, 1536, 1524 } } },
+    { 3000, { 1433, 1352, 1648, 1517 }, { -10, -31, 128, 1553 }, { 52.719, -190.274, 178.856 }, { -102.6, 14.2 }, { { 1529, 1511, 1573, 1599 }, { 1538, 1512, 1572, 1590 }, { 1698, 1502, 1582, 1430 }, { 1586, 1404, 1544, 1678 }, { 1741, 1413, 1535, 1523 } } },
+    { 3000, { 1433, 1352, 1648, 1517 }, { -10, -31, 128, 1553 }, { 55.969, -188.774, 177.106 }, { -102.1, 12.6 }, { { 1529, 1513, 1573, 1597 }, { 1538, 1514, 1572, 1588 }, { 1698, 1504, 1582, 1428 }, { 1584, 1402, 1546, 1680 }, { 1741, 1413, 1535, 1523 } } },
+    { 2987, { 1433, 1352, 1648, 1517 }, { -10, -31, 128, 1553 }, { 59.219, -187.774, 178.106 }, { -101.6, 11.1 }, { { 1530, 1514, 1572, 1596 }, { 1540, 1514, 1572, 1586 }, { 1700, 1506, 1580, 1426 }, { 1585, 1399, 1547, 1681 }, { 1742, 1412, 1534, 1524 } } },
+    { 3007, { 1433, 1352, 1648, 1517 }, { -10, -31, 128, 1553 }, { 61.219, -186.774, 176.606 }, { -101.1, 9.5 }, { { 1531, 1515, 1573, 1593 }, { 1540, 1516, 1572, 1584 }, { 1700, 1508, 1580, 1424 }, { 1587, 1399, 1547, 1679 }, { 1744, 1412, 1534, 1522 } } },
+    { 3000, { 1433, 1352, 1648, 1517 }, { -10, -31, 128, 1553 }, { 64.469, -183.524, 177.106 }, { -100.5, 8.0 }, { { 1532, 1516, 1570, 1594 }, { 1542, 1516, 1570, 1584 }, { 1701, 1509, 1577, 1425 }, { 1590, 1400, 1544, 1678 }, { 1747, 1413, 1531, 1521 } } },
+    { 3007, { 1459, 1352, 1648, 1517 }, { -4, -31, 128, 1553 }, { 66.719, -182.774, 177.106 }, { -100.0, 6.5 }, { { 1525, 1507, 1579, 1601 }, { 1534, 1508, 1578, 1592 }, { 1696, 1504, 1582, 1430 }, { 1587, 1395, 1549, 1681 }, { 1745, 1411, 1533, 1523 } } },
+    { 3000, { 1459, 1352, 1648, 1517 }, { -4, -31, 128, 1553 }, { 69.969, -181.024, 177.606 }, { -99.4, 4.9 }, { { 1527, 1509, 1577, 1599 }, { 1536, 1510, 1576, 1590 }, { 1698, 1506, 1580, 1428 }, { 1589, 1393, 1549, 1681 }, { 1748, 1412, 1530, 1522 } } },
+    { 3000, { 1459, 1352, 1648, 1517 }, { -4, -31, 128, 1553 }, { 72.969, -180.024, 176.606 }, { -98.7, 3.4 }, { { 1527, 1511, 1577, 1597 }, { 1536, 1512, 1576, 1588 }, { 1698, 1510, 1578, 1426 }, { 1588, 1392, 1550, 1682 }, { 1749, 1411, 1531, 1521 } } },
+    { 2994, { 1459, 1352, 1648, 1517 }, { -4, -31, 128, 1553 }, { 75.969, -178.274, 177.106 }, { -98.1, 2.0 }, { { 1530, 1512, 1574, 1596 }, { 1539, 1513, 1573, 1587 }, { 1701, 1511, 1575, 1425 }, { 1590, 1390, 1550, 1682 }, { 1751, 1411, 1529, 1521 } } },
+    { 3000, { 1459, 1352, 1648, 1517 }, { -4, -31, 128, 1553 }, { 78.719, -176.024, 176.856 }, { -97.4, 0.5 }, { { 1530, 1514, 1572, 1596 }, { 1540, 1514, 1572, 1586 }, { 1702, 1514, 1572, 1424 }, { 1592, 1392, 1548, 1680 }, { 1752, 1412, 1528, 1520 } } },
+    { 3000, { 1459, 1352, 1648, 1517 }, { -4, -31, 128, 1553 }, { 81.969, -174.524, 177.606 }, { -96.7, -1.0 }, { { 1533, 1515, 1571, 1593 }, { 1542, 1516, 1570, 1584 }, { 1704, 1516, 1570, 1422 }, { 1596, 1392, 1546, 1678 }, { 1756, 1414, 1524, 1518 } } },
+    { 3007, { 1459, 1352, 1648, 1517 }, { -4, -31, 128, 1553 }, { 84.719, -172.274, 177.106 }, { -96.0, -2.4 }, { { 1533, 1517, 1569, 1593 }, { 1543, 1519, 1567, 1583 }, { 1704, 1518, 1568, 1422 }, { 1599, 1395, 1543, 1675 }, { 1758, 1416, 1522, 1516 } } },
+    { 3000, { 1485, 1352, 1648, 1517 }, { 0, -31, 128, 1553 }, { 86.719, -171.024, 176.106 }, { -95.3, -3.8 }, { { 1527, 1513, 1575, 1597 }, { 1537, 1515, 1573, 1587 }, { 1701, 1517, 1571, 1423 }, { 1598, 1392, 1546, 1676 }, { 1758, 1416, 1522, 1516 } } },
+    { 2987, { 1485, 1352, 1648, 1517 }, { 0, -31, 128, 1553 }, { 89.969, -168.524, 176.106 }, { -94.5, -5.2 }, { { 1528, 1516, 1572, 1596 }, { 1539, 1517, 1571, 1585 }, { 1701, 1519, 1569, 1423 }, { 1599, 1391, 1545, 1677 }, { 1760, 1416, 1520, 1516 } } },
+    { 3007, { 1485, 1352, 1648, 1517 }, { 0, -31, 128, 1553 }, { 91.969, -166.774, 176.106 }, { -93.8, -6.6 }, { { 1529, 1517, 1571, 1595 }, { 1539, 1517, 1571, 1585 }, { 1701, 1521, 1567, 1423 }, { 1601, 1389, 1545, 1677 }, { 1761, 1415, 1519, 1517 } } },
+    { 3000, { 1485, 1352, 1648, 1517 }, { 0, -31, 128, 1553 }, { 94.219, -165.524, 176.356 }, { -93.0, -8.0 }, { { 1531, 1517, 1569, 1595 }, { 1541, 1517, 1569, 1585 }, { 1704, 1522, 1564, 1422 }, { 1600, 1388, 1546, 1678 }, { 1762, 1416, 1518, 1516 } } },
+    { 3000, { 1485, 1352, 1648, 1517 }, { 0, -31, 128, 1553 }, { 98.219, -164.024, 175.356 }, { -92.1, -9.3 }, { { 1532, 1520, 1568, 1592 }, { 1542, 1520, 1568, 1582 }, { 1705, 1525, 1563, 1419 }, { 1603, 1389, 1545, 1675 }, { 1763, 1417, 1517, 1515 } } },
+    { 2994, { 1485, 1352, 1648, 1517 }, { 0, -31, 128, 1553 }, { 100.469, -162.274, 176.356 }, { -91.3, -10.7 }, { { 1535, 1519, 1567, 1591 }, { 1544, 1520, 1566, 1582 }, { 1707, 1525, 1561, 1419 }, { 1606, 1390, 1542, 1674 }, { 1766, 1418, 1514, 1514 } } },
+    { 3000, { 1485, 1352, 1648, 1517 }, { 0, -31, 128, 1553 }, { 101.969, -161.274, 176.606 }, { -90.4, -12.0 }, { { 1536, 1520, 1566, 1590 }, { 1546, 1522, 1564, 1580 }, { 1708, 1526, 1560, 1418 }, { 1609, 1389, 1541, 1673 }, { 1770, 1418, 1512, 1512 } } },
+    { 3000, { 1511, 1352, 1648, 1517 }, { 0, -31, 128, 1553 }, { 104.219, -159.024, 176.106 }, { -89.6, -13.3 }, { { 1537, 1521, 1565, 1589 }, { 1547, 1523, 1563, 1579 }, { 1709, 1529, 1557, 1417 }, { 1612, 1390, 1540, 1670 }, { 1771, 1419, 1511, 1511 } } },
+    { 3078, { 1511, 1352, 1648, 1517 }, { 0, -31, 128, 1553 }, { 107.469, -157.024, 175.356 }, { -88.7, -14.6 }, { { 1538, 1524, 1564, 1586 }, { 1547, 1525, 1563, 1577 }, { 1709, 1531, 1557, 1415 }, { 1615, 1391, 1537, 1669 }, { 1774, 1420, 1508, 1510 } } },
+    { 2920, { 1511, 1352, 1648, 1517 }, { 0, -31, 128, 1553 }, { 107.969, -156.274, 175.356 }, { -87.8, -15.9 }, { { 1538, 1524, 1564, 1586 }, { 1548, 1526, 1562, 1576 }, { 1710, 1532, 1556, 1414 }, { 1617, 1391, 1537, 1667 }, { 1775, 1421, 1507, 1509 } } },
+    { 3007, { 1511, 1352, 1648, 1517 }, { 0, -31, 128, 1553 }, { 110.719, -153.524, 176.356 }, { -86.8, -17.2 }, { { 1540, 1524, 1562, 1586 }, { 1550, 1526, 1560, 1576 }, { 1710, 1534, 1552, 1416 }, { 1619, 1391, 1535, 1667 }, { 1777, 1421, 1505, 1509 } } },
+    { 3000, { 1511, 1352, 1648, 1517 }, { 0, -31, 128, 1553 }, { 110.719, -152.524, 175.606 }, { -85.9, -18.4 }, { { 1539, 1525, 1563, 1585 }, { 1549, 1527, 1561, 1575 }, { 1709, 1535, 1553, 1415 }, { 1620, 1390, 1536, 1666 }, { 1778, 1422, 1504, 1508 } } },
+    { 3007, { 1511, 1352, 1648, 1517 }, { 0, -31, 128, 1553 }, { 112.219, -150.524, 175.356 }, { -85.0, -19.6 }, { { 1539, 1527, 1561, 1585 }, { 1548, 1528, 1560, 1576 }, { 1710, 1536, 1552, 1414 }, { 1621, 1389, 1535, 1667 }, { 1779, 1421, 1503, 1509 } } },
+    { 3000, { 1537, 1352, 1648, 1517 }, { 3, -31, 128, 1553 }, { 114.719, -149.774, 175.606 }, { -84.0, -20.9 }, { { 1536, 1522, 1566, 1588 }, { 1546, 1524, 1564, 1578 }, { 1708, 1534, 1554, 1416 }, { 1620, 1386, 1538, 1668 }, { 1779, 1421, 1503, 1509 } } },
+    { 3000, { 1537, 1352, 1648, 1517 }, { 3, -31, 128, 1553 }, { 114.469, -148.024, 175.356 }, { -83.1, -22.1 }, { { 1536, 1522, 1566, 1588 }, { 1546, 1524, 1564, 1578 }, { 1707, 1535, 1553, 1417 }, { 1621, 1383, 1539, 1669 }, { 1779, 1419, 1503, 1511 } } },
+    { 2994, { 1537, 1352, 1648, 1517 }, { 3, -31, 128, 1553 }, { 114.969, -146.024, 175.356 }, { -82.1, -23.3 }, { { 1536, 1522, 1566, 1588 }, { 1546, 1524, 1564, 1578 }, { 1707, 1535, 1553, 1417 }, { 1620, 1382, 1540, 1670 }, { 1779, 1419, 1503, 1511 } } },
+    { 3000, { 1537, 1352, 1648, 1517 }, { 3, -31, 128, 1553 }, { 115.219, -145.524, 175.356 }, { -81.1, -24.5 }, { { 1536, 1522, 1566, 1588 }, { 1546, 1524, 1564, 1578 }, { 1707, 1535, 1553, 1417 }, { 1621, 1379, 1541, 1671 }, { 1781, 1417, 1503, 1511 } } },
+    { 3000, { 1537, 1352, 1648, 1517 }, { 3, -31, 128, 1553 }, { 115.719, -143.774, 176.106 }, { -80.2, -25.6 }, { { 1537, 1521, 1565, 1589 }, { 1547, 1523, 1563, 1579 }, { 1708, 1536, 1550, 1418 }, { 1623, 1377, 1541, 1671 }, { 1783, 1417, 1501, 1511 } } },
+    { 2987, { 1537, 1352, 1648, 1517 }, { 3, -31, 128, 1553 }, { 115.969, -141.524, 176.356 }, { -79.2, -26.8 }, { { 1537, 1521, 1565, 1589 }, { 1547, 1523, 1563, 1579 }, { 1708, 1536, 1550, 1418 }, { 1624, 1378, 1540, 1670 }, { 1783, 1417, 1501, 1511 } } },
+    { 3007, { 1537, 1352, 1648, 1517 }, { 3, -31, 128, 1553 }, { 115.969, -139.774, 174.856 }, { -78.2, -27.9 }, { { 1536, 1522, 1566, 1588 }, { 1545, 1525, 1563, 1579 }, { 1706, 1538, 1550, 1418 }, { 1625, 1379, 1539, 1669 }, { 1784, 1418, 1500, 1510 } } },
+    { 3000, { 1562, 1352, 1648, 1517 }, { 9, -31, 128, 1553 }, { 116.219, -139.024, 174.856 }, { -77.2, -29.0 }, { { 1527, 1513, 1575, 1597 }, { 1537, 1515, 1573, 1587 }, { 1700, 1532, 1556, 1424 }, { 1621, 1371, 1545, 1675 }, { 1783, 1415, 1501, 1513 } } },
+    { 3007, { 1562, 1352, 1648, 1517 }, { 9, -31, 128, 1553 }, { 115.719, -137.774, 175.106 }, { -76.2, -30.2 }, { { 1527, 1513, 1575, 1597 }, { 1537, 1515, 1573, 1587 }, { 1699, 1533, 1555, 1425 }, { 1621, 1369, 1547, 1675 }, { 1782, 1414, 1502, 1514 } } },
+    { 3000, { 1562, 1352, 1648, 1517 }, { 9, -31, 128, 1553 }, { 116.969, -135.524, 175.106 }, { -75.3, -31.3 }, { { 1528, 1514, 1574, 1596 }, { 1537, 1517, 1571, 1587 }, { 1699, 1533, 1555, 1425 }, { 1620, 1366, 1548, 1678 }, { 1783, 1413, 1501, 1515 } } },
+    { 3000, { 1562, 1352, 1648, 1517 }, { 9, -31, 128, 1553 }, { 117.219, -134.524, 174.856 }, { -74.3, -32.3 }, { { 1528, 1514, 1574, 1596 }, { 1538, 1516, 1572, 1586 }, { 1699, 1535, 1553, 1425 }, { 1620, 1364, 1550, 1678 }, { 1783, 1413, 1501, 1515 } } },
+    { 2994, { 1562, 1352, 1648, 1517 }, { 9, -31, 128, 1553 }, { 118.219, -132.274, 175.106 }, { -73.3, -33.4 }, { { 1528, 1516, 1572, 1596 }, { 1538, 1518, 1570, 1586 }, { 1700, 1536, 1552, 1424 }, { 1622, 1364, 1548, 1678 }, { 1785, 1413, 1499, 1515 } } },
+    { 3000, { 1562, 1352, 1648, 1517 }, { 9, -31, 128, 1553 }, { 118.969, -131.024, 174.356 }, { -72.3, -34.5 }, { { 1529, 1517, 1571, 1595 }, { 1539, 1519, 1569, 1585 }, { 1700, 1538, 1550, 1424 }, { 1624, 1366, 1546, 1676 }, { 1786, 1414, 1498, 1514 } } },
+    { 3000, { 1562, 1352, 1648, 1517 }, { 9, -31, 128, 1553 }, { 120.219, -129.524, 174.356 }, { -71.2, -35.5 }, { { 1530, 1518, 1570, 1594 }, { 1540, 1520, 1568, 1584 }, { 1701, 1539, 1549, 1423 }, { 1629, 1367, 1543, 1673 }, { 1788, 1416, 1494, 1514 } } },
+    { 3007, { 1587, 1352, 1648, 1517 }, { 15, -31, 128, 1553 }, { 121.469, -128.774, 173.856 }, { -70.2, -36.5 }, { { 1521, 1511, 1579, 1601 }, { 1532, 1514, 1576, 1590 }, { 1696, 1536, 1554, 1426 }, { 1626, 1362, 1548, 1676 }, { 1788, 1414, 1496, 1514 } } },
+    { 3000, { 1587, 1352, 1648, 1517 }, { 15, -31, 128, 1553 }, { 123.469, -126.774, 174.356 }, { -69.2, -37.5 }, { { 1524, 1512, 1576, 1600 }, { 1534, 1514, 1574, 1590 }, { 1697, 1537, 1551, 1427 }, { 1627, 1361, 1547, 1677 }, { 1790, 1414, 1494, 1514 } } },
+    { 2987, { 1587, 1352, 1648, 1517 }, { 15, -31, 128, 1553 }, { 124.719, -125.774, 174.606 }, { -68.1, -38.5 }, { { 1526, 1512, 1576, 1598 }, { 1536, 1516, 1572, 1588 }, { 1699, 1539, 1549, 1425 }, { 1628, 1358, 1548, 1678 }, { 1791, 1413, 1493, 1515 } } },
+    { 3007, { 1587, 1352, 1648, 1517 }, { 15, -31, 128, 1553 }, { 126.469, -122.774, 174.606 }, { -67.1, -39.5 }, { { 1527, 1515, 1573, 1597 }, { 1536, 1518, 1570, 1588 }, { 1699, 1541, 1547, 1425 }, { 1628, 1358, 1548, 1678 }, { 1791, 1415, 1491, 1515 } } },
+    { 3000, { 1587, 1352, 1648, 1517 }, { 15, -31, 128, 1553 }, { 128.719, -123.024, 173.856 }, { -66.0, -40.5 }, { { 1529, 1517, 1573, 1593 }, { 1538, 1520, 1570, 1584 }, { 1700, 1544, 1546, 1422 }, { 1631, 1359, 1547, 1675 }, { 1793, 1415, 1491, 1513 } } },
+    { 3000, { 1587, 1352, 1648, 1517 }, { 15, -31, 128, 1553 }, { 129.719, -120.274, 174.356 }, { -64.9, -41.5 }, { { 1530, 1518, 1570, 1594 }, { 1539, 1521, 1567, 1585 }, { 1701, 1545, 1543, 1423 }, { 1634, 1360, 1544, 1674 }, { 1795, 1417, 1487, 1513 } } },
+    { 2994, { 1610, 1352, 1648, 1517 }, { 20, -31, 128, 1553 }, { 132.969, -119.274, 174.106 }, { -63.8, -42.4 }, { { 1525, 1513, 1575, 1599 }, { 1534, 1516, 1572, 1590 }, { 1697, 1543, 1545, 1427 }, { 1632, 1358, 1546, 1676 }, { 1795, 1417, 1487, 1513 } } },
+    { 3000, { 1610, 1352, 1648, 1517 }, { 20, -31, 128, 1553 }, { 134.969, -118.274, 173.356 }, { -62.6, -43.3 }, { { 1525, 1515, 1575, 1597 }, { 1535, 1519, 1571, 1587 }, { 1698, 1546, 1544, 1424 }, { 1635, 1357, 1545, 1675 }, { 1797, 1417, 1485, 1513 } } },
+    { 3000, { 1610, 1352, 1648, 1517 }, { 20, -31, 128, 1553 }, { 136.969, -115.774, 174.106 }, { -61.5, -44.2 }, { { 1527, 1517, 1571, 1597 }, { 1537, 1519, 1569, 1587 }, { 1700, 1548, 1540, 1424 }, { 1635, 1357, 1545, 1675 }, { 1798, 1418, 1484, 1512 } } },
+    { 3007, { 1610, 1352, 1648, 1517 }, { 20, -31, 128, 1553 }, { 139.219, -114.774, 173.606 }, { -60.3, -45.1 }, { { 1528, 1518, 1572, 1594 }, { 1538, 1522, 1568, 1584 }, { 1700, 1550, 1540, 1422 }, { 1637, 1355, 1545, 1675 }, { 1800, 1418, 1482, 1512 } } },
+    { 3000, { 1610, 1352, 1648, 1517 }, { 20, -31, 128, 1553 }, { 140.969, -112.774, 172.856 }, { -59.1, -46.0 }, { { 1529, 1521, 1569, 1593 }, { 1539, 1523, 1567, 1583 }, { 1701, 1553, 1537, 1421 }, { 1639, 1357, 1543, 1673 }, { 1801, 1419, 1481, 1511 } } },
+    { 3007, { 1610, 1352, 1648, 1517 }, { 20, -31, 128, 1553 }, { 143.219, -111.274, 173.356 }, { -57.9, -46.9 }, { { 1530, 1522, 1568, 1592 }, { 1541, 1525, 1565, 1581 }, { 1702, 1554, 1536, 1420 }, { 1642, 1358, 1540, 1672 }, { 1803, 1421, 1477, 1511 } } },
+    { 2989, { 1610, 1352, 1648, 1517 }, { 20, -31, 128, 1553 }, { 146.719, -110.774, 174.106 }, { -56.7, -47.7 }, { { 1533, 1523, 1565, 1591 }, { 1544, 1526, 1562, 1580 }, { 1704, 1556, 1532, 1420 }, { 1647, 1359, 1537, 1669 }, { 1808, 1422, 1474, 1508 } } },
+    { 3009, { 1633, 1352, 1648, 1517 }, { 26, -31, 128, 1553 }, { 148.469, -110.524, 172.606 }, { -55.5, -48.6 }, { { 1526, 1516, 1574, 1596 }, { 1535, 1519, 1571, 1587 }, { 1699, 1551, 1539, 1423 }, { 1643, 1355, 1543, 1671 }, { 1805, 1421, 1477, 1509 } } },
+    { 3000, { 1633, 1352, 1648, 1517 }, { 26, -31, 128, 1553 }, { 149.969, -107.274, 173.356 }, { -54.2, -49.4 }, { { 1526, 1518, 1572, 1596 }, { 1537, 1521, 1569, 1585 }, { 1700, 1554, 1536, 1422 }, { 1644, 1354, 1542, 1672 }, { 1806, 1422, 1474, 1510 } } },
+    { 3000, { 1633, 1352, 1648, 1517 }, { 26, -31, 128, 1553 }, { 151.719, -107.274, 173.106 }, { -53.0, -50.2 }, { { 1528, 1518, 1572, 1594 }, { 1538, 1522, 1568, 1584 }, { 1701, 1555, 1535, 1421 }, { 1645, 1351, 1543, 1673 }, { 1808, 1420, 1474, 1510 } } },
+    { 2994, { 1633, 1352, 1648, 1517 }, { 26, -31, 128, 1553 }, { 153.719, -106.024, 172.606 }, { -51.7, -51.1 }, { { 1530, 1520, 1570, 1592 }, { 1539, 1523, 1567, 1583 }, { 1702, 1556, 1534, 1420 }, { 1645, 1351, 1543, 1673 }, { 1808, 1420, 1474, 1510 } } },
+    { 3000, { 1633, 1352, 1648, 1517 }, { 26, -31, 128, 1553 }, { 155.719, -106.024, 173.356 }, { -50.4, -51.9 }, { { 1532, 1520, 1570, 1590 }, { 1541, 1523, 1567, 1581 }, { 1703, 1557, 1533, 1419 }, { 1648, 1350, 1542, 1672 }, { 1810, 1420, 1472, 1510 } } },
+    { 3000, { 1633, 1352, 1648, 1517 }, { 26, -31, 128, 1553 }, { 157.469, -104.024, 172.606 }, { -49.1, -52.7 }, { { 1532, 1522, 1568, 1590 }, { 1542, 1524, 1566, 1580 }, { 1703, 1559, 1531, 1419 }, { 1651, 1351, 1541, 1669 }, { 1812, 1422, 1470, 1508 } } },
+    { 3007, { 1633, 1352, 1648, 1517 }, { 26, -31, 128, 1553 }, { 159.469, -102.774, 172.606 }, { -47.8, -53.4 }, { { 1534, 1522, 1568, 1588 }, { 1544, 1526, 1564, 1578 }, { 1704, 1560, 1530, 1418 }, { 1655, 1353, 1537, 1667 }, { 1815, 1423, 1467, 1507 } } },
+    { 2987, { 1654, 1352, 1648, 1517 }, { 32, -31, 128, 1553 }, { 161.219, -102.524, 172.106 }, { -46.4, -54.2 }, { { 1525, 1515, 1577, 1595 }, { 1535, 1519, 1573, 1585 }, { 1698, 1556, 1536, 1422 }, { 1652, 1348, 1542, 1670 }, { 1813, 1421, 1469, 1509 } } },
+    { 3000, { 1654, 1352, 1648, 1517 }, { 32, -31, 128, 1553 }, { 163.469, -101.024, 173.106 }, { -45.1, -55.0 }, { { 1528, 1516, 1574, 1594 }, { 1538, 1520, 1570, 1584 }, { 1700, 1558, 1532, 1422 }, { 1654, 1348, 1540, 1670 }, { 1815, 1421, 1467, 1509 } } },
+    { 3007, { 1654, 1352, 1648, 1517 }, { 32, -31, 128, 1553 }, { 165.469, -99.774, 171.356 }, { -43.7, -55.7 }, { { 1528, 1518, 1574, 1592 }, { 1538, 1522, 1570, 1582 }, { 1700, 1560, 1532, 1420 }, { 1653, 1347, 1543, 1669 }, { 1815, 1423, 1467, 1507 } } },
+    { 3000, { 1654, 1352, 1648, 1517 }, { 32, -31, 128, 1553 }, { 166.469, -98.524, 172.856 }, { -42.4, -56.4 }, { { 1530, 1518, 1572, 1592 }, { 1540, 1522, 1568, 1582 }, { 1701, 1561, 1529, 1421 }, { 1654, 1344, 1542, 1672 }, { 1817, 1421, 1465, 1509 } } },
+    { 3000, { 1654, 1352, 1648, 1517 }, { 32, -31, 128, 1553 }, { 168.969, -97.524, 172.106 }, { -41.0, -57.1 }, { { 1530, 1522, 1570, 1590 }, { 1541, 1525, 1567, 1579 }, { 1702, 1564, 1528, 1418 }, { 1657, 1345, 1541, 1669 }, { 1818, 1422, 1464, 1508 } } },
+    { 2994, { 1654, 1352, 1648, 1517 }, { 32, -31, 128, 1553 }, { 170.719, -95.274, 172.356 }, { -39.6, -57.8 }, { { 1532, 1522, 1568, 1590 }, { 1542, 1526, 1564, 1580 }, { 1703, 1565, 1525, 1419 }, { 1661, 1347, 1537, 1667 }, { 1820, 1424, 1460, 1508 } } },
+    { 3000, { 1673, 1352, 1648, 1517 }, { 38, -31, 128, 1553 }, { 171.719, -95.024, 172.606 }, { -38.1, -58.5 }, { { 1524, 1514, 1576, 1598 }, { 1537, 1519, 1571, 1585 }, { 1697, 1559, 1531, 1425 }, { 1657, 1343, 1541, 1671 }, { 1818, 1422, 1462, 1510 } } },
+    { 3000, { 1673, 1352, 1648, 1517 }, { 38, -31, 128, 1553 }, { 172.719, -94.024, 171.606 }, { -36.7, -59.2 }, { { 1524, 1516, 1576, 1596 }, { 1537, 1521, 1571, 1583 }, { 1696, 1562, 1530, 1424 }, { 1658, 1342, 1542, 1670 }, { 1819, 1423, 1461, 1509 } } },
+    { 3007, { 1673, 1352, 1648, 1517 }, { 38, -31, 128, 1553 }, { 175.469, -92.774, 172.356 }, { -35.3, -59.9 }, { { 1527, 1517, 1573, 1595 }, { 1539, 1521, 1569, 1583 }, { 1699, 1563, 1527, 1423 }, { 1659, 1341, 1541, 1671 }, { 1821, 1423, 1459, 1509 } } },
+    { 3000, { 1673, 1352, 1648, 1517 }, { 38, -31, 128, 1553 }, { 177.219, -91.274, 171.856 }, { -33.8, -60.5 }, { { 1527, 1519, 1573, 1593 }, { 1539, 1523, 1569, 1581 }, { 1698, 1566, 1526, 1422 }, { 1660, 1340, 1542, 1670 }, { 1821, 1423, 1459, 1509 } } },
+    { 3007, { 1673, 1352, 1648, 1517 }, { 38, -31, 128, 1553 }, { 180.219, -89.774, 171.606 }, { -32.4, -61.2 }, { { 1529, 1521, 1571, 1591 }, { 1540, 1526, 1566, 1580 }, { 1700, 1568, 1524, 1420 }, { 1663, 1341, 1539, 1669 }, { 1824, 1424, 1456, 1508 } } },
+    { 2987, { 1673, 1352, 1648, 1517 }, { 38, -31, 128, 1553 }, { 180.719, -89.774, 171.856 }, { -30.9, -61.8 }, { { 1530, 1522, 1570, 1590 }, { 1543, 1527, 1565, 1577 }, { 1700, 1568, 1524, 1420 }, { 1667, 1343, 1537, 1665 }, { 1825, 1425, 1455, 1507 } } },
+    { 3000, { 1673, 1352, 1648, 1517 }, { 38, -31, 128, 1553 }, { 182.219, -88.024, 171.856 }, { -29.4, -62.4 }, { { 1532, 1524, 1568, 1588 }, { 1543, 1529, 1563, 1577 }, { 1701, 1571, 1521, 1419 }, { 1671, 1345, 1533, 1663 }, { 1828, 1428, 1450, 1506 } } },
+    { 3000, { 1691, 1352, 1648, 1517 }, { 43, -31, 128, 1553 }, { 183.969, -87.024, 170.856 }, { -27.9, -63.1 }, { { 1526, 1518, 1574, 1594 }, { 1539, 1523, 1569, 1581 }, { 1697, 1567, 1525, 1423 }, { 1669, 1341, 1537, 1665 }, { 1827, 1427, 1451, 1507 } } },
+    { 3014, { 1691, 1352, 1648, 1517 }, { 43, -31, 128, 1553 }, { 185.219, -86.274, 172.356 }, { -26.4, -63.7 }, { { 1528, 1518, 1572, 1594 }, { 1541, 1523, 1567, 1581 }, { 1699, 1567, 1523, 1423 }, { 1671, 1341, 1535, 1665 }, { 1828, 1426, 1450, 1508 } } },
+    { 3000, { 1691, 1352, 1648, 1517 }, { 43, -31, 128, 1553 }, { 188.219, -85.524, 171.356 }, { -24.8, -64.2 }, { { 1528, 1520, 1572, 1592 }, { 1542, 1526, 1566, 1578 }, { 1698, 1570, 1522, 1422 }, { 1672, 1340, 1536, 1664 }, { 1829, 1427, 1449, 1507 } } },
+    { 3000, { 1691, 1352, 1648, 1517 }, { 43, -31, 128, 1553 }, { 189.469, -83.774, 171.106 }, { -23.3, -64.8 }, { { 1530, 1522, 1570, 1590 }, { 1543, 1527, 1565, 1577 }, { 1699, 1571, 1521, 1421 }, { 1673, 1339, 1535, 1665 }, { 1830, 1426, 1448, 1508 } } },
+    { 3058, { 1691, 1352, 1648, 1517 }, { 43, -31, 128, 1553 }, { 191.469, -83.274, 170.856 }, { -21.7, -65.4 }, { { 1531, 1523, 1569, 1589 }, { 1545, 1529, 1563, 1575 }, { 1701, 1573, 1519, 1419 }, { 1675, 1339, 1535, 1663 }, { 1832, 1428, 1446, 1506 } } },
+    { 2940, { 1691, 1352, 1648, 1517 }, { 43, -31, 128, 1553 }, { 193.219, -82.024, 171.856 }, { -20.2, -65.9 }, { { 1533, 1525, 1567, 1587 }, { 1546, 1530, 1562, 1574 }, { 1701, 1575, 1517, 1419 }, { 1679, 1341, 1531, 1661 }, { 1834, 1428, 1444, 1506 } } },
+    { 2987, { 1691, 1352, 1648, 1517 }, { 43, -31, 128, 1553 }, { 195.469, -81.274, 171.606 }, { -18.6, -66.5 }, { { 1535, 1527, 1565, 1585 }, { 1548, 1532, 1560, 1572 }, { 1703, 1577, 1515, 1417 }, { 1682, 1344, 1528, 1658 }, { 1837, 1431, 1441, 1503 } } },
+    { 3000, { 1706, 1352, 1648, 1517 }, { 47, -31, 128, 1553 }, { 196.719, -79.774, 171.606 }, { -17.0, -67.0 }, { { 1530, 1522, 1570, 1590 }, { 1545, 1529, 1563, 1575 }, { 1699, 1575, 1517, 1421 }, { 1682, 1340, 1530, 1660 }, { 1837, 1429, 1441, 1505 } } },
+    { 3007, { 1706, 1352, 1648, 1517 }, { 47, -31, 128, 1553 }, { 198.219, -78.524, 171.356 }, { -15.4, -67.5 }, { { 1531, 1525, 1567, 1589 }, { 1546, 1530, 1562, 1574 }, { 1699, 1577, 1515, 1421 }, { 1683, 1341, 1529, 1659 }, { 1837, 1431, 1439, 1505 } } },
+    { 3000, { 1706, 1352, 1648, 1517 }, { 47, -31, 128, 1553 }, { 199.219, -77.524, 170.856 }, { -13.8, -68.0 }, { { 1532, 1526, 1566, 1588 }, { 1547, 1531, 1561, 1573 }, { 1699, 1577, 1515, 1421 }, { 1684, 1340, 1528, 1660 }, { 1838, 1430, 1438, 1506 } } },
+    { 3000, { 1706, 1352, 1648, 1517 }, { 47, -31, 128, 1553 }, { 199.969, -77.524, 171.606 }, { -12.2, -68.5 }, { { 1533, 1525, 1567, 1587 }, { 1548, 1532, 1560, 1572 }, { 1700, 1578, 1514, 1420 }, { 1685, 1339, 1529, 1659 }, { 1838, 1430, 1438, 1506 } } },
+    { 2994, { 1706, 1352, 1648, 1517 }, { 47, -31, 128, 1553 }, { 200.969, -75.774, 169.856 }, { -10.6, -69.0 }, { { 1532, 1528, 1566, 1586 }, { 1547, 1533, 1561, 1571 }, { 1698, 1580, 1514, 1420 }, { 1686, 1340, 1528, 1658 }, { 1839, 1431, 1437, 1505 } } },
+    { 3000, { 1706, 1352, 1648, 1517 }, { 47, -31, 128, 1553 }, { 201.719, -75.024, 170.606 }, { -8.9, -69.5 }, { { 1533, 1529, 1565, 1585 }, { 1548, 1534, 1560, 1570 }, { 1699, 1581, 1513, 1419 }, { 1690, 1340, 1526, 1656 }, { 1841, 1431, 1435, 1505 } } },
+    { 3000, { 1719, 1352, 1648, 1517 }, { 51, -31, 128, 1553 }, { 203.219, -74.274, 171.356 }, { -7.3, -69.9 }, { { 1530, 1522, 1570, 1590 }, { 1545, 1529, 1563, 1575 }, { 1696, 1576, 1516, 1424 }, { 1689, 1337, 1527, 1659 }, { 1841, 1429, 1435, 1507 } } },
+    { 3007, { 1719, 1352, 1648, 1517 }, { 51, -31, 128, 1553 }, { 203.969, -72.524, 170.356 }, { -5.6, -70.4 }, { { 1529, 1525, 1569, 1589 }, { 1545, 1531, 1563, 1573 }, { 1695, 1579, 1515, 1423 }, { 1690, 1338, 1526, 1658 }, { 1841, 1431, 1433, 1507 } } },
+    { 3007, { 1719, 1352, 1648, 1517 }, { 51, -31, 128, 1553 }, { 203.219, -72.274, 170.856 }, { -4.0, -70.8 }, { { 1530, 1524, 1568, 1590 }, { 1546, 1530, 1562, 1574 }, { 1696, 1578, 1514, 1424 }, { 1691, 1335, 1527, 1659 }, { 1842, 1430, 1432, 1508 } } },
+    { 3000, { 1719, 1352, 1648, 1517 }, { 51, -31, 128, 1553 }, { 205.469, -71.024, 170.606 }, { -2.4, -71.3 }, { { 1530, 1526, 1568, 1588 }, { 1547, 1533, 1561, 1571 }, { 1695, 1581, 1513, 1423 }, { 1692, 1336, 1526, 1658 }, { 1842, 1430, 1432, 1508 } } },
+    { 2987, { 1719, 1352, 1648, 1517 }, { 51, -31, 128, 1553 }, { 205.469, -70.024, 170.856 }, { -0.7, -71.7 }, { { 1532, 1526, 1566, 1588 }, { 1548, 1532, 1560, 1572 }, { 1696, 1580, 1512, 1424 }, { 1694, 1336, 1524, 1658 }, { 1844, 1430, 1430, 1508 } } },
+    { 3000, { 1719, 1352, 1648, 1517 }, { 51, -31, 128, 1553 }, { 206.469, -69.774, 170.356 }, { 0.9, -72.1 }, { { 1532, 1528, 1566, 1586 }, { 1548, 1534, 1560, 1570 }, { 1696, 1582, 1512, 1422 }, { 1698, 1338, 1522, 1654 }, { 1846, 1432, 1428, 1506 } } },
+    { 3000, { 1719, 1352, 1648, 1517 }, { 51, -31, 128, 1553 }, { 206.219, -69.024, 170.856 }, { 2.6, -72.5 }, { { 1534, 1528, 1564, 1586 }, { 1550, 1534, 1558, 1570 }, { 1696, 1582, 1510, 1424 }, { 1702, 1338, 1520, 1652 }, { 1848, 1432, 1426, 1506 } } },
+    { 2994, { 1729, 1352, 1648, 1517 }, { 55, -31, 128, 1553 }, { 206.719, -67.274, 171.356 }, { 4.3, -72.9 }, { { 1529, 1523, 1569, 1591 }, { 1546, 1530, 1562, 1574 }, { 1692, 1578, 1514, 1428 }, { 1699, 1335, 1523, 1655 }, { 1847, 1431, 1427, 1507 } } },
+    { 3000, { 1729, 1352, 1648, 1517 }, { 55, -31, 128, 1553 }, { 206.969, -67.274, 170.106 }, { 5.9, -73.3 }, { { 1528, 1524, 1570, 1590 }, { 1545, 1531, 1563, 1573 }, { 1692, 1580, 1514, 1426 }, { 1700, 1336, 1522, 1654 }, { 1847, 1431, 1427, 1507 } } },
+    { 3000, { 1729, 1352, 1648, 1517 }, { 55, -31, 128, 1553 }, { 207.719, -65.524, 170.856 }, { 7.6, -73.6 }, { { 1531, 1525, 1567, 1589 }, { 1548, 1532, 1560, 1572 }, { 1692, 1580, 1512, 1428 }, { 1701, 1335, 1521, 1655 }, { 1847, 1431, 1425, 1509 } } },
+    { 3007, { 1729, 1352, 1648, 1517 }, { 55, -31, 128, 1553 }, { 207.719, -66.274, 170.356 }, { 9.3, -74.0 }, { { 1532, 1526, 1568, 1586 }, { 1548, 1534, 1560, 1570 }, { 1691, 1581, 1513, 1427 }, { 1702, 1334, 1522, 1654 }, { 1847, 1431, 1425, 1509 } } },
+    { 3000, { 1729, 1352, 1648, 1517 }, { 55, -31, 128, 1553 }, { 209.219, -64.774, 170.356 }, { 10.9, -74.3 }, { { 1533, 1529, 1565, 1585 }, { 1549, 1535, 1559, 1569 }, { 1692, 1582, 1512, 1426 }, { 1705, 1333, 1521, 1653 }, { 1849, 1431, 1423, 1509 } } },
+    { 3007, { 1729, 1352, 1648, 1517 }, { 55, -31, 128, 1553 }, { 208.969, -63.524, 170.356 }, { 12.6, -74.7 }, { { 1534, 1530, 1564, 1584 }, { 1551, 1537, 1557, 1567 }, { 1692, 1584, 1510, 1426 }, { 1707, 1335, 1519, 1651 }, { 1850, 1432, 1422, 1508 } } },
+    { 2987, { 1729, 1352, 1648, 1517 }, { 55, -31, 128, 1553 }, { 209.719, -63.524, 170.106 }, { 14.3, -75.0 }, { { 1536, 1532, 1562, 1582 }, { 1552, 1538, 1556, 1566 }, { 1693, 1585, 1509, 1425 }, { 1711, 1337, 1515, 1649 }, { 1853, 1433, 1419, 1507 } } },
+    { 3000, { 1737, 1352, 1648, 1517 }, { 58, -31, 128, 1553 }, { 210.219, -63.524, 170.356 }, { 15.9, -75.3 }, { { 1534, 1528, 1566, 1584 }, { 1551, 1535, 1559, 1567 }, { 1690, 1582, 1512, 1428 }, { 1711, 1335, 1517, 1649 }, { 1852, 1432, 1420, 1508 } } },
+    { 3000, { 1737, 1352, 1648, 1517 }, { 58, -31, 128, 1553 }, { 209.219, -61.774, 170.356 }, { 17.6, -75.6 }, { { 1533, 1529, 1565, 1585 }, { 1551, 1537, 1557, 1567 }, { 1689, 1583, 1511, 1429 }, { 1712, 1334, 1516, 1650 }, { 1853, 1431, 1419, 1509 } } },
+    { 3014, { 1737, 1352, 1648, 1517 }, { 58, -31, 128, 1553 }, { 211.469, -60.524, 170.106 }, { 19.3, -75.9 }, { { 1536, 1532, 1562, 1582 }, { 1553, 1539, 1555, 1565 }, { 1690, 1584, 1510, 1428 }, { 1713, 1335, 1515, 1649 }, { 1853, 1433, 1417, 1509 } } },
+    { 3000, { 1737, 1352, 1648, 1517 }, { 58, -31, 128, 1553 }, { 210.719, -60.524, 170.356 }, { 21.0, -76.2 }, { { 1536, 1532, 1562, 1582 }, { 1553, 1539, 1555, 1565 }, { 1690, 1584, 1510, 1428 }, { 1715, 1333, 1515, 1649 }, { 1854, 1432, 1416, 1510 } } },
+    { 3000, { 1737, 1352, 1648, 1517 }, { 58, -31, 128, 1553 }, { 210.469, -59.274, 170.856 }, { 22.7, -76.5 }, { { 1538, 1532, 1560, 1582 }, { 1555, 1539, 1553, 1565 }, { 1690, 1584, 1508, 1430 }, { 1717, 1333, 1513, 1649 }, { 1856, 1432, 1414, 1510 } } },
+    { 3058, { 1737, 1352, 1648, 1517 }, { 58, -31, 128, 1553 }, { 210.219, -58.274, 170.356 }, { 24.4, -76.8 }, { { 1538, 1534, 1560, 1580 }, { 1554, 1542, 1552, 1564 }, { 1688, 1586, 1508, 1430 }, { 1719, 1335, 1511, 1647 }, { 1857, 1433, 1413, 1509 } } },
+    { 2940, { 1743, 1352, 1577, 1517 }, { 60, -31, 57, 1553 }, { 209.719, -58.024, 170.356 }, { 26.0, -77.1 }, { { 1608, 1460, 1490, 1654 }, { 1625, 1467, 1483, 1637 }, { 1758, 1512, 1438, 1504 }, { 1746, 1306, 1486, 1674 }, { 1883, 1405, 1387, 1537 } } },
+    { 2987, { 1743, 1352, 1577, 1517 }, { 60, -31, 57, 1553 }, { 209.969, -56.524, 171.106 }, { 27.7, -77.3 }, { { 1609, 1461, 1487, 1655 }, { 1626, 1468, 1480, 1638 }, { 1759, 1511, 1437, 1505 }, { 1748, 1308, 1484, 1672 }, { 1883, 1407, 1385, 1537 } } },
+    { 3000, { 1743, 1352, 1577, 1517 }, { 60, -31, 57, 1553 }, { 210.719, -56.024, 169.356 }, { 29.3, -77.6 }, { { 1609, 1463, 1487, 1653 }, { 1627, 1471, 1479, 1635 }, { 1758, 1514, 1436, 1504 }, { 1748, 1308, 1484, 1672 }, { 1883, 1407, 1385, 1537 } } },
+    { 3007, { 1743, 1352, 1577, 1517 }, { 60, -31, 57, 1553 }, { 209.469, -55.524, 169.856 }, { 31.0, -77.8 }, { { 1611, 1463, 1485, 1653 }, { 1628, 1470, 1478, 1636 }, { 1758, 1512, 1436, 1506 }, { 1750, 1308, 1484, 1670 }, { 1883, 1407, 1385, 1537 } } },
+    { 3000, { 1743, 1352, 1577, 1517 }, { 60, -31, 57, 1553 }, { 210.469, -55.274, 169.356 }, { 32.7, -78.0 }, { { 1613, 1465, 1483, 1651 }, { 1630, 1472, 1476, 1634 }, { 1759, 1513, 1435, 1505 }, { 1751, 1309, 1483, 1669 }, { 1884, 1408, 1384, 1536 } } },
+    { 3000, { 1743, 1352, 1577, 1517 }, { 60, -31, 57, 1553 }, { 209.469, -54.274, 168.606 }, { 34.3, -78.2 }, { { 1614, 1466, 1482, 1650 }, { 1630, 1472, 1476, 1634 }, { 1759, 1513, 1435, 1505 }, { 1753, 1311, 1481, 1667 }, { 1885, 1409, 1383, 1535 } } },
+    { 2994, { 1743, 1352, 1577, 1517 }, { 60, -31, 57, 1553 }, { 209.969, -53.774, 167.856 }, { 36.0, -78.5 }, { { 1616, 1466, 1482, 1648 }, { 1632, 1474, 1474, 1632 }, { 1759, 1515, 1433, 1505 }, { 1756, 1312, 1480, 1664 }, { 1886, 1410, 1382, 1534 } } },
+    { 3000, { 1746, 1352, 1502, 1517 }, { 62, -31, 0, 1553 }, { 209.969, -53.024, 167.106 }, { 37.7, -78.7 }, { { 1636, 1444, 1462, 1670 }, { 1653, 1451, 1455, 1653 }, { 1778, 1492, 1414, 1528 }, { 1698, 1368, 1538, 1608 }, { 1827, 1467, 1439, 1479 } } },
+    { 3000, { 1746, 1352, 1502, 1517 }, { 62, -31, 0, 1553 }, { 209.719, -52.524, 166.606 }, { 39.3, -78.8 }, { { 1636, 1446, 1460, 1670 }, { 1652, 1452, 1454, 1654 }, { 1778, 1492, 1414, 1528 }, { 1700, 1368, 1538, 1606 }, { 1828, 1468, 1438, 1478 } } },
+    { 3007, { 1746, 1352, 1502, 1517 }, { 62, -31, 0, 1553 }, { 209.469, -52.524, 165.856 }, { 41.0, -79.0 }, { { 1638, 1446, 1460, 1668 }, { 1654, 1452, 1454, 1652 }, { 1778, 1492, 1414, 1528 }, { 1701, 1369, 1537, 1605 }, { 1828, 1468, 1438, 1478 } } },
+    { 3007, { 1746, 1352, 1502, 1517 }, { 62, -31, 0, 1553 }, { 208.969, -50.774, 165.106 }, { 42.6, -79.2 }, { { 1638, 1448, 1458, 1668 }, { 1653, 1453, 1453, 1653 }, { 1777, 1493, 1413, 1529 }, { 1701, 1369, 1537, 1605 }, { 1828, 1468, 1438, 1478 } } },
+    { 3000, { 1746, 1352, 1502, 1517 }, { 62, -31, 0, 1553 }, { 208.469, -50.774, 164.106 }, { 44.3, -79.4 }, { { 1639, 1449, 1457, 1667 }, { 1654, 1454, 1452, 1652 }, { 1777, 1493, 1413, 1529 }, { 1703, 1369, 1537, 1603 }, { 1828, 1468, 1438, 1478 } } },
+    { 2987, { 1746, 1352, 1502, 1517 }, { 62, -31, 0, 1553 }, { 207.219, -51.524, 162.106 }, { 45.9, -79.6 }, { { 1640, 1448, 1458, 1666 }, { 1655, 1453, 1453, 1651 }, { 1777, 1493, 1413, 1529 }, { 1704, 1370, 1536, 1602 }, { 1829, 1469, 1437, 1477 } } },
+    { 3000, { 1746, 1352, 1502, 1517 }, { 62, -31, 0, 1553 }, { 205.719, -49.024, 160.856 }, { 47.5, -79.7 }, { { 1639, 1449, 1457, 1667 }, { 1654, 1454, 1452, 1652 }, { 1775, 1493, 1413, 1531 }, { 1705, 1371, 1535, 1601 }, { 1828, 1470, 1436, 1478 } } },
+    { 3000, { 1746, 1352, 1427, 1517 }, { 62, -31, -53, 1553 }, { 205.469, -49.024, 159.356 }, { 49.1, -79.9 }, { { 1693, 1397, 1403, 1719 }, { 1708, 1402, 1398, 1704 }, { 1828, 1440, 1360, 1584 }, { 1761, 1319, 1481, 1651 }, { 1881, 1417, 1383, 1531 } } },
+    { 3014, { 1746, 1352, 1427, 1517 }, { 62, -31, -53, 1553 }, { 204.969, -48.274, 158.106 }, { 50.7, -80.0 }, { { 1693, 1397, 1403, 1719 }, { 1708, 1402, 1398, 1704 }, { 1827, 1439, 1361, 1585 }, { 1762, 1320, 1480, 1650 }, { 1881, 1417, 1383, 1531 } } },
+    { 3000, { 1746, 1352, 1427, 1517 }, { 62, -31, -53, 1553 }, { 204.719, -47.524, 156.606 }, { 52.3, -80.2 }, { { 1694, 1398, 1402, 1718 }, { 1709, 1403, 1397, 1703 }, { 1826, 1440, 1360, 1586 }, { 1763, 1321, 1479, 1649 }, { 1882, 1418, 1382, 1530 } } },
+    { 3000, { 1746, 1352, 1427, 1517 }, { 62, -31, -53, 1553 }, { 202.719, -47.524, 154.856 }, { 53.9, -80.3 }, { { 1695, 1399, 1401, 1717 }, { 1709, 1403, 1397, 1703 }, { 1826, 1440, 1360, 1586 }, { 1764, 1322, 1478, 1648 }, { 1882, 1418, 1382, 1530 } } },
+    { 2987, { 1746, 1352, 1427, 1517 }, { 62, -31, -53, 1553 }, { 201.969, -46.774, 152.606 }, { 55.5, -80.4 }, { { 1696, 1400, 1400, 1716 }, { 1710, 1404, 1396, 1702 }, { 1825, 1441, 1359, 1587 }, { 1766, 1322, 1478, 1646 }, { 1881, 1419, 1381, 1531 } } },
+    { 3000, { 1746, 1352, 1427, 1517 }, { 62, -31, -53, 1553 }, { 201.719, -46.024, 150.856 }, { 57.0, -80.5 }, { { 1696, 1400, 1400, 1716 }, { 1711, 1405, 1395, 1701 }, { 1825, 1441, 1359, 1587 }, { 1767, 1323, 1477, 1645 }, { 1882, 1420, 1380, 1530 } } },
+    { 3007, { 1746, 1352, 1352, 1517 }, { 62, -31, -128, 1553 }, { 200.219, -45.524, 148.606 }, { 58.6, -80.7 }, { { 1772, 1326, 1324, 1790 }, { 1786, 1330, 1320, 1776 }, { 1899, 1365, 1285, 1663 }, { 1843, 1249, 1401, 1719 }, { 1950, 1338, 1298, 1598 } } },
+    { 3007, { 1746, 1352, 1352, 1517 }, { 62, -31, -128, 1553 }, { 197.469, -44.524, 146.356 }, { 60.1, -80.8 }, { { 1771, 1327, 1323, 1791 }, { 1786, 1330, 1320, 1776 }, { 1897, 1365, 1285, 1665 }, { 1844, 1248, 1402, 1718 }, { 1950, 1338, 1300, 1600 } } },
+    { 3000, { 1746, 1352, 1352, 1517 }, { 62, -31, -128, 1553 }, { 197.469, -45.024, 143.606 }, { 61.6, -80.9 }, { { 1772, 1326, 1324, 1790 }, { 1787, 1331, 1319, 1775 }, { 1897, 1365, 1285, 1665 }, { 1845, 1249, 1401, 1717 }, { 1950, 1338, 1298, 1598 } } },
+    { 3000, { 1746, 1352, 1352, 1517 }, { 62, -31, -128, 1553 }, { 194.719, -43.524, 140.356 }, { 63.1, -81.0 }, { { 1771, 1327, 1323, 1791 }, { 1786, 1330, 1320, 1776 }, { 1896, 1364, 1286, 1666 }, { 1845, 1249, 1401, 1717 }, { 1950, 1340, 1300, 1602 } } },
+    { 2994, { 1746, 1352, 1352, 1517 }, { 62, -31, -128, 1553 }, { 192.719, -43.774, 136.856 }, { 64.6, -81.1 }, { { 1772, 1326, 1324, 1790 }, { 1786, 1330, 1320, 1776 }, { 1895, 1363, 1287, 1667 }, { 1847, 1249, 1401, 1715 }, { 1950, 1340, 1300, 1602 } } },
+    { 3000, { 1746, 1352, 1352, 1517 }, { 62, -31, -128, 1553 }, { 191.719, -42.274, 133.606 }, { 66.1, -81.2 }, { { 1771, 1327, 1323, 1791 }, { 1786, 1330, 1320, 1776 }, { 1893, 1363, 1287, 1669 }, { 1847, 1249, 1401, 1715 }, { 1950, 1340, 1300, 1602 } } },
+    { 3000, { 1746, 1352, 1352, 1517 }, { 62, -31, -128, 1553 }, { 189.719, -41.774, 130.856 }, { 67.5, -81.2 }, { { 1771, 1327, 1323, 1791 }, { 1785, 1331, 1319, 1777 }, { 1892, 1362, 1288, 1670 }, { 1848, 1250, 1400, 1714 }, { 1950, 1340, 1302, 1604 } } },
+    { 3007, { 1741, 1352, 1352, 1517 }, { 60, -31, -128, 1553 }, { 188.469, -41.024, 126.606 }, { 69.0, -81.3 }, { { 1774, 1330, 1320, 1788 }, { 1788, 1334, 1316, 1774 }, { 1893, 1365, 1285, 1669 }, { 1851, 1253, 1397, 1711 }, { 1950, 1342, 1300, 1604 } } },
+    { 3000, { 1741, 1352, 1352, 1517 }, { 60, -31, -128, 1553 }, { 185.719, -40.274, 123.856 }, { 70.4, -81.4 }, { { 1773, 1331, 1319, 1789 }, { 1786, 1334, 1316, 1776 }, { 1891, 1365, 1285, 1671 }, { 1852, 1254, 1396, 1710 }, { 1950, 1342, 1300, 1604 } } },
+    { 2987, { 1741, 1352, 1352, 1517 }, { 60, -31, -128, 1553 }, { 184.719, -41.024, 120.606 }, { 71.8, -81.5 }, { { 1775, 1331, 1319, 1787 }, { 1788, 1334, 1316, 1774 }, { 1891, 1363, 1287, 1671 }, { 1853, 1253, 1397, 1709 }, { 1950, 1342, 1298, 1602 } } },
+    { 3009, { 1741, 1352, 1352, 1517 }, { 60, -31, -128, 1553 }, { 182.969, -39.524, 115.606 }, { 73.1, -81.6 }, { { 1774, 1332, 1318, 1788 }, { 1787, 1335, 1315, 1775 }, { 1890, 1364, 1286, 1672 }, { 1854, 1254, 1396, 1708 }, { 1950, 1342, 1298, 1602 } } },
+    { 2989, { 1741, 1352, 1352, 1517 }, { 60, -31, -128, 1553 }, { 180.969, -39.774, 111.356 }, { 74.5, -81.6 }, { { 1775, 1331, 1319, 1787 }, { 1788, 1334, 1316, 1774 }, { 1889, 1363, 1287, 1673 }, { 1855, 1255, 1395, 1707 }, { 1950, 1342, 1298, 1602 } } },
+    { 3000, { 1741, 1352, 1352, 1517 }, { 60, -31, -128, 1553 }, { 179.219, -37.774, 106.856 }, { 75.8, -81.7 }, { { 1774, 1332, 1318, 1788 }, { 1787, 1335, 1315, 1775 }, { 1887, 1363, 1287, 1675 }, { 1855, 1255, 1395, 1707 }, { 1950, 1344, 1300, 1606 } } },
+    { 3000, { 1741, 1352, 1352, 1517 }, { 60, -31, -128, 1553 }, { 177.219, -37.524, 103.856 }, { 77.2, -81.8 }, { { 1774, 1332, 1318, 1788 }, { 1787, 1335, 1315, 1775 }, { 1886, 1362, 1288, 1676 }, { 1856, 1254, 1396, 1706 }, { 1950, 1344, 1300, 1606 } } },
+    { 3014, { 1733, 1352, 1352, 1517 }, { 57, -31, -128, 1553 }, { 174.969, -36.274, 99.356 }, { 78.5, -81.8 }, { { 1776, 1336, 1314, 1786 }, { 1789, 1339, 1311, 1773 }, { 1887, 1365, 1285, 1675 }, { 1858, 1258, 1392, 1704 }, { 1950, 1346, 1298, 1606 } } },
+    { 3000, { 1733, 1352, 1352, 1517 }, { 57, -31, -128, 1553 }, { 172.219, -35.774, 93.606 }, { 79.7, -81.9 }, { { 1776, 1336, 1314, 1786 }, { 1789, 1339, 1311, 1773 }, { 1886, 1364, 1286, 1676 }, { 1860, 1258, 1392, 1702 }, { 1950, 1346, 1298, 1606 } } },
+    { 3000, { 1733, 1352, 1352, 1517 }, { 57, -31, -128, 1553 }, { 169.719, -35.524, 89.106 }, { 81.0, -81.9 }, { { 1775, 1335, 1315, 1787 }, { 1788, 1338, 1312, 1774 }, { 1884, 1364, 1286, 1678 }, { 1862, 1260, 1390, 1700 }, { 1950, 1346, 1298, 1606 } } },
+    { 2987, { 1733, 1352, 1352, 1517 }, { 57, -31, -128, 1553 }, { 166.969, -34.024, 84.856 }, { 82.2, -82.0 }, { { 1773, 1335, 1315, 1789 }, { 1786, 1338, 1312, 1776 }, { 1881, 1363, 1287, 1681 }, { 1862, 1260, 1390, 1700 }, { 1950, 1348, 1300, 1610 } } },
+    { 3007, { 1733, 1352, 1352, 1517 }, { 57, -31, -128, 1553 }, { 164.719, -33.524, 80.856 }, { 83.4, -82.0 }, { { 1773, 1335, 1315, 1789 }, { 1786, 1338, 1312, 1776 }, { 1880, 1362, 1288, 1682 }, { 1863, 1261, 1389, 1699 }, { 1950, 1348, 1300, 1610 } } },
+    { 3000, { 1733, 1352, 1352, 1517 }, { 57, -31, -128, 1553 }, { 162.719, -33.024, 75.856 }, { 84.6, -82.1 }, { { 1773, 1335, 1315, 1789 }, { 1785, 1337, 1313, 1777 }, { 1879, 1361, 1289, 1683 }, { 1862, 1260, 1390, 1700 }, { 1950, 1348, 1302, 1612 } } },
+    { 3007, { 1723, 1352, 1352, 1515 }, { 53, -31, -128, 1552 }, { 158.469, -31.524, 71.106 }, { 85.7, -82.1 }, { { 1776, 1338, 1310, 1784 }, { 1787, 1341, 1307, 1773 }, { 1879, 1363, 1285, 1681 }, { 1864, 1262, 1386, 1696 }, { 1949, 1349, 1299, 1611 } } },
+    { 3000, { 1723, 1352, 1352, 1515 }, { 53, -31, -128, 1552 }, { 156.469, -30.524, 66.606 }, { 86.8, -82.2 }, { { 1775, 1339, 1309, 1785 }, { 1786, 1342, 1306, 1774 }, { 1877, 1363, 1285, 1683 }, { 1865, 1263, 1385, 1695 }, { 1949, 1349, 1299, 1611 } } },
+    { 3000, { 1723, 1352, 1352, 1515 }, { 53, -31, -128, 1552 }, { 154.219, -29.774, 61.856 }, { 87.9, -82.2 }, { { 1775, 1339, 1309, 1785 }, { 1785, 1341, 1307, 1775 }, { 1876, 1362, 1286, 1684 }, { 1867, 1265, 1383, 1693 }, { 1948, 1350, 1298, 1612 } } },
+    { 2994, { 1723, 1352, 1352, 1515 }, { 53, -31, -128, 1552 }, { 151.219, -29.024, 56.856 }, { 89.0, -82.2 }, { { 1773, 1339, 1309, 1787 }, { 1784, 1340, 1308, 1776 }, { 1874, 1362, 1286, 1686 }, { 1868, 1266, 1382, 1692 }, { 1948, 1350, 1298, 1612 } } },
+    { 3000, { 1723, 1352, 1352, 1515 }, { 53, -31, -128, 1552 }, { 148.219, -29.024, 52.106 }, { 90.0, -82.3 }, { { 1773, 1337, 1311, 1787 }, { 1784, 1340, 1308, 1776 }, { 1872, 1360, 1288, 1688 }, { 1869, 1265, 1383, 1691 }, { 1947, 1349, 1299, 1613 } } },
+    { 3000, { 1723, 1352, 1352, 1515 }, { 53, -31, -128, 1552 }, { 144.719, -27.774, 48.106 }, { 91.0, -82.3 }, { { 1771, 1337, 1311, 1789 }, { 1782, 1340, 1308, 1778 }, { 1870, 1360, 1288, 1690 }, { 1868, 1264, 1384, 1692 }, { 1945, 1349, 1299, 1615 } } },
+    { 3007, { 1723, 1352, 1352, 1515 }, { 53, -31, -128, 1552 }, { 142.719, -27.274, 41.856 }, { 92.0, -82.4 }, { { 1768, 1340, 1314, 1786 }, { 1778, 1342, 1312, 1776 }, { 1866, 1362, 1292, 1688 }, { 1867, 1263, 1385, 1693 }, { 1944, 1348, 1300, 1616 } } },
+    { 3000, { 1710, 1352, 1352, 1515 }, { 49, -31, -128, 1552 }, { 139.469, -26.524, 38.356 }, { 93.0, -82.4 }, { { 1771, 1347, 1311, 1779 }, { 1781, 1349, 1309, 1769 }, { 1866, 1366, 1292, 1684 }, { 1871, 1267, 1381, 1689 }, { 1945, 1349, 1299, 1615 } } },
+    { 2987, { 1710, 1352, 1352, 1515 }, { 49, -31, -128, 1552 }, { 135.969, -25.774, 32.606 }, { 93.9, -82.4 }, { { 1767, 1349, 1315, 1777 }, { 1777, 1351, 1313, 1767 }, { 1861, 1369, 1295, 1683 }, { 1871, 1267, 1381, 1689 }, { 1944, 1348, 1300, 1616 } } },
+    { 3007, { 1710, 1352, 1352, 1515 }, { 49, -31, -128, 1552 }, { 133.719, -24.774, 28.106 }, { 94.8, -82.5 }, { { 1764, 1350, 1318, 1776 }, { 1773, 1353, 1315, 1767 }, { 1858, 1370, 1298, 1682 }, { 1873, 1269, 1379, 1687 }, { 1943, 1349, 1299, 1617 } } },
+    { 3000, { 1710, 1352, 1352, 1515 }, { 49, -31, -128, 1552 }, { 129.219, -24.774, 23.606 }, { 95.6, -82.5 }, { { 1761, 1351, 1321, 1775 }, { 1769, 1353, 1319, 1767 }, { 1853, 1371, 1301, 1683 }, { 1874, 1268, 1380, 1686 }, { 1943, 1349, 1299, 1617 } } },
+    { 3000, { 1710, 1352, 1352, 1515 }, { 49, -31, -128, 1552 }, { 126.219, -23.774, 19.106 }, { 96.5, -82.6 }, { { 1757, 1353, 1325, 1773 }, { 1765, 1355, 1323, 1765 }, { 1848, 1372, 1306, 1682 }, { 1874, 1268, 1380, 1686 }, { 1941, 1349, 1299, 1619 } } },
+    { 2994, { 1710, 1352, 1352, 1515 }, { 49, -31, -128, 1552 }, { 123.719, -24.024, 14.856 }, { 97.3, -82.6 }, { { 1754, 1354, 1328, 1772 }, { 1762, 1356, 1326, 1764 }, { 1845, 1373, 1309, 1681 }, { 1873, 1267, 1381, 1687 }, { 1940, 1348, 1300, 1620 } } },
+    { 3000, { 1710, 1352, 1352, 1515 }, { 49, -31, -128, 1552 }, { 118.969, -23.524, 9.356 }, { 98.0, -82.7 }, { { 1749, 1355, 1333, 1771 }, { 1758, 1356, 1332, 1762 }, { 1839, 1373, 1315, 1681 }, { 1873, 1265, 1383, 1687 }, { 1938, 1346, 1302, 1622 } } },
+    { 3000, { 1695, 1352, 1352, 1512 }, { 44, -31, -128, 1551 }, { 116.469, -22.274, 4.106 }, { 98.8, -82.7 }, { { 1752, 1364, 1328, 1760 }, { 1760, 1366, 1326, 1752 }, { 1838, 1380, 1312, 1674 }, { 1876, 1268, 1378, 1682 }, { 1939, 1347, 1299, 1619 } } },
+    { 3078, { 1695, 1352, 1352, 1512 }, { 44, -31, -128, 1551 }, { 113.719, -23.024, -0.644 }, { 99.5, -82.8 }, { { 1748, 1366, 1332, 1758 }, { 1756, 1368, 1330, 1750 }, { 1834, 1382, 1316, 1672 }, { 1877, 1269, 1377, 1681 }, { 1938, 1346, 1300, 1620 } } },
+    { 2920, { 1695, 1352, 1352, 1512 }, { 44, -31, -128, 1551 }, { 111.219, -23.274, -4.894 }, { 100.2, -82.8 }, { { 1747, 1367, 1335, 1755 }, { 1754, 1368, 1334, 1748 }, { 1831, 1383, 1319, 1671 }, { 1880, 1270, 1376, 1678 }, { 1939, 1347, 1299, 1619 } } },
+    { 3007, { 1695, 1352, 1352, 1512 }, { 44, -31, -128, 1551 }, { 108.469, -22.774, -8.644 }, { 100.9, -82.9 }, { { 1744, 1368, 1338, 1754 }, { 1752, 1370, 1336, 1746 }, { 1828, 1384, 1322, 1670 }, { 1882, 1272, 1374, 1676 }, { 1939, 1347, 1299, 1619 } } },
+    { 3000, { 1695, 1352, 1352, 1512 }, { 44, -31, -128, 1551 }, { 104.219, -21.774, -13.394 }, { 101.5, -83.0 }, { { 1741, 1369, 1341, 1753 }, { 1748, 1370, 1340, 1746 }, { 1824, 1384, 1326, 1670 }, { 1882, 1272, 1374, 1676 }, { 1938, 1346, 1300, 1620 } } },
+    { 3007, { 1695, 1352, 1352, 1512 }, { 44, -31, -128, 1551 }, { 100.469, -22.524, -17.394 }, { 102.1, -83.0 }, { { 1737, 1371, 1345, 1751 }, { 1744, 1372, 1344, 1744 }, { 1820, 1386, 1330, 1668 }, { 1879, 1271, 1379, 1675 }, { 1934, 1346, 1304, 1620 } } },
+    { 3000, { 1677, 1352, 1352, 1510 }, { 39, -31, -128, 1550 }, { 96.969, -22.274, -23.644 }, { 102.7, -83.1 }, { { 1739, 1379, 1341, 1741 }, { 1746, 1380, 1340, 1734 }, { 1819, 1391, 1329, 1661 }, { 1880, 1276, 1376, 1668 }, { 1931, 1349, 1303, 1617 } } },
+    { 3000, { 1677, 1352, 1352, 1510 }, { 39, -31, -128, 1550 }, { 93.469, -21.274, -27.144 }, { 103.2, -83.2 }, { { 1736, 1380, 1344, 1740 }, { 1742, 1380, 1344, 1734 }, { 1814, 1392, 1332, 1662 }, { 1879, 1277, 1377, 1667 }, { 1929, 1349, 1305, 1617 } } },
+    { 2994, { 1677, 1352, 1352, 1510 }, { 39, -31, -128, 1550 }, { 90.969, -20.774, -31.894 }, { 103.7, -83.3 }, { { 1732, 1382, 1348, 1738 }, { 1737, 1383, 1347, 1733 }, { 1809, 1393, 1337, 1661 }, { 1879, 1279, 1377, 1665 }, { 1928, 1350, 1306, 1616 } } },
+    { 3000, { 1677, 1352, 1352, 1510 }, { 39, -31, -128, 1550 }, { 86.719, -21.774, -35.894 }, { 104.2, -83.4 }, { { 1728, 1382, 1352, 1738 }, { 1734, 1382, 1352, 1732 }, { 1805, 1393, 1341, 1661 }, { 1879, 1281, 1379, 1661 }, { 1925, 1351, 1309, 1615 } } },
+    { 3000, { 1677, 1352, 1352, 1510 }, { 39, -31, -128, 1550 }, { 83.219, -21.024, -39.894 }, { 104.6, -83.5 }, { { 1725, 1383, 1355, 1737 }, { 1731, 1383, 1355, 1731 }, { 1800, 1394, 1344, 1662 }, { 1877, 1281, 1381, 1661 }, { 1922, 1352, 1310, 1616 } } },
+    { 2987, { 1677, 1352, 1352, 1510 }, { 39, -31, -128, 1550 }, { 79.219, -20.024, -43.644 }, { 105.0, -83.6 }, { { 1720, 1384, 1360, 1736 }, { 1726, 1386, 1358, 1730 }, { 1795, 1395, 1349, 1661 }, { 1874, 1280, 1384, 1662 }, { 1919, 1351, 1313, 1617 } } },
+    { 3007, { 1677, 1352, 1352, 1510 }, { 39, -31, -128, 1550 }, { 75.469, -20.524, -48.644 }, { 105.4, -83.7 }, { { 1716, 1386, 1364, 1734 }, { 1722, 1386, 1364, 1728 }, { 1791, 1397, 1353, 1659 }, { 1871, 1279, 1389, 1661 }, { 1916, 1352, 1316, 1616 } } },
+    { 3000, { 1658, 1352, 1352, 1508 }, { 34, -31, -128, 1549 }, { 72.469, -19.024, -53.144 }, { 105.8, -83.8 }, { { 1719, 1393, 1359, 1725 }, { 1724, 1394, 1358, 1720 }, { 1790, 1402, 1350, 1654 }, { 1872, 1284, 1386, 1654 }, { 1913, 1355, 1315, 1613 } } },
+    { 3007, { 1658, 1352, 1352, 1508 }, { 34, -31, -128, 1549 }, { 67.719, -19.774, -58.144 }, { 106.1, -83.9 }, { { 1714, 1394, 1364, 1724 }, { 1719, 1395, 1363, 1719 }, { 1785, 1403, 1355, 1653 }, { 1871, 1287, 1387, 1651 }, { 1910, 1356, 1318, 1612 } } },
+    { 3000, { 1658, 1352, 1352, 1508 }, { 34, -31, -128, 1549 }, { 64.719, -19.024, -60.644 }, { 106.4, -84.0 }, { { 1711, 1395, 1367, 1723 }, { 1716, 1396, 1366, 1718 }, { 1780, 1404, 1358, 1654 }, { 1871, 1289, 1387, 1649 }, { 1909, 1357, 1319, 1611 } } },
+    { 3000, { 1658, 1352, 1352, 1508 }, { 34, -31, -128, 1549 }, { 61.219, -17.774, -64.894 }, { 106.6, -84.1 }, { { 1707, 1397, 1369, 1723 }, { 1712, 1396, 1370, 1718 }, { 1775, 1405, 1361, 1655 }, { 1871, 1291, 1387, 1647 }, { 1906, 1358, 1320, 1612 } } },
+    { 2994, { 1658, 1352, 1352, 1508 }, { 34, -31, -128, 1549 }, { 57.469, -19.524, -68.644 }, { 106.9, -84.2 }, { { 1703, 1397, 1375, 1721 }, { 1709, 1397, 1375, 1715 }, { 1772, 1406, 1366, 1652 }, { 1869, 1291, 1391, 1645 }, { 1903, 1359, 1323, 1611 } } },
+    { 3000, { 1658, 1352, 1352, 1508 }, { 34, -31, -128, 1549 }, { 54.469, -18.024, -73.394 }, { 107.0, -84.4 }, { { 1699, 1399, 1379, 1719 }, { 1704, 1400, 1378, 1714 }, { 1766, 1408, 1370, 1652 }, { 1866, 1292, 1394, 1644 }, { 1900, 1360, 1326, 1610 } } },
+    { 3000, { 1658, 1352, 1352, 1508 }, { 34, -31, -128, 1549 }, { 51.219, -17.274, -76.394 }, { 107.2, -84.5 }, { { 1698, 1400, 1380, 1718 }, { 1702, 1400, 1380, 1714 }, { 1764, 1408, 1372, 1652 }, { 1863, 1291, 1397, 1645 }, { 1896, 1360, 1328, 1612 } } },
+    { 3007, { 1637, 1352, 1352, 1505 }, { 27, -31, -128, 1548 }, { 47.469, -18.774, -80.894 }, { 107.4, -84.6 }, { { 1704, 1410, 1374, 1704 }, { 1708, 1410, 1374, 1700 }, { 1765, 1415, 1369, 1643 }, { 1868, 1298, 1392, 1634 }, { 1896, 1362, 1328, 1606 } } },
+    { 3000, { 1637, 1352, 1352, 1505 }, { 27, -31, -128, 1548 }, { 43.719, -18.024, -83.894 }, { 107.5, -84.7 }, { { 1700, 1410, 1378, 1704 }, { 1704, 1410, 1378, 1700 }, { 1761, 1415, 1373, 1643 }, { 1867, 1299, 1393, 1633 }, { 1894, 1364, 1328, 1606 } } },
+    { 2987, { 1637, 1352, 1352, 1505 }, { 27, -31, -128, 1548 }, { 40.719, -18.024, -88.394 }, { 107.5, -84.9 }, { { 1696, 1412, 1382, 1702 }, { 1700, 1412, 1382, 1698 }, { 1757, 1417, 1377, 1641 }, { 1869, 1303, 1393, 1627 }, { 1892, 1366, 1330, 1604 } } },
+    { 3007, { 1637, 1352, 1352, 1505 }, { 27, -31, -128, 1548 }, { 37.719, -17.774, -90.644 }, { 107.6, -85.0 }, { { 1695, 1411, 1385, 1701 }, { 1698, 1412, 1384, 1698 }, { 1754, 1416, 1380, 1642 }, { 1869, 1305, 1393, 1625 }, { 1891, 1367, 1331, 1603 } } },
+    { 3000, { 1637, 1352, 1352, 1505 }, { 27, -31, -128, 1548 }, { 34.469, -17.524, -95.144 }, { 107.6, -85.2 }, { { 1690, 1414, 1390, 1698 }, { 1693, 1415, 1389, 1695 }, { 1749, 1419, 1385, 1639 }, { 1868, 1306, 1396, 1622 }, { 1888, 1368, 1334, 1602 } } },
+    { 3000, { 1637, 1352, 1352, 1505 }, { 27, -31, -128, 1548 }, { 30.969, -18.024, -98.394 }, { 107.6, -85.3 }, { { 1687, 1415, 1393, 1697 }, { 1691, 1415, 1393, 1693 }, { 1745, 1419, 1389, 1639 }, { 1865, 1305, 1399, 1623 }, { 1885, 1367, 1337, 1603 } } },
+    { 2994, { 1614, 1352, 1352, 1503 }, { 21, -31, -128, 1546 }, { 25.969, -16.274, -101.894 }, { 107.6, -85.5 }, { { 1688, 1424, 1386, 1686 }, { 1691, 1423, 1387, 1683 }, { 1743, 1425, 1385, 1631 }, { 1864, 1308, 1396, 1616 }, { 1881, 1369, 1335, 1599 } } },
+    { 3000, { 1614, 1352, 1352, 1503 }, { 21, -31, -128, 1546 }, { 22.969, -16.774, -105.144 }, { 107.5, -85.6 }, { { 1685, 1423, 1391, 1685 }, { 1688, 1424, 1390, 1682 }, { 1738, 1426, 1388, 1632 }, { 1863, 1309, 1397, 1615 }, { 1879, 1369, 1337, 1599 } } },
+    { 3000, { 1614, 1352, 1352, 1503 }, { 21, -31, -128, 1546 }, { 20.219, -17.524, -109.144 }, { 107.4, -85.8 }, { { 1681, 1425, 1395, 1683 }, { 1685, 1425, 1395, 1679 }, { 1734, 1426, 1394, 1630 }, { 1863, 1311, 1399, 1611 }, { 1877, 1371, 1339, 1597 } } },
+    { 3007, { 1614, 1352, 1352, 1503 }, { 21, -31, -128, 1546 }, { 15.719, -16.274, -112.394 }, { 107.3, -85.9 }, { { 1676, 1426, 1400, 1682 }, { 1678, 1426, 1400, 1680 }, { 1728, 1428, 1398, 1630 }, { 1861, 1313, 1401, 1609 }, { 1873, 1373, 1341, 1597 } } },
+    { 3000, { 1614, 1352, 1352, 1503 }, { 21, -31, -128, 1546 }, { 11.469, -15.274, -116.394 }, { 107.1, -86.1 }, { { 1671, 1427, 1405, 1681 }, { 1674, 1428, 1404, 1678 }, { 1722, 1430, 1402, 1630 }, { 1858, 1314, 1404, 1608 }, { 1869, 1373, 1345, 1597 } } },
+    { 3007, { 1614, 1352, 1352, 1503 }, { 21, -31, -128, 1546 }, { 6.469, -15.524, -118.894 }, { 106.9, -86.3 }, { { 1666, 1426, 1410, 1682 }, { 1670, 1426, 1410, 1678 }, { 1717, 1429, 1407, 1631 }, { 1854, 1312, 1408, 1610 }, { 1865, 1371, 1349, 1599 } } },
+    { 2989, { 1614, 1352, 1352, 1503 }, { 21, -31, -128, 1546 }, { 4.219, -15.024, -122.144 }, { 106.7, -86.4 }, { { 1664, 1428, 1412, 1680 }, { 1666, 1428, 1412, 1678 }, { 1713, 1431, 1409, 1631 }, { 1850, 1312, 1412, 1610 }, { 1860, 1372, 1352, 1600 } } },
+    { 3009, { 1591, 1352, 1352, 1503 }, { 16, -31, -128, 1546 }, { -0.531, -14.274, -124.894 }, { 106.4, -86.6 }, { { 1666, 1434, 1410, 1674 }, { 1669, 1435, 1409, 1671 }, { 1713, 1435, 1409, 1627 }, { 1853, 1315, 1411, 1605 }, { 1860, 1374, 1352, 1598 } } },
+    { 3000, { 1591, 1352, 1352, 1503 }, { 16, -31, -128, 1546 }, { -3.031, -14.524, -128.144 }, { 106.1, -86.8 }, { { 1662, 1436, 1414, 1672 }, { 1665, 1437, 1413, 1669 }, { 1709, 1437, 1413, 1625 }, { 1851, 1317, 1413, 1603 }, { 1857, 1375, 1355, 1597 } } },
+    { 3000, { 1591, 1352, 1352, 1503 }, { 16, -31, -128, 1546 }, { -7.031, -13.774, -130.394 }, { 105.8, -86.9 }, { { 1660, 1436, 1416, 1672 }, { 1662, 1436, 1416, 1670 }, { 1705, 1437, 1415, 1627 }, { 1851, 1319, 1413, 1601 }, { 1855, 1377, 1355, 1597 } } },
+    { 2994, { 1591, 1352, 1352, 1503 }, { 16, -31, -128, 1546 }, { -9.281, -14.024, -133.894 }, { 105.4, -87.1 }, { { 1656, 1438, 1420, 1670 }, { 1660, 1438, 1420, 1666 }, { 1701, 1439, 1419, 1625 }, { 1851, 1321, 1415, 1597 }, { 1853, 1379, 1357, 1595 } } },
+    { 3000, { 1591, 1352, 1352, 1503 }, { 16, -31, -128, 1546 }, { -13.531, -12.524, -135.644 }, { 105.1, -87.3 }, { { 1654, 1438, 1422, 1670 }, { 1656, 1438, 1422, 1668 }, { 1697, 1439, 1421, 1627 }, { 1849, 1321, 1417, 1597 }, { 1849, 1379, 1359, 1597 } } },
+    { 3000, { 1591, 1352, 1352, 1503 }, { 16, -31, -128, 1546 }, { -16.531, -11.774, -138.894 }, { 104.7, -87.4 }, { { 1651, 1441, 1425, 1667 }, { 1652, 1440, 1426, 1666 }, { 1693, 1441, 1425, 1625 }, { 1846, 1322, 1420, 1596 }, { 1846, 1380, 1362, 1596 } } },
+    { 3007, { 1591, 1352, 1352, 1503 }, { 16, -31, -128, 1546 }, { -21.031, -12.024, -142.394 }, { 104.2, -87.6 }, { { 1646, 1440, 1430, 1668 }, { 1649, 1441, 1429, 1665 }, { 1688, 1442, 1428, 1626 }, { 1842, 1320, 1424, 1598 }, { 1843, 1379, 1365, 1597 } } },
+    { 2987, { 1566, 1352, 1352, 1501 }, { 10, -31, -128, 1545 }, { -23.281, -12.274, -144.644 }, { 103.8, -87.7 }, { { 1650, 1448, 1424, 1658 }, { 1653, 1449, 1423, 1655 }, { 1689, 1447, 1425, 1619 }, { 1844, 1326, 1420, 1590 }, { 1841, 1381, 1365, 1593 } } },
+    { 3000, { 1566, 1352, 1352, 1501 }, { 10, -31, -128, 1545 }, { -26.531, -12.524, -147.644 }, { 103.3, -87.9 }, { { 1648, 1448, 1428, 1656 }, { 1650, 1448, 1428, 1654 }, { 1685, 1447, 1429, 1619 }, { 1843, 1327, 1423, 1587 }, { 1838, 1384, 1366, 1592 } } },
+    { 3007, { 1566, 1352, 1352, 1501 }, { 10, -31, -128, 1545 }, { -28.781, -11.774, -150.644 }, { 102.8, -88.1 }, { { 1645, 1449, 1431, 1655 }, { 1647, 1449, 1431, 1653 }, { 1682, 1448, 1432, 1618 }, { 1844, 1330, 1422, 1584 }, { 1837, 1385, 1367, 1591 } } },
+    { 3000, { 1566, 1352, 1352, 1501 }, { 10, -31, -128, 1545 }, { -31.781, -11.774, -152.644 }, { 102.3, -88.3 }, { { 1642, 1450, 1434, 1654 }, { 1645, 1449, 1435, 1651 }, { 1679, 1449, 1435, 1617 }, { 1844, 1332, 1424, 1580 }, { 1835, 1387, 1369, 1589 } } },
+    { 3000, { 1566, 1352, 1352, 1501 }, { 10, -31, -128, 1545 }, { -35.031, -11.024, -155.644 }, { 101.7, -88.4 }, { { 1639, 1451, 1437, 1653 }, { 1642, 1450, 1438, 1650 }, { 1676, 1450, 1438, 1616 }, { 1843, 1333, 1425, 1579 }, { 1833, 1387, 1371, 1589 } } },
+    { 2994, { 1566, 1352, 1352, 1501 }, { 10, -31, -128, 1545 }, { -36.281, -11.774, -157.894 }, { 101.2, -88.6 }, { { 1638, 1452, 1440, 1650 }, { 1639, 1451, 1441, 1649 }, { 1673, 1451, 1441, 1615 }, { 1840, 1332, 1430, 1578 }, { 1829, 1387, 1375, 1589 } } },
+    { 3000, { 1541, 1352, 1352, 1501 }, { 4, -31, -128, 1545 }, { -40.031, -11.024, -160.394 }, { 100.6, -88.8 }, { { 1643, 1461, 1435, 1641 }, { 1645, 1461, 1435, 1639 }, { 1674, 1458, 1438, 1610 }, { 1843, 1337, 1427, 1573 }, { 1829, 1391, 1373, 1587 } } },
+    { 3000, { 1541, 1352, 1352, 1501 }, { 4, -31, -128, 1545 }, { -42.281, -11.774, -162.894 }, { 100.0, -88.9 }, { { 1640, 1462, 1438, 1640 }, { 1643, 1461, 1439, 1637 }, { 1671, 1459, 1441, 1609 }, { 1842, 1338, 1430, 1570 }, { 1826, 1392, 1376, 1586 } } },
+    { 3007, { 1541, 1352, 1352, 1501 }, { 4, -31, -128, 1545 }, { -45.781, -11.524, -165.144 }, { 99.3, -89.1 }, { { 1638, 1460, 1442, 1640 }, { 1640, 1460, 1442, 1638 }, { 1669, 1459, 1443, 1609 }, { 1841, 1341, 1431, 1567 }, { 1823, 1393, 1379, 1585 } } },
+    { 3000, { 1541, 1352, 1352, 1501 }, { 4, -31, -128, 1545 }, { -48.281, -10.274, -167.394 }, { 98.7, -89.3 }, { { 1634, 1462, 1444, 1640 }, { 1636, 1462, 1444, 1638 }, { 1664, 1460, 1446, 1610 }, { 1841, 1343, 1431, 1565 }, { 1822, 1394, 1380, 1584 } } },
+    { 3007, { 1541, 1352, 1352, 1501 }, { 4, -31, -128, 1545 }, { -50.031, -10.274, -169.394 }, { 98.0, -89.5 }, { { 1632, 1462, 1448, 1638 }, { 1634, 1462, 1448, 1636 }, { 1661, 1461, 1449, 1609 }, { 1838, 1344, 1434, 1564 }, { 1818, 1396, 1382, 1584 } } },
+    { 2987, { 1541, 1352, 1352, 1501 }, { 4, -31, -128, 1545 }, { -54.281, -10.024, -171.644 }, { 97.3, -89.6 }, { { 1629, 1461, 1451, 1639 }, { 1631, 1461, 1451, 1637 }, { 1657, 1461, 1451, 1611 }, { 1835, 1341, 1439, 1565 }, { 1814, 1394, 1386, 1586 } } },
+    { 3000, { 1541, 1352, 1352, 1501 }, { 4, -31, -128, 1545 }, { -57.781, -9.274, -173.394 }, { 96.5, -89.8 }, { { 1625, 1463, 1453, 1639 }, { 1627, 1463, 1453, 1637 }, { 1653, 1461, 1455, 1611 }, { 1831, 1339, 1443, 1567 }, { 1810, 1394, 1388, 1588 } } },
+    { 3000, { 1515, 1352, 1352, 1499 }, { 0, -31, -128, 1544 }, { -60.531, -9.274, -175.894 }, { 95.8, -90.0 }, { { 1626, 1466, 1450, 1634 }, { 1628, 1466, 1450, 1632 }, { 1652, 1464, 1452, 1608 }, { 1830, 1342, 1442, 1562 }, { 1807, 1395, 1389, 1585 } } },
+    { 3014, { 1515, 1352, 1352, 1499 }, { 0, -31, -128, 1544 }, { -63.031, -8.774, -178.644 }, { 95.0, -90.1 }, { { 1622, 1468, 1454, 1632 }, { 1624, 1468, 1454, 1630 }, { 1647, 1465, 1457, 1607 }, { 1828, 1344, 1444, 1560 }, { 1804, 1396, 1392, 1584 } } },
+    { 3000, { 1515, 1352, 1352, 1499 }, { 0, -31, -128, 1544 }, { -66.281, -8.274, -181.394 }, { 94.2, -90.3 }, { { 1619, 1469, 1457, 1631 }, { 1620, 1468, 1458, 1630 }, { 1642, 1466, 1460, 1608 }, { 1826, 1346, 1446, 1558 }, { 1800, 1398, 1394, 1584 } } },
+    { 3000, { 1515, 1352, 1352, 1499 }, { 0, -31, -128, 1544 }, { -68.781, -7.274, -182.144 }, { 93.4, -90.5 }, { { 1618, 1468, 1458, 1632 }, { 1619, 1467, 1459, 1631 }, { 1641, 1465, 1461, 1609 }, { 1825, 1347, 1447, 1557 }, { 1799, 1399, 1395, 1583 } } },
+    { 3058, { 1515, 1352, 1352, 1499 }, { 0, -31, -128, 1544 }, { -72.531, -7.274, -184.894 }, { 92.5, -90.6 }, { { 1614, 1468, 1462, 1632 }, { 1616, 1468, 1462, 1630 }, { 1636, 1466, 1464, 1610 }, { 1823, 1347, 1451, 1555 }, { 1794, 1400, 1398, 1584 } } },
+    { 2940, { 1515, 1352, 1352, 1499 }, { 0, -31, -128, 1544 }, { -74.281, -6.524, -185.894 }, { 91.6, -90.8 }, { { 1612, 1468, 1464, 1632 }, { 1614, 1468, 1464, 1630 }, { 1634, 1466, 1466, 1610 }, { 1820, 1346, 1454, 1556 }, { 1792, 1400, 1400, 1584 } } },
+    { 2987, { 1515, 1352, 1352, 1499 }, { 0, -31, -128, 1544 }, { -76.781, -6.024, -188.894 }, { 90.7, -90.9 }, { { 1608, 1470, 1468, 1630 }, { 1609, 1469, 1469, 1629 }, { 1629, 1469, 1469, 1609 }, { 1816, 1346, 1458, 1556 }, { 1787, 1401, 1403, 1585 } } },
+    { 3000, { 1489, 1352, 1352, 1499 }, { 0, -31, -128, 1544 }, { -78.281, -6.024, -190.394 }, { 89.8, -91.1 }, { { 1606, 1470, 1470, 1630 }, { 1608, 1470, 1470, 1628 }, { 1627, 1469, 1471, 1609 }, { 1814, 1346, 1460, 1556 }, { 1785, 1401, 1405, 1585 } } },
+    { 3007, { 1489, 1352, 1352, 1499 }, { 0, -31, -128, 1544 }, { -80.281, -5.274, -193.144 }, { 88.9, -91.2 }, { { 1603, 1471, 1473, 1629 }, { 1605, 1471, 1473, 1627 }, { 1623, 1471, 1473, 1609 }, { 1811, 1347, 1463, 1555 }, { 1782, 1402, 1408, 1584 } } },
+    { 3000, { 1489, 1352, 1352, 1499 }, { 0, -31, -128, 1544 }, { -82.781, -5.524, -194.644 }, { 88.0, -91.4 }, { { 1602, 1470, 1476, 1628 }, { 1603, 1471, 1475, 1627 }, { 1621, 1471, 1475, 1609 }, { 1809, 1347, 1467, 1553 }, { 1779, 1403, 1411, 1583 } } },
+    { 3000, { 1489, 1352, 1352, 1499 }, { 0, -31, -128, 1544 }, { -84.531, -5.274, -195.894 }, { 87.0, -91.5 }, { { 1600, 1470, 1478, 1628 }, { 1602, 1470, 1478, 1626 }, { 1619, 1471, 1477, 1609 }, { 1807, 1347, 1469, 1553 }, { 1776, 1404, 1412, 1584 } } },
+    { 2994, { 1489, 1352, 1352, 1499 }, { 0, -31, -128, 1544 }, { -86.281, -4.774, -197.394 }, { 86.1, -91.6 }, { { 1598, 1472, 1480, 1626 }, { 1599, 1471, 1481, 1625 }, { 1616, 1472, 1480, 1608 }, { 1807, 1347, 1471, 1551 }, { 1774, 1404, 1414, 1584 } } },
+};
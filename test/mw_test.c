@@ -0,0 +1,96 @@
+// mw.c / mixer.c: the real_t PID controllers and the mixer replay a recorded flight (mw_sequence.h).
+// The float build has to give the recorded float motor outputs exactly, OPTIONS=FIXEDPOINT within PID_MOTOR_MAX / PID_MOTOR_MEAN us.
+// mw_test -g prints mw_sequence.h with the motor columns of this build, after an intended change of the float path.
+
+#include "test.h"
+#include "mw.c"
+
+#define PID_MOTOR_MAX  2                                    // us, any motor, any sample
+#define PID_MOTOR_MEAN 0.1                                  // us, mean absolute difference over a run
+
+#include "mw_replay.h"
+
+static int16_t pidOut[PID_RUNS][PID_SAMPLES][4];
+
+static void pidReplay(void)
+{
+    uint32_t r, n;
+
+    for (r = 0; r < PID_RUNS; r++)
+    {
+        pidReset(r);
+        for (n = 0; n < PID_SAMPLES; n++)
+        {
+            pidStep(&pidSequence[n]);
+            memcpy(pidOut[r][n], motor, sizeof(pidOut[r][n]));
+        }
+    }
+}
+
+static void pidPrintSequence(void)                          // mw_sequence.h with the outputs of this build
+{
+    const pidSample_t *s;
+    uint32_t          r, n;
+
+    testLog("// Recorded sequence for test/mw_test.c, %u consecutive taskControl inputs (looptime 3000).\n", (unsigned)PID_SAMPLES);
+    testLog("// Recorded in SITL in ANGLE mode during the hover, with a roll stick sine, pitch and yaw stick steps,\n");
+    testLog("// by printing the inputs of computePID. The motor columns are the outputs of the float build for each\n");
+    testLog("// entry of pidRuns in mw_test.c: obj/test/float/mw_test -g > test/mw_sequence.h rewrites them.\n");
+    testLog("\nstatic const pidSample_t pidSequence[] =\n{\n");
+    for (n = 0; n < PID_SAMPLES; n++)
+    {
+        s = &pidSequence[n];
+        testLog("    { %u, { %d, %d, %d, %d }, { %d, %d, %d, %d }, { %.3f, %.3f, %.3f }, { %.1f, %.1f }, {", s->cycleTime,
+                s->rcData[0], s->rcData[1], s->rcData[2], s->rcData[3], s->rcCommand[0], s->rcCommand[1], s->rcCommand[2], s->rcCommand[3],
+                s->gyroData[0], s->gyroData[1], s->gyroData[2], s->angle[0], s->angle[1]);
+        for (r = 0; r < PID_RUNS; r++)
+            testLog(" { %d, %d, %d, %d }%s", pidOut[r][n][0], pidOut[r][n][1], pidOut[r][n][2], pidOut[r][n][3], r + 1 < PID_RUNS ? "," : "");
+        testLog(" } },\n");
+    }
+    testLog("};\n");
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t r, n, i;
+    int      d, dMax;
+    double   dSum;
+
+    checkFirstTime(true);
+    NumberOfMotors = mixerInit();
+    newpidimax     = itor(cfg.newpidimax);
+    f.ARMED        = 1;
+    pidReplay();
+
+    if (argc > 1 && !strcmp(argv[1], "-g"))
+    {
+        pidPrintSequence();
+        return 0;
+    }
+
+    for (r = 0; r < PID_RUNS; r++)
+    {
+        dMax = 0;
+        dSum = 0;
+        for (n = 0; n < PID_SAMPLES; n++)
+            for (i = 0; i < 4; i++)
+            {
+                d     = abs(pidOut[r][n][i] - pidSequence[n].motor[r][i]);
+                dMax  = max(dMax, d);
+                dSum += d;
+            }
+        dSum /= PID_SAMPLES * 4;
+        testLog("%-24s motors against float: max %d us, mean %.3f us\n", pidRuns[r].name, dMax, dSum);
+#ifdef FIXEDPOINT
+        CHECK(dMax <= PID_MOTOR_MAX);
+        CHECK(dSum <= PID_MOTOR_MEAN);
+#else
+        CHECK(dMax == 0);
+#endif
+    }
+#ifdef FIXEDPOINT
+    return testDone("mw FIXEDPOINT");
+#else
+    return testDone("mw");
+#endif
+}
@@ -0,0 +1,371 @@
+// sensors.c / drv_mpu6050.c, gy_fifo: MPU6050 FIFO byte streams of a known coning motion through mpuFifoRead and
+// gyroConing, GyroDelta against the exact rotation. The body axis cones around z: R(t) = Rz(W t) Rx(A) Rz(-W t),
+// body rate W (-sin A sin W t, sin A cos W t, cos A - 1). Every FIFO sample is the integrated rate over its 1ms, rounded
+// to the gyro LSB with the rounding carried on, as an integrating gyro would give it. The i2c jobs of the driver are
+// served here from the byte stream, instead of by src/sitl/sitl_i2c.c.
+// What is left is the coning inside the 1ms samples, that no algorithm on the samples sees: a drift of
+// 1/2 W sin^2 A (1 - sin(W T) / (W T)) rad/s with T = 1ms. Adding the samples up leaves the same with T = the loop.
+// ellipsoidFitSolve (mag_ellip): points of a known hard / soft iron ellipsoid, with noise, and the cases it must refuse.
+
+#include "test.h"
+#include "drv_mpu6050.c"
+#include "sensors.c"
+
+#define CONE_A      (2.0 * M_PI / 180.0)                    // Half cone angle
+#define CONE_W      (2.0 * M_PI * 30.0)                     // Cone frequency, rad/s
+#define CONE_LOOPS  333                                     // ca. 1s
+#define LOOP_TOL    6e-6                                    // rad, GyroDelta of one loop against the exact rotation
+
+static uint8_t  fifo[MPU_FIFO_SIZE];
+static uint16_t fifoLen;
+static uint32_t fifoResets;
+static uint32_t sampleNo;
+static double   carry[3];                                   // Rounding carried into the next sample, chip axes
+
+// The i2c bus, one MPU6050 on it. Jobs are through at once, done callbacks run inside i2cSubmit
+
+bool i2cSubmit(i2cJob_t *j)
+{
+    uint16_t n;
+
+    j->state = I2C_JOB_DONE;
+    if (j->addr != MPU6050_ADDRESS)
+        j->state = I2C_JOB_ERROR;
+    else if (!j->read)
+    {
+        if (j->reg == MPU_RA_USER_CTRL && (j->buf[0] & 0x04))   // FIFO_RESET
+        {
+            fifoLen = 0;
+            fifoResets++;
+        }
+    }
+    else if (j->reg == MPU_RA_FIFO_COUNTH)
+    {
+        j->buf[0] = fifoLen >> 8;
+        j->buf[1] = fifoLen;
+    }
+    else if (j->reg == MPU_RA_FIFO_R_W)
+    {
+        n = min(j->len, fifoLen);
+        memcpy(j->buf, fifo, n);
+        memmove(fifo, fifo + n, fifoLen - n);
+        fifoLen -= n;
+    }
+    else
+        memset(j->buf, 0, j->len);
+    if (j->done) j->done(j);
+    return true;
+}
+
+bool i2cWait(i2cJob_t *j)
+{
+    return j->state == I2C_JOB_DONE;
+}
+
+static bool i2cTransfer(uint8_t addr_, uint8_t reg_, uint8_t len_, uint8_t *buf, bool read)
+{
+    i2cJob_t j = { addr_, reg_, len_, read, buf, NULL, I2C_JOB_IDLE };
+    return i2cSubmit(&j) && i2cWait(&j);
+}
+
+bool i2cRead(uint8_t addr_, uint8_t reg_, uint8_t len, uint8_t *buf) { return i2cTransfer(addr_, reg_, len, buf, true); }
+bool i2cWriteBuffer(uint8_t addr_, uint8_t reg_, uint8_t len_, uint8_t *data) { return i2cTransfer(addr_, reg_, len_, data, false); }
+bool i2cWrite(uint8_t addr_, uint8_t reg_, uint8_t data) { return i2cWriteBuffer(addr_, reg_, 1, &data); }
+void i2cInit(I2C_TypeDef *I2Cx) { (void)I2Cx; }
+void i2cPoll(void) { }
+uint16_t i2cGetErrorCounter(void) { return 0; }
+void sitlI2cInit(void) { }
+void sitlI2cUpdate(void) { }
+void sitlMpuSample(void) { }
+
+// The coning motion
+
+typedef double mat3[3][3];
+
+static void coneAttitude(double t, mat3 r)                  // Rz(W t) Rx(A) Rz(-W t)
+{
+    double c = cos(CONE_W * t), s = sin(CONE_W * t), ca = cos(CONE_A), sa = sin(CONE_A);
+    mat3   z = { { c, -s, 0 }, { s, c, 0 }, { 0, 0, 1 } }, x = { { 1, 0, 0 }, { 0, ca, -sa }, { 0, sa, ca } }, zx;
+    int    i, k, m;
+
+    for (i = 0; i < 3; i++)
+        for (k = 0; k < 3; k++)
+            for (zx[i][k] = 0, m = 0; m < 3; m++) zx[i][k] += z[i][m] * x[m][k];
+    for (i = 0; i < 3; i++)
+        for (k = 0; k < 3; k++)
+            r[i][k] = zx[i][0] * z[k][0] + zx[i][1] * z[k][1] + zx[i][2] * z[k][2];  // * Rz(-W t) = * Rz(W t)^T
+}
+
+static void mulT(mat3 a, mat3 b, mat3 r)                    // a^T b
+{
+    int i, k;
+    for (i = 0; i < 3; i++)
+        for (k = 0; k < 3; k++) r[i][k] = a[0][i] * b[0][k] + a[1][i] * b[1][k] + a[2][i] * b[2][k];
+}
+
+static void expRot(const double *v, mat3 r)                 // Rotation vector to matrix
+{
+    double th = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]), a = th > 1e-12 ? sin(th) / th : 1, b = th > 1e-12 ? (1 - cos(th)) / (th * th) : 0.5;
+    mat3   k = { { 0, -v[2], v[1] }, { v[2], 0, -v[0] }, { -v[1], v[0], 0 } };
+    int    i, j, m;
+    double kk;
+
+    for (i = 0; i < 3; i++)
+        for (j = 0; j < 3; j++)
+        {
+            for (kk = 0, m = 0; m < 3; m++) kk += k[i][m] * k[m][j];
+            r[i][j] = (i == j) + a * k[i][j] + b * kk;
+        }
+}
+
+static void logRot(mat3 r, double *v)                       // Matrix to rotation vector, small angles
+{
+    double c = (r[0][0] + r[1][1] + r[2][2] - 1) / 2, th = acos(c > 1 ? 1 : c), f = th > 1e-12 ? th / (2 * sin(th)) : 0.5;
+    v[0] = f * (r[2][1] - r[1][2]);
+    v[1] = f * (r[0][2] - r[2][0]);
+    v[2] = f * (r[1][0] - r[0][1]);
+}
+
+static double rotDiff(mat3 a, mat3 b)                       // Angle of a^T b
+{
+    mat3   d;
+    double v[3];
+    mulT(a, b, d);
+    logRot(d, v);
+    return sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+static void put16(uint8_t *p, int32_t v)
+{
+    v    = constrain(v, -32768, 32767);
+    p[0] = (uint16_t)v >> 8;
+    p[1] = v;
+}
+
+static void fifoPush(uint8_t n)                             // n samples of the cone, 1KHz, into the FIFO
+{
+    double  t0, t1, th[3], raw;
+    float   scale = 0.25f * GyroScale * MPU_SAMPLE_US;      // rad per LSB and sample, as in gyroConing
+    int32_t chip[3];
+    uint8_t *p, i, k;
+
+    for (i = 0; i < n; i++, sampleNo++)
+    {
+        t0    = sampleNo * MPU_SAMPLE_US * 1e-6;
+        t1    = t0 + MPU_SAMPLE_US * 1e-6;
+        th[0] = sin(CONE_A) * (cos(CONE_W * t1) - cos(CONE_W * t0));   // Body rate integrated over the sample
+        th[1] = sin(CONE_A) * (sin(CONE_W * t1) - sin(CONE_W * t0));
+        th[2] = (cos(CONE_A) - 1) * CONE_W * (t1 - t0);
+        for (k = 0; k < 3; k++)                             // gyroConing's frame is (PITCH, -ROLL, -YAW), chip axes are (ROLL, PITCH, -YAW)
+        {
+            raw      = (k == 0 ? -th[1] : k == 1 ? th[0] : th[2]) / scale + carry[k];
+            chip[k]  = lrint(raw);
+            carry[k] = raw - chip[k];
+        }
+        p = &fifo[fifoLen];
+        put16(p + 0, 0);                                    // acc x y z, 1G on z
+        put16(p + 2, 0);
+        put16(p + 4, 4096);
+        put16(p + 6, 0);                                    // temp
+        put16(p + 8, chip[0]);
+        put16(p + 10, chip[1]);
+        put16(p + 12, chip[2]);
+        fifoLen += MPU_FIFO_FRAME;
+    }
+}
+
+static void testCone(void)
+{
+    static const uint8_t perLoop[] = { 3, 3, 2, 4, 3, 1, 3, 5 }; // Loop jitter, the FIFO has a different count every time
+    mat3     r0, r1, truth, d, est, tmp, naiveEst, one = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    double   phi[3], naive[3], drift, err, errMax = 0, naiveErr, naiveMax = 0;
+    uint32_t loop, start;
+    int      i, k, m;
+
+    memcpy(est, one, sizeof(mat3));
+    memcpy(naiveEst, one, sizeof(mat3));
+    coneAttitude(0, r0);
+    for (loop = 0; loop < CONE_LOOPS; loop++)
+    {
+        start = sampleNo;
+        fifoPush(perLoop[loop % sizeof(perLoop)]);
+        coneAttitude(start * MPU_SAMPLE_US * 1e-6, r0);
+        GETMPU6050();
+        CHECK(GyroDeltaValid);
+        coneAttitude(sampleNo * MPU_SAMPLE_US * 1e-6, r1);
+        mulT(r0, r1, truth);                                // This loop's rotation in the body frame
+        phi[0] =  GyroDelta[PITCH];
+        phi[1] = -GyroDelta[ROLL];
+        phi[2] = -GyroDelta[YAW];
+        for (naive[0] = naive[1] = naive[2] = 0, i = start; i < (int)sampleNo; i++) // What the plain sum of the samples would give
+        {
+            double t0 = i * 1e-3, t1 = t0 + 1e-3;
+            naive[0] += sin(CONE_A) * (cos(CONE_W * t1) - cos(CONE_W * t0));
+            naive[1] += sin(CONE_A) * (sin(CONE_W * t1) - sin(CONE_W * t0));
+            naive[2] += (cos(CONE_A) - 1) * CONE_W * (t1 - t0);
+        }
+        expRot(phi, d);
+        err      = rotDiff(truth, d);
+        errMax   = max(errMax, err);
+        expRot(naive, d);
+        naiveErr = rotDiff(truth, d);
+        naiveMax = max(naiveMax, naiveErr);
+        expRot(phi, d);
+        for (i = 0; i < 3; i++)
+            for (k = 0; k < 3; k++)
+                for (tmp[i][k] = 0, m = 0; m < 3; m++) tmp[i][k] += est[i][m] * d[m][k];
+        memcpy(est, tmp, sizeof(mat3));
+        expRot(naive, d);
+        for (i = 0; i < 3; i++)
+            for (k = 0; k < 3; k++)
+                for (tmp[i][k] = 0, m = 0; m < 3; m++) tmp[i][k] += naiveEst[i][m] * d[m][k];
+        memcpy(naiveEst, tmp, sizeof(mat3));
+    }
+    coneAttitude(0, r0);
+    coneAttitude(sampleNo * MPU_SAMPLE_US * 1e-6, r1);
+    mulT(r0, r1, truth);
+    err      = rotDiff(truth, est);
+    naiveErr = rotDiff(truth, naiveEst);
+    testLog("cone %.0f deg %.0f Hz, %u samples in %u loops: GyroDelta max %.2e rad per loop, %.2e rad after the run\n",
+            CONE_A * 180 / M_PI, CONE_W / (2 * M_PI), (unsigned)sampleNo, CONE_LOOPS, errMax, err);
+    testLog("plain sum of the samples: max %.2e rad per loop, %.2e rad after the run\n", naiveMax, naiveErr);
+    drift = 0.5 * CONE_W * sin(CONE_A) * sin(CONE_A) * (1 - sin(CONE_W * 1e-3) / (CONE_W * 1e-3)) * sampleNo * 1e-3;
+    testLog("drift of the coning inside the samples: %.2e rad\n", drift);
+    CHECK(errMax < LOOP_TOL);
+    CHECK_NEAR(err, drift, 0.03 * drift);
+    CHECK(naiveErr > 10 * err);                             // The coning term is what makes the difference
+    CHECK(fifoLen == 0 && fifoResets == 0);
+}
+
+static void testFifoStates(void)
+{
+    int16_t acc16[3], gyro16[MPU_FIFO_MAX][3];
+    float   temp;
+    uint8_t i;
+
+    CHECK(mpuFifoRead(acc16, &temp, gyro16) == -1);         // Empty: nothing new
+    GETMPU6050();                                           // No time covered, no rotation
+    CHECK(GyroDeltaValid && GyroDelta[0] == 0 && GyroDelta[1] == 0 && GyroDelta[2] == 0);
+
+    fifoPush(MPU_FIFO_MAX + 4);                             // More than one loop drains, the rest comes next time
+    CHECK(mpuFifoRead(acc16, &temp, gyro16) == MPU_FIFO_MAX);
+    CHECK(acc16[2] == 4096);
+    CHECK(mpuFifoRead(acc16, &temp, gyro16) == 4);
+
+    fifoPush(2);
+    fifoLen += 5;                                           // A partial frame: only the whole ones are read
+    CHECK(mpuFifoRead(acc16, &temp, gyro16) == 2);
+    CHECK(fifoLen == 5);
+
+    fifoLen = 0;
+    for (i = 0; i < MPU_FIFO_SIZE / MPU_FIFO_FRAME; i++) fifoPush(1);
+    fifoLen = MPU_FIFO_SIZE;                                // Full, the count sticks at the top: overflow, reset, 0
+    CHECK(mpuFifoRead(acc16, &temp, gyro16) == 0);
+    CHECK(fifoResets == 1 && fifoLen == 0);
+    CHECK(!mpuFifoOverflow);
+}
+
+// Ellipsoid fit. raw = center + W^-1 * u with u on a sphere, the fit must give back center and W (determinant 1)
+
+#define ELLIP_POINTS  500
+#define ELLIP_R       400.0                                 // LSB, ca. the earth field of the HMC5883L at gain 1
+#define ELLIP_NOISE   2.0                                   // LSB, uniform +-
+#define CENTER_TOL    0.5                                   // LSB
+#define SOFT_TOL      0.002
+
+static double ellipNoise(void)
+{
+    static uint32_t s = 12345;
+    s = s * 1664525 + 1013904223;
+    return ((s >> 8) / 16777216.0 - 0.5) * 2 * ELLIP_NOISE;
+}
+
+static bool ellipFit(const double c[3], double W[3][3], double noise, float center[3], float soft[3][3], bool plane)
+{
+    ellipsoidFit_t fit;
+    double         inv[3][3], u[3], det, z, r;
+    uint16_t       n;
+    uint8_t        i, j;
+
+    det = W[0][0] * (W[1][1] * W[2][2] - W[1][2] * W[2][1]) - W[0][1] * (W[1][0] * W[2][2] - W[1][2] * W[2][0]) +
+          W[0][2] * (W[1][0] * W[2][1] - W[1][1] * W[2][0]);
+    for (i = 0; i < 3; i++)                                 // Cofactors, W is symmetric
+    {
+        for (j = 0; j < 3; j++)
+        {
+            inv[i][j] = (W[(j + 1) % 3][(i + 1) % 3] * W[(j + 2) % 3][(i + 2) % 3] -
+                         W[(j + 1) % 3][(i + 2) % 3] * W[(j + 2) % 3][(i + 1) % 3]) / det;
+        }
+    }
+    ellipsoidFitClear(&fit);
+    for (n = 0; n < ELLIP_POINTS; n++)                      // Fibonacci sphere, plane: the equator only
+    {
+        z    = plane ? 0 : 1 - (2 * n + 1.0) / ELLIP_POINTS;
+        r    = sqrt(1 - z * z);
+        u[0] = ELLIP_R * r * cos(n * 2.39996323);
+        u[1] = ELLIP_R * r * sin(n * 2.39996323);
+        u[2] = ELLIP_R * z;
+        ellipsoidFitPush(&fit, c[0] + inv[0][0] * u[0] + inv[0][1] * u[1] + inv[0][2] * u[2] + noise * ellipNoise(),
+                               c[1] + inv[1][0] * u[0] + inv[1][1] * u[1] + inv[1][2] * u[2] + noise * ellipNoise(),
+                               c[2] + inv[2][0] * u[0] + inv[2][1] * u[1] + inv[2][2] * u[2] + noise * ellipNoise());
+    }
+    return ellipsoidFitSolve(&fit, center, soft);
+}
+
+static void testEllipsoid(void)
+{
+    static const double c[3] = { 120, -60, 35 };
+    double              W[3][3], R[3][3], e[3], a = 0.5, b = 0.3, centerErr = 0, softErr = 0;
+    float               center[3], soft[3][3];
+    uint8_t             i, j, k;
+
+    R[0][0] = cos(a);           R[0][1] = -sin(a);          R[0][2] = 0;                // Rz(a) * Rx(b)
+    R[1][0] = sin(a) * cos(b);  R[1][1] = cos(a) * cos(b);  R[1][2] = -sin(b);
+    R[2][0] = sin(a) * sin(b);  R[2][1] = cos(a) * sin(b);  R[2][2] = cos(b);
+    e[0] = 1.25;                                            // Axes 1 : 0.85 : 1.47, determinant 1
+    e[1] = 0.8;
+    e[2] = 1 / (e[0] * e[1]);
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            for (W[i][j] = 0, k = 0; k < 3; k++) W[i][j] += R[i][k] * e[k] * R[j][k];
+        }
+    }
+    CHECK(ellipFit(c, W, 1, center, soft, false));
+    for (i = 0; i < 3; i++)
+    {
+        centerErr = fmax(centerErr, fabs(center[i] - c[i]));
+        for (j = 0; j < 3; j++) softErr = fmax(softErr, fabs(soft[i][j] - W[i][j]));
+    }
+    testLog("ellipsoid fit, %d points +-%.0f LSB noise: center within %.3f LSB, soft iron within %.4f\n", ELLIP_POINTS,
+            ELLIP_NOISE, centerErr, softErr);
+    CHECK(centerErr < CENTER_TOL && softErr < SOFT_TOL);
+    CHECK(fabs(soft[0][1] - soft[1][0]) < 1e-5 && fabs(soft[1][2] - soft[2][1]) < 1e-5);   // Symmetric: no extra rotation
+
+    CHECK(!ellipFit(c, W, 0, center, soft, true));          // All points in one plane: degenerated
+    e[0] = 2.5;                                             // Longest / shortest axis 5 > ELLIPmaxratio: bad data, no soft iron
+    e[1] = 0.8;
+    e[2] = 0.5;
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 3; j++) W[i][j] = i == j ? e[i] : 0;
+    }
+    CHECK(!ellipFit(c, W, 1, center, soft, false));
+}
+
+int main(void)
+{
+    checkFirstTime(true);
+    cfg.gy_fifo  = 1;
+    f.ARMED      = 1;                                       // No bias window
+    GyroScale    = ((32767.0f / 16.4f) * M_PI) / ((32767.0f / 4.0f) * 180.0f * 1000000.0f); // sensorsAutodetect, MPU6050
+    mpuFifo      = true;
+    acc.align    = mpu6050AccAlign;
+    gyro.align   = mpu6050GyroAlign;
+
+    testCone();
+    testFifoStates();
+    testEllipsoid();
+    return testDone("sensors");
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// Host stand-in for lib/CMSIS/CM3/CoreSupport/core_cm3.h, for the test/drv_*_test.c programs that compile
+// a NAZE driver against faked peripheral registers. The core intrinsics are left to the test: its
+// __enable_irq is where the faked hardware moves on and raises the pending interrupts.
+
+#include <stdint.h>
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+
+void __enable_irq(void);
+void __disable_irq(void);
+void __DMB(void);
+void __NOP(void);
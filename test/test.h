@@ -0,0 +1,76 @@
+#pragma once
+
+// Host tests and benchmarks, built and run by "make test" / "make bench" (see the Makefile).
+// Every test is one program: it includes or links the code under test, checks with CHECK / CHECK_NEAR,
+// and returns testDone() from main, non zero when a check failed.
+// Include this first: board.h turns printf into the firmware's tfp_printf, print with testLog instead.
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+
+static int testChecks __attribute__((unused)), testFailures __attribute__((unused));
+
+static inline void testLog(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+}
+
+static inline bool testCheck(bool ok, const char *file, int line, const char *what)
+{
+    testChecks++;
+    if (!ok)
+    {
+        testFailures++;
+        printf("%s:%d: FAILED %s\n", file, line, what);
+    }
+    return ok;
+}
+
+#define CHECK(cond)             testCheck((cond), __FILE__, __LINE__, #cond)
+#define CHECK_NEAR(a, b, tol)   testCheck(fabs((double)(a) - (double)(b)) <= (tol), __FILE__, __LINE__, #a " ~ " #b " +- " #tol) // tol is absolute
+
+static inline int testDone(const char *name)
+{
+    printf("%s: %d checks, %d failed\n", name, testChecks, testFailures);
+    return testFailures != 0;
+}
+
+static inline void benchReport(const char *name, double cycles)
+{
+    printf("%-40s %10.1f cycles\n", name, cycles);
+}
+
+static inline uint64_t benchCycles(void)                    // Host cpu cycles (TSC on x86), or ns where there is none
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint32_t lo, hi;
+    __asm__ volatile ("rdtsc" : "=a" (lo), "=d" (hi));
+    return ((uint64_t)hi << 32) | lo;
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + t.tv_nsec;
+#endif
+}
+
+// Cycles per call of stmt, the best of 5 runs of n calls. Host numbers, only the ratios carry over to the cortex-m3
+#define BENCH(name, n, stmt)                                                            \
+    do {                                                                                \
+        uint64_t best_ = UINT64_MAX, t_;                                                \
+        int      r_, i_;                                                                \
+        for (r_ = 0; r_ < 5; r_++)                                                      \
+        {                                                                               \
+            t_ = benchCycles();                                                         \
+            for (i_ = 0; i_ < (n); i_++) { stmt; }                                      \
+            t_ = benchCycles() - t_;                                                    \
+            if (t_ < best_) best_ = t_;                                                 \
+        }                                                                               \
+        benchReport(name, (double)best_ / (n));                                         \
+    } while (0)
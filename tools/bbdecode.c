@@ -0,0 +1,417 @@
+// Host decoder for the blackbox of the firmware (src/blackbox.c), logs to CSV.
+// Input is the raw log (assembled from MSP_BLACKBOX replies) or the text of cli "bb dump" ("offset:hex" lines),
+// from a file or stdin. Every log starts with its 'H' frame that names the fields and their predictions, so nothing
+// here depends on the field list of the firmware. All logs go to stdout, each with its CSV header line, or the one
+// picked with -n. A summary per log goes to stderr.
+// Live (-s): the stream of st_div > 0 from a serial port (-b baud, default 115200) or from host:port (SITL uart1).
+// Frames '$' 'S' len frame crc8, anything else on the line (MSP replies) is skipped. The 'H' frame comes every second,
+// the CSV header is printed again only when it changed. Runs until the end of the input or Ctrl-C, then prints the
+// frames, CRC errors and the frames missing by the time stamps (dropped in the firmware or lost on the line).
+// Build: make bbdecode (host compiler), or cc -O2 -o bbdecode tools/bbdecode.c
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <signal.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#define MAX_FIELDS 64
+
+enum
+{
+    PRED_NONE = 0,
+    PRED_PREV,
+    PRED_STRAIGHT
+};
+
+typedef struct
+{
+    uint32_t period;
+    uint32_t count;
+    uint8_t  pred[MAX_FIELDS];
+    char     name[MAX_FIELDS][16];
+    int32_t  prev[2][MAX_FIELDS];
+    uint32_t iframes, pframes, skipped, bytes;
+    uint32_t firstTime, lastTime;
+    uint32_t crcErrors, missing;                                            // Live only
+    int      haveI;
+} bbLog_t;
+
+static uint8_t *data;
+static size_t  size;
+static volatile sig_atomic_t stop;
+
+static int readVar(size_t *pos, uint32_t *v)                                // 0 at the end of the data or on a varint > 32 bit
+{
+    uint32_t shift = 0;
+    *v = 0;
+    while (*pos < size && shift < 35)
+    {
+        uint8_t c = data[(*pos)++];
+        *v |= (uint32_t)(c & 0x7F) << shift;
+        if (!(c & 0x80)) return 1;
+        shift += 7;
+    }
+    return 0;
+}
+
+static int hexval(int c)
+{
+    return isdigit(c) ? c - '0' : tolower(c) - 'a' + 10;
+}
+
+static void load(FILE *fp)
+{
+    size_t  cap = 1 << 16, n, i, k;
+    uint8_t *text;
+
+    data = malloc(cap);
+    while ((n = fread(data + size, 1, cap - size, fp)) > 0)
+    {
+        size += n;
+        if (size == cap) data = realloc(data, cap *= 2);
+    }
+    for (i = 0; i + 6 <= size && (memcmp(&data[i], "00000:", 6) || (i && data[i - 1] != '\n')); i++);
+    if (i + 6 > size) return;                                               // Raw
+    text = data;                                                            // cli "bb dump": offset:hex per line, in place. Other lines
+                                                                            // (the rest of the cli session) are skipped
+    for (i = 0, n = 0; i < size;)
+    {
+        for (k = i; k < size && text[k] != '\n'; k++);
+        if (k - i > 6 && text[i + 5] == ':' && isxdigit(text[i]) && isxdigit(text[i + 1]) && isxdigit(text[i + 2]) && isxdigit(text[i + 3]) && isxdigit(text[i + 4]))
+        {
+            for (i += 6; i + 1 < k && isxdigit(text[i]) && isxdigit(text[i + 1]); i += 2) data[n++] = hexval(text[i]) << 4 | hexval(text[i + 1]);
+        }
+        i = k + 1;
+    }
+    size = n;
+}
+
+static int header(bbLog_t *log, size_t *pos)                                // Behind the 'H', 0 if broken
+{
+    uint32_t i;
+
+    if (*pos + 4 > size || memcmp(&data[*pos], "BBX1", 4)) return 0;
+    *pos += 4;
+    if (!readVar(pos, &log->period) || !readVar(pos, &log->count) || log->count > MAX_FIELDS) return 0;
+    for (i = 0; i < log->count; i++)
+    {
+        size_t k = 0;
+        if (*pos >= size) return 0;
+        log->pred[i] = data[(*pos)++];
+        while (*pos < size && data[*pos]) if (k < sizeof(log->name[i]) - 1) log->name[i][k++] = data[(*pos)++]; else (*pos)++;
+        (*pos)++;
+    }
+    return 1;
+}
+
+static int values(bbLog_t *log, size_t *pos, int iframe)                    // Behind the 'I' / 'P' into log->prev, 0 if broken
+{
+    uint32_t v, i, pred;
+    int32_t  value;
+
+    for (i = 0; i < log->count; i++)                                        // Modulo 2^32 like the encoder, no signed overflow
+    {
+        if (!readVar(pos, &v)) return 0;
+        if (iframe) pred = 0;
+        else if (log->pred[i] == PRED_STRAIGHT) pred = 2 * (uint32_t)log->prev[0][i] - (uint32_t)log->prev[1][i];
+        else if (log->pred[i] == PRED_PREV) pred = log->prev[0][i];
+        else pred = 0;
+        value = (int32_t)(((v >> 1) ^ (0 - (v & 1))) + pred);
+        log->prev[1][i] = iframe ? value : log->prev[0][i];
+        log->prev[0][i] = value;
+    }
+    return 1;
+}
+
+static void printHeader(const bbLog_t *log)
+{
+    uint32_t i;
+    printf("log");
+    for (i = 0; i < log->count; i++) printf(",%s", log->name[i]);
+    printf("\n");
+}
+
+static void printFrame(const bbLog_t *log, int nr)
+{
+    uint32_t i;
+    printf("%d,%u", nr, (uint32_t)log->prev[0][0]);                         // Time, unsigned like micros()
+    for (i = 1; i < log->count; i++) printf(",%d", log->prev[0][i]);
+    printf("\n");
+}
+
+static void summary(const bbLog_t *log, int nr)
+{
+    uint32_t frames = log->iframes + log->pframes;
+    if (!frames) return;
+    fprintf(stderr, "log %d: %u frames (%u I), %.1fs, %u us period, %u B, %.1f B/frame, %u B skipped\n", nr, frames, log->iframes,
+            (log->lastTime - log->firstTime) * 1e-6, log->period, log->bytes, (double)log->bytes / frames, log->skipped);
+}
+
+static void decodeLog(FILE *fp, int want)                                   // Flash: all logs, or log number want
+{
+    bbLog_t  log;
+    size_t   pos = 0, start;
+    uint32_t i;
+    int      nr = 0, out, ok;
+
+    load(fp);
+    memset(&log, 0, sizeof(log));
+
+    while (pos < size)
+    {
+        start = pos;
+        switch (data[pos++])
+        {
+        case 0x00:                                                          // Padding behind 'E'
+            break;
+        case 0xFF:                                                          // Erased flash, the end
+            pos = size;
+            break;
+        case 'H':
+            summary(&log, nr);
+            memset(&log, 0, sizeof(log));
+            nr++;
+            if (!header(&log, &pos)) goto resync;
+            log.bytes = pos - start;
+            if (!want || want == nr) printHeader(&log);
+            break;
+        case 'I':
+        case 'P':
+            if (!log.count) goto resync;
+            out = (!want || want == nr) && (data[start] == 'I' || log.haveI);
+            ok  = values(&log, &pos, data[start] == 'I');
+            if (!ok) break;
+            for (i = start + 1; i < pos && (i + 5 > size || memcmp(&data[i], "HBBX1", 5)); i++);
+            if (i < pos)                                                    // Torn by a power loss, the next log starts in there
+            {
+                log.skipped += i - start;
+                pos = i;
+                break;
+            }
+            log.bytes += pos - start;
+            if (data[start] == 'I')
+            {
+                log.haveI = 1;
+                log.iframes++;
+            }
+            else if (log.haveI) log.pframes++;
+            if (!log.haveI) break;                                          // P frames without their I frame are lost
+            if (!log.firstTime) log.firstTime = log.prev[0][0];
+            log.lastTime = log.prev[0][0];
+            if (out) printFrame(&log, nr);
+            break;
+        case 'E':
+            summary(&log, nr);
+            log.count = 0;
+            log.iframes = log.pframes = 0;
+            break;
+        default:
+        resync:                                                             // Torn or unknown, next 'H' frame
+            for (pos = start + 1; pos + 5 <= size && memcmp(&data[pos], "HBBX1", 5); pos++);
+            if (pos + 5 > size) pos = size;
+            log.skipped += pos - start;
+            log.count = 0;
+            break;
+        }
+    }
+    summary(&log, nr);
+}
+
+static uint8_t crc8Dvb(uint8_t crc, uint8_t c)                              // Like the firmware
+{
+    int i;
+    crc ^= c;
+    for (i = 0; i < 8; i++) crc = crc & 0x80 ? (crc << 1) ^ 0xD5 : crc << 1;
+    return crc;
+}
+
+static int openSerial(const char *dev, int baud)
+{
+    static const struct { int baud; speed_t speed; } speeds[] =
+    {
+        { 9600, B9600 }, { 19200, B19200 }, { 38400, B38400 }, { 57600, B57600 }, { 115200, B115200 }, { 230400, B230400 },
+        { 460800, B460800 }, { 921600, B921600 },
+    };
+    struct termios tio;
+    size_t i;
+    int    fd;
+
+    for (i = 0; i < sizeof(speeds) / sizeof(speeds[0]) && speeds[i].baud != baud; i++);
+    if (i == sizeof(speeds) / sizeof(speeds[0]))
+    {
+        fprintf(stderr, "%d baud not supported\n", baud);
+        return -1;
+    }
+    if ((fd = open(dev, O_RDONLY | O_NOCTTY)) < 0 || tcgetattr(fd, &tio) < 0)
+    {
+        perror(dev);
+        return -1;
+    }
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, speeds[i].speed);
+    cfsetospeed(&tio, speeds[i].speed);
+    tio.c_cc[VMIN]  = 1;
+    tio.c_cc[VTIME] = 0;
+    tcsetattr(fd, TCSANOW, &tio);
+    return fd;
+}
+
+static int openTcp(const char *src)                                         // host:port
+{
+    struct addrinfo hints, *res;
+    char   host[256];
+    const char *colon = strrchr(src, ':');
+    int    fd;
+
+    snprintf(host, sizeof(host), "%.*s", (int)(colon - src), src);
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host, colon + 1, &hints, &res))
+    {
+        fprintf(stderr, "%s: unknown host\n", src);
+        return -1;
+    }
+    fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd < 0 || connect(fd, res->ai_addr, res->ai_addrlen) < 0)
+    {
+        perror(src);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+static void onSignal(int sig)
+{
+    stop = 1;
+}
+
+static void liveFrame(bbLog_t *log, int *nr, uint8_t *frame, uint8_t len)  // One frame with good CRC
+{
+    bbLog_t  h;
+    size_t   pos = 1;
+    uint32_t last = log->prev[0][0], gap;
+
+    data = frame;
+    size = len;
+    if (frame[0] == 'H')
+    {
+        memset(&h, 0, sizeof(h));
+        if (!header(&h, &pos) || pos != size) return;
+        if (h.period == log->period && h.count == log->count && !memcmp(h.pred, log->pred, sizeof(h.pred)) &&
+            !memcmp(h.name, log->name, sizeof(h.name))) return;             // The repeat of the current one
+        summary(log, *nr);
+        h.crcErrors = log->crcErrors;
+        h.missing   = log->missing;
+        *log = h;
+        printHeader(log);
+        (*nr)++;
+        return;
+    }
+    if ((frame[0] != 'I' && frame[0] != 'P') || !log->count || (frame[0] == 'P' && !log->haveI)) return;
+    if (!values(log, &pos, frame[0] == 'I') || pos != size)
+    {
+        log->haveI = 0;
+        return;
+    }
+    if (log->haveI && log->period)                                          // Frames in between that didn't come
+    {
+        gap = ((uint32_t)log->prev[0][0] - last + log->period / 2) / log->period;
+        if (gap > 1) log->missing += gap - 1;
+    }
+    log->bytes += len + 4;
+    if (frame[0] == 'I') log->iframes++;
+    else log->pframes++;
+    log->haveI = 1;
+    if (!log->firstTime) log->firstTime = log->prev[0][0];
+    log->lastTime = log->prev[0][0];
+    printFrame(log, *nr);
+    fflush(stdout);
+}
+
+static int live(const char *src, int baud)                                  // Serial port or host:port until EOF / Ctrl-C
+{
+    bbLog_t log;
+    uint8_t buf[256], frame[256], crc = 0, len = 0;
+    int     fd, state = 0, nr = 0, n, i, k = 0;
+
+    fd = strchr(src, ':') && src[0] != '/' ? openTcp(src) : openSerial(src, baud);
+    if (fd < 0) return 1;
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    memset(&log, 0, sizeof(log));
+    while (!stop && ((n = read(fd, buf, sizeof(buf))) > 0 || (n < 0 && errno == EINTR)))
+    {
+        for (i = 0; i < n; i++)
+        {
+            switch (state)
+            {
+            case 0:                                                         // '$'
+                state = buf[i] == '$';
+                break;
+            case 1:                                                         // 'S', MSP and the rest are skipped
+                state = buf[i] == 'S' ? 2 : buf[i] == '$';
+                break;
+            case 2:
+                len   = buf[i];
+                crc   = crc8Dvb(0, len);
+                k     = 0;
+                state = len ? 3 : 0;
+                break;
+            case 3:
+                frame[k++] = buf[i];
+                crc        = crc8Dvb(crc, buf[i]);
+                if (k == len) state = 4;
+                break;
+            case 4:
+                if (crc == buf[i]) liveFrame(&log, &nr, frame, len);
+                else
+                {
+                    log.crcErrors++;
+                    log.haveI = 0;                                          // Predictions are off until the next I frame
+                }
+                state = 0;
+                break;
+            }
+        }
+    }
+    close(fd);
+    summary(&log, nr);
+    fprintf(stderr, "stream: %u CRC errors, %u frames missing\n", log.crcErrors, log.missing);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *src = NULL;
+    int   want = 0, baud = 115200, opt;
+    FILE  *fp = stdin;
+
+    for (opt = 1; opt < argc; opt++)
+    {
+        if (!strcmp(argv[opt], "-n") && opt + 1 < argc) want = atoi(argv[++opt]);
+        else if (!strcmp(argv[opt], "-s") && opt + 1 < argc) src = argv[++opt];
+        else if (!strcmp(argv[opt], "-b") && opt + 1 < argc) baud = atoi(argv[++opt]);
+        else if (argv[opt][0] == '-')
+        {
+            fprintf(stderr, "Usage: %s [-n log] [file]\n       %s -s /dev/ttyUSB0 | host:port [-b baud]\n", argv[0], argv[0]);
+            return 1;
+        }
+        else if (!(fp = fopen(argv[opt], "rb")))
+        {
+            perror(argv[opt]);
+            return 1;
+        }
+    }
+    if (src) return live(src, baud);
+    decodeLog(fp, want);
+    return 0;
+}